@@ -2188,6 +2188,41 @@ dnnl_status_t DNNL_API dnnl_layer_normalization_backward_desc_init(
 
 /// @} dnnl_api_layer_normalization
 
+/// @addtogroup dnnl_api_layer_normalization_v2
+/// @{
+
+/// Initializes a descriptor for layer normalization v2 forward propagation
+/// primitive. Unlike dnnl_layer_normalization_forward_desc_init(), the
+/// destination may differ from the source in data type, e.g. to produce
+/// quantized output.
+///
+/// @note
+///     In-place operation is supported if @p src_desc and @p dst_desc have
+///     the same data type.
+///
+/// @param lnrm_desc Output descriptor for layer normalization primitive.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_forward_training and #dnnl_forward_inference.
+/// @param src_desc Source memory descriptor.
+/// @param dst_desc Destination memory descriptor. Must have the same
+///     dimensions as @p src_desc.
+/// @param stat_desc Memory descriptor for mean and variance. If this
+///     parameter is NULL, a zero memory descriptor, or a memory descriptor
+///     with format_kind set to #dnnl_format_kind_undef, then the memory
+///     descriptor for stats is derived from @p src_desc by removing the last
+///     dimension.
+/// @param epsilon Layer normalization epsilon parameter.
+/// @param flags Layer normalization flags (@ref dnnl_normalization_flags_t).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_layer_normalization_v2_forward_desc_init(
+        dnnl_layer_normalization_v2_desc_t *lnrm_desc,
+        dnnl_prop_kind_t prop_kind, const dnnl_memory_desc_t *src_desc,
+        const dnnl_memory_desc_t *dst_desc,
+        const dnnl_memory_desc_t *stat_desc, float epsilon, unsigned flags);
+
+/// @} dnnl_api_layer_normalization_v2
+
 /// @addtogroup dnnl_api_inner_product
 /// @{
 
@@ -3318,6 +3353,27 @@ dnnl_status_t DNNL_API dnnl_engine_create(
 dnnl_status_t DNNL_API dnnl_engine_get_kind(
         dnnl_engine_t engine, dnnl_engine_kind_t *kind);
 
+/// Sets the allocator an engine uses for the memory it allocates: the memory
+/// objects created with #DNNL_MEMORY_ALLOCATE and the scratchpads of the
+/// primitives created on the engine. Only CPU engines with a non-SYCL runtime
+/// support user allocators.
+///
+/// The allocator should be set before the engine is used. Memory allocated
+/// before is freed the way it was allocated. The allocator must stay valid
+/// until all the memory allocated through it is freed. Note that the
+/// scratchpad arena may keep buffers until its capacity is reduced.
+///
+/// @param engine Engine to set the allocator for.
+/// @param allocate Allocation function. Pass NULL together with
+///     @p deallocate to restore the default allocator.
+/// @param deallocate Deallocation function.
+/// @param user_data User data passed to @p allocate and @p deallocate.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_engine_set_allocator(dnnl_engine_t engine,
+        dnnl_engine_allocate_t allocate, dnnl_engine_deallocate_t deallocate,
+        void *user_data);
+
 /// Destroys an engine.
 ///
 /// @param engine Engine to destroy.
@@ -3340,6 +3396,31 @@ dnnl_status_t DNNL_API dnnl_engine_destroy(dnnl_engine_t engine);
 dnnl_status_t DNNL_API dnnl_stream_create(
         dnnl_stream_t *stream, dnnl_engine_t engine, unsigned flags);
 
+/// Creates an execution stream bound to a thread team. The parallel sections
+/// of the primitives executed on the stream use the number of threads of the
+/// team instead of all the threads available to the library. With the OpenMP
+/// CPU runtime the threads are also bound to the CPUs of the team.
+///
+/// @note
+///     Primitives choose their blocking and threading parameters when they
+///     are created. Use dnnl_set_current_thread_team() to create primitives
+///     for the team size. A primitive never uses more threads than were
+///     available when it was created or than the library can use, so a
+///     larger team gets fewer threads.
+///
+/// @param stream Output execution stream.
+/// @param engine CPU engine to create the execution stream on.
+/// @param flags Stream behavior flags (@sa dnnl_stream_flags_t).
+/// @param nthreads Number of threads in the team.
+/// @param ncpus Number of elements in @p cpus. Pass 0 to keep the thread
+///     affinity unchanged.
+/// @param cpus Logical processors the threads of the team run on.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_create_with_thread_team(
+        dnnl_stream_t *stream, dnnl_engine_t engine, unsigned flags,
+        int nthreads, int ncpus, const int *cpus);
+
 /// Returns the engine of a stream object.
 ///
 /// @param stream Stream object.
@@ -3391,6 +3472,43 @@ dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity(int *capacity);
 ///     success.
 dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity(int capacity);
 
+/// Returns the total size of the primitives that can be held in the primitive
+/// cache at the same time.
+///
+/// @param budget Primitive cache budget to query, in bytes. 0 means that the
+/// size of the primitives is not limited. Concurrently accessing @p budget is
+/// safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p budget value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_budget(size_t *budget);
+
+/// Sets the total size of the primitives that can be held in the primitive
+/// cache at a time.
+///
+/// The size of a primitive is the size of the JIT code generated for it and
+/// the size of the scratchpad it requires. The primitives are evicted from the
+/// cache when their total size exceeds the budget. The budget applies in
+/// addition to the primitive cache capacity.
+///
+/// @param budget Primitive cache budget to set, in bytes. Setting the
+/// @p budget to 0 removes the limit. Concurrently modifying @p budget is safe.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_primitive_cache_budget(size_t budget);
+
+/// Returns the primitive cache statistics.
+///
+/// The counters are accumulated since the library was loaded. Setting the
+/// primitive cache capacity does not reset them.
+///
+/// @param stats Primitive cache statistics to query. Concurrently querying
+/// @p stats is safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p stats value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_stats(
+        dnnl_primitive_cache_stats_t *stats);
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_service
@@ -3405,12 +3523,35 @@ dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity(int capacity);
 /// @param level Verbosity level:
 ///  - 0: no verbose output (default),
 ///  - 1: primitive information at execution,
-///  - 2: primitive information at creation and execution.
+///  - 2: primitive information at creation and execution,
+///  - 3: primitive information at creation and execution, and primitive
+///    cache statistics at creation.
 /// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
 ///     @p level value is invalid, and #dnnl_success/#dnnl::status::success on
 ///     success.
 dnnl_status_t DNNL_API dnnl_set_verbose(int level);
 
+/// Configures the execution trace.
+///
+/// The library records the creation and the execution of the primitives into
+/// per-thread buffers and periodically writes them to a file in the Chrome
+/// trace event format, which can be opened with chrome://tracing or Perfetto.
+/// Unlike verbose output, recording does not wait for the primitives to
+/// complete, so for asynchronous streams the execution events only cover the
+/// submission of the primitives. Events are dropped if a thread records them
+/// faster than they are written.
+///
+/// @note
+///     This setting overrides the DNNL_TRACE_FILE environment variable.
+///
+/// @param path Path of the trace file. The file is overwritten. The previous
+///     trace file, if any, is completed and closed. Pass NULL or an empty
+///     string to disable the trace.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     file cannot be opened, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_set_trace_file(const char *path);
+
 /// Configures dumping of JIT-generated code.
 ///
 /// @note
@@ -3557,6 +3698,88 @@ dnnl_status_t DNNL_API dnnl_set_cpu_isa_hints(dnnl_cpu_isa_hints_t isa_hints);
 /// library can follow.
 dnnl_cpu_isa_hints_t DNNL_API dnnl_get_cpu_isa_hints(void);
 
+/// Sets the number of threads of the thread team of the calling thread. The
+/// primitives created by the calling thread choose their blocking and
+/// threading parameters for this number of threads, and the parallel sections
+/// of the primitives it executes use this number of threads unless the
+/// stream is bound to its own thread team.
+///
+/// @sa dnnl_stream_create_with_thread_team()
+///
+/// @param nthreads Number of threads in the team. Pass 0 to use all the
+///     threads available to the library.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_set_current_thread_team(int nthreads);
+
+/// Returns the capacity of the scratchpad arena.
+///
+/// @param capacity Scratchpad arena capacity to query, in bytes. 0 means that
+///     the arena is disabled. Concurrently accessing @p capacity is safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p capacity value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_scratchpad_arena_capacity(size_t *capacity);
+
+/// Sets the capacity of the scratchpad arena.
+///
+/// The scratchpad arena is a pool of scratchpad buffers shared by all the
+/// threads and streams. The primitives created on a CPU engine with
+/// #dnnl_scratchpad_mode_library while the arena is enabled take a buffer
+/// from the arena for each execution and return it afterwards instead of
+/// holding their own scratchpad. The capacity limits the total size of the
+/// buffers the arena keeps for reuse. The arena capacity can also be set with
+/// the DNNL_SCRATCHPAD_ARENA_CAPACITY_MB environment variable.
+///
+/// @param capacity Scratchpad arena capacity to set, in bytes. Setting the
+///     @p capacity to 0 disables the arena for the primitives created
+///     afterwards. Concurrently modifying @p capacity is safe.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_scratchpad_arena_capacity(size_t capacity);
+
+/// Returns the policy applied to the large CPU allocations of the library.
+///
+/// @param threshold Output size starting from which an allocation is
+///     considered large, in bytes. 0 means that the policy is disabled.
+/// @param use_huge_pages Output flag telling whether large allocations are
+///     backed by transparent huge pages.
+/// @param placement Output placement policy of the pages of large
+///     allocations.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if one
+///     of the output pointers is NULL, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_large_allocation_policy(size_t *threshold,
+        int *use_huge_pages, dnnl_memory_placement_t *placement);
+
+/// Sets the policy applied to the large CPU allocations of the library, such
+/// as the memory objects, the scratchpads, and the buffers of the weights
+/// reorders.
+///
+/// Large allocations are aligned to 2 MB and advised to be backed by
+/// transparent huge pages, which reduces the TLB pressure. Their pages can
+/// also be placed on the NUMA nodes of the library threads by touching them
+/// in parallel right after the allocation. The policy can also be set with
+/// the DNNL_LARGE_ALLOCATION_THRESHOLD_MB, DNNL_LARGE_ALLOCATION_HUGE_PAGES,
+/// and DNNL_LARGE_ALLOCATION_PLACEMENT (`system`, `first_touch`, or
+/// `interleave`) environment variables.
+///
+/// @note
+///     Transparent huge pages are supported on Linux only. The system may
+///     still back the memory with regular pages, for example, when
+///     transparent huge pages are disabled.
+///
+/// @param threshold Size starting from which an allocation is considered
+///     large, in bytes. Setting the @p threshold to 0 (default) disables the
+///     policy.
+/// @param use_huge_pages Back large allocations with transparent huge pages
+///     if not 0.
+/// @param placement Placement policy of the pages of large allocations.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p placement value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_set_large_allocation_policy(size_t threshold,
+        int use_huge_pages, dnnl_memory_placement_t placement);
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_blas
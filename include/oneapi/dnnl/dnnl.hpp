@@ -313,6 +313,8 @@ struct primitive : public handle<dnnl_primitive_t> {
         reduction = dnnl_reduction,
         /// A PReLU primitive.
         prelu = dnnl_prelu,
+        /// A layer normalization version 2 primitive.
+        layer_normalization_v2 = dnnl_layer_normalization_v2,
     };
 
     using handle::handle;
@@ -805,6 +807,11 @@ enum class query {
     /// propagation kind
     prop_kind = dnnl_query_prop_kind,
 
+    /// estimated number of floating point operations of an execution
+    flops_estimate_f64 = dnnl_query_flops_estimate_f64,
+    /// estimated number of bytes an execution has to read and write at least
+    bytes_estimate_f64 = dnnl_query_bytes_estimate_f64,
+
     /// operation descriptor
     op_d = dnnl_query_op_d,
     /// convolution descriptor
@@ -839,6 +846,8 @@ enum class query {
     resampling_d = dnnl_query_resampling_d,
     /// reduction descriptor
     reduction_d = dnnl_query_reduction_d,
+    /// layer normalization version 2 descriptor
+    layer_normalization_v2_d = dnnl_query_layer_normalization_v2_d,
 
     /// source memory desc
     src_md = dnnl_query_src_md,
@@ -955,6 +964,21 @@ struct engine : public handle<dnnl_engine_t> {
         return static_cast<engine::kind>(kind);
     }
 
+    /// Sets the allocator the engine uses for the memory it allocates.
+    ///
+    /// @sa dnnl_engine_set_allocator()
+    ///
+    /// @param allocate Allocation function. Pass nullptr together with
+    ///     @p deallocate to restore the default allocator.
+    /// @param deallocate Deallocation function.
+    /// @param user_data User data passed to @p allocate and @p deallocate.
+    void set_allocator(dnnl_engine_allocate_t allocate,
+            dnnl_engine_deallocate_t deallocate, void *user_data = nullptr) {
+        error::wrap_c_api(dnnl_engine_set_allocator(
+                                  get(), allocate, deallocate, user_data),
+                "could not set an engine allocator");
+    }
+
     /// Returns the engine of a primitive descriptor.
     ///
     /// @param pd The primitive descriptor to query.
@@ -1038,6 +1062,27 @@ struct stream : public handle<dnnl_stream_t> {
         reset(stream);
     }
 
+    /// Constructs a stream for the specified engine that is bound to a thread
+    /// team.
+    ///
+    /// @sa dnnl_stream_create_with_thread_team()
+    ///
+    /// @param aengine CPU engine to create the stream on.
+    /// @param aflags Flags controlling stream behavior.
+    /// @param nthreads Number of threads in the team.
+    /// @param cpus Logical processors the threads of the team run on. Pass
+    ///     an empty vector to keep the thread affinity unchanged.
+    stream(const engine &aengine, flags aflags, int nthreads,
+            const std::vector<int> &cpus = {}) {
+        dnnl_stream_t stream;
+        error::wrap_c_api(
+                dnnl_stream_create_with_thread_team(&stream, aengine.get(),
+                        static_cast<dnnl_stream_flags_t>(aflags), nthreads,
+                        (int)cpus.size(), cpus.data()),
+                "could not create a stream");
+        reset(stream);
+    }
+
     /// Returns the associated engine.
     engine get_engine() const {
         dnnl_engine_t c_engine;
@@ -3328,6 +3373,16 @@ struct primitive_desc_base : public handle<dnnl_primitive_desc_t> {
         return status == dnnl_success ? res : 0;
     }
 
+    /// Returns a double value.
+    /// @param what The value to query.
+    /// @returns The result of the query.
+    double query_f64(query what) const {
+        double res;
+        dnnl_status_t status = dnnl_primitive_desc_query(
+                get(), dnnl::convert_to_c(what), 0, &res);
+        return status == dnnl_success ? res : 0;
+    }
+
     /// Returns a memory descriptor.
     ///
     /// @note
@@ -7128,6 +7183,167 @@ struct layer_normalization_backward : public primitive {
 
 /// @} dnnl_api_layer_normalization
 
+/// @addtogroup dnnl_api_layer_normalization_v2 Layer Normalization_v2
+///
+/// A primitive to perform layer normalization with a destination that may
+/// differ from the source in data type, e.g. to produce quantized output.
+///
+/// @sa @ref dev_guide_layer_normalization in developer guide
+///
+/// @{
+
+/// Layer normalization v2 forward propagation primitive.
+struct layer_normalization_v2_forward : public primitive {
+    /// Descriptor for a layer normalization v2 forward propagation primitive.
+    struct desc {
+        dnnl_layer_normalization_v2_desc_t data;
+
+        /// Constructs a descriptor for layer normalization v2 forward
+        /// propagation primitive.
+        ///
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param src_desc Source memory descriptor.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param stat_desc Statistics memory descriptors.
+        /// @param epsilon Layer normalization epsilon parameter.
+        /// @param flags Layer normalization flags (@ref
+        ///     dnnl::normalization_flags).
+        desc(prop_kind aprop_kind, const memory::desc &src_desc,
+                const memory::desc &dst_desc, const memory::desc &stat_desc,
+                float epsilon, normalization_flags flags) {
+            error::wrap_c_api(
+                    dnnl_layer_normalization_v2_forward_desc_init(&data,
+                            dnnl::convert_to_c(aprop_kind), &src_desc.data,
+                            &dst_desc.data, &stat_desc.data, epsilon,
+                            convert_to_c(flags)),
+                    "could not create a descriptor for a layer normalization "
+                    "v2 forward propagation primitive");
+        }
+
+        /// Constructs a descriptor for layer normalization v2 forward
+        /// propagation primitive.
+        ///
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param src_desc Source memory descriptor.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param epsilon Layer normalization epsilon parameter.
+        /// @param flags Layer normalization flags (@ref
+        ///     dnnl::normalization_flags).
+        desc(prop_kind aprop_kind, const memory::desc &src_desc,
+                const memory::desc &dst_desc, float epsilon,
+                normalization_flags flags) {
+            error::wrap_c_api(
+                    dnnl_layer_normalization_v2_forward_desc_init(&data,
+                            dnnl::convert_to_c(aprop_kind), &src_desc.data,
+                            &dst_desc.data, nullptr, epsilon,
+                            convert_to_c(flags)),
+                    "could not create a descriptor for a layer normalization "
+                    "v2 forward propagation primitive");
+        }
+    };
+
+    /// Primitive descriptor for a layer normalization v2 forward propagation
+    /// primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for a layer normalization v2
+        /// forward propagation primitive.
+        ///
+        /// @param adesc Descriptor for a layer normalization v2 forward
+        ///     propagation primitive.
+        /// @param aengine Engine to use.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const desc &adesc, const engine &aengine,
+                bool allow_empty = false)
+            : dnnl::primitive_desc(
+                    &adesc.data, nullptr, aengine, nullptr, allow_empty) {}
+
+        /// Constructs a primitive descriptor for a layer normalization v2
+        /// forward propagation primitive.
+        ///
+        /// @param adesc Descriptor for a layer normalization v2 forward
+        ///     propagation primitive.
+        /// @param attr Primitive attributes to use.
+        /// @param aengine Engine to use.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const desc &adesc, const primitive_attr &attr,
+                const engine &aengine, bool allow_empty = false)
+            : dnnl::primitive_desc(
+                    &adesc.data, &attr, aengine, nullptr, allow_empty) {}
+
+        /// Constructs a primitive descriptor for a layer normalization v2
+        /// forward propagation primitive from a C API primitive descriptor
+        /// that must have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for a layer normalization v2
+        ///     forward propagation primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd,
+                    dnnl::primitive::kind::layer_normalization_v2,
+                    dnnl::prop_kind::forward_training,
+                    dnnl::prop_kind::forward_inference) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::weights_desc()const
+        memory::desc weights_desc() const { return base::weights_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::workspace_desc()const
+        memory::desc workspace_desc() const { return base::workspace_desc(); }
+
+        /// @copydoc dnnl::batch_normalization_forward::primitive_desc::mean_desc()const
+        memory::desc mean_desc() const { return stat_desc(mean); }
+
+        /// @copydoc dnnl::batch_normalization_forward::primitive_desc::variance_desc()const
+        memory::desc variance_desc() const { return stat_desc(var); }
+
+    private:
+        enum {
+            mean = 1,
+            var = 2,
+        };
+        memory::desc stat_desc(int kind) const {
+            dnnl_layer_normalization_v2_desc_t *p;
+            error::wrap_c_api(
+                    dnnl_primitive_desc_query(get(),
+                            dnnl::convert_to_c(query::layer_normalization_v2_d),
+                            0, &p),
+                    "could not retrieve a descriptor from a primitive "
+                    "descriptor for layer normalization v2 forward "
+                    "propagation primitive");
+            return query_md(p->flags & dnnl_use_global_stats ? query::src_md
+                                                             : query::dst_md,
+                    kind);
+        }
+    };
+
+    /// Default constructor. Produces an empty object.
+    layer_normalization_v2_forward() = default;
+
+    /// Constructs a layer normalization v2 forward propagation primitive.
+    /// @param pd Primitive descriptor for a layer normalization v2 forward
+    ///     propagation primitive.
+    layer_normalization_v2_forward(const primitive_desc &pd) : primitive(pd) {}
+};
+
+/// @} dnnl_api_layer_normalization_v2
+
 /// @addtogroup dnnl_api_inner_product Inner Product
 ///
 /// A primitive to compute an inner product.
@@ -10883,6 +11099,11 @@ inline status set_verbose(int level) {
     return static_cast<status>(dnnl_set_verbose(level));
 }
 
+/// @copydoc dnnl_set_trace_file()
+inline status set_trace_file(const std::string &path) {
+    return static_cast<status>(dnnl_set_trace_file(path.c_str()));
+}
+
 /// @copydoc dnnl_version()
 inline const version_t *version() {
     return dnnl_version();
@@ -10959,6 +11180,63 @@ inline cpu_isa_hints get_cpu_isa_hints() {
     return static_cast<cpu_isa_hints>(dnnl_get_cpu_isa_hints());
 }
 
+/// @copydoc dnnl_set_current_thread_team()
+inline void set_current_thread_team(int nthreads) {
+    error::wrap_c_api(dnnl_set_current_thread_team(nthreads),
+            "could not set the thread team");
+}
+
+/// @copydoc dnnl_get_scratchpad_arena_capacity()
+inline size_t get_scratchpad_arena_capacity() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_scratchpad_arena_capacity(&result),
+            "could not get scratchpad arena capacity");
+    return result;
+}
+
+/// @copydoc dnnl_set_scratchpad_arena_capacity()
+inline void set_scratchpad_arena_capacity(size_t capacity) {
+    error::wrap_c_api(dnnl_set_scratchpad_arena_capacity(capacity),
+            "could not set scratchpad arena capacity");
+}
+
+/// @copydoc dnnl_memory_placement_t
+enum class memory_placement {
+    /// @copydoc dnnl_memory_placement_system
+    system = dnnl_memory_placement_system,
+    /// @copydoc dnnl_memory_placement_first_touch
+    first_touch = dnnl_memory_placement_first_touch,
+    /// @copydoc dnnl_memory_placement_interleave
+    interleave = dnnl_memory_placement_interleave,
+};
+
+/// @copydoc dnnl_set_large_allocation_policy()
+inline void set_large_allocation_policy(size_t threshold,
+        bool use_huge_pages = true,
+        memory_placement placement = memory_placement::system) {
+    error::wrap_c_api(
+            dnnl_set_large_allocation_policy(threshold, use_huge_pages,
+                    static_cast<dnnl_memory_placement_t>(placement)),
+            "could not set large allocation policy");
+}
+
+/// Returns the size starting from which a CPU allocation is considered
+/// large, in bytes.
+///
+/// @sa dnnl_get_large_allocation_policy()
+///
+/// @returns Large allocation threshold. 0 means that the large allocation
+///     policy is disabled.
+inline size_t get_large_allocation_threshold() {
+    size_t threshold = 0;
+    int use_huge_pages = 0;
+    dnnl_memory_placement_t placement;
+    error::wrap_c_api(dnnl_get_large_allocation_policy(
+                              &threshold, &use_huge_pages, &placement),
+            "could not get large allocation policy");
+    return threshold;
+}
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_primitive_cache Primitive Cache
@@ -10982,6 +11260,32 @@ inline void set_primitive_cache_capacity(int capacity) {
             "could not set primitive cache capacity");
 }
 
+/// Returns the total size of the primitives that can be held in the primitive
+/// cache at the same time.
+inline size_t get_primitive_cache_budget() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_budget(&result),
+            "could not get primitive cache budget");
+    return result;
+}
+
+/// @copydoc dnnl_set_primitive_cache_budget(size_t budget)
+inline void set_primitive_cache_budget(size_t budget) {
+    error::wrap_c_api(dnnl_set_primitive_cache_budget(budget),
+            "could not set primitive cache budget");
+}
+
+/// @copydoc dnnl_primitive_cache_stats_t
+using primitive_cache_stats_t = dnnl_primitive_cache_stats_t;
+
+/// Returns the primitive cache statistics.
+inline primitive_cache_stats_t get_primitive_cache_stats() {
+    primitive_cache_stats_t result;
+    error::wrap_c_api(dnnl_get_primitive_cache_stats(&result),
+            "could not get primitive cache statistics");
+    return result;
+}
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_blas BLAS functions
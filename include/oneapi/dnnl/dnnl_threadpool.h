@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2020 Intel Corporation
+* Copyright 2020-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -46,6 +46,54 @@ extern "C" {
 dnnl_status_t DNNL_API dnnl_threadpool_interop_stream_create(
         dnnl_stream_t *stream, dnnl_engine_t engine, void *threadpool);
 
+/// Creates an asynchronous execution stream with specified threadpool.
+///
+/// Primitives submitted to an asynchronous stream are executed in order by a
+/// task scheduled on the threadpool, and dnnl_primitive_execute() returns as
+/// soon as the primitive is queued. Completion is signaled with
+/// dnnl_threadpool_interop_stream_enqueue_callback() or awaited with
+/// dnnl_stream_wait(). The memory objects passed to the primitives must stay
+/// alive until the primitives complete.
+///
+/// The execution is asynchronous only if the threadpool is asynchronous and
+/// has more than one thread. Otherwise the stream executes the primitives
+/// synchronously.
+///
+/// @sa @ref dev_guide_threadpool
+///
+/// @param stream Output execution stream.
+/// @param engine Engine to create the execution stream on.
+/// @param threadpool Pointer to an instance of a C++ class that implements
+///     dnnl::threapdool_iface interface.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_threadpool_interop_stream_create_async(
+        dnnl_stream_t *stream, dnnl_engine_t engine, void *threadpool);
+
+/// A callback invoked by an asynchronous execution stream.
+///
+/// @param status #dnnl_success if all the primitives submitted to the stream
+///     since the previous callback completed successfully, and the status of
+///     the first failed primitive otherwise.
+/// @param user_data User data passed along with the callback.
+typedef void (*dnnl_threadpool_interop_callback_t)(
+        dnnl_status_t status, void *user_data);
+
+/// Enqueues a callback to an execution stream. The callback is invoked once
+/// all the primitives submitted to the stream before it complete. For a
+/// synchronous stream the callback is invoked immediately.
+///
+/// @sa @ref dev_guide_threadpool
+///
+/// @param astream Execution stream.
+/// @param callback Callback to invoke.
+/// @param user_data User data to pass to the callback.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_threadpool_interop_stream_enqueue_callback(
+        dnnl_stream_t astream, dnnl_threadpool_interop_callback_t callback,
+        void *user_data);
+
 /// Returns a threadpool to be used by the execution stream.
 ///
 /// @sa @ref dev_guide_threadpool
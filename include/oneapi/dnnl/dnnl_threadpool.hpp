@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2020 Intel Corporation
+* Copyright 2020-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -54,6 +54,43 @@ inline dnnl::stream make_stream(
     return dnnl::stream(c_stream);
 }
 
+/// Constructs an asynchronous execution stream for the specified engine and
+/// threadpool. Primitives submitted to the stream are executed in order by a
+/// task scheduled on the threadpool and primitive::execute() returns as soon
+/// as the primitive is queued. The execution is synchronous if the threadpool
+/// is not asynchronous or has a single thread.
+///
+/// @sa @ref dev_guide_threadpool
+///
+/// @param aengine Engine to create the stream on.
+/// @param threadpool Pointer to an instance of a C++ class that implements
+///     dnnl::threapdool_iface interface.
+/// @returns An execution stream.
+inline dnnl::stream make_async_stream(
+        const dnnl::engine &aengine, threadpool_iface *threadpool) {
+    dnnl_stream_t c_stream;
+    dnnl::error::wrap_c_api(dnnl_threadpool_interop_stream_create_async(
+                                    &c_stream, aengine.get(), threadpool),
+            "could not create stream");
+    return dnnl::stream(c_stream);
+}
+
+/// Enqueues a callback to an execution stream. The callback is invoked with
+/// the status of the primitives submitted since the previous callback once
+/// they complete.
+///
+/// @sa @ref dev_guide_threadpool
+///
+/// @param astream An execution stream.
+/// @param callback Callback to invoke.
+/// @param user_data User data to pass to the callback.
+inline void enqueue_callback(const dnnl::stream &astream,
+        dnnl_threadpool_interop_callback_t callback, void *user_data) {
+    dnnl::error::wrap_c_api(dnnl_threadpool_interop_stream_enqueue_callback(
+                                    astream.get(), callback, user_data),
+            "could not enqueue callback");
+}
+
 /// Returns the pointer to a threadpool that is used by an execution stream.
 ///
 /// @sa @ref dev_guide_threadpool
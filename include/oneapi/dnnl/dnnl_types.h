@@ -1161,6 +1161,9 @@ typedef enum {
     dnnl_reduction,
     /// A PReLU primitive.
     dnnl_prelu,
+    /// A layer normalization version 2 primitive (layer normalization with a
+    /// destination that may differ from the source in data type).
+    dnnl_layer_normalization_v2,
 
     /// Parameter to allow internal only primitives without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -1991,6 +1994,45 @@ typedef struct {
 
 /// @} dnnl_api_layer_normalization
 
+/// @addtogroup dnnl_api_layer_normalization_v2
+/// @{
+
+/// A descriptor of a Layer Normalization operation.
+typedef struct {
+    /// The kind of primitive. Used for self-identifying the primitive
+    /// descriptor. Must be #dnnl_layer_normalization_v2.
+    dnnl_primitive_kind_t primitive_kind;
+    /// The kind of propagation. Possible values: #dnnl_forward_training,
+    /// #dnnl_forward_inference, #dnnl_backward, and #dnnl_backward_data.
+    dnnl_prop_kind_t prop_kind;
+    /// Source memory descriptor.
+    dnnl_memory_desc_t data_desc;
+    /// Source and destination gradient memory descriptor.
+    dnnl_memory_desc_t diff_data_desc;
+    /// Scale and shift data and gradient memory descriptors.
+    ///
+    /// Scaleshift memory descriptor uses 2D #dnnl_ab
+    /// format[2, normalized_dim] where 1-st dimension contains gamma parameter,
+    /// 2-nd dimension contains beta parameter. Normalized_dim is equal to the
+    /// last logical dimension of the data tensor across which normalization is
+    /// performed.
+    dnnl_memory_desc_t data_scaleshift_desc;
+    dnnl_memory_desc_t diff_data_scaleshift_desc;
+    /// Mean and variance data memory descriptors.
+    ///
+    /// Statistics (mean and variance) memory descriptor is the k-dimensional tensor
+    /// where k is equal to data_tensor_ndims - 1 and may have any plain
+    /// (stride[last_dim] == 1) user-provided format.
+    dnnl_memory_desc_t stat_desc;
+    /// Layer normalization epsilon parameter.
+    float layer_norm_epsilon;
+    unsigned flags;
+    /// Destination memory descriptor.
+    dnnl_memory_desc_t dst_desc;
+} dnnl_layer_normalization_v2_desc_t;
+
+/// @} dnnl_api_layer_normalization_v2
+
 /// @addtogroup dnnl_api_inner_product
 /// @{
 
@@ -2265,6 +2307,34 @@ typedef struct dnnl_engine *dnnl_engine_t;
 typedef const struct dnnl_engine *const_dnnl_engine_t;
 #endif
 
+/// @brief Kinds of the memory allocations an engine makes.
+typedef enum {
+    /// Memory of a memory object allocated by the library.
+    dnnl_allocation_kind_memory = 1,
+    /// Scratchpad memory, including the memory given to the primitives by
+    /// the scratchpad arena.
+    dnnl_allocation_kind_scratchpad = 2,
+} dnnl_allocation_kind_t;
+
+/// @brief A function that allocates memory for an engine.
+///
+/// @param size Size of the memory to allocate, in bytes.
+/// @param alignment Minimal alignment of the memory, in bytes.
+/// @param kind Kind of the allocation.
+/// @param user_data User data passed along with the allocator.
+/// @returns A pointer to the allocated memory or NULL on failure.
+typedef void *(*dnnl_engine_allocate_t)(size_t size, size_t alignment,
+        dnnl_allocation_kind_t kind, void *user_data);
+
+/// @brief A function that frees memory allocated by a
+///     #dnnl_engine_allocate_t function.
+///
+/// @param ptr Pointer to the memory to free.
+/// @param kind Kind of the allocation.
+/// @param user_data User data passed along with the allocator.
+typedef void (*dnnl_engine_deallocate_t)(
+        void *ptr, dnnl_allocation_kind_t kind, void *user_data);
+
 /// @} dnnl_api_engine
 
 /// @addtogroup dnnl_api_primitives
@@ -2647,6 +2717,11 @@ typedef enum {
 
     dnnl_query_prop_kind, ///< propagation kind
 
+    dnnl_query_flops_estimate_f64, ///< estimated number of floating point
+    ///  operations of an execution
+    dnnl_query_bytes_estimate_f64, ///< estimated number of bytes an execution
+    ///  has to read and write at least
+
     // memory and op descriptor section
     dnnl_query_some_d = 64, ///< stub
     dnnl_query_op_d, ///< op descriptor
@@ -2669,6 +2744,8 @@ typedef enum {
     dnnl_query_pooling_v2_d, ///< pooling version 2 descriptor
     dnnl_query_reduction_d, ///< reduction descriptor
     dnnl_query_prelu_d, ///< prelu descriptor
+    dnnl_query_layer_normalization_v2_d, ///< layer normalization version 2
+    ///  descriptor
 
     // memory descriptor section
     dnnl_query_some_md = 128, ///< stub
@@ -2713,6 +2790,34 @@ typedef const struct dnnl_stream *const_dnnl_stream_t;
 
 /// @} dnnl_api_stream
 
+/// @addtogroup dnnl_api_primitive_cache
+/// @{
+
+/// Primitive cache statistics.
+typedef struct {
+    /// Number of primitive creations that found the primitive in the cache.
+    int64_t hits;
+    /// Number of primitive creations that added the primitive to the cache.
+    int64_t misses;
+    /// Number of primitives evicted from the cache.
+    int64_t evictions;
+    /// Number of primitives in the cache.
+    int size;
+    /// Primitive cache capacity.
+    int capacity;
+    /// Total time spent in creating the primitives added to the cache, in
+    /// milliseconds.
+    double creation_time_ms;
+    /// Total size of the scratchpads required by the primitives in the cache,
+    /// in bytes.
+    size_t scratchpad_size;
+    /// Total size of the JIT code generated for the primitives in the cache,
+    /// in bytes.
+    size_t jit_code_size;
+} dnnl_primitive_cache_stats_t;
+
+/// @} dnnl_api_primitive_cache
+
 /// @addtogroup dnnl_api_service
 /// @{
 
@@ -2731,6 +2836,9 @@ typedef const struct dnnl_stream *const_dnnl_stream_t;
 /// Threadpool runtime (CPU only)
 #define DNNL_RUNTIME_THREADPOOL 8u
 
+/// Native runtime: library-owned thread pool (CPU only)
+#define DNNL_RUNTIME_NATIVE 16u
+
 /// OpenCL runtime
 #define DNNL_RUNTIME_OCL 256u
 
@@ -2826,6 +2934,23 @@ typedef enum {
     dnnl_cpu_isa_prefer_ymm = 0x1,
 } dnnl_cpu_isa_hints_t;
 
+/// Placement policies for the pages of large allocations.
+///
+/// @sa dnnl_set_large_allocation_policy()
+typedef enum {
+    /// The pages are placed by the system when the computations first access
+    /// them.
+    dnnl_memory_placement_system = 0,
+    /// The pages are first touched by the library threads in contiguous
+    /// blocks, the same way parallel computations split their work, so that
+    /// each block is placed close to the thread that processes it.
+    dnnl_memory_placement_first_touch = 1,
+    /// The pages are first touched by the library threads in a round-robin
+    /// fashion, so that they are spread across the NUMA nodes the threads run
+    /// on.
+    dnnl_memory_placement_interleave = 2,
+} dnnl_memory_placement_t;
+
 /// @} dnnl_api_service
 
 /// @} dnnl_api
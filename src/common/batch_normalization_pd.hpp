@@ -85,6 +85,16 @@ struct batch_normalization_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(desc_.data_desc).has_zero_dim();
     }
 
+    // Per element: an add for the mean and a subtraction and a multiply-add
+    // for the variance when they are computed, then a subtraction and a
+    // multiply-add with the scale and shift. The backward pass reduces
+    // diff_gamma and diff_beta and computes diff_src, 9 operations.
+    double flops_estimate() const override {
+        const double nelems = (double)MB() * C() * D() * H() * W();
+        if (is_bwd()) return 9. * nelems;
+        return (use_global_stats() ? 3. : 7.) * nelems;
+    }
+
 protected:
     batch_normalization_desc_t desc_;
     const batch_normalization_fwd_pd_t *hint_fwd_pd_;
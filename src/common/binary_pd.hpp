@@ -87,6 +87,10 @@ struct binary_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(src_md(0)).has_zero_dim();
     }
 
+    double flops_estimate() const override {
+        return (double)memory_desc_wrapper(dst_md(0)).nelems();
+    }
+
     int ndims() const { return memory_desc_wrapper(src_md(0)).ndims(); }
 
     bool is_tensor_op() const {
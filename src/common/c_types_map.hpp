@@ -944,6 +944,12 @@ const memory_extra_flags_t compensation_conv_asymmetric_src
         = dnnl_memory_extra_flag_compensation_conv_asymmetric_src;
 } // namespace memory_extra_flags
 
+using allocation_kind_t = dnnl_allocation_kind_t;
+namespace allocation_kind {
+const allocation_kind_t memory = dnnl_allocation_kind_memory;
+const allocation_kind_t scratchpad = dnnl_allocation_kind_scratchpad;
+} // namespace allocation_kind
+
 using engine_kind_t = dnnl_engine_kind_t;
 namespace engine_kind {
 const engine_kind_t any_engine = dnnl_any_engine;
@@ -959,6 +965,7 @@ enum runtime_kind_t {
     dnnl_runtime_threadpool,
     dnnl_runtime_ocl,
     dnnl_runtime_sycl,
+    dnnl_runtime_native,
 };
 
 namespace runtime_kind {
@@ -969,6 +976,7 @@ const runtime_kind_t tbb = dnnl_runtime_tbb;
 const runtime_kind_t threadpool = dnnl_runtime_threadpool;
 const runtime_kind_t ocl = dnnl_runtime_ocl;
 const runtime_kind_t sycl = dnnl_runtime_sycl;
+const runtime_kind_t native = dnnl_runtime_native;
 } // namespace runtime_kind
 
 using primitive_kind_t = dnnl_primitive_kind_t;
@@ -988,6 +996,7 @@ const primitive_kind_t prelu = dnnl_prelu;
 const primitive_kind_t lrn = dnnl_lrn;
 const primitive_kind_t batch_normalization = dnnl_batch_normalization;
 const primitive_kind_t layer_normalization = dnnl_layer_normalization;
+const primitive_kind_t layer_normalization_v2 = dnnl_layer_normalization_v2;
 const primitive_kind_t inner_product = dnnl_inner_product;
 const primitive_kind_t rnn = dnnl_rnn;
 const primitive_kind_t gemm = dnnl_gemm;
@@ -1024,6 +1033,9 @@ const query_t reorder_dst_engine = dnnl_query_reorder_dst_engine;
 
 const query_t prop_kind = dnnl_query_prop_kind;
 
+const query_t flops_estimate_f64 = dnnl_query_flops_estimate_f64;
+const query_t bytes_estimate_f64 = dnnl_query_bytes_estimate_f64;
+
 const query_t some_d = dnnl_query_some_d;
 const query_t op_d = dnnl_query_op_d;
 const query_t convolution_d = dnnl_query_convolution_d;
@@ -1037,6 +1049,7 @@ const query_t prelu_d = dnnl_query_prelu_d;
 const query_t lrn_d = dnnl_query_lrn_d;
 const query_t batch_normalization_d = dnnl_query_batch_normalization_d;
 const query_t layer_normalization_d = dnnl_query_layer_normalization_d;
+const query_t layer_normalization_v2_d = dnnl_query_layer_normalization_v2_d;
 const query_t inner_product_d = dnnl_query_inner_product_d;
 const query_t rnn_d = dnnl_query_rnn_d;
 const query_t gemm_d = dnnl_query_gemm_d;
@@ -1079,6 +1092,7 @@ using softmax_desc_t = dnnl_softmax_desc_t;
 using lrn_desc_t = dnnl_lrn_desc_t;
 using batch_normalization_desc_t = dnnl_batch_normalization_desc_t;
 using layer_normalization_desc_t = dnnl_layer_normalization_desc_t;
+using layer_normalization_v2_desc_t = dnnl_layer_normalization_v2_desc_t;
 using inner_product_desc_t = dnnl_inner_product_desc_t;
 using binary_desc_t = dnnl_binary_desc_t;
 using logsoftmax_desc_t = dnnl_logsoftmax_desc_t;
@@ -1115,6 +1129,7 @@ struct op_desc_t {
         lrn_desc_t lrn;
         batch_normalization_desc_t batch_normalization;
         layer_normalization_desc_t layer_normalization;
+        layer_normalization_v2_desc_t layer_normalization_v2;
         inner_product_desc_t inner_product;
         rnn_desc_t rnn;
         gemm_desc_t gemm;
@@ -1146,6 +1161,7 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(lrn_desc_t);
     DECL_CTOR_AND_CONVERTERS(batch_normalization_desc_t);
     DECL_CTOR_AND_CONVERTERS(layer_normalization_desc_t);
+    DECL_CTOR_AND_CONVERTERS(layer_normalization_v2_desc_t);
     DECL_CTOR_AND_CONVERTERS(inner_product_desc_t);
     DECL_CTOR_AND_CONVERTERS(rnn_desc_t);
     DECL_CTOR_AND_CONVERTERS(gemm_desc_t);
@@ -156,6 +156,13 @@ struct convolution_pd_t : public primitive_desc_t {
         return s_d.has_zero_dim() || d_d.has_zero_dim();
     }
 
+    // Every output point of each propagation kind takes a multiply-add per
+    // kernel point and input channel of the group
+    double flops_estimate() const override {
+        return 2. * MB() * OC() * (IC() / G()) * KD() * KH() * KW() * OD()
+                * OH() * OW();
+    }
+
     const memory_desc_t *invariant_src_md() const {
         return desc()->prop_kind == prop_kind::backward_data ? diff_src_md()
                                                              : src_md();
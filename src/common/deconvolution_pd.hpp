@@ -134,6 +134,13 @@ struct deconvolution_pd_t : public primitive_desc_t {
         return s_d.has_zero_dim() || d_d.has_zero_dim();
     }
 
+    // Every input point of each propagation kind is spread over the kernel
+    // with a multiply-add per output channel of the group
+    double flops_estimate() const override {
+        return 2. * MB() * OC() * (IC() / G()) * KD() * KH() * KW() * ID()
+                * IH() * IW();
+    }
+
     const memory_desc_t *invariant_src_md() const {
         return desc()->prop_kind == prop_kind::backward_data ? diff_src_md()
                                                              : src_md();
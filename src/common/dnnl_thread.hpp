@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2017-2020 Intel Corporation
+* Copyright 2017-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -18,10 +18,187 @@
 #define COMMON_DNNL_THREAD_HPP
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
+#include <stdint.h>
+
+#include "perf_counters.hpp"
 #include "utils.hpp"
 #include "z_magic.hpp"
 
+namespace dnnl {
+namespace impl {
+
+// A part of the machine a stream executes on: the number of threads used by
+// the parallel sections and, optionally, the CPUs these threads are bound to.
+struct thread_team_t {
+    thread_team_t(int nthr, const std::vector<int> &cpus);
+
+    const int nthr;
+    const std::vector<int> cpus;
+    // Unique for every team, used to check if a thread is already bound
+    const size_t id;
+};
+
+namespace thread_team_utils {
+
+// Each thread maintains a thread-local pointer to the thread team that is
+// active for the current thread, set while a stream bound to a team executes
+// a primitive on the thread. If this pointer is a nullptr, the number of
+// threads set for the calling thread with dnnl_set_current_thread_team() is
+// used, if any.
+
+// Sets `team` to be the active thread team for the calling thread.
+void activate_thread_team(const thread_team_t *team);
+
+// Resets the active thread team for the calling thread to nullptr.
+void deactivate_thread_team();
+
+// Returns the active thread team for the calling thread.
+const thread_team_t *get_active_thread_team();
+
+// Returns the number of threads of the thread team of the calling thread, or
+// 0 if the calling thread has no thread team.
+int get_thread_team_nthr();
+
+// Limits the number of threads of the parallel sections started by the
+// calling thread to `nthr`, the number of threads the executed primitive was
+// created for, as its per-thread buffers are sized for this number. 0 removes
+// the limit. Returns the previous limit.
+int set_max_threads_limit(int nthr);
+
+// Returns the limit set with set_max_threads_limit() for the calling thread.
+int get_max_threads_limit();
+
+// Returns the number of threads parallel sections use given `max_nthr`, the
+// maximum number of threads of the threading runtime. A thread team never
+// gets more threads than the runtime provides or than the executed primitive
+// was created for.
+inline int get_max_threads(int max_nthr) {
+    const int team_nthr = get_thread_team_nthr();
+    const int nthr = team_nthr > 0 ? std::min(team_nthr, max_nthr) : max_nthr;
+    const int limit = get_max_threads_limit();
+    return limit > 0 ? std::min(nthr, limit) : nthr;
+}
+
+// Binds the calling thread to the CPUs of `team`, or restores its original
+// affinity if `team` is a nullptr or has no CPUs. Does nothing if the thread
+// is already bound accordingly.
+void bind_to_thread_team(const thread_team_t *team);
+
+} // namespace thread_team_utils
+
+namespace parallel_stats {
+
+// Opt-in instrumentation of the parallel sections enabled with the
+// DNNL_PARALLEL_STATS environment variable. For each parallel section the
+// time every thread spends on its part of the work and the number of items
+// for_nd() assigns to it are recorded. The statistics of a section are
+// attributed to the primitive executed by the thread that starts it and
+// reported with the verbose and trace outputs.
+//
+// The sections are also recorded when the hardware performance counters are
+// enabled (see perf_counters.hpp) to sum the counters of all the threads
+// executing a primitive.
+
+namespace detail {
+enum { uninitialized, disabled, enabled };
+extern std::atomic<int> state;
+// Reads the environment on the first call and returns the state
+int init();
+// Adds `n` work items to the record of the calling thread, if any
+void add_items(size_t n);
+} // namespace detail
+
+// Returns true if the parallel sections are recorded. Called for every
+// parallel section, so the check is inline.
+inline bool is_enabled() {
+    int state = detail::state.load(std::memory_order_relaxed);
+    if (state == detail::uninitialized) state = detail::init();
+    return state == detail::enabled;
+}
+
+// Returns true if the imbalance statistics are reported.
+bool is_imbalance_enabled();
+
+// Returns true if the calling thread executes a recorded parallel section.
+bool in_section();
+
+// Adds `n` work items to the record of the calling thread, if any.
+inline void add_items(size_t n) {
+    if (is_enabled()) detail::add_items(n);
+}
+
+// Records a parallel section of `nthr` threads while the object is alive.
+struct DNNL_API section_t {
+    section_t(int nthr);
+    ~section_t();
+
+    // Called by thread `ithr` before and after its part of the section.
+    void begin(int ithr);
+    void end(int ithr);
+
+    // Records are allocated aligned to a cache line
+    struct record_t {
+        uint64_t start_ns;
+        uint64_t end_ns;
+        size_t items;
+        // Counters of a worker thread at the beginning of its part, then
+        // the difference at the end
+        perf_counters::values_t counters;
+        // Keeps the records of different threads in different cache lines
+        char pad[64 - (2 * sizeof(uint64_t) + sizeof(size_t)
+                              + sizeof(perf_counters::values_t))
+                        % 64];
+    };
+
+private:
+    uint64_t start_ns_;
+    int nthr_;
+    // nullptr if the allocation failed, in which case nothing is recorded
+    record_t *records_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(section_t);
+};
+
+// Statistics of the parallel sections started by a thread while it executes
+// a primitive.
+struct summary_t {
+    int nsections = 0;
+    // Sums over the sections of the maximum and the average time the threads
+    // spend on their part of the work, in milliseconds
+    double busy_max_ms = 0;
+    double busy_avg_ms = 0;
+    // Sum over the sections of the average time the threads wait for the
+    // slowest one
+    double wait_ms = 0;
+    // Sums over the sections of the maximum and the average number of items
+    double items_max = 0;
+    double items_avg = 0;
+    // Hardware counters of all the threads, if enabled
+    perf_counters::values_t counters;
+
+    double imbalance() const {
+        return busy_avg_ms > 0 ? busy_max_ms / busy_avg_ms : 1.;
+    }
+    double items_imbalance() const {
+        return items_avg > 0 ? items_max / items_avg : 1.;
+    }
+};
+
+// Starts attributing the parallel sections of the calling thread to a
+// primitive with the trace identifier `trace_id` (-1 if none).
+void start_primitive(int trace_id);
+
+// Stops attributing the parallel sections of the calling thread to the
+// primitive and returns their statistics.
+summary_t finish_primitive();
+
+} // namespace parallel_stats
+} // namespace impl
+} // namespace dnnl
+
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
 #define DNNL_THR_SYNC 1
 inline int dnnl_get_max_threads() {
@@ -36,7 +213,8 @@ inline void dnnl_thr_barrier() {}
 #include "omp.h"
 #define DNNL_THR_SYNC 1
 inline int dnnl_get_max_threads() {
-    return omp_get_max_threads();
+    return dnnl::impl::thread_team_utils::get_max_threads(
+            omp_get_max_threads());
 }
 inline int dnnl_in_parallel() {
     return omp_in_parallel();
@@ -50,7 +228,8 @@ inline void dnnl_thr_barrier() {
 #include "tbb/task_arena.h"
 #define DNNL_THR_SYNC 0
 inline int dnnl_get_max_threads() {
-    return tbb::this_task_arena::max_concurrency();
+    return dnnl::impl::thread_team_utils::get_max_threads(
+            tbb::this_task_arena::max_concurrency());
 }
 inline int dnnl_in_parallel() {
     return 0;
@@ -59,6 +238,20 @@ inline void dnnl_thr_barrier() {
     assert(!"no barrier in TBB");
 }
 
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+#include "native_thread_pool.hpp"
+#define DNNL_THR_SYNC 0
+inline int dnnl_get_max_threads() {
+    return dnnl::impl::thread_team_utils::get_max_threads(
+            dnnl::impl::native_thread_pool::get_max_threads());
+}
+inline int dnnl_in_parallel() {
+    return dnnl::impl::native_thread_pool::in_parallel();
+}
+inline void dnnl_thr_barrier() {
+    assert(!"no barrier in NATIVE");
+}
+
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
 #include <thread>
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
@@ -86,6 +279,19 @@ void deactivate_threadpool();
 // Returns the active threadpool for the calling thread.
 dnnl::threadpool_interop::threadpool_iface *get_active_threadpool();
 
+// Marks the calling thread, a worker of the active threadpool, as running a
+// task of an asynchronous stream outside of any parallel section. The
+// `parallel()` and `parallel_nd()` calls of the task then submit work to the
+// threadpool, and the thread executes the parts no other thread has started.
+void activate_worker_task();
+
+// Resets the mark set by `activate_worker_task()` for the calling thread.
+void deactivate_worker_task();
+
+// Returns true if the calling thread runs a task of an asynchronous stream
+// outside of any parallel section.
+bool is_worker_task();
+
 } // namespace threadpool_utils
 } // namespace impl
 } // namespace dnnl
@@ -106,13 +312,15 @@ inline int dnnl_get_max_threads() {
     assert(def_max_threads > 0);
     // Use the default value if the threadpool-provided is outside the range
     // [1, def_max_threads]
-    return tp ? std::min(std::max(1, tp->get_num_threads()), def_max_threads)
-              : def_max_threads;
+    return dnnl::impl::thread_team_utils::get_max_threads(tp
+                    ? std::min(std::max(1, tp->get_num_threads()),
+                            def_max_threads)
+                    : def_max_threads);
 }
 inline int dnnl_in_parallel() {
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
-    return tp ? tp->get_in_parallel() : 0;
+    return tp && !is_worker_task() ? tp->get_in_parallel() : 0;
 }
 inline void dnnl_thr_barrier() {
     assert(!"no barrier with THREADPOOL");
@@ -123,8 +331,10 @@ inline void dnnl_thr_barrier() {
  * is aware of when this function is invoked. Since oneDNN does not allow nested
  * parallelism, inside a parallel region the number of available threads is 1.
  * Otherwise, the number of current threads varies between threading runtimes:
- * - for OpenMP and TBB, return the max number of threads since the number of
- *   threads is held in a global object throughout the entire execution.
+ * - for OpenMP, TBB and the native thread pool, return the max number of
+ *   threads since the number of threads is held in a global object throughout
+ *   the entire execution, or the number of threads of the thread team of the
+ *   calling thread if any.
  * - for Threadpool, since the global object in oneDNN changes throughout
  *   execution, two situations can occur:
  *   a) if the library *is* aware of a threadpool when this function is invoked,
@@ -134,10 +344,10 @@ inline void dnnl_thr_barrier() {
  */
 inline int dnnl_get_current_num_threads() {
     if (dnnl_in_parallel()) return 1;
-#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
-    return omp_get_max_threads();
-#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
-    return tbb::this_task_arena::max_concurrency();
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+    return dnnl_get_max_threads();
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
@@ -36,6 +36,10 @@
  *  - parallel_nd_in_omp(dims..., f)     - queries current nthr and ithr and
  *                                         then calls for_nd (mostly for
  *                                         convenience)
+ *
+ * When parallel_stats::is_enabled(), parallel() records the time each thread
+ * spends in f and for_nd() records the number of items it assigns to each
+ * thread.
  */
 
 #if defined(DNNL_ENABLE_ITT_TASKS)
@@ -43,6 +47,8 @@
 #endif
 
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include <memory>
+
 #include "counting_barrier.hpp"
 #endif
 
@@ -62,8 +68,7 @@ inline int adjust_num_threads(int nthr, size_t work_amount) {
 
 /* general parallelization */
 template <typename F>
-void parallel(int nthr, F f) {
-    nthr = adjust_num_threads(nthr, SIZE_MAX);
+void parallel_impl(int nthr, F f) {
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
     assert(nthr == 1);
     f(0, 1);
@@ -77,11 +82,15 @@ void parallel(int nthr, F f) {
         return;
     }
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    // OpenMP threads are private to the thread starting the parallel section
+    // so they can be bound to the CPUs of its thread team
+    const thread_team_t *team = thread_team_utils::get_active_thread_team();
 #pragma omp parallel num_threads(nthr)
     {
         int nthr_ = omp_get_num_threads();
         int ithr_ = omp_get_thread_num();
         assert(nthr_ == nthr);
+        thread_team_utils::bind_to_thread_team(team);
 #if defined(DNNL_ENABLE_ITT_TASKS)
         if (ithr_ && itt_enable) itt::primitive_task_start(task_primitive_kind);
 #endif
@@ -106,6 +115,19 @@ void parallel(int nthr, F f) {
 #endif
             },
             tbb::static_partitioner());
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+    native_thread_pool::parallel_for(nthr, [&](int ithr, int nthr) {
+#if defined(DNNL_ENABLE_ITT_TASKS)
+        bool mark_task = itt::primitive_task_get_current_kind()
+                == primitive_kind::undefined;
+        if (mark_task && itt_enable)
+            itt::primitive_task_start(task_primitive_kind);
+#endif
+        f(ithr, nthr);
+#if defined(DNNL_ENABLE_ITT_TASKS)
+        if (mark_task && itt_enable) itt::primitive_task_end();
+#endif
+    });
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
@@ -115,6 +137,46 @@ void parallel(int nthr, F f) {
             f(ithr, nthr);
         }
         threadpool_utils::activate_threadpool(tp);
+    } else if (is_worker_task()) {
+        // A task of an asynchronous stream runs on a worker of the
+        // threadpool, and all the workers may be running such tasks. So
+        // rather than waiting for the threadpool to schedule the parts of the
+        // section, the worker executes every part no other thread has
+        // started yet. The tasks starting late find nothing left to do, and
+        // only touch the state they share with the worker.
+        struct section_state_t {
+            std::atomic<int> next_ithr {0};
+            counting_barrier_t done;
+        };
+        auto state = std::make_shared<section_state_t>();
+        state->done.init(nthr);
+        F *pf = &f;
+        auto run_parts = [=]() {
+            bool is_master = threadpool_utils::get_active_threadpool() == tp;
+            for (int ithr = state->next_ithr++; ithr < nthr;
+                    ithr = state->next_ithr++) {
+                if (!is_master) {
+                    threadpool_utils::activate_threadpool(tp);
+#if defined(DNNL_ENABLE_ITT_TASKS)
+                    if (itt_enable)
+                        itt::primitive_task_start(task_primitive_kind);
+#endif
+                }
+                (*pf)(ithr, nthr);
+                if (!is_master) {
+#if defined(DNNL_ENABLE_ITT_TASKS)
+                    if (itt_enable) itt::primitive_task_end();
+#endif
+                    threadpool_utils::deactivate_threadpool();
+                }
+                state->done.notify();
+            }
+        };
+        deactivate_worker_task();
+        tp->parallel_for(nthr - 1, [run_parts](int, int) { run_parts(); });
+        run_parts();
+        state->done.wait();
+        activate_worker_task();
     } else {
         bool async = tp->get_flags()
                 & dnnl::threadpool_interop::threadpool_iface::ASYNCHRONOUS;
@@ -143,12 +205,28 @@ void parallel(int nthr, F f) {
 #endif
 }
 
+template <typename F>
+void parallel(int nthr, F f) {
+    nthr = adjust_num_threads(nthr, SIZE_MAX);
+    if (parallel_stats::is_enabled() && !parallel_stats::in_section()) {
+        parallel_stats::section_t section(nthr);
+        parallel_impl(nthr, [&](int ithr, int nthr) {
+            section.begin(ithr);
+            f(ithr, nthr);
+            section.end(ithr);
+        });
+        return;
+    }
+    parallel_impl(nthr, f);
+}
+
 /* for_nd section */
 
 template <typename T0, typename F>
 void for_nd(const int ithr, const int nthr, const T0 &D0, F f) {
     T0 start {0}, end {0};
     balance211(D0, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
     for (T0 d0 = start; d0 < end; ++d0)
         f(d0);
 }
@@ -159,6 +237,7 @@ void for_nd(const int ithr, const int nthr, const T0 &D0, const T1 &D1, F f) {
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -176,6 +255,7 @@ void for_nd(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -194,6 +274,7 @@ void for_nd(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -214,6 +295,7 @@ void for_nd(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -235,6 +317,7 @@ void for_nd(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -256,6 +339,7 @@ template <typename T0, typename F>
 void for_nd_ext(const int ithr, const int nthr, const T0 &D0, F f) {
     T0 start {0}, end {0};
     balance211(D0, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
     for (T0 d0 = start; d0 < end; ++d0)
         f(ithr, nthr, d0);
 }
@@ -267,6 +351,7 @@ void for_nd_ext(
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -284,6 +369,7 @@ void for_nd_ext(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -302,6 +388,7 @@ void for_nd_ext(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -322,6 +409,7 @@ void for_nd_ext(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
@@ -343,6 +431,7 @@ void for_nd_ext(const int ithr, const int nthr, const T0 &D0, const T1 &D1,
     if (work_amount == 0) return;
     size_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    parallel_stats::add_items((size_t)(end - start));
 
     T0 d0 {0};
     T1 d1 {0};
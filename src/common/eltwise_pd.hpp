@@ -74,6 +74,11 @@ struct eltwise_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(desc_.data_desc).has_zero_dim();
     }
 
+    // An operation per element, regardless of the algorithm cost
+    double flops_estimate() const override {
+        return (double)memory_desc_wrapper(desc_.data_desc).nelems();
+    }
+
     bool use_dst() const {
         using namespace alg_kind;
         return !is_fwd()
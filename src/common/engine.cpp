@@ -85,6 +85,23 @@ status_t dnnl_engine_get_kind(engine_t *engine, engine_kind_t *kind) {
     return success;
 }
 
+status_t dnnl_engine_set_allocator(engine_t *engine,
+        dnnl_engine_allocate_t allocate, dnnl_engine_deallocate_t deallocate,
+        void *user_data) {
+    if (engine == nullptr || (allocate == nullptr) != (deallocate == nullptr))
+        return invalid_arguments;
+    if (engine->kind() != engine_kind::cpu
+            || !is_native_runtime(engine->runtime_kind()))
+        return unimplemented;
+
+    engine_allocator_t allocator;
+    allocator.allocate = allocate;
+    allocator.deallocate = deallocate;
+    allocator.user_data = allocate ? user_data : nullptr;
+    engine->set_allocator(allocator);
+    return success;
+}
+
 status_t dnnl_engine_destroy(engine_t *engine) {
 #ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
     if (engine != nullptr) engine->release();
@@ -33,6 +33,20 @@
 #include "primitive_desc.hpp"
 #include "utils.hpp"
 
+namespace dnnl {
+namespace impl {
+
+// Allocation functions set by the user for an engine. When set, they replace
+// impl::malloc() and impl::free() for the memory the engine allocates.
+struct engine_allocator_t {
+    dnnl_engine_allocate_t allocate = nullptr;
+    dnnl_engine_deallocate_t deallocate = nullptr;
+    void *user_data = nullptr;
+};
+
+} // namespace impl
+} // namespace dnnl
+
 /** \brief An abstraction of an execution unit with shared resources
  *
  * Responsibilities:
@@ -66,6 +80,16 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
     virtual dnnl::impl::engine_id_t engine_id() const = 0;
 #endif
 
+    /** returns the allocator set by the user */
+    const dnnl::impl::engine_allocator_t &allocator() const {
+        return allocator_;
+    }
+
+    /** sets the allocator used for the memory the engine allocates */
+    void set_allocator(const dnnl::impl::engine_allocator_t &allocator) {
+        allocator_ = allocator;
+    }
+
     /** create memory storage */
     virtual dnnl::impl::status_t create_memory_storage(
             dnnl::impl::memory_storage_t **storage, unsigned flags, size_t size,
@@ -84,7 +108,8 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     virtual dnnl::impl::status_t create_stream(dnnl::impl::stream_t **stream,
-            dnnl::threadpool_interop::threadpool_iface *threadpool) {
+            dnnl::threadpool_interop::threadpool_iface *threadpool,
+            bool async) {
         return dnnl::impl::status::invalid_arguments;
     }
 #endif
@@ -133,6 +158,7 @@ protected:
     dnnl::impl::engine_kind_t kind_;
     dnnl::impl::runtime_kind_t runtime_kind_;
     size_t index_;
+    dnnl::impl::engine_allocator_t allocator_;
 
 #ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
     virtual ~dnnl_engine() = default;
@@ -159,6 +185,8 @@ inline runtime_kind_t get_default_runtime(engine_kind_t kind) {
     return runtime_kind::tbb;
 #elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     return runtime_kind::threadpool;
+#elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_NATIVE
+    return runtime_kind::native;
 #elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_SYCL
     return runtime_kind::sycl;
 #else
@@ -175,6 +203,8 @@ inline runtime_kind_t get_cpu_native_runtime() {
     return runtime_kind::tbb;
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     return runtime_kind::threadpool;
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+    return runtime_kind::native;
 #else
     return runtime_kind::none;
 #endif
@@ -182,7 +212,7 @@ inline runtime_kind_t get_cpu_native_runtime() {
 
 inline bool is_native_runtime(runtime_kind_t kind) {
     return utils::one_of(kind, runtime_kind::seq, runtime_kind::omp,
-            runtime_kind::tbb, runtime_kind::threadpool);
+            runtime_kind::tbb, runtime_kind::threadpool, runtime_kind::native);
 }
 
 struct engine_factory_t : public c_compatible {
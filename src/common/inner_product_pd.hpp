@@ -124,6 +124,10 @@ struct inner_product_pd_t : public primitive_desc_t {
         return s_d.has_zero_dim() || d_d.has_zero_dim();
     }
 
+    double flops_estimate() const override {
+        return 2. * MB() * OC() * IC() * KD() * KH() * KW();
+    }
+
     bool is_fwd() const {
         return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
                 prop_kind::forward_inference);
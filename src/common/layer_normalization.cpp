@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <type_traits>
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
@@ -28,10 +29,18 @@ using namespace dnnl::impl::prop_kind;
 using namespace dnnl::impl::types;
 
 namespace {
-status_t lnorm_desc_init(layer_normalization_desc_t *lnorm_desc,
+void copy_dst_desc(layer_normalization_v2_desc_t &ld,
+        const memory_desc_t *dst_desc) {
+    ld.dst_desc = *dst_desc;
+}
+void copy_dst_desc(layer_normalization_desc_t &ld,
+        const memory_desc_t *dst_desc) {}
+
+template <typename lnorm_desc_type>
+status_t lnorm_desc_init(lnorm_desc_type *lnorm_desc,
         prop_kind_t prop_kind, const memory_desc_t *data_desc,
-        const memory_desc_t *stat_desc, const memory_desc_t *diff_data_desc,
-        float epsilon, unsigned flags) {
+        const memory_desc_t *dst_desc, const memory_desc_t *stat_desc,
+        const memory_desc_t *diff_data_desc, float epsilon, unsigned flags) {
     bool args_ok = true && !any_null(lnorm_desc, data_desc)
             && one_of(prop_kind, forward_training, forward_inference,
                     backward_data, backward)
@@ -43,12 +52,21 @@ status_t lnorm_desc_init(layer_normalization_desc_t *lnorm_desc,
                     == 0;
     if (!args_ok) return invalid_arguments;
 
-    auto ld = layer_normalization_desc_t();
-    ld.primitive_kind = primitive_kind::layer_normalization;
+    auto ld = lnorm_desc_type();
+    ld.primitive_kind
+            = std::is_same<lnorm_desc_type, layer_normalization_desc_t>::value
+            ? primitive_kind::layer_normalization
+            : primitive_kind::layer_normalization_v2;
     ld.prop_kind = prop_kind;
 
+    if (dst_desc == nullptr) dst_desc = data_desc;
+    if (dst_desc->ndims != data_desc->ndims
+            || !array_cmp(dst_desc->dims, data_desc->dims, data_desc->ndims))
+        return invalid_arguments;
+
     bool runtime_dims_or_strides
             = memory_desc_wrapper(data_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides()
             || (stat_desc
                     && memory_desc_wrapper(stat_desc)
                                .has_runtime_dims_or_strides());
@@ -59,6 +77,7 @@ status_t lnorm_desc_init(layer_normalization_desc_t *lnorm_desc,
     if (runtime_dims_or_strides) return unimplemented;
 
     ld.data_desc = *data_desc;
+    copy_dst_desc(ld, dst_desc);
     ld.stat_desc = zero_md();
     ld.diff_data_desc = zero_md();
     if (one_of(ld.prop_kind, backward_data, backward))
@@ -117,8 +136,8 @@ status_t dnnl_layer_normalization_forward_desc_init(
         float epsilon, unsigned flags) {
     if (!one_of(prop_kind, forward_training, forward_inference))
         return invalid_arguments;
-    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, stat_desc, nullptr,
-            epsilon, flags);
+    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, nullptr,
+            stat_desc, nullptr, epsilon, flags);
 }
 
 status_t dnnl_layer_normalization_backward_desc_init(
@@ -126,8 +145,19 @@ status_t dnnl_layer_normalization_backward_desc_init(
         const memory_desc_t *diff_data_desc, const memory_desc_t *data_desc,
         const memory_desc_t *stat_desc, float epsilon, unsigned flags) {
     if (!one_of(prop_kind, backward, backward_data)) return invalid_arguments;
-    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, stat_desc,
-            diff_data_desc, epsilon, flags);
+    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, nullptr,
+            stat_desc, diff_data_desc, epsilon, flags);
+}
+
+status_t dnnl_layer_normalization_v2_forward_desc_init(
+        layer_normalization_v2_desc_t *lnorm_desc, prop_kind_t prop_kind,
+        const memory_desc_t *src_desc, const memory_desc_t *dst_desc,
+        const memory_desc_t *stat_desc, float epsilon, unsigned flags) {
+    if (!one_of(prop_kind, forward_training, forward_inference)
+            || dst_desc == nullptr)
+        return invalid_arguments;
+    return lnorm_desc_init(lnorm_desc, prop_kind, src_desc, dst_desc,
+            stat_desc, nullptr, epsilon, flags);
 }
 
 // vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
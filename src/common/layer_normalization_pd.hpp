@@ -29,9 +29,9 @@ namespace impl {
 struct layer_normalization_fwd_pd_t;
 
 struct layer_normalization_pd_t : public primitive_desc_t {
-    static constexpr auto base_pkind = primitive_kind::layer_normalization;
+    static constexpr auto base_pkind = primitive_kind::layer_normalization_v2;
 
-    const layer_normalization_desc_t *desc() const { return &desc_; }
+    const layer_normalization_v2_desc_t *desc() const { return &desc_; }
     const op_desc_t *op_desc() const override {
         return reinterpret_cast<const op_desc_t *>(this->desc());
     }
@@ -42,7 +42,15 @@ struct layer_normalization_pd_t : public primitive_desc_t {
                 *(prop_kind_t *)result = desc()->prop_kind;
                 break;
             case query::layer_normalization_d:
-                *(const layer_normalization_desc_t **)result = desc();
+                *(const layer_normalization_desc_t **)result
+                        = reinterpret_cast<const layer_normalization_desc_t *>(
+                                desc());
+                break;
+            case query::layer_normalization_v2_d:
+                *(const layer_normalization_v2_desc_t **)result = desc();
+                break;
+            case query::primitive_kind:
+                *(primitive_kind_t *)result = desc_.primitive_kind;
                 break;
             default: return primitive_desc_t::query(what, idx, result);
         }
@@ -79,21 +87,30 @@ struct layer_normalization_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(desc_.data_desc).has_zero_dim();
     }
 
+    // Counted as for batch normalization: 3 operations per element for the
+    // normalization, 4 more when the statistics are computed and 9 for the
+    // backward pass.
+    double flops_estimate() const override {
+        const double nelems = (double)across_axis() * norm_axis();
+        if (is_bwd()) return 9. * nelems;
+        return (use_global_stats() ? 3. : 7.) * nelems;
+    }
+
     const memory_desc_t *stat_md() const { return &stat_md_; }
 
 protected:
-    layer_normalization_desc_t desc_;
+    layer_normalization_v2_desc_t desc_;
     const layer_normalization_fwd_pd_t *hint_fwd_pd_;
 
     memory_desc_t data_md_;
     memory_desc_t stat_md_;
     memory_desc_t scaleshift_md_;
 
-    layer_normalization_pd_t(const layer_normalization_desc_t *adesc,
+    layer_normalization_pd_t(const layer_normalization_v2_desc_t *adesc,
             const primitive_attr_t *attr,
             const layer_normalization_fwd_pd_t *hint_fwd_pd)
         : primitive_desc_t(attr, base_pkind)
-        , desc_(*adesc)
+        , desc_(cast_lnorm_v1_to_v2(*adesc))
         , hint_fwd_pd_(hint_fwd_pd)
         , data_md_(desc_.data_desc)
         , stat_md_(desc_.stat_desc)
@@ -124,6 +141,31 @@ protected:
 
 private:
     const memory_desc_t &data_desc() const { return desc_.data_desc; }
+
+    // A v1 descriptor is only as large as its own fields, so they are read
+    // through the v1 type and dst_desc is taken from data_desc.
+    layer_normalization_v2_desc_t cast_lnorm_v1_to_v2(
+            const layer_normalization_v2_desc_t &lnorm_desc) const {
+        if (lnorm_desc.primitive_kind == primitive_kind::layer_normalization_v2)
+            return lnorm_desc;
+
+        const auto &v1_desc
+                = reinterpret_cast<const layer_normalization_desc_t &>(
+                        lnorm_desc);
+        layer_normalization_v2_desc_t lnorm_v2_desc;
+        lnorm_v2_desc.primitive_kind = primitive_kind::layer_normalization;
+        lnorm_v2_desc.prop_kind = v1_desc.prop_kind;
+        lnorm_v2_desc.data_desc = v1_desc.data_desc;
+        lnorm_v2_desc.diff_data_desc = v1_desc.diff_data_desc;
+        lnorm_v2_desc.data_scaleshift_desc = v1_desc.data_scaleshift_desc;
+        lnorm_v2_desc.diff_data_scaleshift_desc
+                = v1_desc.diff_data_scaleshift_desc;
+        lnorm_v2_desc.stat_desc = v1_desc.stat_desc;
+        lnorm_v2_desc.layer_norm_epsilon = v1_desc.layer_norm_epsilon;
+        lnorm_v2_desc.flags = v1_desc.flags;
+        lnorm_v2_desc.dst_desc = v1_desc.data_desc;
+        return lnorm_v2_desc;
+    }
 };
 
 struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
@@ -170,7 +212,7 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
     }
 
     const memory_desc_t *dst_md(int index = 0) const override {
-        if (index == 0) return &data_md_;
+        if (index == 0) return &dst_md_;
         if (!stats_are_src() && is_training() && (index == 1 || index == 2))
             return &stat_md_;
         return &glob_zero_md;
@@ -182,19 +224,30 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
 
     int n_inputs() const override {
         return 1 + 2 * stats_are_src() + use_scaleshift() + use_scale()
-                + use_shift();
+                + use_shift() + n_binary_po_inputs();
     }
     int n_outputs() const override {
         return 1 + 2 * (!stats_are_src()) * is_training();
     }
 
 protected:
-    layer_normalization_fwd_pd_t(const layer_normalization_desc_t *adesc,
+    memory_desc_t dst_md_;
+
+    layer_normalization_fwd_pd_t(const layer_normalization_v2_desc_t *adesc,
             const primitive_attr_t *attr,
             const layer_normalization_fwd_pd_t *hint_fwd_pd)
-        : layer_normalization_pd_t(adesc, attr, hint_fwd_pd) {}
+        : layer_normalization_pd_t(adesc, attr, hint_fwd_pd)
+        , dst_md_(desc_.dst_desc) {}
 
     bool set_default_formats_common() {
+        // dst follows the src layout unless given explicitly
+        if (dst_md_.format_kind == format_kind::any) {
+            if (data_md_.format_kind != format_kind::blocked) return false;
+            if (memory_desc_init_by_blocking_desc(
+                        dst_md_, data_md_.format_desc.blocking)
+                    != status::success)
+                return false;
+        }
         return set_default_stat_md_format(data_md_);
     }
 
@@ -280,7 +333,7 @@ protected:
     memory_desc_t diff_data_md_;
     memory_desc_t diff_scaleshift_md_;
 
-    layer_normalization_bwd_pd_t(const layer_normalization_desc_t *adesc,
+    layer_normalization_bwd_pd_t(const layer_normalization_v2_desc_t *adesc,
             const primitive_attr_t *attr,
             const layer_normalization_fwd_pd_t *hint_fwd_pd)
         : layer_normalization_pd_t(adesc, attr, hint_fwd_pd)
@@ -65,6 +65,17 @@ struct lrn_pd_t : public primitive_desc_t {
                 prop_kind::forward_inference);
     }
 
+    // Per element: a multiply-add for every point of the window, then 4
+    // operations for the scaling by (k + alpha * sum / size)^beta. The
+    // backward pass goes over the window twice.
+    double flops_estimate() const override {
+        double window = (double)desc_.local_size;
+        if (desc_.alg_kind == alg_kind::lrn_within_channel)
+            for (int d = 1; d < ndims() - 2; d++) window *= desc_.local_size;
+        const double nelems = (double)MB() * C() * D() * H() * W();
+        return (is_fwd() ? 1. : 2.) * (2. * window + 4.) * nelems;
+    }
+
 protected:
     lrn_desc_t desc_;
     const lrn_fwd_pd_t *hint_fwd_pd_;
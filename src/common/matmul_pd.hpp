@@ -90,6 +90,12 @@ struct matmul_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(dst_md(0)).has_zero_dim();
     }
 
+    // The problem size of runtime dimensions is unknown
+    double flops_estimate() const override {
+        if (has_runtime_dims_or_strides()) return 0;
+        return 2. * batch() * M() * N() * K();
+    }
+
     bool has_runtime_dims_or_strides() const {
         return memory_desc_wrapper(src_md_).has_runtime_dims_or_strides()
                 || memory_desc_wrapper(weights_md_)
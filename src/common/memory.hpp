@@ -33,7 +33,9 @@ namespace impl {
 
 struct exec_ctx_t;
 
-enum memory_flags_t { alloc = 0x1, use_runtime_ptr = 0x2 };
+// The scratchpad flag may accompany alloc to tell the engine the memory is
+// allocated for a scratchpad
+enum memory_flags_t { alloc = 0x1, use_runtime_ptr = 0x2, scratchpad = 0x4 };
 } // namespace impl
 } // namespace dnnl
 
@@ -168,6 +168,7 @@ enum {
     key_brgemm_primitive_zp_comp_b,
     key_concat_iptrs,
     key_concat_istrides,
+    key_concat_jobs,
     key_concat_nelems,
     key_concat_optrs,
     key_concat_tent_dst,
@@ -227,6 +228,7 @@ enum {
     key_lnorm_inv_sqrtvar,
     key_lnorm_tmp_mean,
     key_lnorm_tmp_var,
+    key_lnorm_tmp_data,
     key_lnorm_tmp_diff_ss,
     key_lnorm_reduction,
     key_matmul_dst_in_acc_dt,
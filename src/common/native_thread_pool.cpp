@@ -0,0 +1,323 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "oneapi/dnnl/dnnl_config.h"
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "native_thread_pool.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace native_thread_pool {
+
+namespace {
+
+// Set while the thread executes a task, used to serialize nested sections
+thread_local int in_parallel_ = 0;
+
+struct job_t {
+    job_t(int nthr, const std::function<void(int, int)> &f)
+        : f(f), nthr(nthr), pending(nthr) {}
+
+    const std::function<void(int, int)> &f;
+    const int nthr;
+    std::atomic<int> pending;
+};
+
+struct task_t {
+    job_t *job;
+    int ithr;
+};
+
+// Tasks assigned to a worker. The owner takes tasks from the front of the
+// queue and the other threads steal them from the back.
+struct task_queue_t {
+    void push(const task_t &task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+    }
+
+    bool pop(task_t &task, bool steal) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) return false;
+        if (steal) {
+            task = tasks_.back();
+            tasks_.pop_back();
+        } else {
+            task = tasks_.front();
+            tasks_.pop_front();
+        }
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<task_t> tasks_;
+};
+
+#if defined(__GLIBC__)
+// Reads a sysfs list such as "0-3,8-11"
+std::vector<int> read_sysfs_list(const char *path) {
+    std::vector<int> list;
+    FILE *file = fopen(path, "r");
+    if (!file) return list;
+    int first = 0;
+    while (fscanf(file, "%d", &first) == 1) {
+        int last = first;
+        int c = fgetc(file);
+        if (c == '-') {
+            if (fscanf(file, "%d", &last) != 1) break;
+            c = fgetc(file);
+        }
+        for (int i = first; i <= last; i++)
+            list.push_back(i);
+        if (c != ',') break;
+    }
+    fclose(file);
+    return list;
+}
+#endif
+
+// Returns the CPUs available to the process grouped by NUMA node. The result
+// is empty if the topology cannot be queried.
+std::vector<std::vector<int>> get_cpu_groups() {
+    std::vector<std::vector<int>> groups;
+#if defined(__GLIBC__)
+    cpu_set_t mask;
+    if (::sched_getaffinity(0, sizeof(mask), &mask) != 0) return groups;
+
+    for (int node : read_sysfs_list("/sys/devices/system/node/possible")) {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+                node);
+        std::vector<int> group;
+        for (int cpu : read_sysfs_list(path))
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &mask))
+                group.push_back(cpu);
+        if (!group.empty()) groups.push_back(group);
+    }
+
+    // No NUMA information: all the CPUs form a single group
+    if (groups.empty()) {
+        std::vector<int> group;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (CPU_ISSET(cpu, &mask)) group.push_back(cpu);
+        if (!group.empty()) groups.push_back(group);
+    }
+#endif
+    return groups;
+}
+
+struct thread_pool_t {
+    thread_pool_t() : cpu_groups_(get_cpu_groups()) {
+        // Flat list of (cpu, group) used to place the workers
+        std::vector<std::pair<int, int>> cpus;
+        for (size_t g = 0; g < cpu_groups_.size(); g++)
+            for (int cpu : cpu_groups_[g])
+                cpus.emplace_back(cpu, (int)g);
+        for (const auto &c : cpus) {
+            if ((int)cpu_to_group_.size() <= c.first)
+                cpu_to_group_.resize(c.first + 1, 0);
+            cpu_to_group_[c.first] = c.second;
+        }
+
+        int ncpus = (int)cpus.size();
+        if (ncpus == 0) ncpus = (int)std::thread::hardware_concurrency();
+        nthr_ = getenv_int("DNNL_NATIVE_NUM_THREADS", 0);
+        if (nthr_ <= 0) nthr_ = std::max(ncpus, 1);
+        spin_count_ = std::max(0, getenv_int("DNNL_NATIVE_SPIN_COUNT", 2000));
+        const bool bind = getenv_int("DNNL_NATIVE_BIND", 1) != 0;
+
+        // The thread submitting the work takes one of the CPUs, so worker w
+        // is placed next to CPU w + 1
+        const int nworkers = nthr_ - 1;
+        const int ngroups = std::max((int)cpu_groups_.size(), 1);
+        std::vector<int> worker_group(nworkers, 0);
+        for (int w = 0; w < nworkers; w++)
+            if (!cpus.empty()) worker_group[w] = cpus[(w + 1) % ncpus].second;
+
+        // Order in which threads of a group look for work: the workers of the
+        // group first, then all the others
+        order_.resize(ngroups);
+        for (int g = 0; g < ngroups; g++) {
+            for (int w = 0; w < nworkers; w++)
+                if (worker_group[w] == g) order_[g].push_back(w);
+            for (int w = 0; w < nworkers; w++)
+                if (worker_group[w] != g) order_[g].push_back(w);
+        }
+
+        for (int w = 0; w < nworkers; w++)
+            queues_.emplace_back(new task_queue_t());
+        for (int w = 0; w < nworkers; w++)
+            std::thread(&thread_pool_t::worker_loop, this, w, worker_group[w],
+                    bind && !cpus.empty())
+                    .detach();
+    }
+
+    int nthr() const { return nthr_; }
+
+    void parallel_for(int nthr, const std::function<void(int, int)> &f) {
+        const int nworkers = (int)queues_.size();
+        if (nthr == 1 || nworkers == 0 || in_parallel_) {
+            in_parallel_++;
+            for (int ithr = 0; ithr < nthr; ithr++)
+                f(ithr, nthr);
+            in_parallel_--;
+            return;
+        }
+
+        job_t job(nthr, f);
+        const auto &order = order_[current_group()];
+        for (int ithr = 1; ithr < nthr; ithr++)
+            queues_[order[(ithr - 1) % nworkers]]->push({&job, ithr});
+        n_queued_ += nthr - 1;
+        if (n_parked_ > 0) {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            for (int i = 1; i < nthr; i++)
+                park_cv_.notify_one();
+        }
+
+        run({&job, 0});
+
+        // Help with the remaining work until all the tasks of the job are done
+        while (job.pending.load(std::memory_order_acquire) > 0) {
+            task_t task;
+            if (find_task(order, -1, task))
+                run(task);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    const std::vector<std::vector<int>> cpu_groups_;
+    int nthr_;
+    int spin_count_;
+    std::vector<int> cpu_to_group_;
+    std::vector<std::vector<int>> order_;
+    std::vector<std::unique_ptr<task_queue_t>> queues_;
+
+    std::atomic<int> n_queued_ {0};
+    std::atomic<int> n_parked_ {0};
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+
+    int current_group() const {
+#if defined(__GLIBC__)
+        const int cpu = ::sched_getcpu();
+        if (cpu >= 0 && cpu < (int)cpu_to_group_.size())
+            return cpu_to_group_[cpu];
+#endif
+        return 0;
+    }
+
+    // Takes a task from the own queue of worker `self` if any, otherwise
+    // steals one following `order`
+    bool find_task(const std::vector<int> &order, int self, task_t &task) {
+        if (n_queued_.load(std::memory_order_relaxed) <= 0) return false;
+        bool found = self >= 0 && queues_[self]->pop(task, false);
+        for (size_t i = 0; !found && i < order.size(); i++)
+            if (order[i] != self) found = queues_[order[i]]->pop(task, true);
+        if (found) n_queued_--;
+        return found;
+    }
+
+    static void run(const task_t &task) {
+        job_t *job = task.job;
+        in_parallel_++;
+        job->f(task.ithr, job->nthr);
+        in_parallel_--;
+        // the job may be destroyed as soon as its last task is done
+        job->pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    void worker_loop(int w, int group, bool bind) {
+#if defined(__GLIBC__)
+        if (bind) {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            for (int cpu : cpu_groups_[group])
+                CPU_SET(cpu, &mask);
+            pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+        }
+#else
+        MAYBE_UNUSED(bind);
+#endif
+        const auto &order = order_[group];
+        int spins = 0;
+        while (true) {
+            task_t task;
+            if (find_task(order, w, task)) {
+                run(task);
+                spins = 0;
+                continue;
+            }
+            if (spins < spin_count_) {
+                spins++;
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            n_parked_++;
+            park_cv_.wait(lock, [this]() { return n_queued_ > 0; });
+            n_parked_--;
+            spins = 0;
+        }
+    }
+};
+
+// The pool is never destroyed: the workers are detached and may still be
+// needed by parallel sections running from static destructors.
+thread_pool_t &pool() {
+    static thread_pool_t *pool = new thread_pool_t();
+    return *pool;
+}
+
+} // namespace
+
+int DNNL_API get_max_threads() {
+    return pool().nthr();
+}
+
+int DNNL_API in_parallel() {
+    return in_parallel_;
+}
+
+void DNNL_API parallel_for(int nthr, const std::function<void(int, int)> &f) {
+    pool().parallel_for(nthr, f);
+}
+
+} // namespace native_thread_pool
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -0,0 +1,58 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_NATIVE_THREAD_POOL_HPP
+#define COMMON_NATIVE_THREAD_POOL_HPP
+
+/* This header must be included by dnnl_thread.hpp only */
+
+#include <functional>
+
+namespace dnnl {
+namespace impl {
+namespace native_thread_pool {
+
+// Library-owned work-stealing thread pool backing the NATIVE CPU threading
+// runtime. The pool is created on first use. Its workers are split into
+// groups, one per NUMA node available to the process, and each worker first
+// looks for work in its own queue, then in the queues of its group and only
+// then in the other groups. A worker that finds no work spins for a while and
+// then parks until new work is submitted.
+//
+// The pool is configured with the following environment variables:
+// - DNNL_NATIVE_NUM_THREADS: total number of threads, including the thread
+//   that submits the work (default: number of CPUs available to the process).
+// - DNNL_NATIVE_SPIN_COUNT: number of unsuccessful attempts to find work a
+//   worker makes before parking (default: 2000). 0 parks immediately.
+// - DNNL_NATIVE_BIND: if not 0 (default: 1), each worker is bound to the CPUs
+//   of its NUMA node.
+
+// Returns the number of threads the pool can use for a parallel section.
+int get_max_threads();
+
+// Returns 1 if the calling thread executes a task of a parallel section.
+int in_parallel();
+
+// Calls f(ithr, nthr) for all ithr in [0, nthr) and returns once all the
+// calls are done. The calling thread participates in the computation. Nested
+// calls are executed sequentially by the calling thread.
+void parallel_for(int nthr, const std::function<void(int, int)> &f);
+
+} // namespace native_thread_pool
+} // namespace impl
+} // namespace dnnl
+
+#endif
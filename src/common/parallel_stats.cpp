@@ -0,0 +1,185 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+
+#include "dnnl_thread.hpp"
+#include "trace.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace parallel_stats {
+
+namespace {
+// Record of the calling thread in the parallel section it executes, if any
+thread_local section_t::record_t *current_record = nullptr;
+
+// Primitive the parallel sections started by the calling thread are
+// attributed to
+thread_local bool in_primitive = false;
+thread_local int primitive_trace_id = -1;
+thread_local summary_t primitive_summary;
+// Counters of the thread when it started executing the primitive
+thread_local perf_counters::values_t primitive_counters;
+
+// Trace identifier of the sections started outside of a primitive
+int get_default_trace_id() {
+    static const int id = trace::register_name("parallel", "");
+    return id;
+}
+} // namespace
+
+namespace detail {
+DNNL_API std::atomic<int> state {uninitialized};
+
+int DNNL_API init() {
+    const int s = is_imbalance_enabled() || perf_counters::is_enabled()
+            ? enabled
+            : disabled;
+    state.store(s, std::memory_order_relaxed);
+    return s;
+}
+
+void DNNL_API add_items(size_t n) {
+    if (current_record) current_record->items += n;
+}
+} // namespace detail
+
+bool DNNL_API is_imbalance_enabled() {
+    static const bool enabled = getenv_int("DNNL_PARALLEL_STATS", 0) != 0;
+    return enabled;
+}
+
+bool DNNL_API in_section() {
+    return current_record != nullptr;
+}
+
+static_assert(sizeof(section_t::record_t) % 64 == 0,
+        "records must not share cache lines");
+
+section_t::section_t(int nthr)
+    : start_ns_(trace::get_time_ns()), nthr_(nthr), records_(nullptr) {
+    if (nthr_ > 0)
+        records_ = (record_t *)impl::malloc(sizeof(record_t) * nthr_, 64);
+    if (!records_) return;
+    for (int ithr = 0; ithr < nthr_; ithr++) {
+        record_t &r = records_[ithr];
+        r.start_ns = r.end_ns = start_ns_;
+        r.items = 0;
+        r.counters = perf_counters::values_t();
+    }
+}
+
+section_t::~section_t() {
+    const uint64_t end_ns = trace::get_time_ns();
+    const int nthr = nthr_;
+    if (!records_) return;
+
+    uint64_t busy_max = 0, busy_sum = 0, last_end = 0;
+    size_t items_max = 0, items_sum = 0;
+    perf_counters::values_t counters;
+    for (int ithr = 0; ithr < nthr; ithr++) {
+        const record_t &r = records_[ithr];
+        counters += r.counters;
+        const uint64_t busy = r.end_ns - r.start_ns;
+        busy_max = std::max(busy_max, busy);
+        busy_sum += busy;
+        last_end = std::max(last_end, r.end_ns);
+        items_max = std::max(items_max, r.items);
+        items_sum += r.items;
+    }
+    uint64_t wait_sum = 0;
+    for (int ithr = 0; ithr < nthr; ithr++)
+        wait_sum += last_end - records_[ithr].end_ns;
+    impl::free(records_);
+
+    const double busy_avg = (double)busy_sum / nthr;
+    const double items_avg = (double)items_sum / nthr;
+    const double wait_avg = (double)wait_sum / nthr;
+
+    if (in_primitive) {
+        auto &s = primitive_summary;
+        s.nsections++;
+        s.busy_max_ms += busy_max / 1e6;
+        s.busy_avg_ms += busy_avg / 1e6;
+        s.wait_ms += wait_avg / 1e6;
+        s.items_max += items_max;
+        s.items_avg += items_avg;
+        s.counters += counters;
+    }
+
+    if (is_imbalance_enabled() && trace::is_enabled()) {
+        trace::event_t event;
+        event.start_ns = start_ns_;
+        event.end_ns = end_ns;
+        event.name_id = in_primitive && primitive_trace_id >= 0
+                ? primitive_trace_id
+                : get_default_trace_id();
+        event.kind = trace::event_kind_t::parallel;
+        event.nthr = nthr;
+        event.imbalance = busy_avg > 0 ? (float)(busy_max / busy_avg) : 1.f;
+        event.items_imbalance
+                = items_avg > 0 ? (float)(items_max / items_avg) : 1.f;
+        event.wait_us = (float)(wait_avg / 1e3);
+        trace::record(event);
+    }
+}
+
+// The counters of the thread executing the primitive are read for the whole
+// execution, so only the other threads read them in the sections
+void section_t::begin(int ithr) {
+    if (!records_) return;
+    record_t &r = records_[ithr];
+    if (perf_counters::is_enabled() && !in_primitive)
+        perf_counters::read(r.counters);
+    r.start_ns = trace::get_time_ns();
+    current_record = &r;
+}
+
+void section_t::end(int ithr) {
+    current_record = nullptr;
+    if (!records_) return;
+    record_t &r = records_[ithr];
+    r.end_ns = trace::get_time_ns();
+    perf_counters::values_t counters;
+    if (perf_counters::is_enabled() && !in_primitive
+            && perf_counters::read(counters))
+        r.counters = counters - r.counters;
+    else
+        r.counters = perf_counters::values_t();
+}
+
+void DNNL_API start_primitive(int trace_id) {
+    in_primitive = true;
+    primitive_trace_id = trace_id;
+    primitive_summary = summary_t();
+    if (perf_counters::is_enabled()) perf_counters::read(primitive_counters);
+}
+
+summary_t DNNL_API finish_primitive() {
+    if (!in_primitive) return summary_t();
+    in_primitive = false;
+    primitive_trace_id = -1;
+    perf_counters::values_t counters;
+    if (perf_counters::is_enabled() && perf_counters::read(counters))
+        primitive_summary.counters += counters - primitive_counters;
+    return primitive_summary;
+}
+
+} // namespace parallel_stats
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,141 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "perf_counters.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace perf_counters {
+
+#if defined(__linux__)
+namespace {
+
+enum { cycles, instructions, llc_misses, backend_stalls, ncounters };
+
+// Set once the back end stall counter fails to open on some thread
+std::atomic<bool> backend_stalls_unsupported {false};
+
+// Counters of a thread, read at once as a group led by the cycles counter
+struct thread_counters_t {
+    thread_counters_t() {
+        static const struct {
+            uint32_t type;
+            uint64_t config;
+        } events[ncounters] = {
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+        };
+
+        for (int c = 0; c < ncounters; c++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[c].type;
+            attr.config = events[c].config;
+            attr.read_format = PERF_FORMAT_GROUP;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            const int fd = (int)syscall(
+                    __NR_perf_event_open, &attr, 0, -1, leader_fd_, 0);
+            if (fd < 0) {
+                if (c == backend_stalls) backend_stalls_unsupported = true;
+                // Nothing can be counted without the group leader
+                if (c == cycles) return;
+                continue;
+            }
+            if (c == cycles) leader_fd_ = fd;
+            fds_[c] = fd;
+            index_[c] = nopened_++;
+        }
+    }
+
+    ~thread_counters_t() {
+        for (int c = 0; c < ncounters; c++)
+            if (fds_[c] >= 0) close(fds_[c]);
+    }
+
+    bool read(values_t &values) const {
+        if (leader_fd_ < 0) return false;
+        // The group is read as the number of counters followed by the values
+        uint64_t buf[1 + ncounters];
+        const ssize_t size = (1 + nopened_) * sizeof(uint64_t);
+        if (::read(leader_fd_, buf, size) != size) return false;
+
+        auto get = [&](int c) {
+            return index_[c] >= 0 ? buf[1 + index_[c]] : (uint64_t)0;
+        };
+        values.cycles = get(cycles);
+        values.instructions = get(instructions);
+        values.llc_misses = get(llc_misses);
+        values.backend_stalls = get(backend_stalls);
+        return true;
+    }
+
+private:
+    int leader_fd_ = -1;
+    int fds_[ncounters] = {-1, -1, -1, -1};
+    int index_[ncounters] = {-1, -1, -1, -1};
+    int nopened_ = 0;
+};
+
+} // namespace
+
+bool is_enabled() {
+    static const bool enabled = getenv_int("DNNL_PERF_COUNTERS", 0) != 0;
+    return enabled;
+}
+
+bool read(values_t &values) {
+    static thread_local thread_counters_t counters;
+    return counters.read(values);
+}
+
+bool has_backend_stalls() {
+    return !backend_stalls_unsupported;
+}
+
+#else
+
+bool is_enabled() {
+    return false;
+}
+
+bool read(values_t &values) {
+    UNUSED(values);
+    return false;
+}
+
+bool has_backend_stalls() {
+    return false;
+}
+
+#endif
+
+} // namespace perf_counters
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,69 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_PERF_COUNTERS_HPP
+#define COMMON_PERF_COUNTERS_HPP
+
+#include <stdint.h>
+
+namespace dnnl {
+namespace impl {
+namespace perf_counters {
+
+// Hardware performance counters of the calling thread, counted in user space
+// with perf_event_open(). The counters are enabled with the
+// DNNL_PERF_COUNTERS environment variable and are supported on Linux only.
+
+bool is_enabled();
+
+struct values_t {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_misses = 0;
+    // Cycles the back end of the core is stalled, mostly waiting for memory
+    uint64_t backend_stalls = 0;
+
+    values_t &operator+=(const values_t &rhs) {
+        cycles += rhs.cycles;
+        instructions += rhs.instructions;
+        llc_misses += rhs.llc_misses;
+        backend_stalls += rhs.backend_stalls;
+        return *this;
+    }
+
+    values_t operator-(const values_t &rhs) const {
+        values_t result;
+        result.cycles = cycles - rhs.cycles;
+        result.instructions = instructions - rhs.instructions;
+        result.llc_misses = llc_misses - rhs.llc_misses;
+        result.backend_stalls = backend_stalls - rhs.backend_stalls;
+        return result;
+    }
+};
+
+// Reads the counters of the calling thread, opening them on the first call.
+// The counters the system does not support are left 0. Returns false if none
+// of the counters is available.
+bool read(values_t &values);
+
+// Returns false if the system does not support the back end stall counter.
+bool has_backend_stalls();
+
+} // namespace perf_counters
+} // namespace impl
+} // namespace dnnl
+
+#endif
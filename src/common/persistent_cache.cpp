@@ -0,0 +1,116 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <functional>
+
+#include "persistent_cache.hpp"
+#include "utils.hpp"
+
+#include "cpu/platform.hpp"
+
+namespace dnnl {
+namespace impl {
+
+persistent_impl_cache_t &persistent_impl_cache() {
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    static persistent_impl_cache_t cache([]() -> std::string {
+        const int len = 4096;
+        char dir[len] = {0};
+        if (getenv("DNNL_PRIMITIVE_CACHE_DIR", dir, len) <= 0) return "";
+        return dir;
+    }());
+#else
+    static persistent_impl_cache_t cache("");
+#endif
+    return cache;
+}
+
+persistent_impl_cache_t::persistent_impl_cache_t(const std::string &dir) {
+    if (dir.empty()) return;
+
+    // The implementation lists and the decisions made by the implementations
+    // depend on the library build and on the CPU features available.
+    identity_ = utils::format("dnnl_impl_cache,v%d.%d.%d,%s,isa:%d,hints:%d",
+            dnnl_version()->major, dnnl_version()->minor,
+            dnnl_version()->patch, dnnl_version()->hash,
+            (int)cpu::platform::get_effective_cpu_isa(),
+            (int)cpu::platform::get_cpu_isa_hints());
+    file_name_ = utils::format("%s/dnnl_impl_cache_%zx.txt", dir.c_str(),
+            std::hash<std::string>()(identity_));
+    load();
+}
+
+persistent_impl_cache_t::~persistent_impl_cache_t() = default;
+
+void persistent_impl_cache_t::load() {
+    FILE *f = fopen(file_name_.c_str(), "r");
+    if (f) {
+        char line[1024];
+        bool is_valid = fgets(line, sizeof(line), f)
+                && std::string(line) == identity_ + "\n";
+        while (is_valid && fgets(line, sizeof(line), f)) {
+            size_t key_hash = 0;
+            int impl_idx = -1;
+            if (sscanf(line, "%zx %d", &key_hash, &impl_idx) == 2
+                    && impl_idx >= 0)
+                impl_idx_map_[key_hash] = impl_idx;
+        }
+        fclose(f);
+        if (is_valid) return;
+        // The file was written by a different build, start over.
+        impl_idx_map_.clear();
+    }
+
+    f = fopen(file_name_.c_str(), "w");
+    if (!f) {
+        // The directory is not writable, disable the cache.
+        file_name_.clear();
+        return;
+    }
+    fprintf(f, "%s\n", identity_.c_str());
+    fclose(f);
+}
+
+int persistent_impl_cache_t::get_impl_idx(size_t key_hash) const {
+    if (!is_enabled()) return -1;
+
+    utils::lock_read_t lock_r(rw_mutex_);
+    auto it = impl_idx_map_.find(key_hash);
+    return it == impl_idx_map_.end() ? -1 : it->second;
+}
+
+void persistent_impl_cache_t::set_impl_idx(
+        size_t key_hash, int impl_idx, const char *impl_name) {
+    if (!is_enabled()) return;
+
+    utils::lock_write_t lock_w(rw_mutex_);
+    auto it = impl_idx_map_.find(key_hash);
+    if (it != impl_idx_map_.end() && it->second == impl_idx) return;
+    impl_idx_map_[key_hash] = impl_idx;
+
+    // Entries are appended, so the last one wins when the file is loaded.
+    // The implementation name is for information only.
+    FILE *f = fopen(file_name_.c_str(), "a");
+    if (!f) return;
+    fprintf(f, "%zx %d %s\n", key_hash, impl_idx, impl_name);
+    fclose(f);
+}
+
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,69 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_PERSISTENT_CACHE_HPP
+#define COMMON_PERSISTENT_CACHE_HPP
+
+#include <stddef.h>
+#include <string>
+#include <unordered_map>
+
+#include "c_types_map.hpp"
+#include "rw_mutex.hpp"
+
+namespace dnnl {
+namespace impl {
+
+// The persistent cache records which implementation from the implementation
+// list was chosen for a primitive descriptor, so that another process can
+// skip the dispatching (the initialization of all preceding implementations,
+// which are known to fail) when it creates the same primitive descriptor.
+//
+// The cache is enabled by setting the DNNL_PRIMITIVE_CACHE_DIR environment
+// variable to an existing directory. The entries are keyed by the hash of
+// primitive_hashing::key_t and are stored in a text file, the name of which
+// depends on the library version and the effective CPU ISA (and ISA hints).
+// Since only the hash is stored, the cache is used for CPU engines only: the
+// keys of the other engines contain run-time objects.
+struct persistent_impl_cache_t {
+    DNNL_API persistent_impl_cache_t(const std::string &dir);
+    DNNL_API ~persistent_impl_cache_t();
+
+    bool is_enabled() const { return !file_name_.empty(); }
+    const std::string &file_name() const { return file_name_; }
+
+    // Returns the index of the recorded implementation or -1 if there is none.
+    int DNNL_API get_impl_idx(size_t key_hash) const;
+    void DNNL_API set_impl_idx(
+            size_t key_hash, int impl_idx, const char *impl_name);
+
+private:
+    void load();
+
+    std::string file_name_;
+    std::string identity_;
+    std::unordered_map<size_t, int> impl_idx_map_;
+    mutable utils::rw_mutex_t rw_mutex_;
+};
+
+persistent_impl_cache_t &persistent_impl_cache();
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
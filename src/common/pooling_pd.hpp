@@ -120,6 +120,11 @@ struct pooling_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(src_desc()).has_zero_dim();
     }
 
+    // An operation per kernel point of every output point
+    double flops_estimate() const override {
+        return (double)MB() * OC() * OD() * OH() * OW() * KD() * KH() * KW();
+    }
+
     bool is_fwd() const {
         return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
                 prop_kind::forward_inference);
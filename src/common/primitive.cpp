@@ -19,14 +19,17 @@
 #include <assert.h>
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "ittnotify.hpp"
+#include "perf_counters.hpp"
 #include "primitive.hpp"
 #include "primitive_desc.hpp"
 #include "primitive_exec_types.hpp"
 #include "reorder_pd.hpp"
 #include "scratchpad_debug.hpp"
 #include "stream.hpp"
+#include "trace.hpp"
 #include "utils.hpp"
 
 using namespace dnnl::impl;
@@ -79,6 +82,57 @@ nested_scratchpad_t::~nested_scratchpad_t() {
 nested_scratchpad_t::~nested_scratchpad_t() = default;
 #endif
 
+namespace {
+// Prints the hardware counters of a primitive execution along with the IPC
+// and the bandwidth estimated from the last level cache misses
+void print_perf_counters(const std::string &stamp, const char *info,
+        const perf_counters::values_t &c, double duration_ms) {
+    const double ipc = c.cycles ? (double)c.instructions / c.cycles : 0.;
+    const double bytes = (double)c.llc_misses
+            * cpu::platform::get_cache_line_size();
+    const double bandwidth = duration_ms > 0 ? bytes / duration_ms / 1e6 : 0.;
+    printf("dnnl_verbose%s,perf,%s,cycles:%" PRIu64 ",instructions:%" PRIu64
+           ",ipc:%g,llc_misses:%" PRIu64 ",bandwidth:%g",
+            stamp.c_str(), info, c.cycles, c.instructions, ipc, c.llc_misses,
+            bandwidth);
+    if (perf_counters::has_backend_stalls()) {
+        const double stalls
+                = c.cycles ? (double)c.backend_stalls / c.cycles : 0.;
+        printf(",backend_stalls:%" PRIu64 ",backend_bound:%g",
+                c.backend_stalls, stalls);
+    }
+    printf("\n");
+}
+
+// Prints the performance achieved by a primitive execution according to the
+// estimated flops and bytes and, if the peaks of the system are set, the
+// roofline efficiency: the ratio of the time the execution takes at the
+// attainable performance of the system to the actual time
+void print_roofline(const std::string &stamp, const primitive_desc_t *pd,
+        const char *info, double duration_ms) {
+    if (duration_ms <= 0) return;
+    const double flops = pd->flops_estimate();
+    const double bytes = pd->bytes_estimate();
+    const double bandwidth = bytes / duration_ms / 1e6;
+    printf("dnnl_verbose%s,roofline,%s", stamp.c_str(), info);
+    // No operations are counted for the primitives that mostly move data
+    if (flops > 0)
+        printf(",gflops:%g,bandwidth:%g,ai:%g", flops / duration_ms / 1e6,
+                bandwidth, bytes ? flops / bytes : 0.);
+    else
+        printf(",gflops:n/a,bandwidth:%g,ai:n/a", bandwidth);
+
+    const double peak_gflops = get_peak_gflops();
+    const double peak_bandwidth = get_peak_bandwidth();
+    if (peak_gflops > 0 && peak_bandwidth > 0) {
+        const double attainable_ms = nstl::max(
+                flops / peak_gflops / 1e6, bytes / peak_bandwidth / 1e6);
+        printf(",efficiency:%g", attainable_ms / duration_ms);
+    }
+    printf("\n");
+}
+} // namespace
+
 status_t primitive_create(primitive_iface_t **primitive_iface,
         const primitive_desc_iface_t *primitive_desc_iface) {
 
@@ -94,7 +148,28 @@ status_t primitive_create(primitive_iface_t **primitive_iface,
         if (get_verbose_timestamp()) stamp = "," + std::to_string(start_ms);
         printf("dnnl_verbose%s,create:%s,%s,%g\n", stamp.c_str(), str,
                 p_iface.first->pd()->info(), duration_ms);
+        if (get_verbose() >= 3) {
+            primitive_cache_stats_t s;
+            dnnl_get_primitive_cache_stats(&s);
+            printf("dnnl_verbose%s,cache_stats,hits:%" PRId64
+                   ",misses:%" PRId64 ",evictions:%" PRId64
+                   ",size:%d,capacity:%d,creation_time:%g,scratchpad_size:%zu,"
+                   "jit_code_size:%zu\n",
+                    stamp.c_str(), s.hits, s.misses, s.evictions, s.size,
+                    s.capacity, s.creation_time_ms, s.scratchpad_size,
+                    s.jit_code_size);
+        }
         fflush(stdout);
+    } else if (trace::is_enabled()) {
+        trace::event_t event;
+        event.start_ns = trace::get_time_ns();
+        CHECK(primitive_desc_iface->create_primitive_iface(p_iface));
+        event.end_ns = trace::get_time_ns();
+        event.name_id = p_iface.first->pd()->impl()->trace_id(
+                p_iface.first->engine());
+        event.kind = p_iface.second ? trace::event_kind_t::create_cache_hit
+                                    : trace::event_kind_t::create_cache_miss;
+        trace::record(event);
     } else {
         CHECK(primitive_desc_iface->create_primitive_iface(p_iface));
     }
@@ -111,6 +186,13 @@ status_t primitive_execute(
     if (itt::get_itt(itt::__itt_task_level_low))
         itt::primitive_task_start(primitive_iface->pd()->impl()->kind());
 
+    const bool collect_parallel_stats = parallel_stats::is_enabled();
+    if (collect_parallel_stats)
+        parallel_stats::start_primitive(trace::is_enabled()
+                        ? primitive_iface->pd()->impl()->trace_id(
+                                primitive_iface->engine())
+                        : -1);
+
     if (get_verbose()) {
         stream->wait();
         double start_ms = get_msec();
@@ -122,11 +204,39 @@ status_t primitive_execute(
 
         printf("dnnl_verbose%s,exec,%s,%g\n", stamp.c_str(),
                 primitive_iface->pd()->info(), duration_ms);
+        if (collect_parallel_stats) {
+            const auto s = parallel_stats::finish_primitive();
+            if (parallel_stats::is_imbalance_enabled() && s.nsections > 0)
+                printf("dnnl_verbose%s,parallel,%s,sections:%d,imbalance:%g,"
+                       "items_imbalance:%g,wait:%g\n",
+                        stamp.c_str(), primitive_iface->pd()->info(),
+                        s.nsections, s.imbalance(), s.items_imbalance(),
+                        s.wait_ms);
+            if (perf_counters::is_enabled())
+                print_perf_counters(stamp, primitive_iface->pd()->info(),
+                        s.counters, duration_ms);
+        }
+        if (get_verbose_roofline())
+            print_roofline(stamp, primitive_iface->pd()->impl().get(),
+                    primitive_iface->pd()->info(), duration_ms);
         fflush(stdout);
+    } else if (trace::is_enabled()) {
+        // The stream is not waited for, so for asynchronous streams the event
+        // only covers the submission of the primitive
+        trace::event_t event;
+        event.start_ns = trace::get_time_ns();
+        status = stream->enqueue_primitive(primitive_iface, ctx);
+        event.end_ns = trace::get_time_ns();
+        event.name_id = primitive_iface->pd()->impl()->trace_id(
+                primitive_iface->engine());
+        event.kind = trace::event_kind_t::exec;
+        trace::record(event);
     } else {
         status = stream->enqueue_primitive(primitive_iface, ctx);
     }
 
+    if (collect_parallel_stats) parallel_stats::finish_primitive();
+
     if (itt::get_itt(itt::__itt_task_level_low)) itt::primitive_task_end();
 
     stream->after_exec_hook();
@@ -214,7 +324,10 @@ status_t dnnl_primitive::init() {
     const size_t scratchpad_size
             = primitive_->pd()->scratchpad_size(scratchpad_mode::library);
 
-    if (scratchpad_size) {
+    if (scratchpad_size && !scratchpad_debug::is_protect_scratchpad()
+            && is_scratchpad_arena_enabled(pd_->engine())) {
+        use_scratchpad_arena_ = true;
+    } else if (scratchpad_size) {
         const memory_tracking::registry_t &registry
                 = primitive_->pd()->scratchpad_registry();
         bool use_global_scratchpad = scratchpad_debug::is_protect_scratchpad()
@@ -248,12 +361,27 @@ const primitive_desc_iface_t *dnnl_primitive::pd() const {
 
 status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     const memory_storage_t *mem_storage = nullptr;
+    std::unique_ptr<scratchpad_t> arena_scratchpad;
     if (primitive_->pd()->attr()->scratchpad_mode_ == scratchpad_mode::user) {
         memory_t *scratchpad_memory = ctx.output(DNNL_ARG_SCRATCHPAD);
         mem_storage = scratchpad_memory ? scratchpad_memory->memory_storage()
                                         : nullptr;
-    } else if (scratchpad_) {
-        mem_storage = scratchpad_->get_memory_storage();
+    } else if (scratchpad_ || use_scratchpad_arena_) {
+        const size_t scratchpad_size
+                = primitive_->pd()->scratchpad_size(scratchpad_mode::library);
+        // An asynchronous stream executes primitives on threadpool workers,
+        // so it cannot use the global scratchpad, which is per thread, and
+        // provides its own one
+        CHECK(ctx.stream()->get_scratchpad_storage(
+                scratchpad_size, &mem_storage));
+        if (!mem_storage && use_scratchpad_arena_) {
+            arena_scratchpad.reset(
+                    create_arena_scratchpad(pd_->engine(), scratchpad_size));
+            if (!arena_scratchpad || arena_scratchpad->size() < scratchpad_size)
+                return out_of_memory;
+            mem_storage = arena_scratchpad->get_memory_storage();
+        }
+        if (!mem_storage) mem_storage = scratchpad_->get_memory_storage();
     }
 
     auto scratchpad_grantor
@@ -261,7 +389,12 @@ status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     ctx.set_scratchpad_grantor(&scratchpad_grantor);
     ctx.set_resource_mapper(&resource_mapper_);
 
+    // Executed on the thread running the primitive, including the tasks of
+    // asynchronous streams, so the limit applies to the thread team as well
+    const int prev_limit = thread_team_utils::set_max_threads_limit(
+            primitive_->pd()->nthr());
     auto status = primitive_->execute(ctx);
+    thread_team_utils::set_max_threads_limit(prev_limit);
     ctx.set_scratchpad_grantor(nullptr);
     return status;
 }
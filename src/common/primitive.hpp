@@ -112,8 +112,18 @@ protected:
             // The requested primitive is NOT present in the cache therefore
             // we have to create it and notify the waiting threads
             // once the creation is done.
+            auto &jit_code_size = thread_jit_code_size();
+            const size_t jit_code_size_start = jit_code_size;
+            const double start_ms = get_msec();
             p = std::make_shared<impl_type>(pd);
             status = p->init(engine, use_global_scratchpad);
+            const double creation_time_ms = get_msec() - start_ms;
+            // The JIT code generated since the start (except the code of the
+            // nested primitives which has been already taken by them) belongs
+            // to this primitive.
+            const size_t primitive_jit_code_size
+                    = jit_code_size - jit_code_size_start;
+            jit_code_size = jit_code_size_start;
             if (status != status::success) {
                 // Communicate an error.
                 p_promise.set_value({nullptr, status});
@@ -136,7 +146,8 @@ protected:
                 // in the primitive_t.
                 // Therefore the pointers in the key, which has already been put
                 // into the cache, must be updated.
-                global_primitive_cache.update_entry(key, p->pd().get());
+                global_primitive_cache.update_entry(key, p->pd().get(),
+                        creation_time_ms, primitive_jit_code_size);
             }
         }
         primitive = std::make_pair(p, is_from_cache);
@@ -254,7 +265,8 @@ status_t primitive_execute(
 // 1. impl::primitive_t - a primitive implementation that can be
 // stored in the primitive cache. Other data members are NOT stored in
 // the cache
-// 2. scratchpad_t - a memory for scratchpad
+// 2. scratchpad_t - a memory for scratchpad, unless the scratchpad arena is
+// used
 // 3. primitive_desc_iface_t - an alias for dnnl_primitive_desc and is
 // a user facing primitive descriptor (the one a user should create prior
 // creating a primitive)
@@ -290,6 +302,8 @@ private:
     std::atomic<int> counter_;
     std::shared_ptr<dnnl::impl::primitive_t> primitive_;
     std::unique_ptr<dnnl::impl::scratchpad_t> scratchpad_;
+    // The scratchpad is taken from the scratchpad arena on every execution
+    bool use_scratchpad_arena_ = false;
     std::unique_ptr<primitive_desc_iface_t> pd_;
     dnnl::impl::resource_mapper_t resource_mapper_;
 
@@ -21,9 +21,6 @@
 #include "rw_mutex.hpp"
 #include "z_magic.hpp"
 
-#include "cpu/platform.hpp"
-
-#include <algorithm>
 #include <unordered_map>
 
 namespace dnnl {
@@ -36,10 +33,19 @@ primitive_cache_t &primitive_cache() {
 #else
     static const int capacity = 0;
 #endif
-    static lru_primitive_cache_t cache(capacity);
+    // The budget is set in megabytes.
+    static const int budget_mb
+            = getenv_int("DNNL_PRIMITIVE_CACHE_BUDGET_MB", 0);
+    static const size_t budget = budget_mb > 0 ? (size_t)budget_mb << 20 : 0;
+    static lru_primitive_cache_t cache(capacity, budget);
     return cache;
 }
 
+size_t &thread_jit_code_size() {
+    static thread_local size_t size = 0;
+    return size;
+}
+
 // Undocumented API, for testing only
 status_t get_primitive_cache_size(int *size) {
     if (size == nullptr) return dnnl::impl::status::invalid_arguments;
@@ -78,12 +84,36 @@ int lru_primitive_cache_t::get_capacity() const {
     return (int)capacity_;
 }
 
+status_t lru_primitive_cache_t::set_budget(size_t budget) {
+    utils::lock_write_t lock_w(rw_mutex());
+    budget_ = budget;
+    evict_over_budget();
+    return status::success;
+}
+
+size_t lru_primitive_cache_t::get_budget() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return budget_;
+}
+
 // For undocumented API
 int lru_primitive_cache_t::get_size() const {
     utils::lock_read_t lock_r(rw_mutex());
     return (int)cache_mapper_.size();
 }
 
+void lru_primitive_cache_t::get_stats(primitive_cache_stats_t *stats) const {
+    utils::lock_read_t lock_r(rw_mutex());
+    stats->hits = hits_.load(std::memory_order_relaxed);
+    stats->misses = misses_;
+    stats->evictions = evictions_;
+    stats->size = (int)cache_mapper_.size();
+    stats->capacity = (int)capacity_;
+    stats->creation_time_ms = creation_time_ms_;
+    stats->scratchpad_size = scratchpad_size_;
+    stats->jit_code_size = jit_code_size_;
+}
+
 lru_primitive_cache_t::value_t lru_primitive_cache_t::get_or_add(
         const key_t &key, const value_t &value) {
     // 1. Section with shared access (read lock)
@@ -97,6 +127,7 @@ lru_primitive_cache_t::value_t lru_primitive_cache_t::get_or_add(
     auto e = get(key);
     if (e.valid()) {
         unlock_read();
+        hits_.fetch_add(1, std::memory_order_relaxed);
         return e;
     }
 
@@ -120,6 +151,9 @@ lru_primitive_cache_t::value_t lru_primitive_cache_t::get_or_add(
     if (!e.valid()) {
         // If the entry is missing in the cache then add it (cache_miss)
         add(key, value);
+        misses_++;
+    } else {
+        hits_.fetch_add(1, std::memory_order_relaxed);
     }
     unlock_write();
     return e;
@@ -133,21 +167,25 @@ void lru_primitive_cache_t::add(const key_t &key, const value_t &value) {
         evict(1);
     }
 
-    size_t timestamp = dnnl::impl::cpu::platform::get_timestamp();
-
     auto res = cache_mapper_.emplace(std::piecewise_construct,
-            std::forward_as_tuple(key),
-            std::forward_as_tuple(value, timestamp));
+            std::forward_as_tuple(key), std::forward_as_tuple(value));
     MAYBE_UNUSED(res);
     assert(res.second);
+
+    auto &entry = *res.first;
+    entry.second.clock_it_ = clock_.insert(clock_.end(), &entry);
 }
 
 lru_primitive_cache_t::value_t lru_primitive_cache_t::get(const key_t &key) {
     auto it = cache_mapper_.find(key);
     if (it == cache_mapper_.end()) return value_t();
 
-    size_t timestamp = dnnl::impl::cpu::platform::get_timestamp();
-    it->second.timestamp_.store(timestamp);
+    // Mark the entry as recently used. The order of the stores from different
+    // threads doesn't matter, hence the relaxed memory ordering. The check
+    // avoids writing to the (shared) cache line when the bit is already set.
+    auto &referenced = it->second.referenced_;
+    if (!referenced.load(std::memory_order_relaxed))
+        referenced.store(true, std::memory_order_relaxed);
     // Return the entry
     return it->second.value_;
 }
@@ -179,13 +217,15 @@ void lru_primitive_cache_t::remove_if_invalidated(const key_t &key) {
     }
 
     // Remove the invalidated entry
-    cache_mapper_.erase(it);
+    erase(it);
     unlock_write();
 }
 
-void lru_primitive_cache_t::update_entry(
-        const key_t &key, const primitive_desc_t *pd) {
+void lru_primitive_cache_t::update_entry(const key_t &key,
+        const primitive_desc_t *pd, double creation_time_ms,
+        size_t jit_code_size) {
     utils::lock_write_t lock_w(rw_mutex());
+    creation_time_ms_ += creation_time_ms;
     auto it = cache_mapper_.find(key);
 
     // There is nothing to do in two cases:
@@ -202,42 +242,63 @@ void lru_primitive_cache_t::update_entry(
     // Update key in cache_mapper_
     it->first.op_desc_ = op_desc;
     it->first.attr_ = attr;
+
+    auto &entry = it->second;
+    entry.scratchpad_size_ = pd->scratchpad_registry().size();
+    entry.jit_code_size_ = jit_code_size;
+    scratchpad_size_ += entry.scratchpad_size_;
+    jit_code_size_ += entry.jit_code_size_;
+    evict_over_budget();
+}
+
+void lru_primitive_cache_t::erase(
+        std::unordered_map<key_t, clock_entry_t>::iterator it) {
+    scratchpad_size_ -= it->second.scratchpad_size_;
+    jit_code_size_ -= it->second.jit_code_size_;
+    clock_.erase(it->second.clock_it_);
+    cache_mapper_.erase(it);
 }
 
 // Evicts n the least recently used entries
 void lru_primitive_cache_t::evict(size_t n) {
-    if (n == capacity_) {
+    evictions_ += n;
+    if (n == cache_mapper_.size()) {
         cache_mapper_.clear();
+        clock_.clear();
+        scratchpad_size_ = 0;
+        jit_code_size_ = 0;
         return;
     }
 
     for (size_t e = 0; e < n; e++) {
-        // Find the smallest timestamp
-        // TODO: revisit the eviction algorithm due to O(n) complexity, E.g.
-        // maybe evict multiple entries at once.
-        auto it = std::min_element(cache_mapper_.begin(), cache_mapper_.end(),
-                [&](const decltype(cache_mapper_)::value_type &left,
-                        const decltype(cache_mapper_)::value_type &right) {
-                    // By default, load() and operator T use sequentially
-                    // consistent memory ordering, which enforces writing the
-                    // timestamps into registers in the same exact order they
-                    // are read from the CPU cache line. Since eviction is
-                    // performed under a write lock, this order is not
-                    // important, therefore we can safely use the weakest memory
-                    // ordering (relaxed). This brings about a few microseconds
-                    // performance improvement for default primitive cache
-                    // capacity.
-                    return left.second.timestamp_.load(
-                                   std::memory_order_relaxed)
-                            < right.second.timestamp_.load(
-                                    std::memory_order_relaxed);
-                });
-        auto res = cache_mapper_.erase(it->first);
-        MAYBE_UNUSED(res);
-        assert(res);
+        // Entries referenced since the last sweep get a second chance: the
+        // reference bit is cleared and the entry is moved to the back of the
+        // clock. Each entry can be skipped at most once, hence the loop takes
+        // O(1) amortized time per evicted entry. Since eviction is performed
+        // under a write lock, the weakest memory ordering (relaxed) is enough
+        // to access the reference bits.
+        while (clock_.front()->second.referenced_.load(
+                std::memory_order_relaxed)) {
+            clock_.front()->second.referenced_.store(
+                    false, std::memory_order_relaxed);
+            clock_.splice(clock_.end(), clock_, clock_.begin());
+        }
+        auto it = cache_mapper_.find(clock_.front()->first);
+        assert(it != cache_mapper_.end());
+        erase(it);
     }
 }
 
+// Evicts the least recently used entries until the total size of the
+// primitives in the cache fits the budget. A primitive which is larger than
+// the budget itself, including the one just created, is not kept.
+void lru_primitive_cache_t::evict_over_budget() {
+    if (budget_ == 0) return;
+
+    while (scratchpad_size_ + jit_code_size_ > budget_)
+        evict(1);
+}
+
 } // namespace impl
 } // namespace dnnl
 
@@ -258,3 +319,29 @@ dnnl::impl::status_t dnnl_set_primitive_cache_capacity(int capacity) {
 #endif
     return dnnl::impl::status::success;
 }
+
+dnnl::impl::status_t dnnl_get_primitive_cache_budget(size_t *budget) {
+    if (budget == nullptr) return dnnl::impl::status::invalid_arguments;
+    *budget = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    *budget = dnnl::impl::primitive_cache().get_budget();
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_set_primitive_cache_budget(size_t budget) {
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    return dnnl::impl::primitive_cache().set_budget(budget);
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_get_primitive_cache_stats(
+        dnnl_primitive_cache_stats_t *stats) {
+    if (stats == nullptr) return dnnl::impl::status::invalid_arguments;
+    *stats = dnnl_primitive_cache_stats_t();
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    dnnl::impl::primitive_cache().get_stats(stats);
+#endif
+    return dnnl::impl::status::success;
+}
@@ -17,7 +17,9 @@
 #ifndef COMMON_PRIMITIVE_CACHE_HPP
 #define COMMON_PRIMITIVE_CACHE_HPP
 
+#include <atomic>
 #include <future>
+#include <list>
 #include <memory>
 #include <thread>
 #include <unordered_map>
@@ -32,6 +34,8 @@ namespace dnnl {
 namespace impl {
 
 struct primitive_t;
+using primitive_cache_stats_t = dnnl_primitive_cache_stats_t;
+
 struct primitive_cache_t : public c_compatible {
     struct cache_value_t {
         std::shared_ptr<primitive_t> primitive;
@@ -45,11 +49,20 @@ struct primitive_cache_t : public c_compatible {
     virtual status_t set_capacity(int capacity) = 0;
     virtual int get_capacity() const = 0;
 
+    virtual status_t set_budget(size_t budget) = 0;
+    virtual size_t get_budget() const = 0;
+
     virtual value_t get_or_add(const key_t &key, const value_t &value) = 0;
     virtual void remove_if_invalidated(const key_t &key) = 0;
-    virtual void update_entry(const key_t &key, const primitive_desc_t *pd) = 0;
+    // Called once the primitive for the entry is created. The creation time
+    // and the size of the JIT code generated for the primitive are accounted
+    // in the statistics.
+    virtual void update_entry(const key_t &key, const primitive_desc_t *pd,
+            double creation_time_ms, size_t jit_code_size)
+            = 0;
 
     virtual int get_size() const = 0;
+    virtual void get_stats(primitive_cache_stats_t *stats) const = 0;
 
     virtual std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) = 0;
 
@@ -65,44 +78,94 @@ protected:
     void unlock_write() { rw_mutex().unlock_write(); }
 };
 
-// The cache uses LRU replacement policy
+// The cache limits the number of entries (capacity) and, optionally, the total
+// size of the JIT code and scratchpads of the primitives in it (budget).
+// The cache approximates LRU replacement policy with the CLOCK (second
+// chance) algorithm: a cache hit only sets a reference bit of the entry, which
+// is allowed under the read lock, and eviction sweeps the entries in insertion
+// order, giving the referenced ones a second chance. Both operations are O(1)
+// (amortized for eviction) in the number of cached entries.
 struct lru_primitive_cache_t : public primitive_cache_t {
-    lru_primitive_cache_t(int capacity) : capacity_(capacity) {}
+    lru_primitive_cache_t(int capacity, size_t budget = 0)
+        : capacity_(capacity), budget_(budget) {}
 
     ~lru_primitive_cache_t() override = default;
 
     status_t set_capacity(int capacity) override;
     int get_capacity() const override;
 
+    status_t set_budget(size_t budget) override;
+    size_t get_budget() const override;
+
     value_t get_or_add(const key_t &key, const value_t &value) override;
     void remove_if_invalidated(const key_t &key) override;
-    void update_entry(const key_t &key, const primitive_desc_t *pd) override;
+    void update_entry(const key_t &key, const primitive_desc_t *pd,
+            double creation_time_ms, size_t jit_code_size) override;
 
     int get_size() const override;
+    void get_stats(primitive_cache_stats_t *stats) const override;
 
     std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) override;
 
 private:
     void evict(size_t n);
+    void evict_over_budget();
     void add(const key_t &key, const value_t &value);
     value_t get(const key_t &key);
 
     size_t capacity_;
-    struct timed_entry_t {
+    size_t budget_;
+
+    struct clock_entry_t;
+    // The clock holds pointers to the elements of cache_mapper_ rather than
+    // copies of the keys: the keys are updated in place by update_entry() and
+    // the addresses of unordered_map elements are stable until they are
+    // erased.
+    using clock_list_t = std::list<std::pair<const key_t, clock_entry_t> *>;
+
+    struct clock_entry_t {
         value_t value_;
-        std::atomic<size_t> timestamp_;
-        timed_entry_t(const value_t &value, size_t timestamp)
-            : value_(value), timestamp_(timestamp) {}
+        std::atomic<bool> referenced_;
+        clock_list_t::iterator clock_it_;
+        // Set once the primitive is created, see update_entry().
+        size_t scratchpad_size_;
+        size_t jit_code_size_;
+        clock_entry_t(const value_t &value)
+            : value_(value)
+            , referenced_(false)
+            , scratchpad_size_(0)
+            , jit_code_size_(0) {}
     };
-    // Each entry in the cache has a corresponding key and timestamp.
+    // Each entry in the cache has a corresponding key, reference bit,
+    // position in the clock and the sizes accounted in the statistics.
     // NOTE: pairs that contain atomics cannot be stored in an unordered_map *as
     // an element*, since it invokes the copy constructor of std::atomic, which
     // is deleted.
-    std::unordered_map<key_t, timed_entry_t> cache_mapper_;
+    std::unordered_map<key_t, clock_entry_t> cache_mapper_;
+    // Entries in the order they are examined for eviction. New entries are
+    // appended to the back, the next candidate for eviction is at the front.
+    clock_list_t clock_;
+
+    void erase(std::unordered_map<key_t, clock_entry_t>::iterator it);
+
+    // Statistics. Hits are counted under the read lock, the rest is updated
+    // under the write lock.
+    std::atomic<int64_t> hits_ {0};
+    int64_t misses_ = 0;
+    int64_t evictions_ = 0;
+    double creation_time_ms_ = 0;
+    size_t scratchpad_size_ = 0;
+    size_t jit_code_size_ = 0;
 };
 
 primitive_cache_t &primitive_cache();
 
+// The size of the JIT code generated by the calling thread that is not yet
+// accounted for a primitive in the cache. The JIT generators increment it and
+// the primitive creation takes (and resets) the part generated by the
+// primitive, so that the code of nested primitives is accounted only once.
+size_t &thread_jit_code_size();
+
 // Undocumented API for testing.
 status_t DNNL_API get_primitive_cache_size(int *size);
 bool DNNL_API is_primitive_in_cache(const primitive_iface_t *p_iface);
@@ -83,6 +83,45 @@ status_t dnnl_primitive_desc::query(query_t what, int idx, void *result) const {
     return status;
 }
 
+double primitive_desc_t::bytes_estimate() const {
+    static const int args[] = {DNNL_ARG_SRC_0, DNNL_ARG_SRC_1, DNNL_ARG_SRC_2,
+            DNNL_ARG_DST_0, DNNL_ARG_DST_1, DNNL_ARG_DST_2, DNNL_ARG_WEIGHTS_0,
+            DNNL_ARG_WEIGHTS_1, DNNL_ARG_WEIGHTS_2, DNNL_ARG_WEIGHTS_3,
+            DNNL_ARG_BIAS, DNNL_ARG_MEAN, DNNL_ARG_VARIANCE, DNNL_ARG_SCALE,
+            DNNL_ARG_SHIFT, DNNL_ARG_DIFF_SRC_0, DNNL_ARG_DIFF_SRC_1,
+            DNNL_ARG_DIFF_SRC_2, DNNL_ARG_DIFF_DST_0, DNNL_ARG_DIFF_DST_1,
+            DNNL_ARG_DIFF_DST_2, DNNL_ARG_DIFF_WEIGHTS_0,
+            DNNL_ARG_DIFF_WEIGHTS_1, DNNL_ARG_DIFF_WEIGHTS_2,
+            DNNL_ARG_DIFF_WEIGHTS_3, DNNL_ARG_DIFF_BIAS, DNNL_ARG_DIFF_SCALE,
+            DNNL_ARG_DIFF_SHIFT};
+
+    auto md_bytes = [](const memory_desc_t *md) {
+        const memory_desc_wrapper mdw(md);
+        // The size of a memory with runtime dimensions is unknown
+        return mdw.has_runtime_dims_or_strides() ? 0. : (double)mdw.size();
+    };
+
+    double bytes = 0;
+    auto add_arg = [&](int arg) {
+        if (arg_usage(arg) != arg_usage_t::unused)
+            bytes += md_bytes(arg_md(arg));
+    };
+    for (int arg : args)
+        add_arg(arg);
+    // Inputs of concat and sum
+    for (int i = 0; i < n_inputs(); i++)
+        add_arg(DNNL_ARG_MULTIPLE_SRC + i);
+
+    const auto &po = attr()->post_ops_;
+    for (int idx = 0; idx < po.len(); idx++) {
+        if (po.contain(primitive_kind::sum, idx))
+            bytes += md_bytes(dst_md());
+        else if (po.contain(primitive_kind::binary, idx))
+            bytes += md_bytes(&po.entry_[idx].binary.src1_desc);
+    }
+    return bytes;
+}
+
 status_t dnnl_primitive_desc_get_attr(
         const primitive_desc_iface_t *primitive_desc_iface,
         const primitive_attr_t **attr) {
@@ -17,15 +17,18 @@
 #ifndef COMMON_PRIMITIVE_DESC_HPP
 #define COMMON_PRIMITIVE_DESC_HPP
 
+#include <string>
 #include <typeindex>
 
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "memory_tracking.hpp"
 #include "nstl.hpp"
 #include "primitive_attr.hpp"
 #include "primitive_cache.hpp"
+#include "trace.hpp"
 #include "type_helpers.hpp"
 #include "verbose.hpp"
 
@@ -56,6 +59,18 @@ struct primitive_desc_t : public c_compatible {
         return info_.c_str();
     }
 
+    // Returns the identifier of the primitive in the execution trace
+    int trace_id(engine_t *engine) const {
+        int id = info_.trace_id();
+        if (id < 0) {
+            std::string name = std::string(dnnl_prim_kind2str(kind_)) + ":"
+                    + this->name();
+            id = trace::register_name(name.c_str(), info(engine));
+            info_.set_trace_id(id);
+        }
+        return id;
+    }
+
     memory_tracking::registry_t &scratchpad_registry() {
         return scratchpad_registry_;
     }
@@ -177,6 +192,13 @@ struct primitive_desc_t : public c_compatible {
 
             case query::impl_info_str: *(const char **)result = name(); break;
 
+            case query::flops_estimate_f64:
+                *(double *)result = flops_estimate();
+                break;
+            case query::bytes_estimate_f64:
+                *(double *)result = bytes_estimate();
+                break;
+
             default: return status::unimplemented;
         }
         return status::success;
@@ -184,6 +206,15 @@ struct primitive_desc_t : public c_compatible {
 
     virtual int n_inputs() const { return 0; }
     virtual int n_outputs() const { return 0; }
+
+    // Estimated number of floating point operations of an execution, 0 for
+    // the primitives that mostly move data. Post-ops are not accounted for.
+    virtual double flops_estimate() const { return 0; }
+
+    // Estimated number of bytes an execution has to move at least: every
+    // input, including the post-op ones, is read once and every output is
+    // written once
+    double bytes_estimate() const;
     virtual int n_binary_po_inputs() const {
         int n_inputs = 0;
         for (int idx = 0; idx < attr()->post_ops_.len(); ++idx) {
@@ -241,10 +272,16 @@ struct primitive_desc_t : public c_compatible {
 
     int pd_iterator_offset() const { return pd_iterator_offset_; }
 
+    // Returns the number of threads available when the primitive descriptor
+    // was created. Per-thread scratchpad buffers are sized for it, so the
+    // primitive never executes on more threads.
+    int nthr() const { return nthr_; }
+
 protected:
     primitive_attr_t attr_;
     primitive_kind_t kind_;
     int pd_iterator_offset_;
+    int nthr_ = dnnl_get_max_threads();
 
     memory_desc_t scratchpad_md_;
 
@@ -280,8 +317,11 @@ protected:
                 && adesc->kind == primitive_kind::logsoftmax;
         bool valid_pooling = pd_t::base_pkind == primitive_kind::pooling_v2
                 && adesc->kind == primitive_kind::pooling;
+        bool valid_lnorm
+                = pd_t::base_pkind == primitive_kind::layer_normalization_v2
+                && adesc->kind == primitive_kind::layer_normalization;
         if (adesc->kind != pd_t::base_pkind && !valid_logsoftmax
-                && !valid_pooling)
+                && !valid_pooling && !valid_lnorm)
             return invalid_arguments;
         assert(hint_fwd ? hint_fwd->kind() == pd_t::base_pkind : true);
         auto hint
@@ -93,6 +93,7 @@ bool key_t::operator==(const key_t &rhs) const {
             CASE(gemm)
             CASE(inner_product)
             CASE(layer_normalization)
+            CASE(layer_normalization_v2)
             CASE(lrn)
             CASE(matmul)
             CASE(pooling)
@@ -438,6 +439,14 @@ size_t get_desc_hash(const layer_normalization_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const layer_normalization_v2_desc_t &desc) {
+    const auto &v1_desc
+            = *reinterpret_cast<const layer_normalization_desc_t *>(&desc);
+    size_t seed = get_desc_hash(v1_desc);
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    return seed;
+}
+
 size_t get_desc_hash(const lrn_desc_t &desc) {
     size_t seed = 0;
     // Kinds
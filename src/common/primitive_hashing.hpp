@@ -85,6 +85,7 @@ size_t get_desc_hash(const eltwise_desc_t &desc);
 size_t get_desc_hash(const gemm_desc_t &desc);
 size_t get_desc_hash(const inner_product_desc_t &desc);
 size_t get_desc_hash(const layer_normalization_desc_t &desc);
+size_t get_desc_hash(const layer_normalization_v2_desc_t &desc);
 size_t get_desc_hash(const lrn_desc_t &desc);
 size_t get_desc_hash(const matmul_desc_t &desc);
 size_t get_desc_hash(const pooling_desc_t &desc);
@@ -174,6 +175,7 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
             CASE(gemm)
             CASE(inner_product)
             CASE(layer_normalization)
+            CASE(layer_normalization_v2)
             CASE(lrn)
             CASE(matmul)
             CASE(pooling)
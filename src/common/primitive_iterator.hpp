@@ -22,6 +22,7 @@
 #include "c_types_map.hpp"
 #include "engine.hpp"
 #include "impl_list_item.hpp"
+#include "persistent_cache.hpp"
 #include "primitive_attr.hpp"
 #include "primitive_cache.hpp"
 #include "primitive_desc.hpp"
@@ -72,6 +73,31 @@ struct dnnl_primitive_desc_iterator : public dnnl::impl::c_compatible {
         pd_ = dnnl::impl::primitive_cache().get_pd(key);
         if (pd_) { return *this; }
 
+        // If the persistent cache has the implementation chosen for this key
+        // by a previous process, try it first: all the implementations in
+        // between are known to fail.
+        auto &persistent_cache = dnnl::impl::persistent_impl_cache();
+        const bool use_persistent_cache = persistent_cache.is_enabled()
+                && engine_->kind() == dnnl::impl::engine_kind::cpu
+                && engine_->runtime_kind() != dnnl::impl::runtime_kind::sycl;
+        const size_t key_hash = use_persistent_cache
+                ? std::hash<dnnl::impl::primitive_hashing::key_t>()(key)
+                : 0;
+        if (use_persistent_cache) {
+            int hint_idx = persistent_cache.get_impl_idx(key_hash);
+            if (hint_idx > idx_ && hint_idx < last_idx_
+                    && hint_idx != skip_idx_) {
+                dnnl::impl::primitive_desc_t *candidate_pd = nullptr;
+                auto s = impl_list_[hint_idx](&candidate_pd, op_desc_, &attr_,
+                        engine_, hint_fwd_pd_, offset_);
+                if (s == dnnl::impl::status::success) {
+                    idx_ = hint_idx;
+                    pd_.reset(candidate_pd);
+                    return *this;
+                }
+            }
+        }
+
         while (++idx_ != last_idx_) {
             if (idx_ == skip_idx_) continue;
             dnnl::impl::primitive_desc_t *candidate_pd = nullptr;
@@ -82,6 +108,9 @@ struct dnnl_primitive_desc_iterator : public dnnl::impl::c_compatible {
                 break;
             }
         }
+
+        if (use_persistent_cache && pd_)
+            persistent_cache.set_impl_idx(key_hash, idx_, pd_->name());
         return *this;
     }
 
@@ -70,6 +70,10 @@ struct reduction_pd_t : public primitive_desc_t {
     int n_inputs() const override { return 1 + n_binary_po_inputs(); }
     int n_outputs() const override { return 1; }
 
+    double flops_estimate() const override {
+        return (double)memory_desc_wrapper(src_md_).nelems();
+    }
+
     static void memory_desc_reduce_dim(memory_desc_t &md, int dim) {
         if (md.format_kind != format_kind::blocked) return;
 
@@ -87,6 +87,15 @@ struct resampling_pd_t : public primitive_desc_t {
     int n_inputs() const override { return 1 + n_binary_po_inputs(); }
     int n_outputs() const override { return 1; }
 
+    // The linear algorithm takes a multiply-add per neighbor of every dst
+    // point, 2^n neighbors for n spatial dimensions, and the backward pass
+    // spreads diff_dst to the same neighbors. The nearest one moves data.
+    double flops_estimate() const override {
+        if (desc_.alg_kind != alg_kind::resampling_linear) return 0;
+        const double nneighbors = (double)(1 << (ndims() - 2));
+        return 2. * nneighbors * MB() * C() * OD() * OH() * OW();
+    }
+
 protected:
     resampling_desc_t desc_;
     const resampling_fwd_pd_t *hint_fwd_pd_;
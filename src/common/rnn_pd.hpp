@@ -93,6 +93,15 @@ struct rnn_pd_t : public primitive_desc_t {
                 prop_kind::forward_inference);
     }
 
+    // Every cell multiplies the layer and the iteration inputs by the weights
+    // of all the gates. The backward pass computes the gradients with respect
+    // to both the data and the weights.
+    double flops_estimate() const override {
+        const double fwd_flops
+                = 2. * L() * D() * T() * MB() * G() * DHC() * (SLC() + SIC());
+        return is_fwd() ? fwd_flops : 2 * fwd_flops;
+    }
+
     dim_t T() const { return desc_.src_layer_desc.dims[0]; }
     dim_t MB() const { return desc_.src_layer_desc.dims[1]; }
 
@@ -14,7 +14,11 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <map>
 #include <memory>
+#include <mutex>
+
+#include "oneapi/dnnl/dnnl.h"
 
 #include "engine.hpp"
 #include "utils.hpp"
@@ -61,7 +65,8 @@ memory_storage_t *create_scratchpad_memory_storage(
             : engine;
 
     memory_storage_t *mem_storage = nullptr;
-    auto status = mem_engine->create_memory_storage(&mem_storage, size);
+    auto status = mem_engine->create_memory_storage(&mem_storage,
+            memory_flags_t::alloc | memory_flags_t::scratchpad, size, nullptr);
     MAYBE_UNUSED(status);
     return mem_storage;
 }
@@ -146,6 +151,142 @@ thread_local memory_storage_t *global_scratchpad_t::mem_storage_ = nullptr;
 thread_local size_t global_scratchpad_t::size_ = 0;
 thread_local unsigned int global_scratchpad_t::reference_count_ = 0;
 
+/*
+  Scratchpad buffers shared by all the threads and streams. The buffer sizes
+  are rounded up to a size class so that a buffer can be reused for the
+  scratchpads of slightly different sizes. A buffer returned to the arena is
+  kept for reuse while the total size of the kept buffers does not exceed the
+  capacity, and freed otherwise.
+*/
+struct scratchpad_arena_t {
+    scratchpad_arena_t() {
+        // The capacity is set in megabytes.
+        const int capacity_mb
+                = getenv_int("DNNL_SCRATCHPAD_ARENA_CAPACITY_MB", 0);
+        capacity_ = capacity_mb > 0 ? (size_t)capacity_mb << 20 : 0;
+    }
+
+    // Takes a buffer of at least `size` bytes, allocating it with `engine`
+    // if no buffer can be reused. The actual size of the buffer is returned
+    // in `buffer_size`.
+    memory_storage_t *acquire(
+            engine_t *engine, size_t size, size_t &buffer_size) {
+        buffer_size = size_class(size);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Larger buffers are reused as long as they are not more than
+            // twice as large as requested
+            auto it = buffers_.lower_bound(buffer_size);
+            if (it != buffers_.end() && it->first <= 2 * buffer_size) {
+                memory_storage_t *mem_storage = it->second;
+                buffer_size = it->first;
+                kept_size_ -= buffer_size;
+                buffers_.erase(it);
+                return mem_storage;
+            }
+        }
+        return create_scratchpad_memory_storage(engine, buffer_size);
+    }
+
+    void release(memory_storage_t *mem_storage, size_t buffer_size) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (kept_size_ + buffer_size <= capacity_) {
+                buffers_.emplace(buffer_size, mem_storage);
+                kept_size_ += buffer_size;
+                return;
+            }
+        }
+        delete mem_storage;
+    }
+
+    status_t set_capacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+        // Free the largest buffers first
+        while (kept_size_ > capacity_) {
+            auto it = std::prev(buffers_.end());
+            kept_size_ -= it->first;
+            delete it->second;
+            buffers_.erase(it);
+        }
+        return status::success;
+    }
+
+    size_t get_capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::multimap<size_t, memory_storage_t *> buffers_;
+    size_t capacity_ = 0;
+    size_t kept_size_ = 0;
+
+    // Rounds the size up to a multiple of a quarter of its highest power of
+    // two, so that at most 25% of a buffer is wasted.
+    static size_t size_class(size_t size) {
+        const size_t min_size = 4096;
+        if (size <= min_size) return min_size;
+        size_t step = min_size;
+        while (step < size / 4)
+            step <<= 1;
+        return utils::rnd_up(size, step);
+    }
+};
+
+// The arena is never destroyed: the buffers it keeps may be referenced by the
+// scratchpads of primitives destroyed at exit.
+scratchpad_arena_t &scratchpad_arena() {
+    static scratchpad_arena_t *arena = new scratchpad_arena_t();
+    return *arena;
+}
+
+/*
+  Implementation of the scratchpad_t interface that takes a buffer from the
+  scratchpad arena for its lifetime
+*/
+struct arena_scratchpad_t : public scratchpad_t {
+    arena_scratchpad_t(engine_t *engine, size_t size) {
+        mem_storage_ = scratchpad_arena().acquire(engine, size, size_);
+        if (mem_storage_ == nullptr) size_ = 0;
+    }
+
+    ~arena_scratchpad_t() override {
+        if (mem_storage_) scratchpad_arena().release(mem_storage_, size_);
+    }
+
+    const memory_storage_t *get_memory_storage() const override {
+        return mem_storage_;
+    }
+
+    size_t size() const override { return size_; }
+
+private:
+    memory_storage_t *mem_storage_;
+    size_t size_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(arena_scratchpad_t);
+};
+
+bool is_scratchpad_arena_enabled(const engine_t *engine) {
+    return engine->kind() == engine_kind::cpu
+            && scratchpad_arena().get_capacity() > 0;
+}
+
+scratchpad_t *create_arena_scratchpad(engine_t *engine, size_t size) {
+    return new arena_scratchpad_t(engine, size);
+}
+
+status_t set_scratchpad_arena_capacity(size_t capacity) {
+    return scratchpad_arena().set_capacity(capacity);
+}
+
+size_t get_scratchpad_arena_capacity() {
+    return scratchpad_arena().get_capacity();
+}
+
 /*
    Scratchpad creation routine
 */
@@ -169,3 +310,13 @@ scratchpad_t *create_scratchpad(
 
 } // namespace impl
 } // namespace dnnl
+
+dnnl::impl::status_t dnnl_get_scratchpad_arena_capacity(size_t *capacity) {
+    if (capacity == nullptr) return dnnl::impl::status::invalid_arguments;
+    *capacity = dnnl::impl::get_scratchpad_arena_capacity();
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_set_scratchpad_arena_capacity(size_t capacity) {
+    return dnnl::impl::set_scratchpad_arena_capacity(capacity);
+}
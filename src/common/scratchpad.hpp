@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2017-2020 Intel Corporation
+* Copyright 2017-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -33,6 +33,16 @@ struct scratchpad_t {
 scratchpad_t *create_scratchpad(
         engine_t *engine, size_t size, bool use_global_scratchpad);
 
+// The scratchpad arena is a pool of scratchpad buffers shared by all the
+// threads and streams. A primitive using the arena takes a buffer for the
+// duration of each execution only. The arena is enabled for the CPU engines
+// when its capacity, the total size of the buffers it keeps for reuse, is not
+// zero.
+bool is_scratchpad_arena_enabled(const engine_t *engine);
+scratchpad_t *create_arena_scratchpad(engine_t *engine, size_t size);
+status_t set_scratchpad_arena_capacity(size_t capacity);
+size_t get_scratchpad_arena_capacity();
+
 } // namespace impl
 } // namespace dnnl
 #endif
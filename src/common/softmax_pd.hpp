@@ -85,6 +85,15 @@ struct softmax_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(data_desc()).has_zero_dim();
     }
 
+    // Per element: the max, the subtraction and the exponent, the sum and
+    // the final scaling, or the subtraction of the log of the sum for
+    // logsoftmax. The backward pass takes a multiply-add for the reduction,
+    // then a subtraction and a multiplication.
+    double flops_estimate() const override {
+        const double nelems = (double)outer_size() * axis_size() * inner_size();
+        return (is_fwd() ? 5. : 4.) * nelems;
+    }
+
     bool is_softmax() const {
         return desc()->primitive_kind == primitive_kind::softmax;
     }
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2016-2020 Intel Corporation
+* Copyright 2016-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -15,6 +15,9 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <memory>
+#include <vector>
+
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
@@ -43,6 +46,24 @@ status_t dnnl_stream_create(
     return engine->create_stream(stream, flags);
 }
 
+status_t dnnl_stream_create_with_thread_team(stream_t **stream,
+        engine_t *engine, unsigned flags, int nthreads, int ncpus,
+        const int *cpus) {
+    bool args_ok = !utils::any_null(stream, engine) && nthreads > 0
+            && ncpus >= 0 && IMPLICATION(ncpus > 0, cpus != nullptr)
+            && engine->kind() == engine_kind::cpu;
+    if (!args_ok) return invalid_arguments;
+    for (int i = 0; i < ncpus; i++)
+        if (cpus[i] < 0) return invalid_arguments;
+
+    stream_t *s = nullptr;
+    CHECK(engine->create_stream(&s, flags));
+    std::unique_ptr<stream_t> s_ptr(s);
+    s->set_thread_team(nthreads, std::vector<int>(cpus, cpus + ncpus));
+    *stream = s_ptr.release();
+    return success;
+}
+
 status_t dnnl_stream_get_engine(const stream_t *stream, engine_t **engine) {
     if (any_null(stream, engine)) return invalid_arguments;
     *engine = stream->engine();
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2016-2020 Intel Corporation
+* Copyright 2016-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -18,10 +18,18 @@
 #define COMMON_STREAM_HPP
 
 #include <assert.h>
+#include <memory>
+#include <vector>
+
 #include "oneapi/dnnl/dnnl.h"
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
 
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "oneapi/dnnl/dnnl_threadpool.h"
+#endif
+
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "utils.hpp"
 
@@ -40,6 +48,16 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
     /** returns stream's kind */
     unsigned flags() const { return flags_; }
 
+    /** binds the stream to a thread team */
+    void set_thread_team(int nthr, const std::vector<int> &cpus) {
+        thread_team_.reset(new dnnl::impl::thread_team_t(nthr, cpus));
+    }
+
+    /** returns the thread team the stream is bound to or nullptr */
+    const dnnl::impl::thread_team_t *thread_team() const {
+        return thread_team_.get();
+    }
+
     virtual dnnl::impl::status_t enqueue_primitive(
             const primitive_iface_t *primitive_iface,
             dnnl::impl::exec_ctx_t &ctx);
@@ -50,6 +68,14 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
     virtual void before_exec_hook() {}
     virtual void after_exec_hook() {}
 
+    /** provides the storage for a library-managed scratchpad of `size` bytes
+     * if the stream owns one, otherwise sets `storage` to nullptr */
+    virtual dnnl::impl::status_t get_scratchpad_storage(
+            size_t size, const dnnl::impl::memory_storage_t **storage) {
+        *storage = nullptr;
+        return dnnl::impl::status::success;
+    }
+
     virtual dnnl::impl::status_t zero_pad(const dnnl::impl::memory_t *memory,
             const dnnl::impl::exec_ctx_t &ctx);
 
@@ -69,11 +95,20 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
         *threadpool = threadpool_;
         return status::success;
     }
+
+    /** enqueues a callback invoked once the previously submitted primitives
+     * complete */
+    virtual dnnl::impl::status_t enqueue_callback(
+            dnnl_threadpool_interop_callback_t callback, void *user_data) {
+        callback(dnnl::impl::status::success, user_data);
+        return dnnl::impl::status::success;
+    }
 #endif
 
 protected:
     dnnl::impl::engine_t *engine_;
     unsigned flags_;
+    std::unique_ptr<dnnl::impl::thread_team_t> thread_team_;
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     dnnl::threadpool_interop::threadpool_iface *threadpool_ = nullptr;
 #endif
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2020 Intel Corporation
+* Copyright 2020-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -41,7 +41,18 @@ dnnl_status_t dnnl_threadpool_interop_stream_create(
     auto tp = static_cast<dnnl::threadpool_interop::threadpool_iface *>(
             threadpool);
 
-    return engine->create_stream(stream, tp);
+    return engine->create_stream(stream, tp, false);
+}
+
+dnnl_status_t dnnl_threadpool_interop_stream_create_async(
+        stream_t **stream, engine_t *engine, void *threadpool) {
+    bool args_ok = !utils::any_null(stream, engine);
+    if (!args_ok) return invalid_arguments;
+
+    auto tp = static_cast<dnnl::threadpool_interop::threadpool_iface *>(
+            threadpool);
+
+    return engine->create_stream(stream, tp, true);
 }
 
 dnnl_status_t dnnl_threadpool_interop_stream_get_threadpool(
@@ -53,4 +64,11 @@ dnnl_status_t dnnl_threadpool_interop_stream_get_threadpool(
     return status;
 }
 
+dnnl_status_t dnnl_threadpool_interop_stream_enqueue_callback(
+        dnnl_stream_t stream, dnnl_threadpool_interop_callback_t callback,
+        void *user_data) {
+    if (utils::any_null(stream, callback)) return status::invalid_arguments;
+    return stream->enqueue_callback(callback, user_data);
+}
+
 #endif
@@ -75,6 +75,11 @@ struct sum_pd_t : public primitive_desc_t {
         return memory_desc_wrapper(dst_md()).has_zero_dim();
     }
 
+    // A multiply-add per element of every input
+    double flops_estimate() const override {
+        return 2. * n_inputs() * memory_desc_wrapper(dst_md()).nelems();
+    }
+
 protected:
     int n_;
     std::vector<float> scales_;
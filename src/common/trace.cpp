@@ -0,0 +1,328 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <stdio.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "trace.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace trace {
+
+namespace detail {
+std::atomic<int> state {uninitialized};
+} // namespace detail
+
+namespace {
+
+// Events of a thread. The buffer is written by its thread only and drained
+// by the thread writing the trace file.
+struct ring_buffer_t {
+    static constexpr size_t capacity = 4096;
+
+    ring_buffer_t(int tid) : tid(tid) {}
+
+    void push(const event_t &event) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == capacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events_[head % capacity] = event;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename F>
+    void drain(F f) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; tail++)
+            f(events_[tail % capacity]);
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    size_t take_dropped() { return dropped_.exchange(0); }
+
+    const int tid;
+    // Set once the thread owning the buffer exits
+    std::atomic<bool> retired {false};
+
+private:
+    event_t events_[capacity];
+    std::atomic<size_t> head_ {0};
+    std::atomic<size_t> tail_ {0};
+    std::atomic<size_t> dropped_ {0};
+};
+
+std::string escape(const char *str) {
+    std::string result;
+    for (; *str; str++) {
+        const char c = *str;
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if ((unsigned char)c < 0x20) {
+            result += ' ';
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+const char *event_kind2str(event_kind_t kind) {
+    switch (kind) {
+        case event_kind_t::exec: return "exec";
+        case event_kind_t::create_cache_hit: return "create:cache_hit";
+        case event_kind_t::create_cache_miss: return "create:cache_miss";
+        case event_kind_t::parallel: return "parallel";
+    }
+    return "unknown";
+}
+
+struct tracer_t {
+    tracer_t() : pid_((int)getpid()), epoch_ns_(get_time_ns()) {}
+
+    ring_buffer_t *create_buffer() {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffers_.emplace_back(new ring_buffer_t(next_tid_++));
+        return buffers_.back().get();
+    }
+
+    int register_name(const char *name, const char *info) {
+        // The arguments are left open so that events can add their own
+        std::string str = "\"name\":\"" + escape(name)
+                + "\",\"args\":{\"info\":\"" + escape(info) + "\"";
+        std::lock_guard<std::mutex> lock(names_mutex_);
+        auto it = name_ids_.find(str);
+        if (it != name_ids_.end()) return it->second;
+        const int id = (int)names_.size();
+        names_.push_back(str);
+        name_ids_.emplace(std::move(str), id);
+        return id;
+    }
+
+    status_t set_file(const char *path) {
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        close_file();
+        if (path == nullptr || *path == '\0') return status::success;
+
+        file_ = fopen(path, "w");
+        if (!file_) return status::invalid_arguments;
+        // The JSON array format of the trace is still valid when the closing
+        // bracket is missing, e.g. if the application crashes
+        fprintf(file_, "[\n");
+        need_comma_ = false;
+
+        // Events recorded for a previous trace file are discarded
+        drain(false);
+        if (!flusher_started_) {
+            // The thread is never joined: the tracer lives until the process
+            // exits
+            std::thread(&tracer_t::flush_loop, this).detach();
+            flusher_started_ = true;
+        }
+        detail::state = detail::enabled;
+        return status::success;
+    }
+
+private:
+    const int pid_;
+    const uint64_t epoch_ns_;
+
+    std::mutex buffers_mutex_;
+    std::vector<std::unique_ptr<ring_buffer_t>> buffers_;
+    int next_tid_ = 0;
+
+    std::mutex names_mutex_;
+    std::deque<std::string> names_;
+    std::unordered_map<std::string, int> name_ids_;
+
+    std::mutex file_mutex_;
+    FILE *file_ = nullptr;
+    bool need_comma_ = false;
+    bool flusher_started_ = false;
+
+    // Requires file_mutex_ to be held
+    void close_file() {
+        if (!file_) return;
+        detail::state = detail::disabled;
+        drain(true);
+        fprintf(file_, "\n]\n");
+        fclose(file_);
+        file_ = nullptr;
+    }
+
+    void write_event(const std::string &json) {
+        fprintf(file_, "%s%s", need_comma_ ? ",\n" : "", json.c_str());
+        need_comma_ = true;
+    }
+
+    // Requires file_mutex_ to be held
+    void drain(bool write) {
+        std::vector<ring_buffer_t *> buffers;
+        std::vector<bool> retired;
+        {
+            std::lock_guard<std::mutex> lock(buffers_mutex_);
+            for (const auto &b : buffers_) {
+                buffers.push_back(b.get());
+                retired.push_back(b->retired.load());
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(names_mutex_);
+        char buf[256];
+        for (auto *b : buffers) {
+            b->drain([&](const event_t &e) {
+                if (!write) return;
+                snprintf(buf, sizeof(buf),
+                        "{\"ph\":\"X\",\"cat\":\"%s\",\"ts\":%.3f,"
+                        "\"dur\":%.3f,\"pid\":%d,\"tid\":%d,",
+                        event_kind2str(e.kind), (e.start_ns - epoch_ns_) / 1e3,
+                        (e.end_ns - e.start_ns) / 1e3, pid_, b->tid);
+                std::string json = buf + names_[e.name_id];
+                if (e.kind == event_kind_t::parallel) {
+                    snprintf(buf, sizeof(buf),
+                            ",\"nthr\":%d,\"imbalance\":%.3f,"
+                            "\"items_imbalance\":%.3f,\"wait_us\":%.3f",
+                            e.nthr, e.imbalance, e.items_imbalance, e.wait_us);
+                    json += buf;
+                }
+                write_event(json + "}}");
+            });
+            const size_t dropped = b->take_dropped();
+            if (write && dropped > 0) {
+                snprintf(buf, sizeof(buf),
+                        "{\"ph\":\"i\",\"s\":\"t\",\"name\":\"dropped_events\","
+                        "\"ts\":%.3f,\"pid\":%d,\"tid\":%d,"
+                        "\"args\":{\"count\":%zu}}",
+                        (get_time_ns() - epoch_ns_) / 1e3, pid_, b->tid,
+                        dropped);
+                write_event(buf);
+            }
+        }
+        if (write) fflush(file_);
+
+        // The buffers of the exited threads are empty once drained
+        std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+        for (size_t i = 0; i < retired.size(); i++) {
+            if (!retired[i]) continue;
+            for (auto it = buffers_.begin(); it != buffers_.end(); ++it)
+                if (it->get() == buffers[i]) {
+                    buffers_.erase(it);
+                    break;
+                }
+        }
+    }
+
+    void flush_loop() {
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            std::lock_guard<std::mutex> lock(file_mutex_);
+            if (file_) drain(true);
+        }
+    }
+};
+
+tracer_t &tracer() {
+    static tracer_t *tracer = new tracer_t();
+    return *tracer;
+}
+
+struct buffer_holder_t {
+    ~buffer_holder_t() {
+        if (buffer) buffer->retired = true;
+    }
+    ring_buffer_t *buffer = nullptr;
+};
+
+// Completes the trace file when the library is unloaded
+struct finalizer_t {
+    ~finalizer_t() {
+        if (detail::state == detail::enabled) tracer().set_file(nullptr);
+    }
+} finalizer;
+
+} // namespace
+
+namespace detail {
+int init() {
+    static std::once_flag initialized;
+    std::call_once(initialized, []() {
+        status_t status = status::success;
+        const int len = -getenv("DNNL_TRACE_FILE", nullptr, 0);
+        if (len > 0) {
+            std::vector<char> path(len + 1);
+            getenv("DNNL_TRACE_FILE", path.data(), len + 1);
+            status = tracer().set_file(path.data());
+        }
+        // The state is left untouched if the trace was enabled concurrently
+        // with dnnl_set_trace_file()
+        int expected = uninitialized;
+        state.compare_exchange_strong(expected,
+                status == status::success && len > 0 ? enabled : disabled);
+    });
+    return state;
+}
+} // namespace detail
+
+uint64_t get_time_ns() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(
+            steady_clock::now().time_since_epoch())
+            .count();
+}
+
+int register_name(const char *name, const char *info) {
+    return tracer().register_name(name, info);
+}
+
+void record(const event_t &event) {
+    static thread_local buffer_holder_t holder;
+    if (!holder.buffer) holder.buffer = tracer().create_buffer();
+    holder.buffer->push(event);
+}
+
+status_t set_file(const char *path) {
+    detail::init();
+    return tracer().set_file(path);
+}
+
+} // namespace trace
+} // namespace impl
+} // namespace dnnl
+
+dnnl_status_t dnnl_set_trace_file(const char *path) {
+    return dnnl::impl::trace::set_file(path);
+}
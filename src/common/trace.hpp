@@ -0,0 +1,90 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_TRACE_HPP
+#define COMMON_TRACE_HPP
+
+#include <atomic>
+#include <stdint.h>
+
+#include "c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace trace {
+
+// Execution trace in the Chrome trace event format, which can be opened with
+// chrome://tracing or Perfetto.
+//
+// The events are recorded into per-thread single-producer ring buffers and a
+// background thread periodically writes them to the trace file, so recording
+// an event only takes two clock reads and a few stores. Events recorded while
+// the buffer of a thread is full are dropped.
+//
+// The trace is enabled with the DNNL_TRACE_FILE environment variable or
+// dnnl_set_trace_file().
+
+enum class event_kind_t : uint8_t {
+    exec,
+    create_cache_hit,
+    create_cache_miss,
+    parallel,
+};
+
+struct event_t {
+    uint64_t start_ns;
+    uint64_t end_ns;
+    int name_id; // identifier returned by register_name()
+    event_kind_t kind;
+
+    // Statistics of a parallel section, event_kind_t::parallel only
+    int nthr;
+    float imbalance;
+    float items_imbalance;
+    float wait_us;
+};
+
+namespace detail {
+enum { uninitialized, disabled, enabled };
+extern std::atomic<int> state;
+// Reads the environment on the first call and returns the state
+int init();
+} // namespace detail
+
+inline bool is_enabled() {
+    int state = detail::state.load(std::memory_order_relaxed);
+    if (state == detail::uninitialized) state = detail::init();
+    return state == detail::enabled;
+}
+
+// Returns the time elapsed since an arbitrary point in the past, in
+// nanoseconds
+uint64_t get_time_ns();
+
+// Registers the name and the arguments of the events of a primitive and
+// returns the identifier of the pair. The arguments are a verbose-like
+// primitive description.
+int register_name(const char *name, const char *info);
+
+void record(const event_t &event);
+
+status_t set_file(const char *path);
+
+} // namespace trace
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -436,6 +436,17 @@ inline bool operator==(const layer_normalization_desc_t &lhs,
     return ret;
 }
 
+inline bool operator==(const layer_normalization_v2_desc_t &lhs,
+        const layer_normalization_v2_desc_t &rhs) {
+    const auto &v1_desc_lhs
+            = *reinterpret_cast<const layer_normalization_desc_t *>(&lhs);
+    const auto &v1_desc_rhs
+            = *reinterpret_cast<const layer_normalization_desc_t *>(&rhs);
+
+    bool ret = v1_desc_lhs == v1_desc_rhs && COMPARE_DESC_MEMBERS(dst_desc);
+    return ret;
+}
+
 inline bool operator==(const lrn_desc_t &lhs, const lrn_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
             && COMPARE_DESC_MEMBERS(prop_kind)
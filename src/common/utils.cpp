@@ -28,6 +28,16 @@
 #include <sys/types.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
 #include <climits>
 #include <cstdio>
 #include <cstdlib>
@@ -37,6 +47,8 @@
 
 #include "oneapi/dnnl/dnnl.h"
 
+#include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "memory_debug.hpp"
 #include "utils.hpp"
 
@@ -108,19 +120,96 @@ int getpagesize() {
 #endif
 }
 
+namespace {
+// Policy applied to the allocations of at least `threshold` bytes. A zero
+// threshold disables the policy.
+struct large_allocation_policy_t {
+    large_allocation_policy_t() {
+        const int threshold_mb
+                = getenv_int("DNNL_LARGE_ALLOCATION_THRESHOLD_MB", 0);
+        threshold = (size_t)std::max(threshold_mb, 0) * 1024 * 1024;
+        use_huge_pages
+                = getenv_int("DNNL_LARGE_ALLOCATION_HUGE_PAGES", 1) != 0;
+
+        placement = dnnl_memory_placement_system;
+        char value[32];
+        if (getenv("DNNL_LARGE_ALLOCATION_PLACEMENT", value, sizeof(value))
+                > 0) {
+            if (!strcmp(value, "first_touch"))
+                placement = dnnl_memory_placement_first_touch;
+            else if (!strcmp(value, "interleave"))
+                placement = dnnl_memory_placement_interleave;
+        }
+    }
+
+    std::atomic<size_t> threshold;
+    std::atomic<bool> use_huge_pages;
+    std::atomic<int> placement;
+};
+
+large_allocation_policy_t &large_allocation_policy() {
+    static large_allocation_policy_t policy;
+    return policy;
+}
+
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+// Writes to each page of the buffer from the library threads so that the
+// system places the pages on the NUMA nodes of the threads. Nothing is done
+// from a parallel section as the pages would be touched by a single thread.
+void place_pages(void *ptr, size_t size, size_t page_size,
+        dnnl_memory_placement_t placement) {
+    if (placement == dnnl_memory_placement_system || dnnl_in_parallel())
+        return;
+
+    char *base = static_cast<char *>(ptr);
+    const size_t npages = utils::div_up(size, page_size);
+    parallel(0, [&](int ithr, int nthr) {
+        if (placement == dnnl_memory_placement_first_touch) {
+            size_t start = 0, end = 0;
+            balance211(npages, (size_t)nthr, (size_t)ithr, start, end);
+            for (size_t p = start; p < end; p++)
+                base[p * page_size] = 0;
+        } else {
+            for (size_t p = ithr; p < npages; p += nthr)
+                base[p * page_size] = 0;
+        }
+    });
+}
+} // namespace
+
 void *malloc(size_t size, int alignment) {
     void *ptr;
     if (memory_debug::is_mem_debug())
         return memory_debug::malloc(size, alignment);
 
+    const auto &policy = large_allocation_policy();
+    const size_t threshold = policy.threshold;
+    const bool is_large = threshold > 0 && size >= threshold;
+    const bool use_huge_pages = is_large && policy.use_huge_pages;
+    if (use_huge_pages) alignment = std::max(alignment, (int)huge_page_size);
+
 #ifdef _WIN32
     ptr = _aligned_malloc(size, alignment);
     int rc = ptr ? 0 : -1;
 #else
     int rc = ::posix_memalign(&ptr, alignment, size);
 #endif
+    if (rc != 0) return nullptr;
+
+    if (is_large) {
+        size_t page_size = (size_t)getpagesize();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // The advice is only a hint, the memory is still usable if the
+        // system cannot back it with huge pages
+        if (use_huge_pages && ::madvise(ptr, size, MADV_HUGEPAGE) == 0)
+            page_size = huge_page_size;
+#endif
+        place_pages(ptr, size, page_size,
+                (dnnl_memory_placement_t)policy.placement.load());
+    }
 
-    return (rc == 0) ? ptr : nullptr;
+    return ptr;
 }
 
 void free(void *p) {
@@ -239,6 +328,112 @@ dnnl_cpu_isa_hints_t dnnl_get_cpu_isa_hints() {
     return dnnl::impl::cpu::platform::get_cpu_isa_hints();
 }
 
+namespace dnnl {
+namespace impl {
+
+namespace {
+// Number of threads set with dnnl_set_current_thread_team()
+static thread_local int current_thread_team_nthr = 0;
+static thread_local const thread_team_t *active_thread_team = nullptr;
+static thread_local int max_threads_limit = 0;
+} // namespace
+
+thread_team_t::thread_team_t(int nthr, const std::vector<int> &cpus)
+    : nthr(nthr), cpus(cpus), id([]() {
+        static std::atomic<size_t> next_id(1);
+        return next_id++;
+    }()) {}
+
+namespace thread_team_utils {
+
+void DNNL_API activate_thread_team(const thread_team_t *team) {
+    active_thread_team = team;
+}
+
+void DNNL_API deactivate_thread_team() {
+    active_thread_team = nullptr;
+}
+
+const thread_team_t DNNL_API *get_active_thread_team() {
+    return active_thread_team;
+}
+
+int DNNL_API get_thread_team_nthr() {
+    return active_thread_team ? active_thread_team->nthr
+                              : current_thread_team_nthr;
+}
+
+int DNNL_API set_max_threads_limit(int nthr) {
+    const int prev = max_threads_limit;
+    max_threads_limit = nthr;
+    return prev;
+}
+
+int DNNL_API get_max_threads_limit() {
+    return max_threads_limit;
+}
+
+void DNNL_API bind_to_thread_team(const thread_team_t *team) {
+#if defined(__GLIBC__)
+    // Id of the team the calling thread is bound to, 0 if the thread has its
+    // original affinity
+    static thread_local size_t bound_id = 0;
+    static thread_local cpu_set_t original_mask;
+
+    const size_t id = team && !team->cpus.empty() ? team->id : 0;
+    if (id == bound_id) return;
+    if (bound_id == 0
+            && ::sched_getaffinity(0, sizeof(original_mask), &original_mask))
+        return;
+
+    cpu_set_t mask = original_mask;
+    if (id != 0) {
+        CPU_ZERO(&mask);
+        for (int cpu : team->cpus)
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &mask);
+    }
+    if (::sched_setaffinity(0, sizeof(mask), &mask) == 0) bound_id = id;
+#else
+    UNUSED(team);
+#endif
+}
+
+} // namespace thread_team_utils
+} // namespace impl
+} // namespace dnnl
+
+dnnl_status_t dnnl_get_large_allocation_policy(size_t *threshold,
+        int *use_huge_pages, dnnl_memory_placement_t *placement) {
+    using namespace dnnl::impl;
+    if (utils::any_null(threshold, use_huge_pages, placement))
+        return status::invalid_arguments;
+    const auto &policy = large_allocation_policy();
+    *threshold = policy.threshold;
+    *use_huge_pages = policy.use_huge_pages;
+    *placement = (dnnl_memory_placement_t)policy.placement.load();
+    return status::success;
+}
+
+dnnl_status_t dnnl_set_large_allocation_policy(size_t threshold,
+        int use_huge_pages, dnnl_memory_placement_t placement) {
+    using namespace dnnl::impl;
+    if (!utils::one_of(placement, dnnl_memory_placement_system,
+                dnnl_memory_placement_first_touch,
+                dnnl_memory_placement_interleave))
+        return status::invalid_arguments;
+    auto &policy = large_allocation_policy();
+    policy.threshold = threshold;
+    policy.use_huge_pages = use_huge_pages != 0;
+    policy.placement = placement;
+    return status::success;
+}
+
+dnnl_status_t dnnl_set_current_thread_team(int nthreads) {
+    if (nthreads < 0) return dnnl::impl::status::invalid_arguments;
+    dnnl::impl::current_thread_team_nthr = nthreads;
+    return dnnl::impl::status::success;
+}
+
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
 namespace dnnl {
@@ -249,6 +444,7 @@ namespace {
 static thread_local dnnl::threadpool_interop::threadpool_iface
         *active_threadpool
         = nullptr;
+static thread_local bool worker_task = false;
 }
 
 void DNNL_API activate_threadpool(
@@ -265,6 +461,18 @@ dnnl::threadpool_interop::threadpool_iface *get_active_threadpool() {
     return active_threadpool;
 }
 
+void DNNL_API activate_worker_task() {
+    worker_task = true;
+}
+
+void DNNL_API deactivate_worker_task() {
+    worker_task = false;
+}
+
+bool DNNL_API is_worker_task() {
+    return worker_task;
+}
+
 } // namespace threadpool_utils
 } // namespace impl
 } // namespace dnnl
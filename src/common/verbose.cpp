@@ -118,6 +118,41 @@ bool get_verbose_timestamp() {
     return verbose.get() && verbose_timestamp.get();
 }
 
+static setting_t<bool> verbose_roofline {false};
+bool get_verbose_roofline() {
+#if !defined(DISABLE_VERBOSE)
+    if (!verbose_roofline.initialized()) {
+        // Assumes that all threads see the same environment
+        const int len = 2;
+        char val[len] = {0};
+        if (getenv("DNNL_VERBOSE_ROOFLINE", val, len) == 1)
+            verbose_roofline.set(atoi(val));
+        if (!verbose_roofline.initialized()) verbose_roofline.set(false);
+    }
+#endif
+    // No effect if verbose is not set.
+    return verbose.get() && verbose_roofline.get();
+}
+
+static double get_peak(setting_t<double> &peak, const char *name) {
+    if (!peak.initialized()) {
+        const int len = 32;
+        char val[len] = {0};
+        peak.set(getenv(name, val, len) > 0 ? nstl::max(0., atof(val)) : 0.);
+    }
+    return peak.get();
+}
+
+static setting_t<double> peak_gflops {0.};
+double get_peak_gflops() {
+    return get_peak(peak_gflops, "DNNL_PEAK_GFLOPS");
+}
+
+static setting_t<double> peak_bandwidth {0.};
+double get_peak_bandwidth() {
+    return get_peak(peak_bandwidth, "DNNL_PEAK_BANDWIDTH");
+}
+
 double get_msec() {
 #ifdef _WIN32
     static LARGE_INTEGER frequency;
@@ -900,6 +935,7 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             CASE(deconvolution);
             CASE(eltwise);
             CASE(inner_product);
+            case primitive_kind::layer_normalization_v2:
             CASE(layer_normalization);
             CASE(lrn);
             CASE(logsoftmax);
@@ -930,7 +966,7 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
 
 dnnl_status_t dnnl_set_verbose(int level) {
     using namespace dnnl::impl::status;
-    if (level < 0 || level > 2) return invalid_arguments;
+    if (level < 0 || level > 3) return invalid_arguments;
     dnnl::impl::verbose.set(level);
     return success;
 }
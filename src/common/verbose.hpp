@@ -17,6 +17,7 @@
 #ifndef COMMON_VERBOSE_HPP
 #define COMMON_VERBOSE_HPP
 
+#include <atomic>
 #include <cinttypes>
 #include <mutex>
 #include <stdio.h>
@@ -35,6 +36,11 @@ struct verbose_t {
 
 int get_verbose();
 bool get_verbose_timestamp();
+bool get_verbose_roofline();
+// Peak performance of the system in GFLOPS and in GB/s the roofline
+// efficiency is computed against, 0 if not set
+double get_peak_gflops();
+double get_peak_bandwidth();
 double get_msec();
 
 /// A container for primitive desc verbose string.
@@ -42,16 +48,24 @@ struct primitive_desc_t;
 struct pd_info_t {
     pd_info_t() = default;
     pd_info_t(const pd_info_t &rhs)
-        : str_(rhs.str_), is_initialized_(rhs.is_initialized_) {}
+        : str_(rhs.str_)
+        , is_initialized_(rhs.is_initialized_)
+        , trace_id_(rhs.trace_id_.load()) {}
     pd_info_t &operator=(const pd_info_t &rhs) {
         is_initialized_ = rhs.is_initialized_;
         str_ = rhs.str_;
+        trace_id_ = rhs.trace_id_.load();
         return *this;
     }
 
     const char *c_str() const { return str_.c_str(); }
     bool is_initialized() const { return is_initialized_; }
 
+    // Identifier of the primitive in the execution trace, -1 if the primitive
+    // is not registered in the trace yet
+    int trace_id() const { return trace_id_.load(std::memory_order_relaxed); }
+    void set_trace_id(int id) { trace_id_ = id; }
+
     void init(engine_t *engine, const primitive_desc_t *pd);
 
 private:
@@ -68,6 +82,8 @@ private:
     // is always reset. To avoid re-initialization we use an extra
     // `is_initialized_` flag, that should be checked before calling `init()`.
     std::once_flag initialization_flag_;
+
+    std::atomic<int> trace_id_ {-1};
 };
 
 } // namespace impl
@@ -0,0 +1,114 @@
+/*******************************************************************************
+* Copyright 2021 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "cpu/aarch64/gemm/f32/jit_sve_512_kernel_sgemm_kern.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+using namespace Xbyak_aarch64;
+
+namespace {
+// Prefetch distances are given in k-steps of the packed panels.
+constexpr int prefetch_dist_a = 8;
+constexpr int prefetch_dist_b = 16;
+} // namespace
+
+void jit_sve_512_kernel_sgemm_kern::compute_k_step() {
+    for (int i_m = 0; i_m < unroll_m_reg; i_m++)
+        ldr(ZReg(zreg_a(i_m).getIdx()), ptr(reg_ao_, i_m, MUL_VL));
+
+    for (int i_n = 0; i_n < unroll_n; i_n++) {
+        ld1rw(zreg_b(i_n), P_ALL_ONE / T_z, ptr(reg_bo_, i_n * elt_size_));
+        for (int i_m = 0; i_m < unroll_m_reg; i_m++)
+            fmla(zreg_acc(i_m, i_n), P_ALL_ONE / T_m, zreg_a(i_m),
+                    zreg_b(i_n));
+    }
+
+    prfm(PLDL1KEEP,
+            ptr(reg_ao_,
+                    static_cast<uint32_t>(
+                            prefetch_dist_a * unroll_m * elt_size_)));
+    prfm(PLDL1KEEP,
+            ptr(reg_bo_,
+                    static_cast<uint32_t>(
+                            prefetch_dist_b * unroll_n * elt_size_)));
+
+    add(reg_ao_, reg_ao_, unroll_m * elt_size_);
+    add(reg_bo_, reg_bo_, unroll_n * elt_size_);
+}
+
+void jit_sve_512_kernel_sgemm_kern::store_column(int i_n) {
+    for (int i_m = 0; i_m < unroll_m_reg; i_m++) {
+        if (!beta_zero_) {
+            ld1w(zreg_a(i_m), preg_m(i_m) / T_z, ptr(reg_co_, i_m, MUL_VL));
+            fadd(zreg_acc(i_m, i_n), zreg_acc(i_m, i_n), zreg_a(i_m));
+        }
+        st1w(zreg_acc(i_m, i_n), preg_m(i_m), ptr(reg_co_, i_m, MUL_VL));
+    }
+}
+
+void jit_sve_512_kernel_sgemm_kern::generate() {
+    const int simd_w = cpu_isa_traits<sve_512>::vlen / elt_size_;
+
+    preamble();
+
+    // Rows beyond m are masked out on load/store of C; packed A is padded
+    // with zeros so the compute part always works on full vectors.
+    for (int i_m = 0; i_m < unroll_m_reg; i_m++) {
+        mov_imm(reg_tmp_, i_m * simd_w);
+        whilelt(PRegS(preg_m(i_m).getIdx()), reg_tmp_, reg_m_);
+    }
+
+    for (int i_n = 0; i_n < unroll_n; i_n++)
+        for (int i_m = 0; i_m < unroll_m_reg; i_m++)
+            dup(zreg_acc(i_m, i_n), 0);
+
+    mov(reg_ao_, reg_a_);
+    mov(reg_bo_, reg_b_);
+    mov(reg_kk_, reg_k_);
+
+    Label l_k_loop;
+    L_aligned(l_k_loop);
+    {
+        compute_k_step();
+        subs(reg_kk_, reg_kk_, 1);
+        b(GT, l_k_loop);
+    }
+
+    lsl(reg_ldc_, reg_ldc_, 2);
+    mov(reg_co_, reg_c_);
+
+    Label l_done;
+    for (int i_n = 0; i_n < unroll_n; i_n++) {
+        if (i_n > 0) {
+            cmp(reg_n_, i_n);
+            b(LE, l_done);
+        }
+        store_column(i_n);
+        if (i_n < unroll_n - 1) add(reg_co_, reg_co_, reg_ldc_);
+    }
+    L(l_done);
+
+    postamble();
+}
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,408 @@
+/*******************************************************************************
+* Copyright 2021 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <memory>
+#include <mutex>
+
+#include "oneapi/dnnl/dnnl_types.h"
+
+#include "common/dnnl_thread.hpp"
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/platform.hpp"
+
+#include "cpu/gemm/f32/gemm_utils_f32.hpp"
+#include "cpu/gemm/gemm_msan_unpoison.hpp"
+#include "cpu/gemm/s8x8s32/blocked_gemm_s8x8s32.hpp"
+
+#include "cpu/aarch64/gemm/f32/jit_sve_512_kernel_sgemm_kern.hpp"
+#include "cpu/aarch64/gemm/gemm_driver.hpp"
+#include "cpu/aarch64/gemm/s8x8s32/jit_sve_512_kernel_gemm_s8s8s32_kern.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+using namespace dnnl::impl::utils;
+using namespace gemm_utils;
+
+namespace {
+
+using sgemm_kern_t = jit_sve_512_kernel_sgemm_kern;
+
+// Cache blocking of the packed panels: a (bm x bk) block of A is kept in L1/L2
+// while the micro-kernel sweeps over a (bk x bn) block of B.
+constexpr dim_t sgemm_bm = 4 * sgemm_kern_t::unroll_m;
+constexpr dim_t sgemm_bn = 48 * sgemm_kern_t::unroll_n;
+constexpr dim_t sgemm_bk = 256;
+
+const sgemm_kern_t *get_sgemm_kern(bool beta_zero) {
+    static std::unique_ptr<sgemm_kern_t> kernels[2];
+    static status_t st = status::success;
+    static std::once_flag initialized;
+
+    std::call_once(initialized, [&] {
+        for (bool b0 : {false, true}) {
+            kernels[b0].reset(new sgemm_kern_t(b0));
+            status_t ker_st = kernels[b0]->create_kernel();
+            if (ker_st != status::success) st = ker_st;
+        }
+    });
+
+    return st == status::success ? kernels[beta_zero].get() : nullptr;
+}
+
+// Packs an (m x k) block of op(A) scaled by alpha into panels of unroll_m
+// rows. Each panel is stored k-major and padded with zeros up to unroll_m.
+void copy_a(bool trans, dim_t m, dim_t k, const float *a, dim_t lda,
+        float alpha, float *ws) {
+    constexpr dim_t um = sgemm_kern_t::unroll_m;
+    for (dim_t i0 = 0; i0 < m; i0 += um) {
+        const dim_t mu = nstl::min(um, m - i0);
+        for (dim_t kk = 0; kk < k; kk++) {
+            if (trans) {
+                const float *a_k = a + i0 * lda + kk;
+                for (dim_t i = 0; i < mu; i++)
+                    ws[i] = alpha * a_k[i * lda];
+            } else {
+                const float *a_k = a + i0 + kk * lda;
+                PRAGMA_OMP_SIMD()
+                for (dim_t i = 0; i < mu; i++)
+                    ws[i] = alpha * a_k[i];
+            }
+            for (dim_t i = mu; i < um; i++)
+                ws[i] = 0.f;
+            ws += um;
+        }
+    }
+}
+
+// Packs a (k x n) block of op(B) into panels of unroll_n columns. Each panel
+// is stored k-major and padded with zeros up to unroll_n.
+void copy_b(bool trans, dim_t k, dim_t n, const float *b, dim_t ldb,
+        float *ws) {
+    constexpr dim_t un = sgemm_kern_t::unroll_n;
+    for (dim_t j0 = 0; j0 < n; j0 += un) {
+        const dim_t nu = nstl::min(un, n - j0);
+        for (dim_t kk = 0; kk < k; kk++) {
+            if (trans) {
+                const float *b_k = b + j0 + kk * ldb;
+                for (dim_t j = 0; j < nu; j++)
+                    ws[j] = b_k[j];
+            } else {
+                const float *b_k = b + j0 * ldb + kk;
+                for (dim_t j = 0; j < nu; j++)
+                    ws[j] = b_k[j * ldb];
+            }
+            for (dim_t j = nu; j < un; j++)
+                ws[j] = 0.f;
+            ws += un;
+        }
+    }
+}
+
+// C <- beta * C + bias, used before accumulating the K-blocks into C.
+void prepare_c(dim_t m, dim_t n, float beta, const float *bias, float *c,
+        dim_t ldc) {
+    for (dim_t j = 0; j < n; j++) {
+        float *c_j = c + j * ldc;
+        if (beta == 0.f) {
+            PRAGMA_OMP_SIMD()
+            for (dim_t i = 0; i < m; i++)
+                c_j[i] = bias ? bias[i] : 0.f;
+        } else if (beta != 1.f || bias) {
+            PRAGMA_OMP_SIMD()
+            for (dim_t i = 0; i < m; i++)
+                c_j[i] = beta * c_j[i] + (bias ? bias[i] : 0.f);
+        }
+    }
+}
+
+// Single-threaded C = alpha * op(A) * op(B) + beta * C (+ bias).
+void sgemm_ithr(bool trans_a, bool trans_b, dim_t m, dim_t n, dim_t k,
+        float alpha, const float *a, dim_t lda, const float *b, dim_t ldb,
+        float beta, const float *bias, float *c, dim_t ldc, float *ws_a,
+        float *ws_b) {
+    if (m <= 0 || n <= 0) return;
+
+    const bool beta_zero = beta == 0.f && bias == nullptr;
+    if (k <= 0 || alpha == 0.f || !beta_zero)
+        prepare_c(m, n, beta, bias, c, ldc);
+    if (k <= 0 || alpha == 0.f) return;
+
+    for (dim_t k0 = 0; k0 < k; k0 += sgemm_bk) {
+        const dim_t kb = nstl::min(sgemm_bk, k - k0);
+        const sgemm_kern_t &ker = *get_sgemm_kern(beta_zero && k0 == 0);
+
+        for (dim_t n0 = 0; n0 < n; n0 += sgemm_bn) {
+            const dim_t nb = nstl::min(sgemm_bn, n - n0);
+            const float *b_blk
+                    = trans_b ? b + n0 + k0 * ldb : b + k0 + n0 * ldb;
+            copy_b(trans_b, kb, nb, b_blk, ldb, ws_b);
+
+            for (dim_t m0 = 0; m0 < m; m0 += sgemm_bm) {
+                const dim_t mb = nstl::min(sgemm_bm, m - m0);
+                const float *a_blk
+                        = trans_a ? a + k0 + m0 * lda : a + m0 + k0 * lda;
+                copy_a(trans_a, mb, kb, a_blk, lda, alpha, ws_a);
+
+                for (dim_t j = 0; j < nb; j += sgemm_kern_t::unroll_n) {
+                    const dim_t nu = nstl::min<dim_t>(
+                            sgemm_kern_t::unroll_n, nb - j);
+                    for (dim_t i = 0; i < mb; i += sgemm_kern_t::unroll_m) {
+                        const dim_t mu = nstl::min<dim_t>(
+                                sgemm_kern_t::unroll_m, mb - i);
+                        ker(mu, nu, kb, (const float *)(ws_a + i * kb),
+                                (const float *)(ws_b + j * kb),
+                                c + (m0 + i) + (n0 + j) * ldc, ldc);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Splits the problem between threads along M, N and, if the threading
+// runtime allows synchronization, K. M blocks are rounded to the vector
+// length so that only the last block of each thread has masked rows.
+void partition_sgemm(dim_t m, dim_t n, dim_t k, int nthr, int &nthr_m,
+        int &nthr_n, int &nthr_k, dim_t &MB, dim_t &NB, dim_t &KB) {
+    constexpr dim_t simd_w = cpu_isa_traits<sve_512>::vlen / sizeof(float);
+
+    calc_nthr_nocopy_avx512_common(
+            m, n, k, nthr, &nthr_m, &nthr_n, &nthr_k, &MB, &NB, &KB);
+
+    MB = rnd_up(nstl::max<dim_t>(MB, 1), simd_w);
+    NB = nstl::max<dim_t>(NB, 1);
+    KB = nstl::max<dim_t>(KB, 1);
+    nthr_m = (int)div_up(m, MB);
+    nthr_n = (int)div_up(n, NB);
+    nthr_k = k > 0 ? (int)div_up(k, KB) : 1;
+    assert(IMPLICATION(!dnnl_thr_syncable(), nthr_k == 1));
+}
+
+dnnl_status_t sgemm_driver(const char *transa, const char *transb,
+        const dim_t *M_, const dim_t *N_, const dim_t *K_, const float *alpha_,
+        const float *A, const dim_t *lda_, const float *B, const dim_t *ldb_,
+        const float *beta_, float *C, const dim_t *ldc_, const float *bias) {
+    if (!(utils::one_of(*transa, 'n', 'N', 't', 'T')
+                && utils::one_of(*transb, 'n', 'N', 't', 'T')))
+        return dnnl_unimplemented;
+
+    const bool trans_a = utils::one_of(*transa, 't', 'T');
+    const bool trans_b = utils::one_of(*transb, 't', 'T');
+    const dim_t M = *M_, N = *N_, K = *K_;
+    const dim_t lda = *lda_, ldb = *ldb_, ldc = *ldc_;
+    const float alpha = *alpha_, beta = *beta_;
+
+    if (utils::one_of(0, M, N)) return dnnl_success;
+
+    if (get_sgemm_kern(false) == nullptr) return dnnl_runtime_error;
+
+    int nthr_m, nthr_n, nthr_k;
+    dim_t MB, NB, KB;
+    partition_sgemm(M, N, K, dnnl_get_current_num_threads(), nthr_m, nthr_n,
+            nthr_k, MB, NB, KB);
+
+    const int nthr_mn = nthr_m * nthr_n;
+    const int nthr = nthr_mn * nthr_k;
+
+    const size_t ws_a_elems = sgemm_bm * sgemm_bk;
+    const size_t ws_b_elems = sgemm_bk * sgemm_bn;
+    const size_t ws_elems_per_thr
+            = rnd_up(ws_a_elems + ws_b_elems, PAGE_4K / sizeof(float));
+    float *ws_buffers = (float *)malloc(
+            sizeof(float) * ws_elems_per_thr * nthr, PAGE_4K);
+    if (!ws_buffers) return dnnl_out_of_memory;
+
+    // Threads working on the K-blocks other than the first accumulate their
+    // partial results into private buffers which are reduced afterwards.
+    float *c_buffers = nullptr;
+    if (nthr_k > 1) {
+        c_buffers = (float *)malloc(
+                sizeof(float) * nthr_mn * (nthr_k - 1) * MB * NB, PAGE_4K);
+        if (!c_buffers) {
+            free(ws_buffers);
+            return dnnl_out_of_memory;
+        }
+    }
+
+    auto get_thr_block = [](dim_t &from, dim_t &size, dim_t blk, dim_t total,
+                                 int ithr) {
+        from = nstl::min(blk * ithr, total);
+        size = nstl::min(blk, total - from);
+    };
+
+    parallel(nthr, [&](int ithr, int nthr_) {
+        assert(nthr == nthr_);
+        MAYBE_UNUSED(nthr_);
+
+        const int ithr_mn = ithr % nthr_mn;
+        const int ithr_m = ithr_mn % nthr_m;
+        const int ithr_n = ithr_mn / nthr_m;
+        const int ithr_k = ithr / nthr_mn;
+
+        dim_t m_from, my_m, n_from, my_n, k_from, my_k;
+        get_thr_block(m_from, my_m, MB, M, ithr_m);
+        get_thr_block(n_from, my_n, NB, N, ithr_n);
+        get_thr_block(k_from, my_k, KB, K, ithr_k);
+        if (my_m <= 0 || my_n <= 0) return;
+
+        float *ws_a = ws_buffers + ithr * ws_elems_per_thr;
+        float *ws_b = ws_a + ws_a_elems;
+
+        const float *my_a = trans_a ? A + k_from + m_from * lda
+                                    : A + m_from + k_from * lda;
+        const float *my_b = trans_b ? B + n_from + k_from * ldb
+                                    : B + k_from + n_from * ldb;
+
+        if (ithr_k == 0) {
+            sgemm_ithr(trans_a, trans_b, my_m, my_n, my_k, alpha, my_a, lda,
+                    my_b, ldb, beta, bias ? bias + m_from : nullptr,
+                    C + m_from + n_from * ldc, ldc, ws_a, ws_b);
+        } else {
+            float *my_c = c_buffers
+                    + MB * NB * (ithr_mn * (nthr_k - 1) + ithr_k - 1);
+            sgemm_ithr(trans_a, trans_b, my_m, my_n, my_k, alpha, my_a, lda,
+                    my_b, ldb, 0.f, nullptr, my_c, MB, ws_a, ws_b);
+        }
+    });
+
+    if (nthr_k > 1) {
+        parallel(nthr, [&](int ithr, int nthr_) {
+            assert(nthr == nthr_);
+            MAYBE_UNUSED(nthr_);
+
+            const int ithr_mn = ithr % nthr_mn;
+            const int ithr_m = ithr_mn % nthr_m;
+            const int ithr_n = ithr_mn / nthr_m;
+            const int ithr_k = ithr / nthr_mn;
+
+            dim_t m_from, my_m, n_from, my_n;
+            get_thr_block(m_from, my_m, MB, M, ithr_m);
+            get_thr_block(n_from, my_n, NB, N, ithr_n);
+            if (my_m <= 0 || my_n <= 0) return;
+
+            // Every thread of a K-group reduces its own slice of columns.
+            dim_t offset = 0, block = 0;
+            partition_unit_diff(ithr_k, nthr_k, my_n, &offset, &block);
+            for (int ik = 1; ik < nthr_k; ik++) {
+                float *my_c = c_buffers
+                        + MB
+                                * (NB * (ithr_mn * (nthr_k - 1) + ik - 1)
+                                        + offset);
+                sum_two_matrices(my_m, block, my_c, MB,
+                        C + m_from + (n_from + offset) * ldc, ldc);
+            }
+        });
+    }
+
+    free(c_buffers);
+    free(ws_buffers);
+
+    msan_unpoison_matrix(C, M, N, ldc, sizeof(*C));
+
+    return dnnl_success;
+}
+
+using igemm_kern_t = jit_sve_512_kernel_gemm_s8s8s32_kern;
+
+const gemm_s8x8s32_ukernel_t *get_igemm_ukernel() {
+    static std::unique_ptr<igemm_kern_t> kernels[2];
+    static gemm_s8x8s32_ukernel_t ukernel;
+    static status_t st = status::success;
+    static std::once_flag initialized;
+
+    std::call_once(initialized, [&] {
+        for (bool b0 : {false, true}) {
+            kernels[b0].reset(new igemm_kern_t(b0));
+            status_t ker_st = kernels[b0]->create_kernel();
+            if (ker_st != status::success) st = ker_st;
+        }
+        if (st != status::success) return;
+
+        ukernel.unroll_m = igemm_kern_t::unroll_m;
+        ukernel.unroll_n = igemm_kern_t::unroll_n;
+        using func_t = gemm_s8x8s32_ukernel_t::func_t;
+        ukernel.ker_beta0 = (func_t)kernels[true]->jit_ker();
+        ukernel.ker_beta1 = (func_t)kernels[false]->jit_ker();
+    });
+
+    return st == status::success ? &ukernel : nullptr;
+}
+
+template <typename b_dt>
+dnnl_status_t igemm_driver(const char *transa, const char *transb,
+        const char *offsetc, const dim_t *M, const dim_t *N, const dim_t *K,
+        const float *alpha, const int8_t *A, const dim_t *lda, const int8_t *ao,
+        const b_dt *B, const dim_t *ldb, const b_dt *bo, const float *beta,
+        int32_t *C, const dim_t *ldc, const int32_t *co) {
+    const gemm_s8x8s32_ukernel_t *ukernel = get_igemm_ukernel();
+    if (ukernel == nullptr) return dnnl_runtime_error;
+
+    return blocked_gemm_s8x8s32(*ukernel, transa, transb, offsetc, M, N, K,
+            alpha, A, lda, ao, B, ldb, bo, beta, C, ldc, co);
+}
+
+} // namespace
+
+template <>
+dnnl_status_t gemm_driver<float, float, float>(const char *transA,
+        const char *transB, const char *offsetC, const dim_t *m,
+        const dim_t *n, const dim_t *k, const float *alpha, const float *a,
+        const dim_t *lda, const float *oa, const float *b, const dim_t *ldb,
+        const float *ob, const float *beta, float *c, const dim_t *ldc,
+        const float *oc, const bool force_jit_nocopy_gemm) {
+    MAYBE_UNUSED(oa);
+    MAYBE_UNUSED(ob);
+    MAYBE_UNUSED(force_jit_nocopy_gemm);
+
+    const float *bias
+            = (offsetC && utils::one_of(*offsetC, 'C', 'c')) ? oc : nullptr;
+    return sgemm_driver(transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c,
+            ldc, bias);
+}
+
+template <>
+dnnl_status_t gemm_driver<int8_t, uint8_t, int32_t>(const char *transA,
+        const char *transB, const char *offsetC, const dim_t *m,
+        const dim_t *n, const dim_t *k, const float *alpha, const int8_t *a,
+        const dim_t *lda, const int8_t *oa, const uint8_t *b, const dim_t *ldb,
+        const uint8_t *ob, const float *beta, int32_t *c, const dim_t *ldc,
+        const int32_t *oc, const bool force_jit_nocopy_gemm) {
+    MAYBE_UNUSED(force_jit_nocopy_gemm);
+    return igemm_driver(transA, transB, offsetC, m, n, k, alpha, a, lda, oa, b,
+            ldb, ob, beta, c, ldc, oc);
+}
+
+template <>
+dnnl_status_t gemm_driver<int8_t, int8_t, int32_t>(const char *transA,
+        const char *transB, const char *offsetC, const dim_t *m,
+        const dim_t *n, const dim_t *k, const float *alpha, const int8_t *a,
+        const dim_t *lda, const int8_t *oa, const int8_t *b, const dim_t *ldb,
+        const int8_t *ob, const float *beta, int32_t *c, const dim_t *ldc,
+        const int32_t *oc, const bool force_jit_nocopy_gemm) {
+    MAYBE_UNUSED(force_jit_nocopy_gemm);
+    return igemm_driver(transA, transB, offsetC, m, n, k, alpha, a, lda, oa, b,
+            ldb, ob, beta, c, ldc, oc);
+}
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,71 @@
+/*******************************************************************************
+* Copyright 2021 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_GEMM_GEMM_DRIVER_HPP
+#define CPU_AARCH64_GEMM_GEMM_DRIVER_HPP
+
+#include <cstdint>
+
+#include "oneapi/dnnl/dnnl_types.h"
+
+#include "common/c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+// Follows the x64 gemm_driver() interface. For f32, `oc` is the bias applied
+// to the rows of C when offsetC is 'C', and oa/ob are ignored. For int8, the
+// offsets have the gemm_s8x8s32() semantics.
+template <typename a_type, typename b_type, typename c_type>
+dnnl_status_t gemm_driver(const char *transA, const char *transB,
+        const char *offsetC, const dim_t *m, const dim_t *n, const dim_t *k,
+        const float *alpha, const a_type *a, const dim_t *lda, const a_type *oa,
+        const b_type *b, const dim_t *ldb, const b_type *ob, const float *beta,
+        c_type *c, const dim_t *ldc, const c_type *oc,
+        const bool force_jit_nocopy_gemm);
+
+template <>
+dnnl_status_t gemm_driver<float, float, float>(const char *transA,
+        const char *transB, const char *offsetC, const dim_t *m,
+        const dim_t *n, const dim_t *k, const float *alpha, const float *a,
+        const dim_t *lda, const float *oa, const float *b, const dim_t *ldb,
+        const float *ob, const float *beta, float *c, const dim_t *ldc,
+        const float *oc, const bool force_jit_nocopy_gemm);
+
+template <>
+dnnl_status_t gemm_driver<int8_t, uint8_t, int32_t>(const char *transA,
+        const char *transB, const char *offsetC, const dim_t *m,
+        const dim_t *n, const dim_t *k, const float *alpha, const int8_t *a,
+        const dim_t *lda, const int8_t *oa, const uint8_t *b, const dim_t *ldb,
+        const uint8_t *ob, const float *beta, int32_t *c, const dim_t *ldc,
+        const int32_t *oc, const bool force_jit_nocopy_gemm);
+
+template <>
+dnnl_status_t gemm_driver<int8_t, int8_t, int32_t>(const char *transA,
+        const char *transB, const char *offsetC, const dim_t *m,
+        const dim_t *n, const dim_t *k, const float *alpha, const int8_t *a,
+        const dim_t *lda, const int8_t *oa, const int8_t *b, const dim_t *ldb,
+        const int8_t *ob, const float *beta, int32_t *c, const dim_t *ldc,
+        const int32_t *oc, const bool force_jit_nocopy_gemm);
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif // CPU_AARCH64_GEMM_GEMM_DRIVER_HPP
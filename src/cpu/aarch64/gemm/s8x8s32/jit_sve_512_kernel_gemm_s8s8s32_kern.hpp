@@ -0,0 +1,96 @@
+/*******************************************************************************
+* Copyright 2021 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_GEMM_S8X8S32_JIT_SVE_512_KERNEL_GEMM_S8S8S32_KERN_HPP
+#define CPU_AARCH64_GEMM_S8X8S32_JIT_SVE_512_KERNEL_GEMM_S8S8S32_KERN_HPP
+
+#include "cpu/aarch64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+// sdot based micro-kernel for blocked_gemm_s8x8s32() computing
+// C[m x n] (+)= A_packed[m x k] * B_packed[k x n] with s32 accumulation.
+//
+// Every s32 lane of a vector holds one row of C, the 4 bytes feeding it are
+// 4 consecutive k-elements of the packed A panel ([k / 4][unroll_m][4]). The
+// 4 bytes of a packed B column ([k / 4][unroll_n][4]) are broadcast to all
+// lanes, so one sdot updates unroll_m / 3 rows of a column for 4 k-elements.
+//
+// Call: ker(m, n, k, a, b, c, ldc) with k a multiple of 4 and ldc given in
+// elements.
+class jit_sve_512_kernel_gemm_s8s8s32_kern : public jit_generator {
+public:
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_512_kernel_gemm_s8s8s32_kern);
+
+    static constexpr int unroll_m_reg = 3;
+    static constexpr int unroll_m
+            = unroll_m_reg * cpu_isa_traits<sve_512>::vlen / sizeof(int32_t);
+    static constexpr int unroll_n = 8;
+
+    jit_sve_512_kernel_gemm_s8s8s32_kern(bool beta_zero)
+        : jit_generator(nullptr, 64 * 1024), beta_zero_(beta_zero) {}
+
+protected:
+    void generate() override;
+
+private:
+    const bool beta_zero_;
+
+    static constexpr int k_group_ = 4;
+    static constexpr int n_bcast_regs_ = 5;
+
+    const Xbyak_aarch64::XReg reg_m_ = abi_param1;
+    const Xbyak_aarch64::XReg reg_n_ = abi_param2;
+    const Xbyak_aarch64::XReg reg_k_ = abi_param3;
+    const Xbyak_aarch64::XReg reg_a_ = abi_param4;
+    const Xbyak_aarch64::XReg reg_b_ = abi_param5;
+    const Xbyak_aarch64::XReg reg_c_ = abi_param6;
+    const Xbyak_aarch64::XReg reg_ldc_ = abi_param7;
+
+    const Xbyak_aarch64::XReg reg_ao_ = x8;
+    const Xbyak_aarch64::XReg reg_bo_ = x9;
+    const Xbyak_aarch64::XReg reg_kk_ = x10;
+    const Xbyak_aarch64::XReg reg_co_ = x11;
+    const Xbyak_aarch64::XReg reg_tmp_ = x12;
+
+    Xbyak_aarch64::ZRegS zreg_acc(int i_m, int i_n) const {
+        return Xbyak_aarch64::ZRegS(i_m + i_n * unroll_m_reg);
+    }
+    Xbyak_aarch64::ZRegB zreg_a(int i_m) const {
+        return Xbyak_aarch64::ZRegB(unroll_m_reg * unroll_n + i_m);
+    }
+    Xbyak_aarch64::ZRegS zreg_b(int i_n) const {
+        return Xbyak_aarch64::ZRegS(
+                unroll_m_reg * (unroll_n + 1) + i_n % n_bcast_regs_);
+    }
+    // Row masks for the (possibly partial) vectors of the m dimension.
+    Xbyak_aarch64::PReg preg_m(int i_m) const {
+        return Xbyak_aarch64::PReg(1 + i_m);
+    }
+
+    void compute_k_step();
+    void store_column(int i_n);
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif // CPU_AARCH64_GEMM_S8X8S32_JIT_SVE_512_KERNEL_GEMM_S8S8S32_KERN_HPP
@@ -0,0 +1,452 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+
+#include "common/math_utils.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/aarch64/injectors/jit_uni_binary_injector.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+namespace binary_injector {
+
+using namespace Xbyak_aarch64;
+
+static bcast_set_t get_all_strategies_supported_by_injector() {
+    return bcast_set_t {broadcasting_strategy_t::scalar,
+            broadcasting_strategy_t::per_oc,
+            broadcasting_strategy_t::per_oc_spatial,
+            broadcasting_strategy_t::no_broadcast};
+}
+
+bool is_data_supported(cpu_isa_t isa, data_type_t data_type) {
+    using namespace data_type;
+    return utils::one_of(isa, sve_512)
+            && utils::one_of(data_type, f32, bf16, s32, s8, u8);
+}
+
+static bool src1_desc_layout_same_as_dst_d(
+        const dnnl::impl::memory_desc_t &src1_desc,
+        const memory_desc_wrapper &dst_d) {
+    if (dst_d.md_ == nullptr) return false;
+    const auto &lhs = src1_desc;
+    const auto &rhs = *(dst_d.md_);
+
+    using namespace dnnl::impl::utils;
+    return lhs.ndims == rhs.ndims
+            && (lhs.format_kind == rhs.format_kind
+                    || one_of(
+                            format_kind::any, lhs.format_kind, rhs.format_kind))
+            && array_cmp(lhs.dims, rhs.dims, lhs.ndims)
+            && array_cmp(lhs.padded_dims, rhs.padded_dims, lhs.ndims)
+            && array_cmp(lhs.padded_offsets, rhs.padded_offsets, lhs.ndims)
+            && lhs.offset0 == rhs.offset0;
+}
+
+bool is_bcast_supported(const dnnl::impl::memory_desc_t &src1_desc,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set) {
+    const auto bcast_type = get_rhs_arg_broadcasting_strategy(
+            src1_desc, dst_d, supported_strategy_set);
+
+    if (bcast_type == broadcasting_strategy_t::no_broadcast) {
+        // in case of no broadcast data layout of dst and src1 have to be the
+        // same
+        if (!src1_desc_layout_same_as_dst_d(src1_desc, dst_d)) return false;
+    }
+
+    return bcast_type != broadcasting_strategy_t::unsupported;
+}
+
+bool is_supported(cpu_isa_t isa, const dnnl::impl::memory_desc_t &src1_desc,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set) {
+    return is_data_supported(isa, src1_desc.data_type)
+            && is_bcast_supported(src1_desc, dst_d, supported_strategy_set);
+}
+
+bool binary_args_broadcast_supported(const post_ops_t &post_ops,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set) {
+
+    return std::none_of(post_ops.entry_.cbegin(), post_ops.entry_.cend(),
+            [&](const post_ops_t::entry_t &entry) -> bool {
+                if (entry.is_binary()) {
+                    const auto bcast_type = get_rhs_arg_broadcasting_strategy(
+                            entry.binary.src1_desc, dst_d,
+                            supported_strategy_set);
+                    return bcast_type == broadcasting_strategy_t::unsupported;
+                }
+                return false;
+            });
+}
+
+bool binary_args_tail_supported(const post_ops_t &post_ops,
+        const memory_desc_wrapper &dst_d, int vlen,
+        const bcast_set_t &supported_strategy_set) {
+    const auto channels = dst_d.dims()[1];
+    const int vmm_l_len = vlen / 4;
+
+    return std::none_of(post_ops.entry_.cbegin(), post_ops.entry_.cend(),
+            [&](const post_ops_t::entry_t &entry) -> bool {
+                if (entry.is_binary()) {
+                    const auto bcast_type = get_rhs_arg_broadcasting_strategy(
+                            entry.binary.src1_desc, dst_d,
+                            supported_strategy_set);
+                    return utils::one_of(bcast_type,
+                                   broadcasting_strategy_t::per_oc,
+                                   broadcasting_strategy_t::per_oc_spatial)
+                            && (channels % vmm_l_len != 0);
+                }
+                return false;
+            });
+}
+
+bool binary_args_matches_tag(format_tag_t tag, const post_ops_t &post_ops) {
+    return std::all_of(post_ops.entry_.cbegin(), post_ops.entry_.cend(),
+            [&](const post_ops_t::entry_t &entry) {
+                if (entry.is_binary()) {
+                    const memory_desc_wrapper rhs_arg_d(entry.binary.src1_desc);
+                    return rhs_arg_d.matches_tag(tag);
+                }
+                return true;
+            });
+}
+
+bool any_binary_postop_rhs_per_oc_broadcast(const post_ops_t &post_ops,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set) {
+    return std::any_of(post_ops.entry_.cbegin(), post_ops.entry_.cend(),
+            [&](const post_ops_t::entry_t &entry) -> bool {
+                if (entry.is_binary()) {
+                    const auto bcast_type = get_rhs_arg_broadcasting_strategy(
+                            entry.binary.src1_desc, dst_d,
+                            supported_strategy_set);
+                    return utils::one_of(bcast_type,
+                            broadcasting_strategy_t::per_oc,
+                            broadcasting_strategy_t::per_oc_spatial);
+                }
+                return false;
+            });
+}
+
+rhs_arg_static_params_t::rhs_arg_static_params_t(
+        std::size_t rhs_dt_helper_vmm_idx, const XReg &rhs_addr_reg,
+        const XReg &rhs_helper_reg, bool preserve_gpr_helpers,
+        bool preserve_vmm_helper, std::size_t abi_param_offset,
+        const memory_desc_wrapper &dst_d, std::size_t tail_size,
+        const PReg &tail_opmask, bool use_exact_tail_scalar_bcast)
+    : rhs_dt_helper_vmm_idx(rhs_dt_helper_vmm_idx)
+    , rhs_addr_reg(rhs_addr_reg)
+    , rhs_helper_reg(rhs_helper_reg)
+    , preserve_gpr_helpers(preserve_gpr_helpers)
+    , preserve_vmm_helper(preserve_vmm_helper)
+    , abi_param_offset(abi_param_offset)
+    , dst_d(dst_d)
+    , tail_size(tail_size)
+    , tail_opmask(tail_opmask)
+    , use_exact_tail_scalar_bcast(use_exact_tail_scalar_bcast) {}
+
+static_params_t::static_params_t(const XReg &param1,
+        const bcast_set_t &supported_strategy_set,
+        const rhs_arg_static_params_t &rhs_arg_static_params)
+    : param1(param1)
+    , supported_strategy_set(supported_strategy_set)
+    , rhs_arg_static_params(rhs_arg_static_params) {}
+
+static_params_t::static_params_t(const XReg &param1,
+        const rhs_arg_static_params_t &rhs_arg_static_params)
+    : static_params_t(param1, get_all_strategies_supported_by_injector(),
+            rhs_arg_static_params) {}
+
+template <cpu_isa_t isa>
+jit_uni_binary_injector_t<isa>::jit_uni_binary_injector_t(
+        jit_generator *host, const static_params_t &static_params)
+    : host_(host)
+    , rhs_arg_static_params_(static_params.rhs_arg_static_params)
+    , param1_(static_params.param1)
+    , supported_strategy_set_(static_params.supported_strategy_set) {}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::compute_vector_range(
+        const injector_utils::vmm_index_set_t &vmm_idxs,
+        std::size_t rhs_arg_idx, const dnnl_post_ops::entry_t &post_op,
+        const rhs_arg_dynamic_params_t &rhs_arg_params) const {
+    if (vmm_idxs.empty()) return;
+
+    const auto &rasp = rhs_arg_static_params_;
+    const auto rhs_broadcasting_strategy
+            = get_rhs_arg_broadcasting_strategy(post_op.binary.src1_desc,
+                    rasp.dst_d, supported_strategy_set_);
+
+    const int tmp_vmm_idx
+            = adjust_temp_vmm_hint(rasp.rhs_dt_helper_vmm_idx, vmm_idxs);
+    const TReg tmp_vmm(tmp_vmm_idx);
+    // the hint given by user is free to be clobbered unless asked otherwise
+    const bool preserve_vmm = rasp.preserve_vmm_helper
+            || tmp_vmm_idx != static_cast<int>(rasp.rhs_dt_helper_vmm_idx);
+
+    if (rasp.preserve_gpr_helpers) push_gpr_helpers();
+    if (preserve_vmm) push_vmm_helper(tmp_vmm);
+
+    // scalar rhs is the same for every vmm, so it is loaded only once
+    const bool is_scalar
+            = rhs_broadcasting_strategy == broadcasting_strategy_t::scalar;
+    if (is_scalar) {
+        const bool with_tail = rasp.tail_size
+                && rasp.use_exact_tail_scalar_bcast
+                && std::any_of(vmm_idxs.cbegin(), vmm_idxs.cend(),
+                        [&](size_t idx) {
+                            return rhs_arg_params.vmm_tail_idx_.count(idx);
+                        });
+        prepare_rhs_arg_addr(*vmm_idxs.cbegin(), rhs_arg_idx, post_op,
+                rhs_arg_params, rhs_broadcasting_strategy);
+        load_rhs(tmp_vmm, post_op.binary.src1_desc.data_type, true, with_tail);
+    }
+
+    for (const auto vmm_idx : vmm_idxs) {
+        if (!is_scalar) {
+            const bool with_tail = rasp.tail_size
+                    && rhs_arg_params.vmm_tail_idx_.count(vmm_idx);
+            prepare_rhs_arg_addr(vmm_idx, rhs_arg_idx, post_op, rhs_arg_params,
+                    rhs_broadcasting_strategy);
+            inject_binary(post_op, TReg(vmm_idx), tmp_vmm,
+                    rhs_broadcasting_strategy, with_tail);
+        } else
+            execute_binary(post_op.binary.alg, TReg(vmm_idx), tmp_vmm);
+    }
+
+    if (preserve_vmm) pop_vmm_helper(tmp_vmm);
+    if (rasp.preserve_gpr_helpers) pop_gpr_helpers();
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::compute_vector_range(size_t start_idx,
+        size_t end_idx, std::size_t rhs_arg_idx,
+        const dnnl_post_ops::entry_t &post_op,
+        const rhs_arg_dynamic_params_t &rhs_arg_params) const {
+    injector_utils::vmm_index_set_t vmm_idxs;
+    for (size_t i = start_idx; i < end_idx; i++)
+        vmm_idxs.emplace(i);
+    compute_vector_range(vmm_idxs, rhs_arg_idx, post_op, rhs_arg_params);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::compute_vector(size_t idx,
+        std::size_t rhs_arg_idx, const dnnl_post_ops::entry_t &post_op,
+        const rhs_arg_dynamic_params_t &rhs_arg_params) const {
+    compute_vector_range({idx}, rhs_arg_idx, post_op, rhs_arg_params);
+}
+
+template <cpu_isa_t isa>
+int jit_uni_binary_injector_t<isa>::adjust_temp_vmm_hint(int user_hint,
+        const injector_utils::vmm_index_set_t &vmm_idxs) const {
+    if (vmm_idxs.count(user_hint) == 0) return user_hint;
+
+    // allocate from the end, where kernels usually keep their helpers
+    for (int idx = vmm_count - 1; idx >= 0; --idx)
+        if (vmm_idxs.count(idx) == 0) return idx;
+
+    assert(!"no free vmm for binary injector");
+    return user_hint;
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::prepare_rhs_arg_addr(std::size_t vmm_idx,
+        std::size_t rhs_arg_idx, const dnnl_post_ops::entry_t &post_op,
+        const rhs_arg_dynamic_params_t &rhs_arg_params,
+        const broadcasting_strategy_t rhs_broadcasting_strategy) const {
+    const auto &rasp = rhs_arg_static_params_;
+    const auto &rhs_addr_reg = rasp.rhs_addr_reg;
+    const auto rhs_arg_elem_size
+            = types::data_type_size(post_op.binary.src1_desc.data_type);
+
+    host_->add_imm(
+            rhs_addr_reg, param1_, rasp.abi_param_offset, rasp.rhs_helper_reg);
+    host_->ldr(rhs_addr_reg, ptr(rhs_addr_reg));
+    host_->add_imm(rhs_addr_reg, rhs_addr_reg, rhs_arg_idx * sizeof(void *),
+            rasp.rhs_helper_reg);
+    host_->ldr(rhs_addr_reg, ptr(rhs_addr_reg));
+
+    switch (rhs_broadcasting_strategy) {
+        case broadcasting_strategy_t::scalar: break;
+        case broadcasting_strategy_t::no_broadcast:
+            append_offset(rhs_arg_params.vmm_idx_to_out_elem_off_addr,
+                    rhs_arg_params.vmm_idx_to_out_elem_off_val,
+                    rhs_arg_params.vmm_idx_to_out_off_oprnd, vmm_idx,
+                    rhs_arg_elem_size);
+            break;
+        case broadcasting_strategy_t::per_oc:
+        case broadcasting_strategy_t::per_oc_spatial:
+            append_offset(rhs_arg_params.vmm_idx_to_oc_elem_off_addr,
+                    rhs_arg_params.vmm_idx_to_oc_elem_off_val,
+                    rhs_arg_params.vmm_idx_to_oc_off_oprnd, vmm_idx,
+                    rhs_arg_elem_size);
+            break;
+        default: assert(!"Broadcasting type not supported");
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::append_offset(
+        const std::map<int, AdrImm> &addr_off,
+        const std::map<int, int> &val_off, const std::map<int, XReg> &oprnd_off,
+        int vmm_idx,
+        std::size_t elem_size_bytes) const {
+    const auto &addr_reg = rhs_arg_static_params_.rhs_addr_reg;
+    const auto &tmp_reg = rhs_arg_static_params_.rhs_helper_reg;
+    const auto shift = math::ilog2q(elem_size_bytes);
+
+    // offsets given in different forms for the same vmm are accumulated
+    const auto it_addr = addr_off.find(vmm_idx);
+    if (it_addr != addr_off.end()) {
+        host_->ldr(tmp_reg, it_addr->second);
+        host_->add(addr_reg, addr_reg, tmp_reg, LSL, shift);
+    }
+
+    const auto it_val = val_off.find(vmm_idx);
+    if (it_val != val_off.end() && it_val->second)
+        host_->add_imm(
+                addr_reg, addr_reg, it_val->second * elem_size_bytes, tmp_reg);
+
+    const auto it_oprnd = oprnd_off.find(vmm_idx);
+    if (it_oprnd != oprnd_off.end())
+        host_->add(addr_reg, addr_reg, it_oprnd->second, LSL, shift);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::inject_binary(
+        const dnnl_post_ops::entry_t &post_op, const TReg &dst,
+        const TReg &tmp, broadcasting_strategy_t rhs_broadcasting_strategy,
+        bool with_tail) const {
+    const bool bcast = rhs_broadcasting_strategy
+            == broadcasting_strategy_t::per_oc_spatial;
+    load_rhs(tmp, post_op.binary.src1_desc.data_type, bcast, with_tail);
+    execute_binary(post_op.binary.alg, dst, tmp);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::load_rhs(const TReg &tmp,
+        data_type_t data_type, bool bcast, bool with_tail) const {
+    const auto &rasp = rhs_arg_static_params_;
+    const auto &addr = rasp.rhs_addr_reg;
+    const PReg p = with_tail ? rasp.tail_opmask : host_->P_ALL_ONE;
+
+    switch (data_type) {
+        case data_type::f32:
+        case data_type::s32:
+            if (bcast)
+                host_->ld1rw(tmp.s, p / T_z, ptr(addr));
+            else
+                host_->ld1w(tmp.s, p / T_z, ptr(addr));
+            break;
+        case data_type::bf16:
+            if (bcast)
+                host_->ld1rh(tmp.s, p / T_z, ptr(addr));
+            else
+                host_->ld1h(tmp.s, p / T_z, ptr(addr));
+            host_->lsl(tmp.s, tmp.s, 16);
+            break;
+        case data_type::s8:
+            if (bcast)
+                host_->ld1rsb(tmp.s, p / T_z, ptr(addr));
+            else
+                host_->ld1sb(tmp.s, p / T_z, ptr(addr));
+            break;
+        case data_type::u8:
+            if (bcast)
+                host_->ld1rb(tmp.s, p / T_z, ptr(addr));
+            else
+                host_->ld1b(tmp.s, p / T_z, ptr(addr));
+            break;
+        default: assert(!"unsupported data type");
+    }
+
+    if (utils::one_of(data_type, data_type::s32, data_type::s8, data_type::u8))
+        host_->scvtf(tmp.s, host_->P_ALL_ONE / T_m, tmp.s);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::execute_binary(
+        alg_kind_t binary_alg, const TReg &dst, const TReg &rhs) const {
+    using namespace alg_kind;
+    const auto &p_all = host_->P_ALL_ONE;
+    const auto &p_cmp = host_->P_TMP;
+
+    switch (binary_alg) {
+        case binary_add: host_->fadd(dst.s, dst.s, rhs.s); break;
+        case binary_sub: host_->fsub(dst.s, dst.s, rhs.s); break;
+        case binary_mul: host_->fmul(dst.s, dst.s, rhs.s); break;
+        case binary_div: host_->fdiv(dst.s, p_all / T_m, rhs.s); break;
+        case binary_max: host_->fmax(dst.s, p_all / T_m, rhs.s); break;
+        case binary_min: host_->fmin(dst.s, p_all / T_m, rhs.s); break;
+        case binary_ge: host_->fcmge(p_cmp.s, p_all / T_z, dst.s, rhs.s); break;
+        case binary_gt: host_->fcmgt(p_cmp.s, p_all / T_z, dst.s, rhs.s); break;
+        case binary_le: host_->fcmge(p_cmp.s, p_all / T_z, rhs.s, dst.s); break;
+        case binary_lt: host_->fcmgt(p_cmp.s, p_all / T_z, rhs.s, dst.s); break;
+        case binary_eq: host_->fcmeq(p_cmp.s, p_all / T_z, dst.s, rhs.s); break;
+        case binary_ne: host_->fcmne(p_cmp.s, p_all / T_z, dst.s, rhs.s); break;
+        default: assert(!"not supported operation!");
+    }
+
+    if (utils::one_of(binary_alg, binary_ge, binary_gt, binary_le, binary_lt,
+                binary_eq, binary_ne)) {
+        host_->dup(dst.s, 0);
+        host_->fmov(dst.s, p_cmp / T_m, 1.0);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::push_gpr_helpers() const {
+    const auto &rasp = rhs_arg_static_params_;
+    host_->str(rasp.rhs_addr_reg, pre_ptr(host_->X_SP, -8));
+    host_->str(rasp.rhs_helper_reg, pre_ptr(host_->X_SP, -8));
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::pop_gpr_helpers() const {
+    const auto &rasp = rhs_arg_static_params_;
+    host_->ldr(rasp.rhs_helper_reg, post_ptr(host_->X_SP, 8));
+    host_->ldr(rasp.rhs_addr_reg, post_ptr(host_->X_SP, 8));
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::push_vmm_helper(const TReg &vmm) const {
+    host_->sub_imm(host_->X_SP, host_->X_SP, cpu_isa_traits<isa>::vlen,
+            host_->X_TMP_0);
+    host_->st1w(vmm.s, host_->P_ALL_ONE, ptr(host_->X_SP));
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_injector_t<isa>::pop_vmm_helper(const TReg &vmm) const {
+    host_->ld1w(vmm.s, host_->P_ALL_ONE / T_z, ptr(host_->X_SP));
+    host_->add_imm(host_->X_SP, host_->X_SP, cpu_isa_traits<isa>::vlen,
+            host_->X_TMP_0);
+}
+
+template class jit_uni_binary_injector_t<sve_512>;
+
+} // namespace binary_injector
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
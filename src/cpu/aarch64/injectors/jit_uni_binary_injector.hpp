@@ -0,0 +1,284 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_JIT_UNI_BINARY_INJECTOR_HPP
+#define CPU_AARCH64_JIT_UNI_BINARY_INJECTOR_HPP
+
+#include <map>
+#include <unordered_set>
+
+#include "common/broadcast_strategy.hpp"
+#include "common/c_types_map.hpp"
+#include "common/primitive_attr.hpp"
+#include "common/primitive_exec_types.hpp"
+#include "cpu/binary_injector_utils.hpp"
+
+#include "cpu/aarch64/cpu_isa_traits.hpp"
+#include "cpu/aarch64/injectors/injector_utils.hpp"
+#include "cpu/aarch64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+namespace binary_injector {
+using dnnl::impl::cpu::binary_injector_utils::prepare_binary_args;
+
+bool binary_args_matches_tag(format_tag_t tag, const post_ops_t &post_ops);
+
+bool binary_args_broadcast_supported(const post_ops_t &post_ops,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set);
+
+bool binary_args_tail_supported(const post_ops_t &post_ops,
+        const memory_desc_wrapper &dst_d, int vlen,
+        const bcast_set_t &supported_strategy_set);
+
+bool any_binary_postop_rhs_per_oc_broadcast(const post_ops_t &post_ops,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set);
+
+/*
+ * Represents params related to all binary post-ops right-hand side arguments
+ * (arg1) that don't change during jit_uni_binary_injector_t object lifetime
+ * and between compute_vector_range calls.
+ *
+ * @param rhs_dt_helper_vmm_idx - index of vmm helper used when loading data for
+ * calculations. Treated as hint from user. If inside compute_vector_range hint
+ * turns out to be invalid, it will be overwriten by register preserving logic
+ * inside binary injector.
+ * @param rhs_addr_reg - gpr register, used as the currently processed address
+ * of rhs tensor slice. Data of rhs(arg1) for the binary operation is loaded
+ * from address stored inside rhs_addr_reg.
+ * @param rhs_helper_reg - gpr register used as helper for calculations during
+ * data loading phase.
+ * @param preserve_gpr_helpers - determines whether gpr registers specified
+ * above should be preserved (pushed to stack and poped back afterwords)
+ * between compute_vector_range calls.
+ * @param preserve_vmm_helper - determines whether vmm helper register
+ * specified above should be preserved between compute_vector_range calls.
+ * @param abi_param_offset - offset to rhs tensor from first binary post-op
+ * operation specified by user from runtime structure passed to kernel as abi
+ * param 1.
+ * @param dst_d - descriptor of destination tensor (result after applying all
+ * post-ops operations).
+ * @param tail_size - size of processed tail in elements.
+ * @param tail_opmask - predicate register with loaded by user tail mask, only
+ * the first tail_size lanes are active.
+ * @param use_exact_tail_scalar_bcast - in case of scalar broadcast user can
+ * disable loading data with tail, broadcast through entire vector is cheaper
+ * and values above tail size are usually ignored during store.
+ */
+struct rhs_arg_static_params_t {
+    rhs_arg_static_params_t(std::size_t rhs_dt_helper_vmm_idx,
+            const Xbyak_aarch64::XReg &rhs_addr_reg,
+            const Xbyak_aarch64::XReg &rhs_helper_reg,
+            bool preserve_gpr_helpers, bool preserve_vmm_helper,
+            std::size_t abi_param_offset, const memory_desc_wrapper &dst_d,
+            std::size_t tail_size = 0u,
+            const Xbyak_aarch64::PReg &tail_opmask = Xbyak_aarch64::PReg(2),
+            bool use_exact_tail_scalar_bcast = false);
+
+    std::size_t rhs_dt_helper_vmm_idx;
+    Xbyak_aarch64::XReg rhs_addr_reg;
+    Xbyak_aarch64::XReg rhs_helper_reg;
+    bool preserve_gpr_helpers;
+    bool preserve_vmm_helper;
+    std::size_t abi_param_offset;
+    memory_desc_wrapper dst_d;
+    std::size_t tail_size;
+    Xbyak_aarch64::PReg tail_opmask;
+    bool use_exact_tail_scalar_bcast;
+};
+
+/*
+ * Represents params required by jit_uni_binary_injector_t that don't change
+ * during it's entire lifetime.
+ *
+ * @param param1 - register storing abi param1. At the moment of calling
+ * compute_vector_range method can be different than the default one defined
+ * inside jit_generator.
+ * @param bcast_set_t supported_strategy_set - set allowing disabling
+ * particular bcast strategies
+ * @param rhs_arg_static_params - params related to all binary post-ops
+ * right-hand side arguments that don't change during entire lifetime of
+ * jit_uni_binary_injector_t object.
+ */
+struct static_params_t {
+    static_params_t(const Xbyak_aarch64::XReg &param1,
+            const bcast_set_t &supported_strategy_set,
+            const rhs_arg_static_params_t &rhs_arg_static_params);
+    static_params_t(const Xbyak_aarch64::XReg &param1,
+            const rhs_arg_static_params_t &rhs_arg_static_params);
+
+    Xbyak_aarch64::XReg param1;
+    const bcast_set_t supported_strategy_set;
+    rhs_arg_static_params_t rhs_arg_static_params;
+};
+
+/*
+ * Represents params passed to compute_vector_range method of
+ * jit_uni_binary_injector_t that can be different for each call.
+ * Contains configurable std::maps where key is vmm index and value is
+ * offset in elements. The offset value identifies tensor slice in particular
+ * vmm. This is utilized by broadcasting mechanism. Offset, depending on the
+ * implementation particular kernels, can be passed as value (usually during
+ * unrolling), inside register, under memory address.
+ *
+ * @param vmm_idx_to_out_elem_off_addr - vmm mapped to offset in elements
+ * stored under memory address intended to use in no_broadcast strategy.
+ * @param vmm_idx_to_out_elem_off_val - vmm mapped to offset in elements passed
+ * as raw value intended to use in no_broadcast strategy
+ * @param vmm_idx_to_out_off_oprnd - vmm mapped to offset in elements inside
+ * register intended to use in no_broadcast strategy
+ * @param vmm_idx_to_oc_elem_off_addr - vmm mapped to output channel offset in
+ * elements stored under memory address intended to use in per_oc broadcast
+ * strategies.
+ * @param vmm_idx_to_oc_elem_off_val - vmm mapped to output channel offset in
+ * elements passed as raw value intended to use in per_oc broadcast strategies.
+ * @param vmm_idx_to_oc_off_oprnd - vmm mapped to output channel offset in
+ * elements inside register intended to use in per_oc broadcast strategies.
+ * @param vmm_tail_idx - vmm indices that contains data don't fill the whole
+ * vector (tail).
+ */
+struct rhs_arg_dynamic_params_t {
+    std::map<int, Xbyak_aarch64::AdrImm> vmm_idx_to_out_elem_off_addr;
+    std::map<int, int> vmm_idx_to_out_elem_off_val;
+    std::map<int, Xbyak_aarch64::XReg> vmm_idx_to_out_off_oprnd;
+
+    std::map<int, Xbyak_aarch64::AdrImm> vmm_idx_to_oc_elem_off_addr;
+    std::map<int, int> vmm_idx_to_oc_elem_off_val;
+    std::map<int, Xbyak_aarch64::XReg> vmm_idx_to_oc_off_oprnd;
+
+    std::unordered_set<int> vmm_tail_idx_;
+};
+
+/*
+ * Checks if src1 data type is supported by binary injector.
+ */
+bool is_data_supported(cpu_isa_t isa, data_type_t data_type);
+
+/*
+ * Checks if broadcast of src1 is supported by binary injector.
+ */
+bool is_bcast_supported(const dnnl::impl::memory_desc_t &src1_desc,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set);
+
+/*
+ * Checks if binary injection for given args is supported.
+ */
+bool is_supported(cpu_isa_t isa, const dnnl::impl::memory_desc_t &src1_desc,
+        const memory_desc_wrapper &dst_d,
+        const bcast_set_t &supported_strategy_set);
+
+/*
+ * Main mechanism responsible for injecting binary postops supporting sve_512
+ * and data types: f32, bf16, s32, u8, s8. Computations are done in f32.
+ */
+template <cpu_isa_t isa>
+class jit_uni_binary_injector_t {
+public:
+    using TReg = typename cpu_isa_traits<isa>::TReg;
+
+    jit_uni_binary_injector_t(
+            jit_generator *host, const static_params_t &static_params);
+
+    /*
+     * Generates code of binary post_op injected to host primitive. Applied to
+     * ordered set of vector registers' indexes. Function loads appropriate
+     * slice of rhs tensor for computations based on internally determined
+     * broadcast strategy and information about stored data in particular vmm
+     * described inside rhs_arg_params.
+     */
+    void compute_vector_range(const injector_utils::vmm_index_set_t &vmm_idxs,
+            std::size_t rhs_arg_idx, const dnnl_post_ops::entry_t &post_op,
+            const rhs_arg_dynamic_params_t &rhs_arg_params) const;
+
+    /*
+     * Generates code of binary post_op injected to host primitive. Applied to
+     * range <start_idx, end_idx) of vector registers' indexes.
+     */
+    void compute_vector_range(size_t start_idx, size_t end_idx,
+            std::size_t rhs_arg_idx, const dnnl_post_ops::entry_t &post_op,
+            const rhs_arg_dynamic_params_t &rhs_arg_params) const;
+
+    /*
+     * Generates code of binary post_op injected to host primitive. Applied to
+     * a single vector register index.
+     */
+    void compute_vector(size_t idx, std::size_t rhs_arg_idx,
+            const dnnl_post_ops::entry_t &post_op,
+            const rhs_arg_dynamic_params_t &rhs_arg_params) const;
+
+private:
+    /*
+     * Determines if hint passed by user is valid (is not one of the processed
+     * vmms). If not it returns new vmm idx value that will be used as
+     * temporary vmm in future computations.
+     */
+    int adjust_temp_vmm_hint(int user_hint,
+            const injector_utils::vmm_index_set_t &vmm_idxs) const;
+    /*
+     * Taking into account rhs_broadcasting_strategy and information from user
+     * about tensor slice (rhs_arg_params) stored in Vmm(vmm_idx) calculates
+     * address of rhs tensor slice needed for binary operation and stores it
+     * inside rhs_addr_reg.
+     */
+    void prepare_rhs_arg_addr(std::size_t vmm_idx, std::size_t rhs_arg_idx,
+            const dnnl_post_ops::entry_t &post_op,
+            const rhs_arg_dynamic_params_t &rhs_arg_params,
+            const broadcasting_strategy_t rhs_broadcasting_strategy) const;
+    /*
+     * Helper functions responsible for preparing rhs tensor slice address.
+     */
+    void append_offset(const std::map<int, Xbyak_aarch64::AdrImm> &addr_off,
+            const std::map<int, int> &val_off,
+            const std::map<int, Xbyak_aarch64::XReg> &oprnd_off, int vmm_idx,
+            std::size_t elem_size_bytes) const;
+    /*
+     * Loads data and applies particular binary operation.
+     */
+    void inject_binary(const dnnl_post_ops::entry_t &post_op, const TReg &dst,
+            const TReg &tmp, broadcasting_strategy_t rhs_broadcasting_strategy,
+            bool with_tail) const;
+    void load_rhs(const TReg &tmp, data_type_t data_type, bool bcast,
+            bool with_tail) const;
+    void execute_binary(
+            alg_kind_t binary_alg, const TReg &dst, const TReg &rhs) const;
+
+    void push_gpr_helpers() const;
+    void pop_gpr_helpers() const;
+    void push_vmm_helper(const TReg &vmm) const;
+    void pop_vmm_helper(const TReg &vmm) const;
+
+    jit_generator *host_;
+    const rhs_arg_static_params_t rhs_arg_static_params_;
+    const Xbyak_aarch64::XReg param1_;
+    const bcast_set_t supported_strategy_set_;
+
+    static constexpr int vmm_count = 32;
+};
+
+} // namespace binary_injector
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
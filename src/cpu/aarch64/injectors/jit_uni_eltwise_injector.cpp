@@ -29,6 +29,23 @@ namespace impl {
 namespace cpu {
 namespace aarch64 {
 
+namespace eltwise_injector {
+
+bool is_alg_supported(alg_kind_t alg) {
+    using namespace alg_kind;
+    return utils::one_of(alg, eltwise_relu, eltwise_tanh, eltwise_elu,
+            eltwise_square, eltwise_abs, eltwise_sqrt, eltwise_linear,
+            eltwise_bounded_relu, eltwise_soft_relu, eltwise_logistic,
+            eltwise_exp, eltwise_gelu_tanh, eltwise_swish, eltwise_log,
+            eltwise_clip, eltwise_clip_v2, eltwise_gelu_erf, eltwise_round,
+            eltwise_relu_use_dst_for_bwd, eltwise_tanh_use_dst_for_bwd,
+            eltwise_elu_use_dst_for_bwd, eltwise_sqrt_use_dst_for_bwd,
+            eltwise_logistic_use_dst_for_bwd, eltwise_exp_use_dst_for_bwd,
+            eltwise_clip_v2_use_dst_for_bwd);
+}
+
+} // namespace eltwise_injector
+
 using namespace Xbyak_aarch64;
 
 template <cpu_isa_t isa>
@@ -58,6 +58,12 @@ struct static_params_t {
     bool is_fwd;
     bool use_dst;
 };
+
+/*
+ * Checks if eltwise algorithm is supported by eltwise injector.
+ */
+bool is_alg_supported(alg_kind_t alg);
+
 } // namespace eltwise_injector
 
 template <cpu_isa_t isa>
@@ -100,15 +106,7 @@ struct jit_uni_eltwise_injector_f32 {
     {
         using namespace alg_kind;
         assert(utils::one_of(isa, sve_512));
-        assert(utils::one_of(alg_, eltwise_relu, eltwise_tanh, eltwise_elu,
-                eltwise_square, eltwise_abs, eltwise_sqrt, eltwise_linear,
-                eltwise_bounded_relu, eltwise_soft_relu, eltwise_logistic,
-                eltwise_exp, eltwise_gelu_tanh, eltwise_swish, eltwise_log,
-                eltwise_clip, eltwise_clip_v2, eltwise_gelu_erf, eltwise_round,
-                eltwise_relu_use_dst_for_bwd, eltwise_tanh_use_dst_for_bwd,
-                eltwise_elu_use_dst_for_bwd, eltwise_sqrt_use_dst_for_bwd,
-                eltwise_logistic_use_dst_for_bwd, eltwise_exp_use_dst_for_bwd,
-                eltwise_clip_v2_use_dst_for_bwd));
+        assert(eltwise_injector::is_alg_supported(alg_));
         register_table_entries();
     }
 
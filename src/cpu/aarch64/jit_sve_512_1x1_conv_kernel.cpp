@@ -45,6 +45,63 @@ using namespace dnnl::impl::format_tag;
 using namespace dnnl::impl::prop_kind;
 using namespace dnnl::impl::utils;
 
+jit_sve_512_1x1_conv_kernel::jit_sve_512_1x1_conv_kernel(
+        const jit_1x1_conv_conf_t &ajcp, const primitive_attr_t &attr,
+        const memory_desc_t &dst_md)
+    : jcp(ajcp), attr_(attr) {
+    if (jcp.with_eltwise || jcp.with_binary) {
+        using namespace binary_injector;
+        static constexpr bool preserve_gpr = false;
+        static constexpr bool preserve_vmm = false;
+        const size_t helper_vmm_idx = binary_helper_vmm_idx;
+
+        const rhs_arg_static_params_t rhs_arg_static_params {helper_vmm_idx,
+                reg_binary_rhs_addr, reg_binary_helper, preserve_gpr,
+                preserve_vmm, GET_OFF(post_ops_binary_rhs_arg_vec),
+                memory_desc_wrapper(dst_md)};
+        const static_params_t static_params {
+                this->param1, rhs_arg_static_params};
+
+        postops_injector_ = utils::make_unique<
+                injector::jit_uni_postops_injector_t<sve_512>>(
+                this, jcp.post_ops, static_params);
+    }
+}
+
+void jit_sve_512_1x1_conv_kernel::apply_postops(int load_loop_blk, int ur) {
+    injector_utils::vmm_index_set_t vmm_idxs;
+    if (jcp.with_binary) {
+        binary_injector::rhs_arg_dynamic_params_t rhs_arg_params;
+        for (int i_load = 0; i_load < load_loop_blk; ++i_load)
+            for (int i_ur = 0; i_ur < ur; ++i_ur) {
+                const int aux_output_l_off
+                        = (i_load * jcp.bcast_dim + i_ur) * jcp.load_block;
+                const int vmm_idx = i_ur * load_loop_blk + i_load;
+                vmm_idxs.emplace(vmm_idx);
+
+                rhs_arg_params.vmm_idx_to_oc_off_oprnd.emplace(
+                        vmm_idx, reg_binary_oc_off);
+                rhs_arg_params.vmm_idx_to_oc_elem_off_val.emplace(
+                        vmm_idx, i_load * jcp.load_block);
+                rhs_arg_params.vmm_idx_to_out_off_oprnd.emplace(
+                        vmm_idx, reg_binary_out_off);
+                rhs_arg_params.vmm_idx_to_out_elem_off_val.emplace(
+                        vmm_idx, aux_output_l_off);
+            }
+
+        // offset of the current output block from dst origin, in elements
+        ldr(reg_binary_out_off, ptr(abi_param1, GET_OFF(dst_orig)));
+        sub(reg_binary_out_off, aux_reg_output_data, reg_binary_out_off);
+        lsr(reg_binary_out_off, reg_binary_out_off, 2);
+
+        postops_injector_->compute_vector_range(vmm_idxs, rhs_arg_params);
+    } else {
+        for (int i = 0; i < ur * load_loop_blk; ++i)
+            vmm_idxs.emplace(i);
+        postops_injector_->compute_vector_range(vmm_idxs);
+    }
+}
+
 void jit_sve_512_1x1_conv_kernel::bcast_loop(int load_loop_blk) {
 
     mov(aux1_reg_bcast_data, reg_bcast_data);
@@ -381,16 +438,12 @@ void jit_sve_512_1x1_conv_kernel::reduce_loop(
             }
 
         L(store_noadd);
-        if (jcp.with_eltwise) {
-#ifndef DISABLE_ELTWISE
-            Label store_noeltwise;
+        if (jcp.with_eltwise || jcp.with_binary) {
+            Label store_nopostops;
             tst(reg_reduce_pos_flag, FLAG_REDUCE_LAST);
-            b(EQ, store_noeltwise);
-            eltwise_injector_->compute_vector_range(0, ur * load_loop_blk);
-            L(store_noeltwise);
-#else
-            assert(!"fused eltwise error!");
-#endif
+            b(EQ, store_nopostops);
+            apply_postops(load_loop_blk, ur);
+            L(store_nopostops);
         }
 
         prev_ofs = -1;
@@ -505,8 +558,8 @@ void jit_sve_512_1x1_conv_kernel::generate() {
     /* A flag for controlling reduce loop */
     ldr(reg_reduce_pos_flag, ptr(abi_param1, GET_OFF(first_last_flag)));
 
-    if (one_of(jcp.prop_kind, forward_training, forward_inference))
-        mov(reg_relu_ns, reinterpret_cast<size_t>(&jcp.eltwise.alpha));
+    if (jcp.with_binary)
+        ldr(reg_binary_oc_off, ptr(abi_param1, GET_OFF(oc_l_off)));
 
     if (jcp.prop_kind == backward_weights)
         ldr(reg_output_stride, ptr(abi_param1, GET_OFF(output_stride)));
@@ -521,6 +574,9 @@ void jit_sve_512_1x1_conv_kernel::generate() {
         switch (jcp.prop_kind) {
             case forward_training:
             case forward_inference:
+                if (jcp.with_binary)
+                    add_imm(reg_binary_oc_off, reg_binary_oc_off,
+                            load_loop_blk * jcp.load_block, reg_tmp_imm);
                 add_imm(reg_bias_data, reg_bias_data,
                         load_loop_blk * jcp.load_block * jcp.typesize_out,
                         reg_tmp_imm);
@@ -598,21 +654,31 @@ void jit_sve_512_1x1_conv_kernel::generate() {
     L(load_loop_blk[num_ur_cases]);
 
     postamble();
-    if (jcp.with_eltwise) {
-#ifndef DISABLE_ELTWISE
-        eltwise_injector_->prepare_table();
-        binCommit();
-#else
-        assert(!"fused eltwise error");
-#endif
-    }
+    if (postops_injector_) postops_injector_->prepare_table();
 }
 
-bool jit_sve_512_1x1_conv_kernel::post_ops_ok(
-        jit_1x1_conv_conf_t &jcp, const primitive_attr_t &attr) {
+bool jit_sve_512_1x1_conv_kernel::post_ops_ok(jit_1x1_conv_conf_t &jcp,
+        const primitive_attr_t &attr, const memory_desc_wrapper &dst_d) {
 
     const auto &p = attr.post_ops_;
 
+    if (p.find(primitive_kind::convolution) == -1) {
+        using namespace injector;
+        // The previous dst is accumulated as is, hence the sum scale has to
+        // be one. The kernel has no oc tail for per-channel rhs.
+        static constexpr bool sum_at_pos_0_only = true;
+        static constexpr bool sum_requires_scale_one = true;
+        const bcast_set_t enabled_bcast_strategy
+                = {broadcasting_strategy_t::scalar,
+                        broadcasting_strategy_t::per_oc,
+                        broadcasting_strategy_t::no_broadcast};
+        return injector::post_ops_ok({sve_512, {eltwise, binary, sum}, p,
+                       &dst_d, sum_at_pos_0_only, sum_requires_scale_one,
+                       enabled_bcast_strategy})
+                && binary_injector::binary_args_tail_supported(p, dst_d,
+                        cpu_isa_traits<sve_512>::vlen, enabled_bcast_strategy);
+    }
+
     auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
     auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
     auto is_convolution
@@ -688,7 +754,7 @@ status_t jit_sve_512_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
     jcp.is = jcp.id * jcp.ih * jcp.iw;
     jcp.tr_is = rnd_up(jcp.is, 4);
 
-    if (!post_ops_ok(jcp, attr)) return status::unimplemented;
+    if (!post_ops_ok(jcp, attr, dst_d)) return status::unimplemented;
 
     /* Depthwise conv check */
     const auto &p = attr.post_ops_;
@@ -702,15 +768,11 @@ status_t jit_sve_512_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
     const int eltwise_ind = p.find(primitive_kind::eltwise, 0, dw_conv_ind);
     jcp.with_eltwise = eltwise_ind != -1;
     if (jcp.with_eltwise) {
-#ifndef DISABLE_ELTWISE
         jcp.eltwise = p.entry_[eltwise_ind].eltwise;
-        if (jcp.eltwise.alg == alg_kind::eltwise_pow)
-            return status::unimplemented;
         if (dst_d.data_type() == data_type::s32) return status::unimplemented;
-#else
-        return status::unimplemented;
-#endif
     }
+    jcp.with_binary = p.find(primitive_kind::binary, 0, dw_conv_ind) != -1;
+    jcp.post_ops = p;
 
     /* Data format check */
     const auto dat_tag_nxc = pick(ndims - 3, nwc, nhwc, ndhwc);
@@ -21,15 +21,11 @@
 #include "common/c_types_map.hpp"
 #include "common/memory_tracking.hpp"
 
+#include "cpu/aarch64/injectors/jit_uni_postops_injector.hpp"
 #include "cpu/aarch64/jit_generator.hpp"
 #include "cpu/aarch64/jit_op_imm_check.hpp"
 #include "cpu/aarch64/jit_primitive_conf.hpp"
 
-#define DISABLE_ELTWISE
-#ifndef DISABLE_ELTWISE
-#include "cpu/aarch64/jit_uni_eltwise_injector.hpp"
-#endif
-
 using namespace Xbyak_aarch64;
 
 namespace dnnl {
@@ -41,32 +37,13 @@ namespace aarch64 {
 #define VL64_OFS(ofs) ((ofs) >> 6)
 
 struct jit_sve_512_1x1_conv_kernel : public jit_generator {
-    jit_sve_512_1x1_conv_kernel(
-            const jit_1x1_conv_conf_t &ajcp, const primitive_attr_t &attr)
-        : jcp(ajcp)
-        , attr_(attr)
-#ifndef DISABLE_ELTWISE
-        , eltwise_injector_(nullptr)
-#endif
-    {
-        if (jcp.with_eltwise) {
-#ifndef DISABLE_ELTWISE
-            eltwise_injector_ = new jit_uni_eltwise_injector_f32<sve_512>(
-                    this, jcp.eltwise);
-#endif
-        }
-    }
-
-    ~jit_sve_512_1x1_conv_kernel() {
-#ifndef DISABLE_ELTWISE
-        delete eltwise_injector_;
-#endif
-    }
+    jit_sve_512_1x1_conv_kernel(const jit_1x1_conv_conf_t &ajcp,
+            const primitive_attr_t &attr, const memory_desc_t &dst_md);
 
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_512_1x1_conv_kernel)
 
-    static bool post_ops_ok(
-            jit_1x1_conv_conf_t &jcp, const primitive_attr_t &attr);
+    static bool post_ops_ok(jit_1x1_conv_conf_t &jcp,
+            const primitive_attr_t &attr, const memory_desc_wrapper &dst_d);
 
     static status_t init_conf(jit_1x1_conv_conf_t &jcp,
             const convolution_desc_t &cd, const memory_desc_wrapper &src_d,
@@ -88,7 +65,7 @@ private:
     reg64_t reg_reduce_pos_flag = x1;
     reg64_t reduce_loop_iter = x2;
     reg64_t reg_bcast_loop_iter = x3;
-    reg64_t reg_relu_ns = x20; // For forward
+    reg64_t reg_binary_oc_off = x20; // For forward
     reg64_t reg_output_stride = x20; // For backward
 
     /* Pointer */
@@ -114,6 +91,13 @@ private:
     reg64_t reg_tmp_imm = x18; // tmp for add_imm
     reg64_t reg_tmp_ofs = x19; // tmp reg to calc bwd wei offset in out_load
 
+    /* Binary post-ops */
+    reg64_t reg_binary_rhs_addr = x4;
+    reg64_t reg_binary_helper = x22;
+    // reg_prev_out_addr is reloaded by out_str, so it is free in apply_postops
+    reg64_t reg_binary_out_off = x14;
+    static constexpr int binary_helper_vmm_idx = 31;
+
     void prefetch(
             const std::string prfop, int level, reg64_t in, long long int ofs) {
         bool for_load = false;
@@ -166,9 +150,10 @@ private:
         }
     }
 
-#ifndef DISABLE_ELTWISE
-    jit_uni_eltwise_injector_f32<sve_512> *eltwise_injector_;
-#endif
+    std::unique_ptr<injector::jit_uni_postops_injector_t<sve_512>>
+            postops_injector_;
+
+    void apply_postops(int load_loop_blk, int ur);
     void bcast_loop(int load_loop_blk);
     void reduce_loop(int load_loop_blk, int ur, int substep, bool wraparound);
 
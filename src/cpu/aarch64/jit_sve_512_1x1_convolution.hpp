@@ -123,7 +123,8 @@ struct jit_sve_512_1x1_convolution_fwd_t : public primitive_t {
 
     status_t init(engine_t *engine) override {
         CHECK(safe_ptr_assign(kernel_,
-                new jit_sve_512_1x1_conv_kernel(pd()->jcp_, *pd()->attr())));
+                new jit_sve_512_1x1_conv_kernel(
+                        pd()->jcp_, *pd()->attr(), *pd()->dst_md(0))));
         CHECK(kernel_->create_kernel());
         CHECK(init_rtus_driver<sve_512>(this));
         return status::success;
@@ -140,7 +141,8 @@ private:
             const src_data_t *src, const wei_data_t *weights,
             const dst_data_t *bias, const wei_data_t *weights_dw,
             const dst_data_t *bias_dw, dst_data_t *dst,
-            const memory_tracking::grantor_t &scratchpad) const;
+            const memory_tracking::grantor_t &scratchpad,
+            const void *post_ops_binary_rhs_arg_vec) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
 
     std::unique_ptr<jit_sve_512_1x1_conv_kernel> kernel_;
@@ -214,7 +216,8 @@ struct jit_sve_512_1x1_convolution_bwd_data_t : public primitive_t {
 
     status_t init(engine_t *engine) override {
         CHECK(safe_ptr_assign(kernel_,
-                new jit_sve_512_1x1_conv_kernel(pd()->jcp_, *pd()->attr())));
+                new jit_sve_512_1x1_conv_kernel(
+                        pd()->jcp_, *pd()->attr(), *pd()->dst_md(0))));
         CHECK(kernel_->create_kernel());
         CHECK(init_rtus_driver<sve_512>(this));
         return status::success;
@@ -121,9 +121,67 @@ void jit_sve_512_conv_fwd_kernel::prepare_output(int ur_w) {
         }
 }
 
+jit_sve_512_conv_fwd_kernel::jit_sve_512_conv_fwd_kernel(
+        const jit_conv_conf_t &ajcp, const primitive_attr_t &attr,
+        const memory_desc_t &dst_md)
+    : jcp(ajcp), attr_(attr) {
+    if (jcp.with_eltwise || jcp.with_binary) {
+        using namespace binary_injector;
+        static constexpr bool preserve_gpr = false;
+        static constexpr bool preserve_vmm = false;
+        const size_t helper_vmm_idx = binary_helper_vmm_idx;
+
+        const rhs_arg_static_params_t rhs_arg_static_params {helper_vmm_idx,
+                reg_binary_rhs_addr, reg_binary_helper, preserve_gpr,
+                preserve_vmm, GET_OFF(post_ops_binary_rhs_arg_vec),
+                memory_desc_wrapper(dst_md)};
+        const static_params_t static_params {
+                this->param1, rhs_arg_static_params};
+
+        postops_injector_ = utils::make_unique<
+                injector::jit_uni_postops_injector_t<sve_512>>(
+                this, jcp.post_ops, static_params);
+    }
+}
+
+void jit_sve_512_conv_fwd_kernel::apply_postops(int ur_w) {
+    injector_utils::vmm_index_set_t vmm_idxs;
+    if (jcp.with_binary) {
+        binary_injector::rhs_arg_dynamic_params_t rhs_arg_params;
+        for (int k = 0; k < jcp.nb_oc_blocking; k++)
+            for (int j = 0; j < ur_w; j++) {
+                const int aux_output_l_off
+                        = get_output_offset(j, k) / jcp.typesize_out;
+                const int vmm_idx = j + k * jcp.ur_w;
+                vmm_idxs.emplace(vmm_idx);
+
+                rhs_arg_params.vmm_idx_to_oc_elem_off_addr.emplace(
+                        vmm_idx, ptr(param, GET_OFF(oc_l_off)));
+                rhs_arg_params.vmm_idx_to_oc_elem_off_val.emplace(
+                        vmm_idx, k * jcp.oc_block);
+                rhs_arg_params.vmm_idx_to_out_off_oprnd.emplace(
+                        vmm_idx, reg_binary_out_off);
+                rhs_arg_params.vmm_idx_to_out_elem_off_val.emplace(
+                        vmm_idx, aux_output_l_off);
+            }
+
+        // offset of the current output block from dst origin, in elements
+        ldr(reg_binary_out_off, ptr(param, GET_OFF(dst_orig)));
+        sub(reg_binary_out_off, reg_out, reg_binary_out_off);
+        lsr(reg_binary_out_off, reg_binary_out_off, 2);
+
+        postops_injector_->compute_vector_range(vmm_idxs, rhs_arg_params);
+    } else {
+        for (int k = 0; k < jcp.nb_oc_blocking; k++)
+            for (int j = 0; j < ur_w; j++)
+                vmm_idxs.emplace(j + k * jcp.ur_w);
+        postops_injector_->compute_vector_range(vmm_idxs);
+    }
+}
+
 void jit_sve_512_conv_fwd_kernel::store_output(int ur_w) {
 
-    Label no_update_label, store_label, eltwise_label;
+    Label no_update_label, store_label, post_ops_label;
 
     auto _test = [&](const int cond) { return tst(reg_channel, cond); };
 
@@ -183,13 +241,13 @@ void jit_sve_512_conv_fwd_kernel::store_output(int ur_w) {
     }
 
     if (!jcp.with_sum) {
-        b(eltwise_label);
+        b(post_ops_label);
     } else {
         auto _jmp = [&](const Label &l) { return b(EQ, l); };
 
         // *Note 1
         _test(FLAG_IC_FIRST);
-        _jmp(eltwise_label);
+        _jmp(post_ops_label);
     }
 
     auto bias_load = [=](int bias_offset, int idx) {
@@ -220,19 +278,12 @@ void jit_sve_512_conv_fwd_kernel::store_output(int ur_w) {
         }
     }
 
-    L(eltwise_label);
-    if (jcp.with_eltwise) {
+    L(post_ops_label);
+    if (jcp.with_eltwise || jcp.with_binary) {
         tst(reg_channel, FLAG_IC_LAST);
         b(EQ, store_label);
 
-        if (ur_w == jcp.ur_w) {
-            eltwise_injector_->compute_vector_range(
-                    0, jcp.nb_oc_blocking * jcp.ur_w);
-        } else {
-            for (int k = 0; k < jcp.nb_oc_blocking; k++)
-                eltwise_injector_->compute_vector_range(
-                        k * jcp.ur_w, k * jcp.ur_w + ur_w);
-        }
+        apply_postops(ur_w);
     }
     auto out_str = [=](int j, int k, int aux_output_offset, int prev_out_ofs) {
         int ofs = aux_output_offset;
@@ -802,24 +853,27 @@ void jit_sve_512_conv_fwd_kernel::generate() {
     }
     postamble();
 
-    if (jcp.with_eltwise) { eltwise_injector_->prepare_table(); }
+    if (postops_injector_) postops_injector_->prepare_table();
 }
 
-bool jit_sve_512_conv_fwd_kernel::post_ops_ok(
-        jit_conv_conf_t &jcp, const primitive_attr_t &attr) {
+bool jit_sve_512_conv_fwd_kernel::post_ops_ok(jit_conv_conf_t &jcp,
+        const primitive_attr_t &attr, const memory_desc_wrapper &dst_d) {
+    using namespace injector;
+    // The kernel accumulates the previous dst as is, hence the sum scale has
+    // to be one. Per-channel rhs with a partial last block would be read
+    // out of bounds, the kernel has no oc tail.
+    static constexpr bool sum_at_pos_0_only = true;
+    static constexpr bool sum_requires_scale_one = true;
+    const bcast_set_t enabled_bcast_strategy
+            = {broadcasting_strategy_t::scalar, broadcasting_strategy_t::per_oc,
+                    broadcasting_strategy_t::no_broadcast};
     const auto &p = attr.post_ops_;
 
-    auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
-    auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
-
-    switch (p.len()) {
-        case 0: return true; // no post_ops
-        case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
-        case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
-        default: return false;
-    }
-
-    return false;
+    return injector::post_ops_ok({sve_512, {eltwise, binary, sum}, p, &dst_d,
+                   sum_at_pos_0_only, sum_requires_scale_one,
+                   enabled_bcast_strategy})
+            && binary_injector::binary_args_tail_supported(p, dst_d,
+                    cpu_isa_traits<sve_512>::vlen, enabled_bcast_strategy);
 }
 
 status_t jit_sve_512_conv_fwd_kernel::init_conf(jit_conv_conf_t &jcp,
@@ -917,21 +971,6 @@ status_t jit_sve_512_conv_fwd_kernel::init_conf(jit_conv_conf_t &jcp,
     jcp.ic_tail = 0;
     jcp.oc_tail = 0;
 
-    /* Post operation check */
-    if (!post_ops_ok(jcp, attr)) { return status::unimplemented; }
-
-    /* Eltwise operation check */
-    const auto &p = attr.post_ops_;
-    jcp.with_sum = p.find(primitive_kind::sum) != -1;
-    const int eltwise_ind = p.find(primitive_kind::eltwise);
-    jcp.with_eltwise = eltwise_ind != -1;
-    if (jcp.with_eltwise) {
-        jcp.eltwise = p.entry_[eltwise_ind].eltwise;
-        if (jcp.eltwise.alg == alg_kind::eltwise_pow)
-            return status::unimplemented;
-        if (dst_d.data_type() == data_type::s32) return status::unimplemented;
-    }
-
     format_tag_t src_tag, dst_tag, wei_tag;
 
     dst_tag = dat_tag_nCx16c;
@@ -951,6 +990,20 @@ status_t jit_sve_512_conv_fwd_kernel::init_conf(jit_conv_conf_t &jcp,
         return status::unimplemented;
     jcp.dst_tag = dst_tag;
 
+    /* Post operation check, binary post-ops need the final dst layout */
+    if (!post_ops_ok(jcp, attr, dst_d)) { return status::unimplemented; }
+
+    const auto &p = attr.post_ops_;
+    jcp.with_sum = p.find(primitive_kind::sum) != -1;
+    const int eltwise_ind = p.find(primitive_kind::eltwise);
+    jcp.with_eltwise = eltwise_ind != -1;
+    if (jcp.with_eltwise) {
+        jcp.eltwise = p.entry_[eltwise_ind].eltwise;
+        if (dst_d.data_type() == data_type::s32) return status::unimplemented;
+    }
+    jcp.with_binary = p.find(primitive_kind::binary) != -1;
+    jcp.post_ops = p;
+
     jcp.with_bias = cd.bias_desc.format_kind != format_kind::undef;
     if (jcp.with_bias) {
         if (bias_d.format_kind() == format_kind::any)
@@ -24,7 +24,7 @@
 #include "cpu/aarch64/jit_generator.hpp"
 #include "cpu/aarch64/jit_primitive_conf.hpp"
 
-#include "cpu/aarch64/injectors/jit_uni_eltwise_injector.hpp"
+#include "cpu/aarch64/injectors/jit_uni_postops_injector.hpp"
 
 #include "cpu/aarch64/jit_op_imm_check.hpp"
 
@@ -42,23 +42,16 @@ namespace aarch64 {
 
 struct jit_sve_512_conv_fwd_kernel : public jit_generator {
 
-    jit_sve_512_conv_fwd_kernel(
-            const jit_conv_conf_t &ajcp, const primitive_attr_t &attr)
-        : jcp(ajcp), attr_(attr), eltwise_injector_(nullptr) {
-
-        if (jcp.with_eltwise)
-            eltwise_injector_ = new jit_uni_eltwise_injector_f32<sve_512>(
-                    this, jcp.eltwise);
-    }
-
-    ~jit_sve_512_conv_fwd_kernel() { delete eltwise_injector_; }
+    jit_sve_512_conv_fwd_kernel(const jit_conv_conf_t &ajcp,
+            const primitive_attr_t &attr, const memory_desc_t &dst_md);
 
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_512_conv_fwd_kernel)
 
     jit_conv_conf_t jcp;
     const primitive_attr_t &attr_;
 
-    static bool post_ops_ok(jit_conv_conf_t &jcp, const primitive_attr_t &attr);
+    static bool post_ops_ok(jit_conv_conf_t &jcp, const primitive_attr_t &attr,
+            const memory_desc_wrapper &dst_d);
     static status_t init_conf(jit_conv_conf_t &jcp,
             const convolution_desc_t &cd, memory_desc_t &src_pd,
             memory_desc_t &weights_pd, memory_desc_t &dst_pd,
@@ -110,6 +103,12 @@ private:
     reg64_t reg_ker_org = x21; // ker base addr (3d)
     reg64_t reg_inp_org = x29; // src base addr (3d)
 
+    /* Binary post-ops */
+    reg64_t reg_binary_rhs_addr = x4;
+    reg64_t reg_binary_helper = x22;
+    reg64_t reg_binary_out_off = x14; // reg_tmp_addr is free in apply_postops
+    static constexpr int binary_helper_vmm_idx = 31;
+
     void prefetch(
             const std::string prfop, int level, reg64_t in, long long int ofs) {
         bool for_load = false;
@@ -163,9 +162,11 @@ private:
         }
     }
 
-    jit_uni_eltwise_injector_f32<sve_512> *eltwise_injector_;
+    std::unique_ptr<injector::jit_uni_postops_injector_t<sve_512>>
+            postops_injector_;
 
     inline void prepare_output(int ur_w);
+    inline void apply_postops(int ur_w);
     inline void store_output(int ur_w);
     inline void compute_loop_fma_core(int ur_w, int pad_l, int pad_r);
     inline void compute_loop(int ur_w, int pad_l, int pad_r);
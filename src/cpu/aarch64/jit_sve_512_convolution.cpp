@@ -61,9 +61,15 @@ inline void jit_conv_ker_pipeline(jit_conv_ker_t ker, jit_conv_call_s &p,
 inline void jit_conv_ker_pipeline_ow_thr(jit_conv_ker_t ker, jit_conv_call_s &p,
         const void *src, const void *dst, const void *filt, const void *bias,
         int channel, int kh_padding, int owb, int reduce_work, int load_work,
-        int flags) {
+        const void *post_ops_binary_rhs_arg_vec, int oc_l_off,
+        const void *dst_orig, int flags) {
     PIPELINE(owb);
     PIPELINE(flags);
+
+    PIPELINE(oc_l_off);
+    PIPELINE(dst_orig);
+    p.post_ops_binary_rhs_arg_vec = post_ops_binary_rhs_arg_vec;
+
     jit_conv_ker_pipeline(ker, p, src, dst, filt, bias, channel, kh_padding,
             reduce_work, load_work);
 }
@@ -100,10 +106,15 @@ inline void jit_sve_512_conv_3d_ker_pipeline(jit_conv_ker_t ker,
 inline void jit_sve_512_conv_3d_ker_pipeline_ow_thr(jit_conv_ker_t ker,
         jit_conv_call_s &p, const void *src, const void *dst, const void *filt,
         const void *bias, int channel, int kh_padding, int kd_padding, int owb,
-        int reduce_work, int load_work, int flags) {
+        int reduce_work, int load_work, const void *post_ops_binary_rhs_arg_vec,
+        int oc_l_off, const void *dst_orig, int flags) {
     PIPELINE(owb);
     PIPELINE(flags);
 
+    PIPELINE(oc_l_off);
+    PIPELINE(dst_orig);
+    p.post_ops_binary_rhs_arg_vec = post_ops_binary_rhs_arg_vec;
+
     jit_sve_512_conv_3d_ker_pipeline(ker, p, src, dst, filt, bias, channel,
             kh_padding, kd_padding, reduce_work, load_work);
 }
@@ -183,6 +194,8 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const dst_data_t *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    const auto post_ops_binary_rhs_arg_vec
+            = binary_injector::prepare_binary_args(pd()->jcp_.post_ops, ctx);
 
     prepare_padded_bias(bias, ctx.get_scratchpad_grantor());
 
@@ -256,6 +269,8 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
                 int icb_end = min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2);
                 const int oc_work = utils::this_block_size(ocb * jcp.oc_block,
                         jcp.oc, jcp.nb_oc_blocking * jcp.oc_block);
+                const int oc_l_off
+                        = oc_off_idx * (is_dst_layout_nxc ? 1 : jcp.oc_block);
                 int ic_work = icb_step * jcp.ic_block;
                 for (int icb = icb_l2; icb < icb_end; icb += icb_step) {
                     int curr_nb_ic = nstl::min(icb_step, icb_end - icb);
@@ -268,6 +283,7 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
                     }
                     jit_conv_ker_pipeline_ow_thr(jit_ker, par_conv, src_w,
                             dst_w, wht_w, bias_w, icb, 1, owb, ic_work, oc_work,
+                            post_ops_binary_rhs_arg_vec.data(), oc_l_off, dst,
                             flags);
 
                     src_w += src_c_stride;
@@ -295,8 +311,9 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
         // on the last iteration of loop above. Only valid pointers make sense
         // here as call parameters to avoid execution of prefetch instructions
         // with nullptr, other parameters are not used in real jit call here
-        jit_conv_ker_pipeline_ow_thr(
-                jit_ker, par_conv, src, dst, weights, bias, 0, 0, 0, 0, 0, 0);
+        jit_conv_ker_pipeline_ow_thr(jit_ker, par_conv, src, dst, weights, bias,
+                0, 0, 0, 0, 0, post_ops_binary_rhs_arg_vec.data(), 0, nullptr,
+                0);
     });
 }
 
@@ -307,6 +324,8 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const dst_data_t *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    const auto post_ops_binary_rhs_arg_vec
+            = binary_injector::prepare_binary_args(pd()->jcp_.post_ops, ctx);
 
     prepare_padded_bias(bias, ctx.get_scratchpad_grantor());
 
@@ -393,6 +412,8 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
                     const int oc_work
                             = utils::this_block_size(ocb * jcp.oc_block, jcp.oc,
                                     jcp.nb_oc_blocking * jcp.oc_block);
+                    const int oc_l_off = oc_off_idx
+                            * (is_dst_layout_nxc ? 1 : jcp.oc_block);
                     int ic_work = icb_step * jcp.ic_block;
                     for (int icb = icb_l2; icb < icb_end; icb += icb_step) {
                         int curr_nb_ic = nstl::min(icb_step, icb_end - icb);
@@ -425,7 +446,9 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
 
                             jit_conv_ker_pipeline_ow_thr(jit_ker, par_conv,
                                     aux_src, dst_c, aux_wht, bias_w, icb,
-                                    kh_padding, owb, ic_work, oc_work, flags);
+                                    kh_padding, owb, ic_work, oc_work,
+                                    post_ops_binary_rhs_arg_vec.data(),
+                                    oc_l_off, dst, flags);
 
                             src_c += src_h_stride * jcp.stride_h;
                             dst_c += dst_h_stride;
@@ -454,8 +477,9 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
         // on the last iteration of loop above. Only valid pointers make sense
         // here as call parameters to avoid execution of prefetch instructions
         // with nullptr, other parameters are not used in real jit call here
-        jit_conv_ker_pipeline_ow_thr(
-                jit_ker, par_conv, src, dst, weights, bias, 0, 0, 0, 0, 0, 0);
+        jit_conv_ker_pipeline_ow_thr(jit_ker, par_conv, src, dst, weights, bias,
+                0, 0, 0, 0, 0, post_ops_binary_rhs_arg_vec.data(), 0, nullptr,
+                0);
     });
 }
 
@@ -466,6 +490,8 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
     auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const dst_data_t *, DNNL_ARG_BIAS);
     auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    const auto post_ops_binary_rhs_arg_vec
+            = binary_injector::prepare_binary_args(pd()->jcp_.post_ops, ctx);
 
     prepare_padded_bias(bias, ctx.get_scratchpad_grantor());
 
@@ -561,6 +587,8 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
                 int icb_end = min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2);
                 const int oc_work = utils::this_block_size(ocb * jcp.oc_block,
                         jcp.oc, jcp.nb_oc_blocking * jcp.oc_block);
+                const int oc_l_off
+                        = oc_off_idx * (is_dst_layout_nxc ? 1 : jcp.oc_block);
                 int ic_work = icb_step * jcp.ic_block;
                 for (int icb = icb_l2; icb < icb_end; icb += icb_step) {
                     int curr_nb_ic = nstl::min(icb_step, icb_end - icb);
@@ -589,7 +617,9 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
                                 src_c + i_t_overflow * dilate_h * src_h_stride,
                                 dst_c, wht_w + i_t_overflow * wht_h_stride,
                                 bias_w, icb, kh_padding, kd_padding, owb,
-                                ic_work, oc_work, flags);
+                                ic_work, oc_work,
+                                post_ops_binary_rhs_arg_vec.data(), oc_l_off,
+                                dst, flags);
 
                         src_c += src_h_stride * jcp.stride_h;
                         dst_c += dst_h_stride;
@@ -620,7 +650,8 @@ void jit_sve_512_convolution_fwd_t<src_type, wei_type,
         // here as call parameters to avoid execution of prefetch instructions
         // with nullptr, other parameters are not used in real jit call here
         jit_sve_512_conv_3d_ker_pipeline_ow_thr(jit_ker, par_conv, src, dst,
-                weights, bias, 0, 0, 0, 0, 0, 0, 0);
+                weights, bias, 0, 0, 0, 0, 0, 0,
+                post_ops_binary_rhs_arg_vec.data(), 0, nullptr, 0);
     });
 }
 
@@ -78,7 +78,8 @@ struct jit_sve_512_convolution_fwd_t : public primitive_t {
 
     status_t init(engine_t *engine) override {
         CHECK(safe_ptr_assign(kernel_,
-                new jit_sve_512_conv_fwd_kernel(pd()->jcp_, *pd()->attr())));
+                new jit_sve_512_conv_fwd_kernel(
+                        pd()->jcp_, *pd()->attr(), *pd()->dst_md(0))));
         return kernel_->create_kernel();
     }
 
@@ -0,0 +1,348 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/broadcast_strategy.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/aarch64/jit_uni_binary.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+using namespace data_type;
+
+static bool data_type_supported(const data_type_t dtype) {
+    return utils::one_of(dtype, f32, bf16, s8, u8);
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_binary_t<isa>::pd_t::init(engine_t *engine) {
+    using sm = primitive_attr_t::skip_mask_t;
+
+    conf_.dst_type = dst_md()->data_type;
+    conf_.src0_type = src_md(0)->data_type;
+    conf_.src1_type = src_md(1)->data_type;
+
+    const bool is_i8 = utils::one_of(conf_.dst_type, s8, u8);
+
+    const bool ok = mayiuse(isa) && data_type_supported(conf_.dst_type)
+            && data_type_supported(conf_.src0_type)
+            && data_type_supported(conf_.src1_type)
+            && IMPLICATION(!is_i8,
+                    utils::everyone_is(
+                            conf_.dst_type, conf_.src0_type, conf_.src1_type))
+            && set_default_params() == status::success && !has_zero_dim_memory()
+            && attr()->has_default_values(sm::post_ops | sm::scales)
+            && IMPLICATION(!attr()->scales_.has_default_values(),
+                    check_scales_mask())
+            && post_ops_ok() && is_applicable();
+    if (!ok) return status::unimplemented;
+
+    const auto &po = attr()->post_ops_;
+    conf_.op_type = get_op_type(memory_desc_wrapper(src_md(0)));
+    conf_.do_scale_src0 = !attr()->scales_.get(DNNL_ARG_SRC_0).defined()
+            || !attr()->scales_.get(DNNL_ARG_SRC_0).has_default_values();
+    conf_.do_scale_src1 = !attr()->scales_.get(DNNL_ARG_SRC_1).defined()
+            || !attr()->scales_.get(DNNL_ARG_SRC_1).has_default_values();
+    conf_.do_sum = po.contain(primitive_kind::sum, 0)
+            && po.entry_[0].sum.scale != 0.f;
+    conf_.with_eltwise = po.find(primitive_kind::eltwise) != -1;
+    conf_.sum_scale = conf_.do_sum ? po.entry_[0].sum.scale : 0.f;
+    conf_.broadcast_src1_value = conf_.bcast_type == bcast_t::scalar
+            || (conf_.op_type == op_t::n_c_spatial
+                    && conf_.bcast_type == bcast_t::per_c);
+    conf_.use_stride_src1 = !conf_.broadcast_src1_value
+            && (conf_.bcast_type == bcast_t::none
+                    || conf_.op_type == op_t::n_spatial_c);
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+binary_op_t jit_uni_binary_t<isa>::pd_t::get_op_type(
+        const memory_desc_wrapper &src0_d) const {
+    const auto &strides = src0_d.blocking_desc().strides;
+    const auto ndims = src0_d.ndims();
+
+    if (!src0_d.is_plain())
+        return op_t::c_blocked;
+    else if (strides[1] == 1)
+        return op_t::n_spatial_c;
+    else if (strides[0] >= strides[1]
+            && IMPLICATION(ndims >= 3, strides[1] >= strides[2]))
+        return op_t::n_c_spatial;
+    return op_t::none;
+}
+
+template <cpu_isa_t isa>
+bool jit_uni_binary_t<isa>::pd_t::check_scales_mask() const {
+    for (const auto &s : attr()->scales_.scales_) {
+        if (s.second.mask_ != 0) return false;
+    }
+    return true;
+}
+
+template <cpu_isa_t isa>
+bool jit_uni_binary_t<isa>::pd_t::post_ops_ok() const {
+    const auto &p = attr()->post_ops_;
+    for (int i = 0; i < p.len(); i++) {
+        const auto &e = p.entry_[i];
+        if (p.contain(primitive_kind::sum, i)) {
+            if (i > 0) return false;
+            if (src_md(0)->data_type != dst_md()->data_type) return false;
+        } else if (!(e.is_eltwise()
+                           && eltwise_injector::is_alg_supported(
+                                   e.eltwise.alg)))
+            return false;
+    }
+    return true;
+}
+
+template <cpu_isa_t isa>
+bool jit_uni_binary_t<isa>::pd_t::is_applicable() {
+    const memory_desc_wrapper src0_d(src_md(0));
+    const memory_desc_wrapper src1_d(src_md(1));
+    const memory_desc_wrapper dst_d(dst_md());
+    const auto ndims = src0_d.ndims();
+
+    // check density first to avoid same non-dense src0 and src1 to pass
+    // the next check
+    bool ok = src0_d.is_dense(true) && src1_d.is_dense(true)
+            && dst_d.is_dense(true);
+    if (!ok) return false;
+
+    // source0 broadcast not supported
+    if (!src0_d.similar_to(dst_d, true, false, 0)) return false;
+
+    // Blocked layouts are processed a block of channels per vector. The
+    // padded channels are left untouched by the tail kernel.
+    if (!src0_d.is_plain()) {
+        const auto &bd = src0_d.blocking_desc();
+        ok = bd.inner_nblks == 1 && bd.inner_blks[0] == kernel_t::simd_w
+                && bd.inner_idxs[0] == 1;
+        if (!ok) return false;
+    }
+    if (get_op_type(src0_d) == op_t::none) return false;
+
+    const bcast_set_t supported_strategies {broadcasting_strategy_t::scalar,
+            broadcasting_strategy_t::per_oc,
+            broadcasting_strategy_t::per_oc_spatial,
+            broadcasting_strategy_t::no_broadcast};
+    switch (get_rhs_arg_broadcasting_strategy(
+            *src_md(1), dst_d, supported_strategies)) {
+        case broadcasting_strategy_t::no_broadcast:
+            // full tensor operation
+            conf_.bcast_type = bcast_t::none;
+            return src0_d.similar_to(src1_d, true, false, 0);
+        case broadcasting_strategy_t::scalar:
+            conf_.bcast_type = bcast_t::scalar;
+            return true;
+        case broadcasting_strategy_t::per_oc:
+        case broadcasting_strategy_t::per_oc_spatial: {
+            // src1 is 1xCx1x...x1, its channels are contiguous for plain
+            // layouts and layouts with a single block over channels.
+            conf_.bcast_type = bcast_t::per_c;
+            const auto &bd1 = src1_d.blocking_desc();
+            return ndims >= 2
+                    && (src1_d.is_plain()
+                            || (bd1.inner_nblks == 1
+                                    && bd1.inner_idxs[0] == 1));
+        }
+        default: return false;
+    }
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_binary_t<isa>::init(engine_t *engine) {
+    const auto &conf = pd()->get_conf();
+    CHECK(safe_ptr_assign(kernel_, new kernel_t(pd(), conf)));
+
+    const memory_desc_wrapper src0_d(pd()->src_md(0));
+    const dim_t C = src0_d.ndims() >= 2 ? src0_d.dims()[1] : 1;
+    if (conf.op_type == op_t::c_blocked && C % kernel_t::simd_w) {
+        CHECK(safe_ptr_assign(kernel_tail_,
+                new kernel_t(pd(), conf, true /*tail_kernel*/)));
+        CHECK(kernel_tail_->create_kernel());
+    }
+
+    return kernel_->create_kernel();
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_t<isa>::execute_no_bcast_strategy(const data_t *src0,
+        const data_t *src1, data_t *dst, const float *scale0,
+        const float *scale1) const {
+    const auto kernel = kernel_.get();
+    const dim_t simd_w = kernel_t::simd_w;
+
+    const memory_desc_wrapper src0_d(pd()->src_md(0));
+    const auto &conf = pd()->get_conf();
+    const int src0_type_size = types::data_type_size(conf.src0_type);
+    const int src1_type_size = types::data_type_size(conf.src1_type);
+    const int dst_type_size = types::data_type_size(conf.dst_type);
+    const dim_t nelems0 = src0_d.nelems(true);
+    const dim_t nelems0_simd = nelems0 / simd_w;
+    const dim_t nelems0_tail = nelems0 % simd_w;
+    const bool has_tail = nelems0_tail > 0;
+
+    const bool point_broadcast = conf.bcast_type == bcast_t::scalar;
+
+    // Compute strategy:
+    // Compute number of vectors, divide it equally between all threads.
+    // Last one will also handle a tail if present.
+    parallel(0, [&](const int ithr, const int nthr) {
+        dim_t start = 0, end = 0;
+        balance211(nelems0_simd + has_tail, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        const bool ithr_does_tail = has_tail && end == nelems0_simd + has_tail;
+        const dim_t n_simd_to_do = (end - start - ithr_does_tail) * simd_w;
+        const dim_t tail_to_do = ithr_does_tail * nelems0_tail;
+        const dim_t off = start * simd_w;
+
+        jit_binary_call_s p;
+        p.spat_offt_count = n_simd_to_do + tail_to_do;
+        p.src0 = src0 + off * src0_type_size;
+        p.src1 = src1 + (point_broadcast ? 0 : off * src1_type_size);
+        p.dst = dst + off * dst_type_size;
+        p.scales_src0 = scale0;
+        p.scales_src1 = scale1;
+        (*kernel)(&p);
+    });
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_t<isa>::execute_bcast_per_c_strategy(const data_t *src0,
+        const data_t *src1, data_t *dst, const float *scale0,
+        const float *scale1, bool blocked_oc_tail) const {
+    const auto kernel = kernel_.get();
+    const auto kernel_tail = kernel_tail_.get();
+    const dim_t simd_w = kernel_t::simd_w;
+
+    const memory_desc_wrapper src0_d(pd()->src_md(0));
+    const auto &conf = pd()->get_conf();
+    const int src0_type_size = types::data_type_size(conf.src0_type);
+    const int src1_type_size = types::data_type_size(conf.src1_type);
+    const int dst_type_size = types::data_type_size(conf.dst_type);
+    const auto ndims = src0_d.ndims();
+    const auto &dims = src0_d.dims();
+    const dim_t MB = dims[0];
+    const dim_t C = ndims >= 2 ? dims[1] : 1;
+    const dim_t SP = ndims >= 3 ? utils::array_product(dims + 2, ndims - 2) : 1;
+
+    const bool no_broadcast = conf.bcast_type == bcast_t::none;
+    const bool point_broadcast = conf.bcast_type == bcast_t::scalar;
+
+    const dim_t nelems_slice_src0
+            = utils::array_product(src0_d.padded_dims() + 1, ndims - 1);
+
+    // src1 is never broadcast over a subset of the minibatch, so apart from
+    // the tensor operation only its channel offset matters.
+    const auto src1_offset = [&](dim_t off, dim_t c) -> dim_t {
+        return no_broadcast ? off : (point_broadcast ? 0 : c);
+    };
+
+    if (conf.op_type == op_t::c_blocked) {
+        const dim_t C_blocks = utils::div_up(src0_d.padded_dims()[1], simd_w);
+        // Compute strategy:
+        // Each block is individual - parallel over MB and C_blocks safely.
+
+        parallel_nd(MB, C_blocks, [&](dim_t mb, dim_t C_blk) {
+            jit_binary_call_s p;
+            p.spat_offt_count = SP * simd_w;
+            const dim_t off = mb * nelems_slice_src0 + C_blk * SP * simd_w;
+            p.dst = dst + off * dst_type_size;
+            p.src0 = src0 + off * src0_type_size;
+            p.src1 = src1 + src1_offset(off, C_blk * simd_w) * src1_type_size;
+            p.scales_src0 = scale0;
+            p.scales_src1 = scale1;
+            if (blocked_oc_tail && C_blk == C_blocks - 1)
+                (*kernel_tail)(&p);
+            else
+                (*kernel)(&p);
+        });
+    } else if (conf.op_type == op_t::n_spatial_c) {
+        // Compute strategy:
+        // Each line of channels is individual, parallel over MB and spatial.
+
+        parallel_nd(MB, SP, [&](dim_t mb, dim_t sp) {
+            jit_binary_call_s p;
+            p.spat_offt_count = C;
+            const dim_t off = mb * nelems_slice_src0 + sp * C;
+            p.dst = dst + off * dst_type_size;
+            p.src0 = src0 + off * src0_type_size;
+            p.src1 = src1 + src1_offset(off, 0) * src1_type_size;
+            p.scales_src0 = scale0;
+            p.scales_src1 = scale1;
+            (*kernel)(&p);
+        });
+    } else if (conf.op_type == op_t::n_c_spatial) {
+        // Compute strategy:
+        // Each line of spatial is individual, parallel over MB and C.
+
+        parallel_nd(MB, C, [&](dim_t mb, dim_t c) {
+            jit_binary_call_s p;
+            p.spat_offt_count = SP;
+            const dim_t off = mb * nelems_slice_src0 + c * SP;
+            p.dst = dst + off * dst_type_size;
+            p.src0 = src0 + off * src0_type_size;
+            p.src1 = src1 + src1_offset(off, c) * src1_type_size;
+            p.scales_src0 = scale0;
+            p.scales_src1 = scale1;
+            (*kernel)(&p);
+        });
+    }
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_binary_t<isa>::execute(const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+    const auto src0 = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC_0);
+    const auto src1 = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC_1);
+    auto dst = CTX_OUT_CLEAN_MEM(data_t *, DNNL_ARG_DST, status);
+    CHECK(status);
+    const float *scales[2];
+    ASSIGN_INPUT_SCALE_VALUE(scales[0], DNNL_ARG_SRC_0);
+    ASSIGN_INPUT_SCALE_VALUE(scales[1], DNNL_ARG_SRC_1);
+
+    const auto &conf = pd()->get_conf();
+    // The last block of channels is processed by the tail kernel to keep
+    // the zero padding of dst and to not read src1 beyond its channels.
+    const bool blocked_oc_tail = kernel_tail_ != nullptr;
+
+    if (utils::one_of(conf.bcast_type, bcast_t::none, bcast_t::scalar)
+            && !blocked_oc_tail)
+        execute_no_bcast_strategy(src0, src1, dst, scales[0], scales[1]);
+    else
+        execute_bcast_per_c_strategy(
+                src0, src1, dst, scales[0], scales[1], blocked_oc_tail);
+
+    return status::success;
+}
+
+template struct jit_uni_binary_t<sve_512>;
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
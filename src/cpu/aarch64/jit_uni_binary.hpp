@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_JIT_UNI_BINARY_HPP
+#define CPU_AARCH64_JIT_UNI_BINARY_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+
+#include "cpu/aarch64/cpu_isa_traits.hpp"
+#include "cpu/aarch64/jit_primitive_conf.hpp"
+#include "cpu/aarch64/jit_uni_binary_kernel.hpp"
+#include "cpu/cpu_binary_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_binary_t : public primitive_t {
+    using op_t = binary_op_t;
+    using bcast_t = binary_bcast_t;
+
+    struct pd_t : public cpu_binary_pd_t {
+        using cpu_binary_pd_t::cpu_binary_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", isa, ""), jit_uni_binary_t);
+
+        status_t init(engine_t *engine);
+
+        const jit_binary_conf_t &get_conf() const { return conf_; };
+
+    private:
+        op_t get_op_type(const memory_desc_wrapper &src0_d) const;
+        bool check_scales_mask() const;
+        bool post_ops_ok() const;
+        bool is_applicable();
+
+        jit_binary_conf_t conf_;
+    };
+
+    jit_uni_binary_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+
+    using data_t = int8_t;
+    using kernel_t = jit_uni_binary_kernel_t<isa>;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    void execute_no_bcast_strategy(const data_t *src0, const data_t *src1,
+            data_t *dst, const float *scale0, const float *scale1) const;
+    void execute_bcast_per_c_strategy(const data_t *src0, const data_t *src1,
+            data_t *dst, const float *scale0, const float *scale1,
+            bool blocked_oc_tail) const;
+
+    std::unique_ptr<kernel_t> kernel_;
+    // used only in c_blocked strategy for the last block if oc tail exists
+    std::unique_ptr<kernel_t> kernel_tail_;
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,335 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/math_utils.hpp"
+#include "common/nstl.hpp"
+
+#include "cpu/aarch64/jit_uni_binary_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+using namespace Xbyak_aarch64;
+
+#define PARAM_OFF(x) offsetof(jit_binary_call_s, x)
+
+static bool is_cmp_op(alg_kind_t alg) {
+    using namespace alg_kind;
+    return utils::one_of(alg, binary_ge, binary_gt, binary_le, binary_lt,
+            binary_eq, binary_ne);
+}
+
+template <cpu_isa_t isa>
+jit_uni_binary_kernel_t<isa>::jit_uni_binary_kernel_t(
+        const binary_pd_t *pd, const jit_binary_conf_t conf, bool tail_kernel)
+    : pd_(pd)
+    , conf_(conf)
+    , is_tail_kernel_(tail_kernel)
+    , tail_size_(get_tail_size()) {
+    const auto &po = pd_->attr()->post_ops_;
+    for (int i = 0; i < po.len(); ++i) {
+        if (!po.entry_[i].is_eltwise()) continue;
+        eltwise_injectors_.emplace_back(new injector_t(this,
+                po.entry_[i].eltwise, true /*save_state*/, reg_elt_inj_table,
+                p_elt_inj_mask, p_elt_inj_tmp, p_elt_inj_all, true /*is_fwd*/,
+                false /*use_dst*/));
+    }
+}
+
+template <cpu_isa_t isa>
+size_t jit_uni_binary_kernel_t<isa>::get_tail_size() const {
+    // Only the c_blocked tail kernel has a tail known at creation time, the
+    // other tails are computed from the number of elements of a call.
+    if (!is_tail_kernel_) return 0;
+    const memory_desc_wrapper src0_d(pd_->src_md(0));
+    const dim_t C = src0_d.ndims() >= 2 ? src0_d.dims()[1] : 1;
+    return C % simd_w;
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::load_kernel_params() {
+    add_imm(X_DEFAULT_ADDR, reg_param, PARAM_OFF(src0), X_TMP_0);
+    ldr(reg_src0, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, PARAM_OFF(src1), X_TMP_0);
+    ldr(reg_src1, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, PARAM_OFF(dst), X_TMP_0);
+    ldr(reg_dst, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, PARAM_OFF(spat_offt_count), X_TMP_0);
+    ldr(reg_reverse_spat_offt, ptr(X_DEFAULT_ADDR));
+    if (conf_.do_scale_src0) {
+        add_imm(X_DEFAULT_ADDR, reg_param, PARAM_OFF(scales_src0), X_TMP_0);
+        ldr(reg_scales_src0, ptr(X_DEFAULT_ADDR));
+    }
+    if (conf_.do_scale_src1) {
+        add_imm(X_DEFAULT_ADDR, reg_param, PARAM_OFF(scales_src1), X_TMP_0);
+        ldr(reg_scales_src1, ptr(X_DEFAULT_ADDR));
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::compute_addr(
+        const XReg &addr, const XReg &base, data_type_t dt) {
+    // reg_offt is kept in elements, scale it by the data type size.
+    const int shift = math::ilog2q(types::data_type_size(dt));
+    add(addr, base, reg_offt, LSL, shift);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::load(const TReg &v, const XReg &addr,
+        int vec, data_type_t dt, bool tail) {
+    // Vectors of every data type hold simd_w elements, so MUL_VL offsets are
+    // scaled by the memory size of a vector for the given type.
+    const auto p = (tail ? p_tail : P_ALL_ONE) / T_z;
+    switch (dt) {
+        case data_type::f32: ld1w(v.s, p, ptr(addr, vec, MUL_VL)); break;
+        case data_type::bf16:
+            ld1h(v.s, p, ptr(addr, vec, MUL_VL));
+            lsl(v.s, v.s, 16);
+            break;
+        case data_type::s8:
+            ld1sb(v.s, p, ptr(addr, vec, MUL_VL));
+            scvtf(v.s, P_ALL_ONE / T_m, v.s);
+            break;
+        case data_type::u8:
+            ld1b(v.s, p, ptr(addr, vec, MUL_VL));
+            scvtf(v.s, P_ALL_ONE / T_m, v.s);
+            break;
+        default: assert(!"unsupported data type");
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::broadcast(
+        const TReg &v, const XReg &addr, data_type_t dt) {
+    switch (dt) {
+        case data_type::f32: ld1rw(v.s, P_ALL_ONE / T_z, ptr(addr)); break;
+        case data_type::bf16:
+            ld1rh(v.s, P_ALL_ONE / T_z, ptr(addr));
+            lsl(v.s, v.s, 16);
+            break;
+        case data_type::s8:
+            ld1rsb(v.s, P_ALL_ONE / T_z, ptr(addr));
+            scvtf(v.s, P_ALL_ONE / T_m, v.s);
+            break;
+        case data_type::u8:
+            ld1rb(v.s, P_ALL_ONE / T_z, ptr(addr));
+            scvtf(v.s, P_ALL_ONE / T_m, v.s);
+            break;
+        default: assert(!"unsupported data type");
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::store(
+        const TReg &v, const XReg &addr, int vec, bool tail) {
+    const auto &p = tail ? p_tail : P_ALL_ONE;
+    switch (conf_.dst_type) {
+        case data_type::f32: st1w(v.s, p, ptr(addr, vec, MUL_VL)); break;
+        case data_type::bf16:
+            // Round to nearest even: x + 0x7fff + ((x >> 16) & 1). NaNs are
+            // kept quiet instead.
+            lsr(vbf16_tmp.s, v.s, 16);
+            and_(vbf16_tmp.s, 1);
+            add(vbf16_tmp.s, vbf16_tmp.s, v.s);
+            add(vbf16_tmp.s, vbf16_tmp.s, vbf16_round.s);
+            fcmuo(p_cmp.s, P_ALL_ONE / T_z, v.s, v.s);
+            orr(v.s, 0x400000);
+            sel(v.s, p_cmp, v.s, vbf16_tmp.s);
+            lsr(v.s, v.s, 16);
+            st1h(v.s, p, ptr(addr, vec, MUL_VL));
+            break;
+        case data_type::s8:
+        case data_type::u8:
+            fmax(v.s, P_ALL_ONE / T_m, vsaturation_lbound.s);
+            fmin(v.s, P_ALL_ONE / T_m, vsaturation_ubound.s);
+            frinti(v.s, P_ALL_ONE / T_m, v.s);
+            fcvtzs(v.s, P_ALL_ONE / T_m, v.s);
+            st1b(v.s, p, ptr(addr, vec, MUL_VL));
+            break;
+        default: assert(!"unsupported data type");
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::perform_op(const TReg &v0, const TReg &v1) {
+    using namespace alg_kind;
+    const auto alg = pd_->desc()->alg_kind;
+    switch (alg) {
+        case binary_add: fadd(v0.s, v0.s, v1.s); break;
+        case binary_sub: fsub(v0.s, v0.s, v1.s); break;
+        case binary_mul: fmul(v0.s, v0.s, v1.s); break;
+        case binary_div: fdiv(v0.s, P_ALL_ONE / T_m, v1.s); break;
+        case binary_max: fmax(v0.s, P_ALL_ONE / T_m, v1.s); break;
+        case binary_min: fmin(v0.s, P_ALL_ONE / T_m, v1.s); break;
+        case binary_ge: fcmge(p_cmp.s, P_ALL_ONE / T_z, v0.s, v1.s); break;
+        case binary_gt: fcmgt(p_cmp.s, P_ALL_ONE / T_z, v0.s, v1.s); break;
+        case binary_le: fcmge(p_cmp.s, P_ALL_ONE / T_z, v1.s, v0.s); break;
+        case binary_lt: fcmgt(p_cmp.s, P_ALL_ONE / T_z, v1.s, v0.s); break;
+        case binary_eq: fcmeq(p_cmp.s, P_ALL_ONE / T_z, v0.s, v1.s); break;
+        case binary_ne: fcmne(p_cmp.s, P_ALL_ONE / T_z, v0.s, v1.s); break;
+        default: assert(!"not supported operation!");
+    }
+    if (is_cmp_op(alg)) sel(v0.s, p_cmp, vone.s, vzero.s);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::apply_postops(int nvecs) {
+    // Every injector saves the registers it uses, so the table register is
+    // shared and reloaded before each of them.
+    for (auto &inj : eltwise_injectors_) {
+        inj->load_table_addr();
+        inj->compute_vector_range(0, nvecs);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::compute_bcast(bool tail) {
+    if (conf_.broadcast_src1_value)
+        broadcast(vbcast_src1, reg_src1, conf_.src1_type);
+    else if (!conf_.use_stride_src1)
+        load(vbcast_src1, reg_src1, 0, conf_.src1_type, tail);
+    else
+        return;
+
+    // src1 stays the same over the call, apply its scale only once.
+    if (conf_.do_scale_src1)
+        fmul(vbcast_src1.s, vbcast_src1.s, vscales_src1.s);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::compute_dst(int nvecs, bool tail) {
+    compute_addr(reg_addr_src0, reg_src0, conf_.src0_type);
+    compute_addr(reg_addr_dst, reg_dst, conf_.dst_type);
+    if (conf_.use_stride_src1)
+        compute_addr(reg_addr_src1, reg_src1, conf_.src1_type);
+
+    for (int i = 0; i < nvecs; ++i) {
+        const TReg v0 = vsrc0(i);
+        const TReg v1 = conf_.use_stride_src1 ? vtmp(i) : vbcast_src1;
+
+        load(v0, reg_addr_src0, i, conf_.src0_type, tail);
+        if (conf_.do_scale_src0) fmul(v0.s, v0.s, vscales_src0.s);
+        if (conf_.use_stride_src1) {
+            load(v1, reg_addr_src1, i, conf_.src1_type, tail);
+            if (conf_.do_scale_src1) fmul(v1.s, v1.s, vscales_src1.s);
+        }
+
+        perform_op(v0, v1);
+
+        if (conf_.do_sum) {
+            load(vtmp(i), reg_addr_dst, i, conf_.dst_type, tail);
+            fmla(v0.s, P_ALL_ONE / T_m, vtmp(i).s, vsum_scale.s);
+        }
+    }
+
+    apply_postops(nvecs);
+
+    for (int i = 0; i < nvecs; ++i)
+        store(vsrc0(i), reg_addr_dst, i, tail);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::forward() {
+    Label unroll_loop, unroll_loop_tail, nelems_tail, end;
+
+    const auto set_const = [&](const TReg &v, float val) {
+        mov_imm(W_TMP_0, float2int(val));
+        dup(v.s, W_TMP_0);
+    };
+
+    if (conf_.do_sum) set_const(vsum_scale, conf_.sum_scale);
+    if (is_cmp_op(pd_->desc()->alg_kind)) {
+        set_const(vone, 1.f);
+        set_const(vzero, 0.f);
+    }
+    if (conf_.dst_type == data_type::bf16) {
+        mov_imm(W_TMP_0, 0x7fff);
+        dup(vbf16_round.s, W_TMP_0);
+    } else if (utils::one_of(conf_.dst_type, data_type::s8, data_type::u8)) {
+        const bool is_s8 = conf_.dst_type == data_type::s8;
+        set_const(vsaturation_lbound, is_s8 ? -128.f : 0.f);
+        set_const(vsaturation_ubound, is_s8 ? 127.f : 255.f);
+    }
+    if (conf_.do_scale_src0)
+        ld1rw(vscales_src0.s, P_ALL_ONE / T_z, ptr(reg_scales_src0));
+    if (conf_.do_scale_src1)
+        ld1rw(vscales_src1.s, P_ALL_ONE / T_z, ptr(reg_scales_src1));
+
+    // used in c_blocked strategy for the last block if oc tail exists
+    const bool treat_each_compute_step_as_tail
+            = is_tail_kernel_ && tail_size_ > 0;
+    if (treat_each_compute_step_as_tail) {
+        mov_imm(X_TMP_0, tail_size_);
+        whilelt(p_tail.s, xzr, X_TMP_0);
+    }
+
+    mov_imm(reg_offt, 0);
+    compute_bcast(treat_each_compute_step_as_tail);
+
+    L(unroll_loop);
+    {
+        cmp(reg_reverse_spat_offt, unroll * simd_w);
+        b(LT, unroll_loop_tail);
+        compute_dst(unroll, treat_each_compute_step_as_tail);
+        sub(reg_reverse_spat_offt, reg_reverse_spat_offt, unroll * simd_w);
+        add(reg_offt, reg_offt, unroll * simd_w);
+        b(unroll_loop);
+    }
+
+    L(unroll_loop_tail);
+    {
+        cmp(reg_reverse_spat_offt, simd_w);
+        b(LT, nelems_tail);
+        compute_dst(1, treat_each_compute_step_as_tail);
+        sub(reg_reverse_spat_offt, reg_reverse_spat_offt, simd_w);
+        add(reg_offt, reg_offt, simd_w);
+        b(unroll_loop_tail);
+    }
+
+    L(nelems_tail);
+    {
+        cmp(reg_reverse_spat_offt, 0);
+        b(LE, end);
+        whilelt(p_tail.s, xzr, reg_reverse_spat_offt);
+        compute_dst(1, true);
+    }
+
+    L(end);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_binary_kernel_t<isa>::generate() {
+    preamble();
+    load_kernel_params();
+    forward();
+    postamble();
+
+    for (auto &inj : eltwise_injectors_)
+        inj->prepare_table();
+}
+
+#undef PARAM_OFF
+
+template struct jit_uni_binary_kernel_t<sve_512>;
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
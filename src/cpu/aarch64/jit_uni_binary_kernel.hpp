@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_JIT_UNI_BINARY_KERNEL_HPP
+#define CPU_AARCH64_JIT_UNI_BINARY_KERNEL_HPP
+
+#include <memory>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/aarch64/cpu_isa_traits.hpp"
+#include "cpu/aarch64/injectors/jit_uni_eltwise_injector.hpp"
+#include "cpu/aarch64/jit_generator.hpp"
+#include "cpu/aarch64/jit_primitive_conf.hpp"
+
+#include "cpu/cpu_binary_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+// Computes dst = post_ops(op(scale0 * src0, scale1 * src1)) for
+// spat_offt_count consecutive dst elements. The computations are done in f32,
+// other data types are converted on load and store.
+template <cpu_isa_t isa>
+struct jit_uni_binary_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_binary_kernel_t)
+
+    using op_t = binary_op_t;
+    using bcast_t = binary_bcast_t;
+
+    jit_uni_binary_kernel_t(const binary_pd_t *pd, const jit_binary_conf_t conf,
+            bool tail_kernel = false);
+
+    void operator()(jit_binary_call_s *p) { jit_generator::operator()(p); }
+
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+private:
+    using TReg = typename cpu_isa_traits<isa>::TReg;
+    using XReg = Xbyak_aarch64::XReg;
+    using PReg = Xbyak_aarch64::PReg;
+    using injector_t = jit_uni_eltwise_injector_f32<isa>;
+
+    static constexpr int unroll = 4;
+
+    void generate() override;
+
+    size_t get_tail_size() const;
+    void load_kernel_params();
+    void compute_addr(const XReg &addr, const XReg &base, data_type_t dt);
+    void load(const TReg &v, const XReg &addr, int vec, data_type_t dt,
+            bool tail);
+    void broadcast(const TReg &v, const XReg &addr, data_type_t dt);
+    void store(const TReg &v, const XReg &addr, int vec, bool tail);
+    void perform_op(const TReg &v0, const TReg &v1);
+    void apply_postops(int nvecs);
+    void compute_bcast(bool tail);
+    void compute_dst(int nvecs, bool tail);
+    void forward();
+
+    const binary_pd_t *pd_;
+    const jit_binary_conf_t conf_;
+    const bool is_tail_kernel_;
+    const size_t tail_size_;
+
+    std::vector<std::unique_ptr<injector_t>> eltwise_injectors_;
+
+    XReg reg_param = abi_param1;
+    XReg reg_elt_inj_table = x3;
+    XReg reg_addr_src0 = x4;
+    XReg reg_addr_src1 = x5;
+    XReg reg_addr_dst = x6;
+    XReg reg_src0 = x8;
+    XReg reg_src1 = x9;
+    XReg reg_dst = x10;
+    XReg reg_offt = x11;
+    XReg reg_reverse_spat_offt = x12;
+    XReg reg_scales_src0 = x13;
+    XReg reg_scales_src1 = x14;
+
+    const PReg p_tail = p1;
+    const PReg p_cmp = p2;
+    const PReg p_elt_inj_mask = p3;
+    const PReg p_elt_inj_tmp = p4;
+    const PReg p_elt_inj_all = p7;
+
+    TReg vsrc0(int idx) const { return TReg(idx); }
+    TReg vtmp(int idx) const { return TReg(unroll + idx); }
+    TReg vbcast_src1 = TReg(20);
+    TReg vscales_src0 = TReg(21);
+    TReg vscales_src1 = TReg(22);
+    TReg vsum_scale = TReg(23);
+    TReg vone = TReg(24);
+    TReg vzero = TReg(25);
+    TReg vsaturation_lbound = TReg(26);
+    TReg vsaturation_ubound = TReg(27);
+    TReg vbf16_round = TReg(28);
+    TReg vbf16_tmp = TReg(29);
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
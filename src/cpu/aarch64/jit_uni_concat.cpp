@@ -0,0 +1,64 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/memory_tracking.hpp"
+
+#include "cpu/aarch64/jit_uni_concat.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+status_t jit_uni_concat_t<isa>::init(engine_t *engine) {
+    CHECK(safe_ptr_assign(
+            kernel_, new jit_uni_concat_kernel_t<isa>(pd()->conf_)));
+    return kernel_->create_kernel();
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_concat_t<isa>::execute(const exec_ctx_t &ctx) const {
+    const int n = pd()->n_inputs();
+    std::vector<const char *> srcs(n);
+    for (int i = 0; i < n; ++i)
+        srcs[i] = CTX_IN_MEM(const char *, DNNL_ARG_MULTIPLE_SRC + i);
+
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST)
+            + dst_d.offset0() * dst_d.data_type_size();
+
+    auto scratchpad = ctx.get_scratchpad_grantor().template get<
+            concat_utils::job_t>(memory_tracking::names::key_concat_jobs);
+
+    concat_utils::execute(pd()->conf_,
+            [&](const concat_utils::call_params_t *p) { (*kernel_)(p); },
+            srcs, dst, scratchpad);
+
+    return status::success;
+}
+
+template struct jit_uni_concat_t<sve_512>;
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,82 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_JIT_UNI_CONCAT_HPP
+#define CPU_AARCH64_JIT_UNI_CONCAT_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/aarch64/cpu_isa_traits.hpp"
+#include "cpu/aarch64/jit_uni_concat_kernel.hpp"
+#include "cpu/concat_utils.hpp"
+#include "cpu/cpu_concat_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_concat_t : public primitive_t {
+    struct pd_t : public cpu_concat_pd_t {
+        using cpu_concat_pd_t::cpu_concat_pd_t;
+
+        DECLARE_CONCAT_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", isa, ""), jit_uni_concat_t);
+
+        status_t init(engine_t *engine) {
+            if (!mayiuse(isa)) return status::unimplemented;
+
+            // The inputs that are not block-aligned have no images in dst,
+            // which is handled by the blocked layout of the concat.
+            CHECK(concat_utils::init_dst_md(dst_md_, this));
+            const bool has_src_images
+                    = cpu_concat_pd_t::init() == status::success;
+            CHECK(concat_utils::init_conf(conf_, this, has_src_images));
+
+            auto scratchpad = scratchpad_registry().registrar();
+            concat_utils::init_scratchpad(scratchpad, conf_);
+
+            return status::success;
+        }
+
+        concat_utils::conf_t conf_;
+    };
+
+    jit_uni_concat_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<jit_uni_concat_kernel_t<isa>> kernel_;
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,142 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/utils.hpp"
+
+#include "cpu/aarch64/jit_uni_concat_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+using namespace Xbyak_aarch64;
+
+#define GET_OFF(field) offsetof(concat_utils::call_params_t, field)
+#define GET_JOB_OFF(field) \
+    static_cast<int32_t>(offsetof(concat_utils::job_t, field))
+
+template <cpu_isa_t isa>
+void jit_uni_concat_kernel_t<isa>::store(
+        const TReg &v, const PReg &p, int vec) {
+    if (use_nt_stores_)
+        stnt1b(v.b, p, ptr(reg_dst, vec, MUL_VL));
+    else
+        st1b(v.b, p, ptr(reg_dst, vec, MUL_VL));
+}
+
+template <cpu_isa_t isa>
+void jit_uni_concat_kernel_t<isa>::copy_row() {
+    Label l_unroll_loop, l_loop, l_tail, l_end;
+
+    L(l_unroll_loop);
+    {
+        cmp(reg_bytes, unroll * vlen);
+        b(LT, l_loop);
+        for (int i = 0; i < unroll; ++i)
+            ld1b(TReg(i).b, P_ALL_ONE / T_z, ptr(reg_src, i, MUL_VL));
+        for (int i = 0; i < unroll; ++i)
+            store(TReg(i), P_ALL_ONE, i);
+        add_imm(reg_src, reg_src, unroll * vlen, X_TMP_0);
+        add_imm(reg_dst, reg_dst, unroll * vlen, X_TMP_0);
+        sub(reg_bytes, reg_bytes, unroll * vlen);
+        b(l_unroll_loop);
+    }
+
+    L(l_loop);
+    {
+        cmp(reg_bytes, vlen);
+        b(LT, l_tail);
+        ld1b(TReg(0).b, P_ALL_ONE / T_z, ptr(reg_src));
+        store(TReg(0), P_ALL_ONE, 0);
+        add_imm(reg_src, reg_src, vlen, X_TMP_0);
+        add_imm(reg_dst, reg_dst, vlen, X_TMP_0);
+        sub(reg_bytes, reg_bytes, vlen);
+        b(l_loop);
+    }
+
+    L(l_tail);
+    {
+        cmp(reg_bytes, 0);
+        b(LE, l_end);
+        whilelt(p_tail.b, xzr, reg_bytes);
+        ld1b(TReg(0).b, p_tail / T_z, ptr(reg_src));
+        store(TReg(0), p_tail, 0);
+    }
+    L(l_end);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_concat_kernel_t<isa>::generate() {
+    preamble();
+
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(jobs), X_TMP_0);
+    ldr(reg_jobs, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(njobs), X_TMP_0);
+    ldr(reg_njobs, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(nrows), X_TMP_0);
+    ldr(reg_nrows, ptr(X_DEFAULT_ADDR));
+
+    Label l_row_loop, l_job_loop, l_end;
+
+    cbz(reg_njobs, l_end);
+    cbz(reg_nrows, l_end);
+    mov_imm(reg_row, 0);
+
+    // The jobs are processed row by row, so that the rows of dst are written
+    // one after another.
+    L(l_row_loop);
+    {
+        mov(reg_job, reg_jobs);
+        mov(reg_j, reg_njobs);
+
+        L(l_job_loop);
+        {
+            ldr(reg_src, ptr(reg_job, GET_JOB_OFF(src)));
+            ldr(reg_tmp, ptr(reg_job, GET_JOB_OFF(src_stride)));
+            madd(reg_src, reg_tmp, reg_row, reg_src);
+            ldr(reg_dst, ptr(reg_job, GET_JOB_OFF(dst)));
+            ldr(reg_tmp, ptr(reg_job, GET_JOB_OFF(dst_stride)));
+            madd(reg_dst, reg_tmp, reg_row, reg_dst);
+            ldr(reg_bytes, ptr(reg_job, GET_JOB_OFF(bytes)));
+
+            copy_row();
+
+            add_imm(reg_job, reg_job, sizeof(concat_utils::job_t), X_TMP_0);
+            subs(reg_j, reg_j, 1);
+            b(NE, l_job_loop);
+        }
+
+        add(reg_row, reg_row, 1);
+        cmp(reg_row, reg_nrows);
+        b(LT, l_row_loop);
+    }
+    L(l_end);
+
+    postamble();
+}
+
+#undef GET_JOB_OFF
+#undef GET_OFF
+
+template struct jit_uni_concat_kernel_t<sve_512>;
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_JIT_UNI_CONCAT_KERNEL_HPP
+#define CPU_AARCH64_JIT_UNI_CONCAT_KERNEL_HPP
+
+#include "common/c_types_map.hpp"
+
+#include "cpu/aarch64/jit_generator.hpp"
+#include "cpu/concat_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+// Copies the rows of the jobs, see cpu/concat_utils.hpp for the description
+// of the call parameters.
+template <cpu_isa_t isa>
+struct jit_uni_concat_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_concat_kernel_t)
+
+    jit_uni_concat_kernel_t(const concat_utils::conf_t &conf)
+        : use_nt_stores_(conf.use_nt_stores) {}
+
+    void operator()(const concat_utils::call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+private:
+    using TReg = typename cpu_isa_traits<isa>::TReg;
+    using XReg = Xbyak_aarch64::XReg;
+    using PReg = Xbyak_aarch64::PReg;
+
+    static constexpr int vlen = cpu_isa_traits<isa>::vlen;
+    static constexpr int unroll = 4;
+
+    void generate() override;
+
+    void store(const TReg &v, const PReg &p, int vec);
+    void copy_row();
+
+    const bool use_nt_stores_;
+
+    XReg reg_param = abi_param1;
+    XReg reg_jobs = x8;
+    XReg reg_njobs = x9;
+    XReg reg_nrows = x10;
+    XReg reg_row = x11;
+    XReg reg_job = x12;
+    XReg reg_j = x13;
+    XReg reg_src = x14;
+    XReg reg_dst = x15;
+    XReg reg_bytes = x6;
+    XReg reg_tmp = x7;
+
+    const PReg p_tail = p1;
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,795 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/aarch64/cpu_isa_traits.hpp"
+#include "cpu/aarch64/jit_generator.hpp"
+#include "cpu/aarch64/jit_uni_layer_normalization_kernels.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+namespace lnorm_utils {
+
+using namespace dnnl::impl::cpu::lnorm_utils;
+using namespace data_type;
+using namespace Xbyak_aarch64;
+
+// Moves rows of f32 or bf16 data between memory and f32 vectors. Rows are
+// fully unrolled over C, the last vector of a row is handled with p_tail.
+struct jit_transfer_t {
+    // A pointer walked along a row, vec_bytes is the memory size of a vector.
+    struct walker_t {
+        XReg aux;
+        XReg base;
+        int vec_bytes;
+    };
+
+    static constexpr int simd_w = cpu_isa_traits<sve_512>::vlen / sizeof(float);
+    // MUL_VL immediates of contiguous loads and stores are limited to [-8, 7]
+    static constexpr int chunk = 8;
+
+    jit_transfer_t(jit_generator &gen, data_type_t dt, int C)
+        : gen_(gen), dt_(dt), C_(C) {}
+
+    int data_vec_bytes() const {
+        return simd_w * static_cast<int>(types::data_type_size(dt_));
+    }
+    int f32_vec_bytes() const { return cpu_isa_traits<sve_512>::vlen; }
+    int nvecs() const { return utils::div_up(C_, simd_w); }
+    bool has_tail() const { return C_ % simd_w != 0; }
+
+    void prepare() const {
+        if (has_tail()) {
+            gen_.mov_imm(gen_.X_TMP_0, C_ % simd_w);
+            gen_.whilelt(p_tail.s, gen_.xzr, gen_.X_TMP_0);
+        }
+        if (dt_ == bf16) {
+            gen_.mov_imm(gen_.W_TMP_0, 0x7fff);
+            gen_.dup(vbf16_round_.s, gen_.W_TMP_0);
+        }
+    }
+
+    void set_const(const ZReg &v, float val) const {
+        gen_.mov_imm(gen_.W_TMP_0, float2int(val));
+        gen_.dup(v.s, gen_.W_TMP_0);
+    }
+
+    void load(const ZReg &v, const XReg &addr, int vec, bool tail,
+            data_type_t dt) const {
+        const auto p = (tail ? p_tail : gen_.P_ALL_ONE) / T_z;
+        if (dt == bf16) {
+            gen_.ld1h(v.s, p, ptr(addr, vec, MUL_VL));
+            gen_.lsl(v.s, v.s, 16);
+        } else
+            gen_.ld1w(v.s, p, ptr(addr, vec, MUL_VL));
+    }
+    void load(const ZReg &v, const XReg &addr, int vec, bool tail) const {
+        load(v, addr, vec, tail, dt_);
+    }
+
+    void store(const ZReg &v, const XReg &addr, int vec, bool tail,
+            data_type_t dt) const {
+        const auto &p = tail ? p_tail : gen_.P_ALL_ONE;
+        if (dt == bf16) {
+            // Round to nearest even: x + 0x7fff + ((x >> 16) & 1). NaNs are
+            // kept quiet instead.
+            gen_.lsr(vbf16_tmp_.s, v.s, 16);
+            gen_.and_(vbf16_tmp_.s, 1);
+            gen_.add(vbf16_tmp_.s, vbf16_tmp_.s, v.s);
+            gen_.add(vbf16_tmp_.s, vbf16_tmp_.s, vbf16_round_.s);
+            gen_.fcmuo(p_cmp_.s, gen_.P_ALL_ONE / T_z, v.s, v.s);
+            gen_.orr(v.s, 0x400000);
+            gen_.sel(v.s, p_cmp_, v.s, vbf16_tmp_.s);
+            gen_.lsr(v.s, v.s, 16);
+            gen_.st1h(v.s, p, ptr(addr, vec, MUL_VL));
+        } else
+            gen_.st1w(v.s, p, ptr(addr, vec, MUL_VL));
+    }
+    void store(const ZReg &v, const XReg &addr, int vec, bool tail) const {
+        store(v, addr, vec, tail, dt_);
+    }
+
+    // Calls f(i, vec, tail) for every vector i of a row, where vec is the
+    // offset of the vector from the current position of the walkers.
+    template <typename F>
+    void for_each_vec(const std::vector<walker_t> &walkers, F f) const {
+        for (const auto &w : walkers)
+            gen_.mov(w.aux, w.base);
+        for (int i = 0; i < nvecs(); i++) {
+            if (i > 0 && i % chunk == 0)
+                for (const auto &w : walkers)
+                    gen_.add_imm(
+                            w.aux, w.aux, chunk * w.vec_bytes, gen_.X_TMP_0);
+            f(i, i % chunk, has_tail() && i == nvecs() - 1);
+        }
+    }
+
+    const PReg p_tail = PReg(1);
+
+private:
+    jit_generator &gen_;
+    const data_type_t dt_;
+    const int C_;
+
+    const ZReg vbf16_round_ = ZReg(30);
+    const ZReg vbf16_tmp_ = ZReg(31);
+    const PReg p_cmp_ = PReg(3);
+};
+
+template <data_type_t data_type>
+struct jit_stat_and_data_kernel_t : stat_and_data_kernel_t<data_type>,
+                                    public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(lnorm_utils::jit_stat_and_data_kernel_t);
+
+    jit_stat_and_data_kernel_t(const layer_normalization_pd_t *pd);
+
+    using data_t = typename prec_traits<data_type>::type;
+    void operator()(const data_t *src, data_t *dst, const float *scale,
+            const float *shift, float *mean, float *var,
+            const size_t block_size) const override;
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    jit_transfer_t jit_transfer_;
+    // number of independent Welford accumulators
+    static constexpr int unroll_factor_ = 4;
+    using stat_and_data_kernel_t<data_type>::C_;
+    using stat_and_data_kernel_t<data_type>::use_scaleshift_;
+    using stat_and_data_kernel_t<data_type>::use_scale_;
+    using stat_and_data_kernel_t<data_type>::use_shift_;
+    using stat_and_data_kernel_t<data_type>::save_stats_;
+    using stat_and_data_kernel_t<data_type>::calculate_stats_;
+    using stat_and_data_kernel_t<data_type>::eps_;
+
+    struct ker_args_t {
+        const data_t *src;
+        data_t *dst;
+        const float *scale;
+        const float *shift;
+        float *mean;
+        float *var;
+        size_t block_size;
+    };
+
+    void generate() override;
+
+    void compute_stats();
+    void compute_dst();
+
+    const XReg reg_param = abi_param1;
+    const XReg reg_src = x1;
+    const XReg reg_dst = x2;
+    const XReg reg_scale = x3;
+    const XReg reg_shift = x4;
+    const XReg reg_mean = x5;
+    const XReg reg_var = x6;
+    const XReg reg_block_end = x7;
+    const XReg reg_src_aux = x8;
+    const XReg reg_dst_aux = x9;
+    const XReg reg_scale_aux = x10;
+    const XReg reg_shift_aux = x11;
+
+    const PReg p_lane0 = p2;
+
+    // Welford state of accumulator j: running mean, M2 and element count
+    ZReg vmm_wmean(int j) const { return ZReg(j); }
+    ZReg vmm_wm2(int j) const { return ZReg(unroll_factor_ + j); }
+    ZReg vmm_wsrc(int j) const { return ZReg(2 * unroll_factor_ + j); }
+    ZReg vmm_wdelta(int j) const { return ZReg(3 * unroll_factor_ + j); }
+    ZReg vmm_wcount(int j) const { return ZReg(4 * unroll_factor_ + j); }
+
+    const ZReg vmm_inv_count = ZReg(20);
+    const ZReg vmm_acc = ZReg(21);
+    const ZReg vmm_inv_C = ZReg(22);
+    const ZReg vmm_eps = ZReg(23);
+    const ZReg vmm_ones = ZReg(24);
+    const ZReg vmm_mean = ZReg(25);
+    const ZReg vmm_inv_sqrtvar = ZReg(26);
+    const ZReg vmm_gamma = ZReg(27);
+    const ZReg vmm_beta = ZReg(28);
+    const ZReg vmm_data = ZReg(29);
+};
+
+template <data_type_t data_type>
+jit_stat_and_data_kernel_t<data_type>::jit_stat_and_data_kernel_t(
+        const layer_normalization_pd_t *pd)
+    : stat_and_data_kernel_t<data_type>(pd)
+    , jit_transfer_ {*this, data_type, C_} {
+    assert(mayiuse(sve_512));
+}
+
+template <data_type_t data_type>
+void jit_stat_and_data_kernel_t<data_type>::operator()(const data_t *src,
+        data_t *dst, const float *scale, const float *shift, float *mean,
+        float *var, const size_t block_size) const {
+    ker_args_t args;
+    args.src = src;
+    args.dst = dst;
+    args.scale = scale;
+    args.shift = shift;
+    args.mean = mean;
+    args.var = var;
+    args.block_size = block_size * C_ * types::data_type_size(data_type);
+    jit_generator::operator()(&args);
+}
+
+// Single pass over the row. Vector i updates the Welford state of
+// accumulator i % unroll_factor_, whose lanes have all seen i / unroll_factor_
+// elements before, so the count is known at generation time. The per-lane
+// states are merged afterwards with the parallel variance formula.
+template <data_type_t data_type>
+void jit_stat_and_data_kernel_t<data_type>::compute_stats() {
+    const int nvecs = jit_transfer_.nvecs();
+    const int nacc = nvecs < unroll_factor_ ? nvecs : unroll_factor_;
+    const auto &p_tail = jit_transfer_.p_tail;
+
+    for (int j = 0; j < nacc; j++) {
+        dup(vmm_wmean(j).s, 0);
+        dup(vmm_wm2(j).s, 0);
+    }
+
+    jit_transfer_.for_each_vec({{reg_src_aux, reg_src,
+                                       jit_transfer_.data_vec_bytes()}},
+            [&](int i, int vec, bool tail) {
+                const int j = i % nacc;
+                if (j == 0)
+                    jit_transfer_.set_const(
+                            vmm_inv_count, 1.f / (i / nacc + 1));
+                const auto p = (tail ? p_tail : P_ALL_ONE) / T_m;
+                jit_transfer_.load(vmm_wsrc(j), reg_src_aux, vec, tail);
+                fsub(vmm_wdelta(j).s, vmm_wsrc(j).s, vmm_wmean(j).s);
+                fmla(vmm_wmean(j).s, p, vmm_wdelta(j).s, vmm_inv_count.s);
+                fsub(vmm_wsrc(j).s, vmm_wsrc(j).s, vmm_wmean(j).s);
+                fmla(vmm_wm2(j).s, p, vmm_wdelta(j).s, vmm_wsrc(j).s);
+            });
+
+    // mean = sum(n_j * mean_j) / C
+    const int nfull = C_ / jit_transfer_t::simd_w;
+    dup(vmm_acc.s, 0);
+    for (int j = 0; j < nacc; j++) {
+        const int count = nfull / nacc + (j < nfull % nacc);
+        jit_transfer_.set_const(vmm_wcount(j), count);
+        if (jit_transfer_.has_tail() && j == nfull % nacc)
+            fadd(vmm_wcount(j).s, p_tail / T_m, 1.f);
+        fmla(vmm_acc.s, P_ALL_ONE / T_m, vmm_wcount(j).s, vmm_wmean(j).s);
+    }
+    faddv(SReg(vmm_acc.getIdx()), P_ALL_ONE, vmm_acc.s);
+    dup(vmm_mean.s, vmm_acc.s[0]);
+    fmul(vmm_mean.s, vmm_mean.s, vmm_inv_C.s);
+
+    // var = sum(M2_j + n_j * (mean_j - mean)^2) / C
+    dup(vmm_acc.s, 0);
+    for (int j = 0; j < nacc; j++) {
+        fsub(vmm_wdelta(j).s, vmm_wmean(j).s, vmm_mean.s);
+        fmul(vmm_wdelta(j).s, vmm_wdelta(j).s, vmm_wdelta(j).s);
+        fmla(vmm_wm2(j).s, P_ALL_ONE / T_m, vmm_wcount(j).s,
+                vmm_wdelta(j).s);
+        fadd(vmm_acc.s, vmm_acc.s, vmm_wm2(j).s);
+    }
+    faddv(SReg(vmm_acc.getIdx()), P_ALL_ONE, vmm_acc.s);
+    dup(vmm_inv_sqrtvar.s, vmm_acc.s[0]);
+    fmul(vmm_inv_sqrtvar.s, vmm_inv_sqrtvar.s, vmm_inv_C.s);
+}
+
+template <data_type_t data_type>
+void jit_stat_and_data_kernel_t<data_type>::compute_dst() {
+    const bool with_scale = use_scaleshift_ || use_scale_;
+    const bool with_shift = use_scaleshift_ || use_shift_;
+
+    std::vector<jit_transfer_t::walker_t> walkers {
+            {reg_src_aux, reg_src, jit_transfer_.data_vec_bytes()},
+            {reg_dst_aux, reg_dst, jit_transfer_.data_vec_bytes()}};
+    if (with_scale)
+        walkers.push_back(
+                {reg_scale_aux, reg_scale, jit_transfer_.f32_vec_bytes()});
+    if (with_shift)
+        walkers.push_back(
+                {reg_shift_aux, reg_shift, jit_transfer_.f32_vec_bytes()});
+
+    jit_transfer_.for_each_vec(walkers, [&](int i, int vec, bool tail) {
+        if (with_scale)
+            jit_transfer_.load(vmm_gamma, reg_scale_aux, vec, tail, f32);
+        if (with_shift)
+            jit_transfer_.load(vmm_beta, reg_shift_aux, vec, tail, f32);
+        jit_transfer_.load(vmm_data, reg_src_aux, vec, tail);
+        fsub(vmm_data.s, vmm_data.s, vmm_mean.s);
+        fmul(vmm_data.s, vmm_data.s, vmm_inv_sqrtvar.s);
+        if (with_scale && with_shift)
+            fmad(vmm_data.s, P_ALL_ONE / T_m, vmm_gamma.s, vmm_beta.s);
+        else if (with_scale)
+            fmul(vmm_data.s, vmm_data.s, vmm_gamma.s);
+        else if (with_shift)
+            fadd(vmm_data.s, vmm_data.s, vmm_beta.s);
+        jit_transfer_.store(vmm_data, reg_dst_aux, vec, tail);
+    });
+}
+
+template <data_type_t data_type>
+void jit_stat_and_data_kernel_t<data_type>::generate() {
+    const auto c_size = C_ * types::data_type_size(data_type);
+    static const auto float_size = types::data_type_size(f32);
+
+    preamble();
+#define PARAM_OFF(x) static_cast<int32_t>(offsetof(ker_args_t, x))
+    ldr(reg_src, ptr(reg_param, PARAM_OFF(src)));
+    ldr(reg_dst, ptr(reg_param, PARAM_OFF(dst)));
+    ldr(reg_scale, ptr(reg_param, PARAM_OFF(scale)));
+    ldr(reg_shift, ptr(reg_param, PARAM_OFF(shift)));
+    ldr(reg_mean, ptr(reg_param, PARAM_OFF(mean)));
+    ldr(reg_var, ptr(reg_param, PARAM_OFF(var)));
+    ldr(reg_block_end, ptr(reg_param, PARAM_OFF(block_size)));
+#undef PARAM_OFF
+
+    jit_transfer_.prepare();
+    ptrue(p_lane0.s, VL1);
+    jit_transfer_.set_const(vmm_inv_C, 1.f / C_);
+    jit_transfer_.set_const(vmm_eps, eps_);
+    jit_transfer_.set_const(vmm_ones, 1.f);
+
+    // add block_start to block_size to define block_end
+    add(reg_block_end, reg_block_end, reg_src);
+
+    Label unroll_loop, end;
+    L(unroll_loop);
+    {
+        cmp(reg_block_end, reg_src);
+        b(LE, end);
+
+        if (calculate_stats_) {
+            compute_stats();
+            if (save_stats_) {
+                st1w(vmm_mean.s, p_lane0, ptr(reg_mean));
+                st1w(vmm_inv_sqrtvar.s, p_lane0, ptr(reg_var));
+            }
+        } else {
+            // read mean and var from input
+            ld1rw(vmm_mean.s, P_ALL_ONE / T_z, ptr(reg_mean));
+            ld1rw(vmm_inv_sqrtvar.s, P_ALL_ONE / T_z, ptr(reg_var));
+        }
+
+        // calculate inv_sqrtvar
+        fadd(vmm_inv_sqrtvar.s, vmm_inv_sqrtvar.s, vmm_eps.s);
+        fsqrt(vmm_inv_sqrtvar.s, P_ALL_ONE / T_m, vmm_inv_sqrtvar.s);
+        fdivr(vmm_inv_sqrtvar.s, P_ALL_ONE / T_m, vmm_ones.s);
+
+        compute_dst();
+
+        add_imm(reg_src, reg_src, c_size, X_TMP_0);
+        add_imm(reg_dst, reg_dst, c_size, X_TMP_0);
+        add_imm(reg_mean, reg_mean, float_size, X_TMP_0);
+        add_imm(reg_var, reg_var, float_size, X_TMP_0);
+        b(unroll_loop);
+    }
+    L(end);
+
+    postamble();
+}
+
+template <data_type_t data_type>
+struct jit_diff_ss_kernel_t : diff_ss_kernel_t<data_type>,
+                              public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(lnorm_utils::jit_diff_ss_kernel_t);
+
+    jit_diff_ss_kernel_t(const layer_normalization_pd_t *pd);
+
+    using data_t = typename prec_traits<data_type>::type;
+    void operator()(const data_t *src, const data_t *diff_dst,
+            float *diff_gamma, float *diff_beta, const float *mean,
+            const float *var, float *const inv_sqrtvar,
+            const size_t block_size) const override;
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    jit_transfer_t jit_transfer_;
+    static constexpr int unroll_factor_ = 4;
+    using diff_ss_kernel_t<data_type>::C_;
+    using diff_ss_kernel_t<data_type>::eps_;
+
+    struct ker_args_t {
+        const data_t *src;
+        const data_t *diff_dst;
+        float *diff_gamma;
+        float *diff_beta;
+        const float *mean;
+        const float *inv_sqrtvar;
+        size_t block_size;
+    };
+
+    void generate() override;
+
+    const XReg reg_param = abi_param1;
+    const XReg reg_src = x1;
+    const XReg reg_diff_dst = x2;
+    const XReg reg_block_end = x3;
+    const XReg reg_mean = x4;
+    const XReg reg_inv_sqrtvar = x5;
+    const XReg reg_diff_gamma = x6;
+    const XReg reg_diff_beta = x7;
+    const XReg reg_src_aux = x8;
+    const XReg reg_diff_dst_aux = x9;
+    const XReg reg_diff_gamma_aux = x10;
+    const XReg reg_diff_beta_aux = x11;
+
+    ZReg vmm_ddst(int j) const { return ZReg(j); }
+    ZReg vmm_dgamma(int j) const { return ZReg(unroll_factor_ + j); }
+    ZReg vmm_dbeta(int j) const { return ZReg(2 * unroll_factor_ + j); }
+    ZReg vmm_src(int j) const { return ZReg(3 * unroll_factor_ + j); }
+
+    const ZReg vmm_inv_sqrtvar = ZReg(26);
+    const ZReg vmm_mean = ZReg(25);
+};
+
+template <data_type_t data_type>
+jit_diff_ss_kernel_t<data_type>::jit_diff_ss_kernel_t(
+        const layer_normalization_pd_t *pd)
+    : diff_ss_kernel_t<data_type>(pd), jit_transfer_ {*this, data_type, C_} {
+    assert(mayiuse(sve_512));
+}
+
+template <data_type_t data_type>
+void jit_diff_ss_kernel_t<data_type>::operator()(const data_t *src,
+        const data_t *diff_dst, float *diff_gamma, float *diff_beta,
+        const float *mean, const float *var, float *const inv_sqrtvar,
+        const size_t block_size) const {
+    ker_args_t args;
+    args.src = src;
+    args.diff_dst = diff_dst;
+    args.diff_gamma = diff_gamma;
+    args.diff_beta = diff_beta;
+    args.mean = mean;
+    for (size_t i = 0; i < block_size; i++)
+        inv_sqrtvar[i] = 1.f / sqrtf(var[i] + eps_);
+    args.inv_sqrtvar = inv_sqrtvar;
+    args.block_size = block_size * C_ * types::data_type_size(data_type);
+    jit_generator::operator()(&args);
+}
+
+template <data_type_t data_type>
+void jit_diff_ss_kernel_t<data_type>::generate() {
+    const auto c_size = C_ * types::data_type_size(data_type);
+    static const auto float_size = types::data_type_size(f32);
+
+    preamble();
+#define PARAM_OFF(x) static_cast<int32_t>(offsetof(ker_args_t, x))
+    ldr(reg_src, ptr(reg_param, PARAM_OFF(src)));
+    ldr(reg_diff_dst, ptr(reg_param, PARAM_OFF(diff_dst)));
+    ldr(reg_diff_gamma, ptr(reg_param, PARAM_OFF(diff_gamma)));
+    ldr(reg_diff_beta, ptr(reg_param, PARAM_OFF(diff_beta)));
+    ldr(reg_mean, ptr(reg_param, PARAM_OFF(mean)));
+    ldr(reg_inv_sqrtvar, ptr(reg_param, PARAM_OFF(inv_sqrtvar)));
+    ldr(reg_block_end, ptr(reg_param, PARAM_OFF(block_size)));
+#undef PARAM_OFF
+
+    jit_transfer_.prepare();
+
+    const auto calculate_diff_gamma_beta = [&](int i, int vec, bool tail) {
+        const int j = i % unroll_factor_;
+        jit_transfer_.load(vmm_ddst(j), reg_diff_dst_aux, vec, tail);
+        jit_transfer_.load(vmm_dbeta(j), reg_diff_beta_aux, vec, tail, f32);
+        jit_transfer_.load(vmm_dgamma(j), reg_diff_gamma_aux, vec, tail, f32);
+        jit_transfer_.load(vmm_src(j), reg_src_aux, vec, tail);
+        fadd(vmm_dbeta(j).s, vmm_dbeta(j).s, vmm_ddst(j).s);
+        fsub(vmm_src(j).s, vmm_src(j).s, vmm_mean.s);
+        fmul(vmm_src(j).s, vmm_src(j).s, vmm_inv_sqrtvar.s);
+        fmla(vmm_dgamma(j).s, P_ALL_ONE / T_m, vmm_src(j).s, vmm_ddst(j).s);
+        jit_transfer_.store(vmm_dbeta(j), reg_diff_beta_aux, vec, tail, f32);
+        jit_transfer_.store(
+                vmm_dgamma(j), reg_diff_gamma_aux, vec, tail, f32);
+    };
+
+    // add block_start to block_size to define block_end
+    add(reg_block_end, reg_block_end, reg_src);
+
+    Label unroll_loop, end;
+    L(unroll_loop);
+    {
+        cmp(reg_block_end, reg_src);
+        b(LE, end);
+
+        ld1rw(vmm_mean.s, P_ALL_ONE / T_z, ptr(reg_mean));
+        ld1rw(vmm_inv_sqrtvar.s, P_ALL_ONE / T_z, ptr(reg_inv_sqrtvar));
+
+        const int data_vec_bytes = jit_transfer_.data_vec_bytes();
+        const int f32_vec_bytes = jit_transfer_.f32_vec_bytes();
+        jit_transfer_.for_each_vec(
+                {{reg_src_aux, reg_src, data_vec_bytes},
+                        {reg_diff_dst_aux, reg_diff_dst, data_vec_bytes},
+                        {reg_diff_gamma_aux, reg_diff_gamma, f32_vec_bytes},
+                        {reg_diff_beta_aux, reg_diff_beta, f32_vec_bytes}},
+                calculate_diff_gamma_beta);
+
+        add_imm(reg_src, reg_src, c_size, X_TMP_0);
+        add_imm(reg_diff_dst, reg_diff_dst, c_size, X_TMP_0);
+        add_imm(reg_mean, reg_mean, float_size, X_TMP_0);
+        add_imm(reg_inv_sqrtvar, reg_inv_sqrtvar, float_size, X_TMP_0);
+        b(unroll_loop);
+    }
+    L(end);
+
+    postamble();
+}
+
+template <data_type_t data_type>
+struct jit_diff_data_kernel_t : diff_data_kernel_t<data_type>,
+                                public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(lnorm_utils::jit_diff_data_kernel_t);
+
+    jit_diff_data_kernel_t(const layer_normalization_pd_t *pd);
+
+    using data_t = typename prec_traits<data_type>::type;
+    void operator()(const data_t *src, const data_t *diff_dst, data_t *diff_src,
+            const float *ss, const float *mean, float *const inv_sqrtvar,
+            const size_t block_size) const override;
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    jit_transfer_t jit_transfer_;
+    static constexpr int unroll_factor_ = 4;
+    using diff_data_kernel_t<data_type>::C_;
+    using diff_data_kernel_t<data_type>::eps_;
+    using diff_data_kernel_t<data_type>::calculate_diff_stats_;
+    using diff_data_kernel_t<data_type>::use_scaleshift_;
+    using diff_data_kernel_t<data_type>::use_scale_;
+    using diff_data_kernel_t<data_type>::use_shift_;
+
+    struct ker_args_t {
+        const data_t *src;
+        const data_t *diff_dst;
+        data_t *diff_src;
+        const float *ss;
+        const float *mean;
+        const float *inv_sqrtvar;
+        size_t block_size;
+    };
+
+    void generate() override;
+
+    void compute_dd_gammas();
+    void compute_diff_src();
+
+    const XReg reg_param = abi_param1;
+    const XReg reg_src = x1;
+    const XReg reg_diff_src = x2;
+    const XReg reg_diff_dst = x3;
+    const XReg reg_block_end = x4;
+    const XReg reg_mean = x5;
+    const XReg reg_inv_sqrtvar = x6;
+    const XReg reg_gamma = x7;
+    const XReg reg_src_aux = x8;
+    const XReg reg_diff_src_aux = x9;
+    const XReg reg_diff_dst_aux = x10;
+    const XReg reg_gamma_aux = x11;
+
+    ZReg vmm_dd_gamma(int j) const { return ZReg(j); }
+    ZReg vmm_dd_gamma_x(int j) const { return ZReg(unroll_factor_ + j); }
+    ZReg vmm_ddst(int j) const { return ZReg(2 * unroll_factor_ + j); }
+    ZReg vmm_src(int j) const { return ZReg(3 * unroll_factor_ + j); }
+    ZReg vmm_gamma(int j) const { return ZReg(4 * unroll_factor_ + j); }
+
+    const ZReg vmm_inv_C = ZReg(22);
+    const ZReg vmm_mean = ZReg(25);
+    const ZReg vmm_inv_sqrtvar = ZReg(26);
+};
+
+template <data_type_t data_type>
+jit_diff_data_kernel_t<data_type>::jit_diff_data_kernel_t(
+        const layer_normalization_pd_t *pd)
+    : diff_data_kernel_t<data_type>(pd), jit_transfer_ {*this, data_type, C_} {
+    assert(mayiuse(sve_512));
+}
+
+template <data_type_t data_type>
+void jit_diff_data_kernel_t<data_type>::operator()(const data_t *src,
+        const data_t *diff_dst, data_t *diff_src, const float *ss,
+        const float *mean, float *const inv_sqrtvar,
+        const size_t block_size) const {
+    ker_args_t args;
+    args.src = src;
+    args.diff_dst = diff_dst;
+    args.diff_src = diff_src;
+    args.ss = ss;
+    args.mean = mean;
+    args.inv_sqrtvar = inv_sqrtvar;
+    args.block_size = block_size * C_ * types::data_type_size(data_type);
+    jit_generator::operator()(&args);
+}
+
+// Computes dd_gamma = sum(diff_dst * gamma) / C and
+// dd_gamma_x = sum(diff_dst * gamma * (src - mean)) * inv_sqrtvar / C, both
+// broadcast to the whole vector.
+template <data_type_t data_type>
+void jit_diff_data_kernel_t<data_type>::compute_dd_gammas() {
+    const bool with_scale = use_scaleshift_ || use_scale_;
+    const int nvecs = jit_transfer_.nvecs();
+    const int nacc = nvecs < unroll_factor_ ? nvecs : unroll_factor_;
+
+    for (int j = 0; j < nacc; j++) {
+        dup(vmm_dd_gamma(j).s, 0);
+        dup(vmm_dd_gamma_x(j).s, 0);
+    }
+
+    std::vector<jit_transfer_t::walker_t> walkers {
+            {reg_src_aux, reg_src, jit_transfer_.data_vec_bytes()},
+            {reg_diff_dst_aux, reg_diff_dst, jit_transfer_.data_vec_bytes()}};
+    if (with_scale)
+        walkers.push_back(
+                {reg_gamma_aux, reg_gamma, jit_transfer_.f32_vec_bytes()});
+
+    // inactive lanes of the tail are loaded as zeros and add nothing
+    jit_transfer_.for_each_vec(walkers, [&](int i, int vec, bool tail) {
+        const int j = i % nacc;
+        jit_transfer_.load(vmm_ddst(j), reg_diff_dst_aux, vec, tail);
+        if (with_scale) {
+            jit_transfer_.load(vmm_gamma(j), reg_gamma_aux, vec, tail, f32);
+            fmul(vmm_ddst(j).s, vmm_ddst(j).s, vmm_gamma(j).s);
+        }
+        jit_transfer_.load(vmm_src(j), reg_src_aux, vec, tail);
+        fadd(vmm_dd_gamma(j).s, vmm_dd_gamma(j).s, vmm_ddst(j).s);
+        fsub(vmm_src(j).s, vmm_src(j).s, vmm_mean.s);
+        fmla(vmm_dd_gamma_x(j).s, P_ALL_ONE / T_m, vmm_ddst(j).s,
+                vmm_src(j).s);
+    });
+
+    for (int j = 1; j < nacc; j++) {
+        fadd(vmm_dd_gamma(0).s, vmm_dd_gamma(0).s, vmm_dd_gamma(j).s);
+        fadd(vmm_dd_gamma_x(0).s, vmm_dd_gamma_x(0).s, vmm_dd_gamma_x(j).s);
+    }
+    faddv(SReg(vmm_dd_gamma(0).getIdx()), P_ALL_ONE, vmm_dd_gamma(0).s);
+    faddv(SReg(vmm_dd_gamma_x(0).getIdx()), P_ALL_ONE, vmm_dd_gamma_x(0).s);
+    dup(vmm_dd_gamma(0).s, vmm_dd_gamma(0).s[0]);
+    dup(vmm_dd_gamma_x(0).s, vmm_dd_gamma_x(0).s[0]);
+
+    fmul(vmm_dd_gamma_x(0).s, vmm_dd_gamma_x(0).s, vmm_inv_sqrtvar.s);
+    fmul(vmm_dd_gamma(0).s, vmm_dd_gamma(0).s, vmm_inv_C.s);
+    fmul(vmm_dd_gamma_x(0).s, vmm_dd_gamma_x(0).s, vmm_inv_C.s);
+}
+
+template <data_type_t data_type>
+void jit_diff_data_kernel_t<data_type>::compute_diff_src() {
+    const bool with_scale = use_scaleshift_ || use_scale_;
+    // the reduced values live in accumulator 0, the others are free
+    const int nregs = unroll_factor_ - 1;
+
+    std::vector<jit_transfer_t::walker_t> walkers {
+            {reg_diff_dst_aux, reg_diff_dst, jit_transfer_.data_vec_bytes()},
+            {reg_diff_src_aux, reg_diff_src, jit_transfer_.data_vec_bytes()}};
+    if (calculate_diff_stats_)
+        walkers.push_back(
+                {reg_src_aux, reg_src, jit_transfer_.data_vec_bytes()});
+    if (with_scale)
+        walkers.push_back(
+                {reg_gamma_aux, reg_gamma, jit_transfer_.f32_vec_bytes()});
+
+    jit_transfer_.for_each_vec(walkers, [&](int i, int vec, bool tail) {
+        const int j = 1 + i % nregs;
+        const ZReg vmm_dsrc = vmm_ddst(j);
+        jit_transfer_.load(vmm_dsrc, reg_diff_dst_aux, vec, tail);
+        if (with_scale) {
+            jit_transfer_.load(vmm_gamma(j), reg_gamma_aux, vec, tail, f32);
+            fmul(vmm_dsrc.s, vmm_dsrc.s, vmm_gamma(j).s);
+        }
+        if (calculate_diff_stats_) {
+            jit_transfer_.load(vmm_src(j), reg_src_aux, vec, tail);
+            fsub(vmm_src(j).s, vmm_src(j).s, vmm_mean.s);
+            fmul(vmm_src(j).s, vmm_src(j).s, vmm_inv_sqrtvar.s);
+            fmad(vmm_src(j).s, P_ALL_ONE / T_m, vmm_dd_gamma_x(0).s,
+                    vmm_dd_gamma(0).s);
+            fsub(vmm_dsrc.s, vmm_dsrc.s, vmm_src(j).s);
+        }
+        fmul(vmm_dsrc.s, vmm_dsrc.s, vmm_inv_sqrtvar.s);
+        jit_transfer_.store(vmm_dsrc, reg_diff_src_aux, vec, tail);
+    });
+}
+
+template <data_type_t data_type>
+void jit_diff_data_kernel_t<data_type>::generate() {
+    const auto c_size = C_ * types::data_type_size(data_type);
+    static const auto float_size = types::data_type_size(f32);
+
+    preamble();
+#define PARAM_OFF(x) static_cast<int32_t>(offsetof(ker_args_t, x))
+    ldr(reg_src, ptr(reg_param, PARAM_OFF(src)));
+    ldr(reg_diff_dst, ptr(reg_param, PARAM_OFF(diff_dst)));
+    ldr(reg_diff_src, ptr(reg_param, PARAM_OFF(diff_src)));
+    ldr(reg_gamma, ptr(reg_param, PARAM_OFF(ss)));
+
+    if (calculate_diff_stats_) ldr(reg_mean, ptr(reg_param, PARAM_OFF(mean)));
+    ldr(reg_inv_sqrtvar, ptr(reg_param, PARAM_OFF(inv_sqrtvar)));
+    ldr(reg_block_end, ptr(reg_param, PARAM_OFF(block_size)));
+#undef PARAM_OFF
+
+    jit_transfer_.prepare();
+    jit_transfer_.set_const(vmm_inv_C, 1.f / C_);
+
+    // add block_start to block_size to define block_end
+    add(reg_block_end, reg_block_end, reg_src);
+
+    Label unroll_loop, end;
+    L(unroll_loop);
+    {
+        cmp(reg_block_end, reg_src);
+        b(LE, end);
+
+        ld1rw(vmm_inv_sqrtvar.s, P_ALL_ONE / T_z, ptr(reg_inv_sqrtvar));
+        if (calculate_diff_stats_) {
+            ld1rw(vmm_mean.s, P_ALL_ONE / T_z, ptr(reg_mean));
+            compute_dd_gammas();
+        }
+
+        compute_diff_src();
+
+        add_imm(reg_src, reg_src, c_size, X_TMP_0);
+        add_imm(reg_diff_dst, reg_diff_dst, c_size, X_TMP_0);
+        add_imm(reg_diff_src, reg_diff_src, c_size, X_TMP_0);
+        if (calculate_diff_stats_)
+            add_imm(reg_mean, reg_mean, float_size, X_TMP_0);
+        add_imm(reg_inv_sqrtvar, reg_inv_sqrtvar, float_size, X_TMP_0);
+        b(unroll_loop);
+    }
+    L(end);
+
+    postamble();
+}
+
+template <data_type_t d_type>
+stat_and_data_kernel_t<d_type> *stat_and_data_kernel_create(
+        const layer_normalization_pd_t *pd) {
+    return mayiuse(sve_512) ? new jit_stat_and_data_kernel_t<d_type>(pd)
+                            : nullptr;
+}
+
+template <data_type_t d_type>
+diff_ss_kernel_t<d_type> *diff_ss_kernel_create(
+        const layer_normalization_pd_t *pd) {
+    return mayiuse(sve_512) ? new jit_diff_ss_kernel_t<d_type>(pd) : nullptr;
+}
+
+template <data_type_t d_type>
+diff_data_kernel_t<d_type> *diff_data_kernel_create(
+        const layer_normalization_pd_t *pd) {
+    return mayiuse(sve_512) ? new jit_diff_data_kernel_t<d_type>(pd) : nullptr;
+}
+
+template stat_and_data_kernel_t<f32> *stat_and_data_kernel_create(
+        const layer_normalization_pd_t *pd);
+template stat_and_data_kernel_t<bf16> *stat_and_data_kernel_create(
+        const layer_normalization_pd_t *pd);
+template diff_ss_kernel_t<f32> *diff_ss_kernel_create(
+        const layer_normalization_pd_t *pd);
+template diff_ss_kernel_t<bf16> *diff_ss_kernel_create(
+        const layer_normalization_pd_t *pd);
+template diff_data_kernel_t<f32> *diff_data_kernel_create(
+        const layer_normalization_pd_t *pd);
+template diff_data_kernel_t<bf16> *diff_data_kernel_create(
+        const layer_normalization_pd_t *pd);
+
+} // namespace lnorm_utils
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
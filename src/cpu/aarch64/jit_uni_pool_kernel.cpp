@@ -39,10 +39,36 @@ using namespace alg_kind;
 template <cpu_isa_t isa>
 jit_uni_pool_kernel<isa>::~jit_uni_pool_kernel() = default;
 
+static bcast_set_t get_supported_bcast_strategies() {
+    return {broadcasting_strategy_t::scalar, broadcasting_strategy_t::per_oc};
+}
+
 template <cpu_isa_t isa>
 jit_uni_pool_kernel<isa>::jit_uni_pool_kernel(
         const jit_pool_conf_t &ajpp, const memory_desc_t *dst_md)
-    : jpp(ajpp) {}
+    : jpp(ajpp) {
+    if (jpp.with_postops) {
+        static constexpr bool preserve_gpr = false;
+        static constexpr bool preserve_vmm = true;
+        static constexpr bool use_exact_tail_scalar_bcast = false;
+
+        const binary_injector::rhs_arg_static_params_t rhs_sp {
+                static_cast<std::size_t>(z_tmp0.getIdx()), reg_binary_rhs_addr,
+                reg_binary_helper, preserve_gpr, preserve_vmm,
+                GET_OFF(post_ops_binary_rhs_arg_vec),
+                memory_desc_wrapper(*dst_md),
+                static_cast<std::size_t>(jpp.c_tail), k_c_tail_mask_s,
+                use_exact_tail_scalar_bcast};
+        const binary_injector::static_params_t bsp {
+                reg_param, get_supported_bcast_strategies(), rhs_sp};
+        const eltwise_injector::static_params_t esp {true, reg_param,
+                p_elt_mask, p_elt_tmp, p_elt_all};
+
+        postops_injector_
+                = utils::make_unique<injector::jit_uni_postops_injector_t<isa>>(
+                        this, jpp.post_ops, bsp, esp);
+    }
+}
 
 template <cpu_isa_t isa>
 status_t jit_uni_pool_kernel<isa>::init_conf(jit_pool_conf_t &jpp,
@@ -241,6 +267,8 @@ status_t jit_uni_pool_kernel<isa>::init_conf(jit_pool_conf_t &jpp,
     const auto attr = *ppd->attr();
     if (!post_ops_ok(jpp, attr, dst_d)) return status::unimplemented;
 
+    jpp.post_ops = attr.post_ops_;
+
     return status::success;
 }
 
@@ -258,6 +286,11 @@ inline void jit_uni_pool_kernel<isa>::prepare_tail_mask() {
     str(X_TMP_0, ptr(X_TRANSLATOR_STACK));
     ldr(PReg(k_c_tail_mask), ptr(X_TRANSLATOR_STACK));
     add(X_TRANSLATOR_STACK, X_TRANSLATOR_STACK, 8);
+
+    if (jpp.with_binary) {
+        mov_imm(X_TMP_0, jpp.c_tail);
+        whilelt(k_c_tail_mask_s.s, xzr, X_TMP_0);
+    }
 }
 
 template <cpu_isa_t isa>
@@ -330,12 +363,56 @@ template <cpu_isa_t isa>
 bool jit_uni_pool_kernel<isa>::post_ops_ok(jit_pool_conf_t &jpp,
         const primitive_attr_t &attr, const memory_desc_wrapper &dst_d) {
     const auto &post_ops = attr.post_ops_;
+    const auto &entries = post_ops.entry_;
     jpp.with_postops = false;
     jpp.with_eltwise = false;
     jpp.with_binary = false;
 
-    /* At this time, post_op is not supported. */
-    return post_ops.len() ? false : true;
+    if (!jpp.is_backward) {
+        for (const auto &entry : entries) {
+            if (entry.is_eltwise()) {
+                const auto alg = entry.eltwise.alg;
+                if (!eltwise_injector::is_alg_supported(alg)) return false;
+                jpp.with_eltwise = true;
+            } else if (entry.is_binary()) {
+                jpp.with_binary = true;
+            } else
+                return false;
+        }
+
+        jpp.with_postops = jpp.with_eltwise || jpp.with_binary;
+    } else if (post_ops.len())
+        return false;
+
+    return injector::is_supported({isa, {injector::eltwise, injector::binary},
+            post_ops, &dst_d, false, false,
+            get_supported_bcast_strategies()});
+}
+
+template <cpu_isa_t isa>
+void jit_uni_pool_kernel<isa>::apply_postops(int ur_bc, int ur_w, int c_block,
+        const std::function<bool(int)> &is_tail_predicate) {
+    binary_injector::rhs_arg_dynamic_params_t rhs_arg_params;
+    const int end_idx = vmm_idx_upper_bound() + 1;
+    const int start_idx = end_idx - (ur_bc * ur_w);
+
+    if (jpp.with_binary) {
+        for (int jj = 0; jj < ur_w; jj++) {
+            for (int bci = 0; bci < ur_bc; bci++) {
+                const auto vmm_idx
+                        = vreg(reg_ind(0, bci, jj, ur_bc, ur_w)).getIdx();
+                rhs_arg_params.vmm_idx_to_oc_elem_off_addr.emplace(
+                        vmm_idx,
+                        ptr(reg_param,
+                                static_cast<int32_t>(GET_OFF(c_elem_off))));
+                rhs_arg_params.vmm_idx_to_oc_elem_off_val.emplace(
+                        vmm_idx, bci * c_block);
+                if (is_tail_predicate(bci))
+                    rhs_arg_params.vmm_tail_idx_.emplace(vmm_idx);
+            }
+        }
+    }
+    postops_injector_->compute_vector_range(start_idx, end_idx, rhs_arg_params);
 }
 
 template <cpu_isa_t isa>
@@ -483,6 +560,9 @@ inline void jit_uni_pool_kernel<isa>::avg_step(int ur_w, int ur_bc, int pad_l,
             }
         }
 
+        if (jpp.with_postops)
+            apply_postops(ur_bc, ur_w, c_block, is_tail_processing);
+
         for (int jj = 0; jj < ur_w; jj++) {
             for (int bci = 0; bci < ur_bc; bci++) {
                 const auto accr_i = reg_ind(0, bci, jj, ur_bc, ur_w);
@@ -620,6 +700,9 @@ inline void jit_uni_pool_kernel<isa>::max_step_fwd(int ur_w, int ur_bc,
         ldr(reg_input, post_ptr(X_TRANSLATOR_STACK, 8));
     }
 
+    if (jpp.with_postops)
+        apply_postops(ur_bc, ur_w, c_block, is_tail_processing);
+
     for_(int jj = 0; jj < ur_w; jj++)
     for (int bci = 0; bci < ur_bc; bci++) {
         const auto accr_i = reg_ind(0, bci, jj, ur_bc, ur_w);
@@ -1053,6 +1136,9 @@ void jit_uni_pool_kernel<isa>::generate() {
     }
 
     this->postamble();
+
+    if (jpp.with_eltwise && postops_injector_)
+        postops_injector_->prepare_table();
 }
 
 template struct jit_uni_pool_kernel<sve_512>;
@@ -28,6 +28,7 @@
 #include "common/utils.hpp"
 #include "cpu/aarch64/jit_generator.hpp"
 
+#include "cpu/aarch64/injectors/jit_uni_postops_injector.hpp"
 #include "cpu/aarch64/jit_primitive_conf.hpp"
 
 using namespace Xbyak_aarch64;
@@ -128,6 +129,16 @@ private:
     xreg_t xreg_index = x10;
     xreg_t xreg_zero_ptr = x5;
 
+    /* Post-ops: c tail in 32-bit lanes for binary rhs, and eltwise injector
+       predicates kept clear of k_c_tail_mask. */
+    PReg k_c_tail_mask_s = p9;
+    PReg p_elt_mask = p1;
+    PReg p_elt_tmp = p7;
+    PReg p_elt_all = p8;
+
+    xreg_t reg_binary_rhs_addr = x8;
+    xreg_t reg_binary_helper = x11;
+
     int prev_kw;
 
     void prepare_tail_mask();
@@ -151,6 +162,9 @@ private:
 
     void zero_diff_src(int ur_bc, bool with_c_tail_proccessing);
 
+    void apply_postops(int ur_bc, int ur_w, int c_block,
+            const std::function<bool(int)> &is_tail_predicate);
+
     void step(int ur_w, int ur_bc, int pad_l, int pad_r,
             bool with_c_tail_proccessing) {
         if (jpp.alg == alg_kind::pooling_max) {
@@ -168,6 +182,9 @@ private:
 
     static bool post_ops_ok(jit_pool_conf_t &jpp, const primitive_attr_t &attr,
             const memory_desc_wrapper &dst_d);
+
+    std::unique_ptr<injector::jit_uni_postops_injector_t<isa>>
+            postops_injector_;
 };
 
 } // namespace aarch64
@@ -551,6 +551,9 @@ void jit_uni_pooling_fwd_t<isa, d_type>::execute_forward(const data_t *src,
             = indices ? types::data_type_size(indices_d.data_type()) : 0;
     const auto &jpp = pd()->jpp_;
 
+    const auto post_ops_binary_rhs_arg_vec
+            = binary_injector::prepare_binary_args(jpp.post_ops, ctx);
+
     using wsp_data_t = typename prec_traits<wsp_dt_>::type;
     using namespace jit_uni_pooling_utils;
 
@@ -607,6 +610,7 @@ void jit_uni_pooling_fwd_t<isa, d_type>::execute_forward(const data_t *src,
         arg.ur_bc = ur_bc;
         arg.b_c = b_c;
         arg.c_elem_off = c_elem_off;
+        arg.post_ops_binary_rhs_arg_vec = post_ops_binary_rhs_arg_vec.data();
         (*kernel_)(&arg);
     };
 
@@ -666,6 +670,9 @@ void jit_uni_pooling_fwd_t<isa, d_type>::execute_forward_3d(const data_t *src,
     const size_t ind_dt_size
             = indices ? types::data_type_size(indices_d.data_type()) : 0;
 
+    const auto post_ops_binary_rhs_arg_vec
+            = binary_injector::prepare_binary_args(jpp.post_ops, ctx);
+
     using wsp_data_t = typename prec_traits<wsp_dt_>::type;
     using namespace jit_uni_pooling_utils;
     static constexpr int first_ithr = 0;
@@ -731,6 +738,7 @@ void jit_uni_pooling_fwd_t<isa, d_type>::execute_forward_3d(const data_t *src,
         arg.ur_bc = ur_bc;
         arg.b_c = b_c;
         arg.c_elem_off = jpp.c_block * b_c;
+        arg.post_ops_binary_rhs_arg_vec = post_ops_binary_rhs_arg_vec.data();
         (*kernel_)(&arg);
     };
 
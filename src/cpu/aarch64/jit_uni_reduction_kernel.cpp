@@ -0,0 +1,262 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/aarch64/jit_uni_reduction_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+using namespace Xbyak_aarch64;
+
+#define GET_OFF(field) offsetof(reduction_utils::call_params_t, field)
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::load(
+        const TReg &v, const XReg &addr, int vec, bool tail) {
+    if (!tail) {
+        ld1w(v.s, P_ALL_ONE / T_z, ptr(addr, vec, MUL_VL));
+    } else {
+        // Inactive elements are zeroed, which is neutral for sum-like
+        // algorithms only.
+        ld1w(v.s, p_tail / T_z, ptr(addr, vec, MUL_VL));
+        if (!reduction_utils::is_sum_like(conf_.alg))
+            sel(v.s, p_tail / T_m, v.s, vneutral.s);
+    }
+
+    if (reduction_utils::is_norm(conf_.alg)) {
+        if (conf_.p == 1.f)
+            fabs(v.s, P_ALL_ONE / T_m, v.s);
+        else
+            fmul(v.s, v.s, v.s);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::store(
+        const TReg &v, const XReg &addr, int vec, bool tail) {
+    st1w(v.s, tail ? p_tail : P_ALL_ONE, ptr(addr, vec, MUL_VL));
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::accumulate(
+        const TReg &acc, const TReg &v) {
+    using namespace alg_kind;
+    switch (conf_.alg) {
+        case reduction_max: fmax(acc.s, P_ALL_ONE / T_m, v.s); break;
+        case reduction_min: fmin(acc.s, P_ALL_ONE / T_m, v.s); break;
+        case reduction_mul: fmul(acc.s, acc.s, v.s); break;
+        default: fadd(acc.s, acc.s, v.s); break;
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::compute_vertical(int nvecs, bool tail) {
+    // With a few vectors along the inner dimension the rows are distributed
+    // over several sets of accumulators to hide the latency of the operation.
+    const int nsets = unroll / nvecs;
+
+    for (int i = 0; i < nsets * nvecs; ++i)
+        mov(vacc(i).d, vneutral.d);
+
+    Label l_unroll_loop, l_loop, l_end;
+
+    mov(reg_src_r, reg_src);
+    mov(reg_r, reg_n_reduce);
+
+    if (nsets > 1) {
+        L(l_unroll_loop);
+        {
+            cmp(reg_r, nsets);
+            b(LT, l_loop);
+            for (int s = 0; s < nsets; ++s) {
+                for (int i = 0; i < nvecs; ++i) {
+                    const int idx = s * nvecs + i;
+                    load(vtmp(idx), reg_src_r, i, tail);
+                    accumulate(vacc(idx), vtmp(idx));
+                }
+                add(reg_src_r, reg_src_r, reg_stride);
+            }
+            sub(reg_r, reg_r, nsets);
+            b(l_unroll_loop);
+        }
+    }
+
+    L(l_loop);
+    {
+        cmp(reg_r, 0);
+        b(LE, l_end);
+        for (int i = 0; i < nvecs; ++i) {
+            load(vtmp(i), reg_src_r, i, tail);
+            accumulate(vacc(i), vtmp(i));
+        }
+        add(reg_src_r, reg_src_r, reg_stride);
+        sub(reg_r, reg_r, 1);
+        b(l_loop);
+    }
+    L(l_end);
+
+    for (int s = 1; s < nsets; ++s)
+        for (int i = 0; i < nvecs; ++i)
+            accumulate(vacc(i), vacc(s * nvecs + i));
+
+    for (int i = 0; i < nvecs; ++i)
+        store(vacc(i), reg_acc, i, tail);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::vertical() {
+    Label l_unroll_loop, l_loop, l_tail, l_end;
+
+    // The rows are inner elements apart.
+    mov_imm(reg_stride, conf_.inner * sizeof(float));
+
+    L(l_unroll_loop);
+    {
+        cmp(reg_n_inner, unroll * simd_w);
+        b(LT, l_loop);
+        compute_vertical(unroll, false);
+        add_imm(reg_src, reg_src, unroll * vlen, X_TMP_0);
+        add_imm(reg_acc, reg_acc, unroll * vlen, X_TMP_0);
+        sub(reg_n_inner, reg_n_inner, unroll * simd_w);
+        b(l_unroll_loop);
+    }
+
+    L(l_loop);
+    {
+        cmp(reg_n_inner, simd_w);
+        b(LT, l_tail);
+        compute_vertical(1, false);
+        add_imm(reg_src, reg_src, vlen, X_TMP_0);
+        add_imm(reg_acc, reg_acc, vlen, X_TMP_0);
+        sub(reg_n_inner, reg_n_inner, simd_w);
+        b(l_loop);
+    }
+
+    L(l_tail);
+    {
+        cmp(reg_n_inner, 0);
+        b(LE, l_end);
+        whilelt(p_tail.s, xzr, reg_n_inner);
+        compute_vertical(1, true);
+    }
+    L(l_end);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::horizontal() {
+    Label l_outer_loop, l_unroll_loop, l_loop, l_tail, l_store, l_end;
+
+    // The rows are reduce elements apart.
+    mov_imm(reg_stride, conf_.reduce * sizeof(float));
+
+    L(l_outer_loop);
+    {
+        cmp(reg_n_outer, 0);
+        b(LE, l_end);
+
+        for (int i = 0; i < unroll; ++i)
+            mov(vacc(i).d, vneutral.d);
+        mov(reg_src_r, reg_src);
+        mov(reg_r, reg_n_reduce);
+
+        L(l_unroll_loop);
+        {
+            cmp(reg_r, unroll * simd_w);
+            b(LT, l_loop);
+            for (int i = 0; i < unroll; ++i) {
+                load(vtmp(i), reg_src_r, i, false);
+                accumulate(vacc(i), vtmp(i));
+            }
+            add_imm(reg_src_r, reg_src_r, unroll * vlen, X_TMP_0);
+            sub(reg_r, reg_r, unroll * simd_w);
+            b(l_unroll_loop);
+        }
+
+        L(l_loop);
+        {
+            cmp(reg_r, simd_w);
+            b(LT, l_tail);
+            load(vtmp(0), reg_src_r, 0, false);
+            accumulate(vacc(0), vtmp(0));
+            add_imm(reg_src_r, reg_src_r, vlen, X_TMP_0);
+            sub(reg_r, reg_r, simd_w);
+            b(l_loop);
+        }
+
+        L(l_tail);
+        {
+            cmp(reg_r, 0);
+            b(LE, l_store);
+            whilelt(p_tail.s, xzr, reg_r);
+            load(vtmp(0), reg_src_r, 0, true);
+            accumulate(vacc(0), vtmp(0));
+        }
+
+        L(l_store);
+        accumulate(vacc(0), vacc(1));
+        accumulate(vacc(2), vacc(3));
+        accumulate(vacc(0), vacc(2));
+        store(vacc(0), reg_acc, 0, false);
+
+        add(reg_src, reg_src, reg_stride);
+        add_imm(reg_acc, reg_acc, vlen, X_TMP_0);
+        sub(reg_n_outer, reg_n_outer, 1);
+        b(l_outer_loop);
+    }
+    L(l_end);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::generate() {
+    preamble();
+
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(src), X_TMP_0);
+    ldr(reg_src, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(acc), X_TMP_0);
+    ldr(reg_acc, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(n_outer), X_TMP_0);
+    ldr(reg_n_outer, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(n_reduce), X_TMP_0);
+    ldr(reg_n_reduce, ptr(X_DEFAULT_ADDR));
+    add_imm(X_DEFAULT_ADDR, reg_param, GET_OFF(n_inner), X_TMP_0);
+    ldr(reg_n_inner, ptr(X_DEFAULT_ADDR));
+
+    mov_imm(W_TMP_0, float2int(reduction_utils::neutral(conf_.alg)));
+    dup(vneutral.s, W_TMP_0);
+
+    if (conf_.is_horizontal())
+        horizontal();
+    else
+        vertical();
+
+    postamble();
+}
+
+#undef GET_OFF
+
+template struct jit_uni_reduction_kernel_t<sve_512>;
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,88 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_JIT_UNI_REDUCTION_KERNEL_HPP
+#define CPU_AARCH64_JIT_UNI_REDUCTION_KERNEL_HPP
+
+#include "common/c_types_map.hpp"
+
+#include "cpu/aarch64/jit_generator.hpp"
+#include "cpu/reduction_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+// Accumulates src[o][r][i] over r, see cpu/reduction_utils.hpp for the
+// description of the canonical form and of the call parameters.
+template <cpu_isa_t isa>
+struct jit_uni_reduction_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_reduction_kernel_t)
+
+    jit_uni_reduction_kernel_t(const reduction_utils::conf_t &conf)
+        : conf_(conf) {}
+
+    void operator()(const reduction_utils::call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+private:
+    using TReg = typename cpu_isa_traits<isa>::TReg;
+    using XReg = Xbyak_aarch64::XReg;
+    using PReg = Xbyak_aarch64::PReg;
+
+    static constexpr int vlen = cpu_isa_traits<isa>::vlen;
+    static constexpr int unroll = reduction_utils::unroll;
+
+    void generate() override;
+
+    void load(const TReg &v, const XReg &addr, int vec, bool tail);
+    void store(const TReg &v, const XReg &addr, int vec, bool tail);
+    void accumulate(const TReg &acc, const TReg &v);
+    void compute_vertical(int nvecs, bool tail);
+    void vertical();
+    void horizontal();
+
+    const reduction_utils::conf_t conf_;
+
+    XReg reg_param = abi_param1;
+    XReg reg_src = x8;
+    XReg reg_acc = x9;
+    XReg reg_n_outer = x10;
+    XReg reg_n_reduce = x11;
+    XReg reg_n_inner = x12;
+    XReg reg_src_r = x13;
+    XReg reg_r = x14;
+    XReg reg_stride = x15;
+
+    const PReg p_tail = p1;
+
+    TReg vacc(int idx) const { return TReg(idx); }
+    TReg vtmp(int idx) const { return TReg(unroll + idx); }
+    TReg vneutral = TReg(31);
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,106 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_GRU_CELL_POSTGEMM_1_BWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_GRU_CELL_POSTGEMM_1_BWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_gru_cell_postgemm_part1_bwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_cell_postgemm_part1_bwd)
+
+    jit_uni_gru_cell_postgemm_part1_bwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        return create_kernel();
+    }
+
+protected:
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        // Register map
+        const TReg G0(16), G2(17), dHt(18), dG0(19), dG2(20), h(21), one(22),
+                tmp1(23);
+
+        const XReg addr_ws_gates_reg = abi_param1;
+        const XReg addr_scratch_gates_reg = abi_param2;
+        const XReg addr_diff_states_t_lp1_reg = abi_param3;
+        const XReg addr_diff_states_tp1_l_reg = abi_param4;
+        const XReg addr_diff_states_t_l_reg = abi_param5;
+        const XReg addr_states_tm1_l_reg = abi_param6;
+
+        // We start code generations here
+        preamble();
+
+        set_const(one, 1.0f);
+
+        vec_loop(rnn_.dhc, [&](const PReg &p) {
+            const auto pm = P_ALL_ONE / T_m;
+
+            uni_load(G0, vaddr(addr_ws_gates_reg, 0), p);
+            uni_load(G2, vaddr(addr_ws_gates_reg, 2), p);
+            uni_load(h, vaddr(addr_states_tm1_l_reg), p);
+
+            // compute dHt
+            uni_load(dHt, vaddr(addr_diff_states_tp1_l_reg), p);
+            uni_load(tmp1, vaddr(addr_diff_states_t_lp1_reg), p);
+            fadd(dHt.s, dHt.s, tmp1.s);
+
+            // compute dG2 = (1 - G0) * dHt * (1 - G2^2)
+            mov(dG2.d, one.d);
+            fsub(dG2.s, dG2.s, G0.s);
+            fmul(dG2.s, dG2.s, dHt.s);
+            mov(tmp1.d, one.d);
+            fmls(tmp1.s, pm, G2.s, G2.s);
+            fmul(dG2.s, dG2.s, tmp1.s);
+
+            // compute dG0 = (h - G2) * dHt * (G0 - G0^2)
+            fsub(dG0.s, h.s, G2.s);
+            fmul(dG0.s, dG0.s, dHt.s);
+            mov(tmp1.d, G0.d);
+            fmls(tmp1.s, pm, G0.s, G0.s);
+            fmul(dG0.s, dG0.s, tmp1.s);
+
+            // compute diff_states_t_l = dHt * G0
+            fmul(dHt.s, dHt.s, G0.s);
+            uni_store(vaddr(addr_diff_states_t_l_reg), dHt, p);
+
+            uni_store(vaddr(addr_scratch_gates_reg, 0), dG0, p);
+            uni_store(vaddr(addr_scratch_gates_reg, 2), dG2, p);
+        });
+
+        postamble();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
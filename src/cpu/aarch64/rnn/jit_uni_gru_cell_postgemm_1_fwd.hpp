@@ -0,0 +1,114 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_GRU_CELL_POSTGEMM_1_FWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_GRU_CELL_POSTGEMM_1_FWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_gru_cell_postgemm_part1_fwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_cell_postgemm_part1_fwd)
+
+    jit_uni_gru_cell_postgemm_part1_fwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    ~jit_uni_gru_cell_postgemm_part1_fwd() { delete sigmoid_injector_; }
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        sigmoid_injector_
+                = create_injector(alg_kind::eltwise_logistic, 0.0f, x19);
+        return create_kernel();
+    }
+
+protected:
+    injector_t *sigmoid_injector_ = nullptr;
+
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        const bool is_training
+                = pd_->desc()->prop_kind == prop_kind::forward_training;
+
+        // Register map
+        const TReg G0(16), G1(17), tmp1_vmm(18);
+
+        const XReg addr_ws_gates_reg = abi_param1;
+        const XReg addr_scratch_gates_reg = abi_param2;
+        const XReg addr_bias_reg = abi_param3;
+        const XReg addr_states_t_l_reg = abi_param4;
+        const XReg addr_states_t_l_copy_reg = abi_param5;
+        const XReg addr_states_tm1_l_reg = abi_param6;
+
+        // We start code generations here
+        preamble();
+
+        sigmoid_injector_->load_table_addr();
+
+        vec_loop(rnn_.dhc, [&](const PReg &p) {
+            // load G0 G1 and add biases
+            uni_load(G0, vaddr(addr_scratch_gates_reg, 0), p);
+            uni_load(tmp1_vmm, vaddr(addr_bias_reg, 0), p);
+            fadd(G0.s, G0.s, tmp1_vmm.s);
+            uni_load(G1, vaddr(addr_scratch_gates_reg, 1), p);
+            uni_load(tmp1_vmm, vaddr(addr_bias_reg, 1), p);
+            fadd(G1.s, G1.s, tmp1_vmm.s);
+
+            // inject eltwise code
+            sigmoid_injector_->compute_vector_range(
+                    G0.getIdx(), G1.getIdx() + 1);
+
+            // if training we write back the gates
+            if (is_training) {
+                uni_store(vaddr(addr_ws_gates_reg, 0), G0, p);
+                uni_store(vaddr(addr_ws_gates_reg, 1), G1, p);
+            }
+
+            // G0 is needed by part2
+            uni_store(vaddr(addr_scratch_gates_reg, 0), G0, p);
+
+            // states_t_l = states_tm1_l * G1
+            uni_load(tmp1_vmm, vaddr(addr_states_tm1_l_reg), p);
+            fmul(G1.s, G1.s, tmp1_vmm.s);
+            uni_store(vaddr(addr_states_t_l_reg), G1, p);
+            // if states_t_l_copy is not null, we write the output to it too
+            Label skip_copy_label;
+            cbz(addr_states_t_l_copy_reg, skip_copy_label);
+            uni_store(vaddr(addr_states_t_l_copy_reg), G1, p);
+            L(skip_copy_label);
+        });
+
+        postamble();
+
+        sigmoid_injector_->prepare_table();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
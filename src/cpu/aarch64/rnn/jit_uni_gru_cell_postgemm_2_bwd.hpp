@@ -0,0 +1,94 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_GRU_CELL_POSTGEMM_2_BWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_GRU_CELL_POSTGEMM_2_BWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_gru_cell_postgemm_part2_bwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_cell_postgemm_part2_bwd)
+
+    jit_uni_gru_cell_postgemm_part2_bwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        return create_kernel();
+    }
+
+protected:
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        // Register map
+        const TReg G1(16), dhG1(17), h(18), dG1(19), tmp1(20);
+
+        const XReg addr_ws_gates_reg = abi_param1;
+        const XReg addr_scratch_gates_reg = abi_param2;
+        const XReg addr_diff_states_t_l_reg = abi_param5;
+        const XReg addr_states_tm1_l_reg = abi_param6;
+        const XReg addr_scratch_cell_reg = abi_param7;
+        const XReg addr_ds_reg = x8;
+
+        // We start code generations here
+        preamble();
+
+        load_stack_param(addr_ds_reg, 9);
+
+        vec_loop(rnn_.dhc, [&](const PReg &p) {
+            const auto pm = P_ALL_ONE / T_m;
+
+            uni_load(G1, vaddr(addr_ws_gates_reg, 1), p);
+            uni_load(dhG1, vaddr(addr_ds_reg), p);
+            uni_load(h, vaddr(addr_states_tm1_l_reg), p);
+
+            // dG1 = dhG1 * h * (G1 - G1^2)
+            mov(dG1.d, G1.d);
+            fmls(dG1.s, pm, G1.s, G1.s);
+            fmul(dG1.s, dG1.s, h.s);
+            fmul(dG1.s, dG1.s, dhG1.s);
+            uni_store(vaddr(addr_scratch_gates_reg, 1), dG1, p);
+
+            // diff_states_t_l += dhG1 * G1
+            uni_load(tmp1, vaddr(addr_diff_states_t_l_reg), p);
+            fmla(tmp1.s, pm, dhG1.s, G1.s);
+            uni_store(vaddr(addr_diff_states_t_l_reg), tmp1, p);
+
+            // hG1 = h * G1, required for dWh
+            fmul(h.s, h.s, G1.s);
+            uni_store(vaddr(addr_scratch_cell_reg), h, p);
+        });
+
+        postamble();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
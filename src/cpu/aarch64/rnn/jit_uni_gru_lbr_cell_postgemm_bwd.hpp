@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_GRU_LBR_CELL_POSTGEMM_BWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_GRU_LBR_CELL_POSTGEMM_BWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_gru_lbr_cell_postgemm_bwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_lbr_cell_postgemm_bwd)
+
+    jit_uni_gru_lbr_cell_postgemm_bwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        return create_kernel();
+    }
+
+protected:
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        // Register map
+        const TReg G0(16), G1(17), G2(18), dHt(19), dG0(20), dG1(21), dG2(22),
+                one(23), tmp1(24);
+
+        const XReg addr_ws_gates_reg = abi_param1;
+        const XReg addr_scratch_gates_reg = abi_param2;
+        const XReg addr_diff_states_t_lp1_reg = abi_param3;
+        const XReg addr_diff_states_tp1_l_reg = abi_param4;
+        const XReg addr_diff_states_t_l_reg = abi_param5;
+        const XReg addr_states_tm1_l_reg = abi_param6;
+        const XReg addr_scratch_cell_reg = abi_param7;
+        const XReg addr_ws_grid_reg = abi_param8;
+
+        // We start code generations here
+        preamble();
+
+        set_const(one, 1.0f);
+
+        vec_loop(rnn_.dhc, [&](const PReg &p) {
+            const auto pm = P_ALL_ONE / T_m;
+
+            uni_load(G0, vaddr(addr_ws_gates_reg, 0), p);
+            uni_load(G1, vaddr(addr_ws_gates_reg, 1), p);
+            uni_load(G2, vaddr(addr_ws_gates_reg, 2), p);
+
+            // compute dHt
+            uni_load(dHt, vaddr(addr_diff_states_tp1_l_reg), p);
+            uni_load(tmp1, vaddr(addr_diff_states_t_lp1_reg), p);
+            fadd(dHt.s, dHt.s, tmp1.s);
+
+            // compute dG0 = (h - G2) * dHt * (G0 - G0^2)
+            uni_load(dG0, vaddr(addr_states_tm1_l_reg), p);
+            fsub(dG0.s, dG0.s, G2.s);
+            fmul(dG0.s, dG0.s, dHt.s);
+            mov(tmp1.d, G0.d);
+            fmls(tmp1.s, pm, G0.s, G0.s);
+            fmul(dG0.s, dG0.s, tmp1.s);
+
+            // compute dG2 = (1 - G0) * (1 - G2^2) * dHt
+            mov(dG2.d, one.d);
+            fsub(dG2.s, dG2.s, G0.s);
+            mov(tmp1.d, one.d);
+            fmls(tmp1.s, pm, G2.s, G2.s);
+            fmul(dG2.s, dG2.s, tmp1.s);
+            fmul(dG2.s, dG2.s, dHt.s);
+
+            // compute dG1 = Wh_b * dG2 * (G1 - G1^2)
+            uni_load(dG1, vaddr(addr_ws_grid_reg), p);
+            fmul(dG1.s, dG1.s, dG2.s);
+            mov(tmp1.d, G1.d);
+            fmls(tmp1.s, pm, G1.s, G1.s);
+            fmul(dG1.s, dG1.s, tmp1.s);
+
+            // compute diff_states_t_l = dHt * G0
+            fmul(dHt.s, dHt.s, G0.s);
+            uni_store(vaddr(addr_diff_states_t_l_reg), dHt, p);
+
+            // the gates of the iter GEMM are stored in scratch_cell
+            uni_store(vaddr(addr_scratch_gates_reg, 0), dG0, p);
+            uni_store(vaddr(addr_scratch_cell_reg, 0), dG0, p);
+            uni_store(vaddr(addr_scratch_gates_reg, 1), dG1, p);
+            uni_store(vaddr(addr_scratch_cell_reg, 1), dG1, p);
+            uni_store(vaddr(addr_scratch_gates_reg, 2), dG2, p);
+            fmul(dG2.s, dG2.s, G1.s);
+            uni_store(vaddr(addr_scratch_cell_reg, 2), dG2, p);
+        });
+
+        postamble();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
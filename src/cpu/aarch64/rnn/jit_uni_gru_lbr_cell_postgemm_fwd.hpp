@@ -0,0 +1,138 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_GRU_LBR_CELL_POSTGEMM_FWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_GRU_LBR_CELL_POSTGEMM_FWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_gru_lbr_cell_postgemm_fwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_lbr_cell_postgemm_fwd)
+
+    jit_uni_gru_lbr_cell_postgemm_fwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    ~jit_uni_gru_lbr_cell_postgemm_fwd() {
+        delete sigmoid_injector_;
+        delete tanh_injector_;
+    }
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        sigmoid_injector_
+                = create_injector(alg_kind::eltwise_logistic, 0.0f, x19);
+        tanh_injector_ = create_injector(alg_kind::eltwise_tanh, 0.0f, x20);
+        return create_kernel();
+    }
+
+protected:
+    injector_t *sigmoid_injector_ = nullptr;
+    injector_t *tanh_injector_ = nullptr;
+
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        const bool is_training
+                = pd_->desc()->prop_kind == prop_kind::forward_training;
+
+        // Register map
+        const TReg G0(16), G1(17), G2(18), Wh_b(19), tmp1_vmm(20);
+
+        const XReg addr_ws_gates_reg = abi_param1;
+        const XReg addr_scratch_gates_reg = abi_param2;
+        const XReg addr_bias_reg = abi_param3;
+        const XReg addr_states_t_l_reg = abi_param4;
+        const XReg addr_states_t_l_copy_reg = abi_param5;
+        const XReg addr_states_tm1_l_reg = abi_param6;
+        const XReg addr_scratch_cell_reg = abi_param7;
+        const XReg addr_ws_h_reg = abi_param8;
+
+        // We start code generations here
+        preamble();
+
+        sigmoid_injector_->load_table_addr();
+        tanh_injector_->load_table_addr();
+
+        vec_loop(rnn_.dhc, [&](const PReg &p) {
+            // Wh_b = scratch_cell[2] + bias[3]
+            uni_load(Wh_b, vaddr(addr_scratch_cell_reg, 2), p);
+            uni_load(tmp1_vmm, vaddr(addr_bias_reg, 3), p);
+            fadd(Wh_b.s, Wh_b.s, tmp1_vmm.s);
+
+            // G0 and G1 accumulate the layer and the iter GEMMs and biases
+            const TReg G[] = {G0, G1};
+            for (int i = 0; i < 2; i++) {
+                uni_load(G[i], vaddr(addr_scratch_gates_reg, i), p);
+                uni_load(tmp1_vmm, vaddr(addr_scratch_cell_reg, i), p);
+                fadd(G[i].s, G[i].s, tmp1_vmm.s);
+                uni_load(tmp1_vmm, vaddr(addr_bias_reg, i), p);
+                fadd(G[i].s, G[i].s, tmp1_vmm.s);
+            }
+
+            // inject eltwise code
+            sigmoid_injector_->compute_vector_range(
+                    G0.getIdx(), G1.getIdx() + 1);
+
+            // G2 = tanh(scratch_gates[2] + G1 * Wh_b + bias[2])
+            uni_load(G2, vaddr(addr_scratch_gates_reg, 2), p);
+            uni_load(tmp1_vmm, vaddr(addr_bias_reg, 2), p);
+            fadd(G2.s, G2.s, tmp1_vmm.s);
+            fmla(G2.s, P_ALL_ONE / T_m, G1.s, Wh_b.s);
+            tanh_injector_->compute_vector(G2.getIdx());
+
+            // if training we write back the gates
+            if (is_training) {
+                uni_store(vaddr(addr_ws_gates_reg, 0), G0, p);
+                uni_store(vaddr(addr_ws_gates_reg, 1), G1, p);
+                uni_store(vaddr(addr_ws_gates_reg, 2), G2, p);
+                uni_store(vaddr(addr_ws_h_reg), Wh_b, p);
+            }
+
+            // states_t_l = states_tm1_l * G0 + (1 - G0) * G2
+            //            = G2 + G0 * (states_tm1_l - G2)
+            uni_load(tmp1_vmm, vaddr(addr_states_tm1_l_reg), p);
+            fsub(tmp1_vmm.s, tmp1_vmm.s, G2.s);
+            fmla(G2.s, P_ALL_ONE / T_m, G0.s, tmp1_vmm.s);
+            uni_store(vaddr(addr_states_t_l_reg), G2, p);
+            // if states_t_l_copy is not null, we write the output to it too
+            Label skip_copy_label;
+            cbz(addr_states_t_l_copy_reg, skip_copy_label);
+            uni_store(vaddr(addr_states_t_l_copy_reg), G2, p);
+            L(skip_copy_label);
+        });
+
+        postamble();
+
+        sigmoid_injector_->prepare_table();
+        tanh_injector_->prepare_table();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
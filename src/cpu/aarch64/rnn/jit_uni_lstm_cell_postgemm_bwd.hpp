@@ -0,0 +1,158 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_LSTM_CELL_POSTGEMM_BWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_LSTM_CELL_POSTGEMM_BWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_lstm_cell_postgemm_bwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_lstm_cell_postgemm_bwd)
+
+    jit_uni_lstm_cell_postgemm_bwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    ~jit_uni_lstm_cell_postgemm_bwd() { delete tanh_injector_; }
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        tanh_injector_ = create_injector(alg_kind::eltwise_tanh, 0.0f, x20);
+        return create_kernel();
+    }
+
+protected:
+    injector_t *tanh_injector_ = nullptr;
+
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        // Register map
+        const TReg dG0(16), dG1(17), dG2(18), dG3(19), tanhCt(20), dHt(21),
+                dCt(22), G0(23), G1(24), one_vmm(25), tmp1(26);
+
+        const XReg addr_ws_gates_reg = abi_param1;
+        const XReg addr_scratch_gates_reg = abi_param2;
+        const XReg addr_diff_states_t_lp1_reg = abi_param3;
+        const XReg addr_diff_states_tp1_l_reg = abi_param4;
+        const XReg addr_diff_c_states_t_l_reg = abi_param5;
+        const XReg addr_diff_c_states_tp1_l_reg = abi_param6;
+        const XReg addr_c_states_tm1_l_reg = abi_param7;
+        const XReg addr_c_states_t_l_reg = abi_param8;
+        const XReg addr_weights_peephole_reg = x8;
+
+        // We start code generations here
+        preamble();
+
+        load_stack_param(addr_weights_peephole_reg, 9);
+        set_const(one_vmm, 1.0f);
+        tanh_injector_->load_table_addr();
+
+        vec_loop(rnn_.dhc, [&](const PReg &p) {
+            const auto pm = P_ALL_ONE / T_m;
+
+            // compute tanhCt
+            uni_load(tanhCt, vaddr(addr_c_states_t_l_reg), p);
+            tanh_injector_->compute_vector(tanhCt.getIdx());
+
+            // compute dHt
+            // assumption: diff_states_t_lp1 is already offset by rnn.n_states
+            uni_load(dHt, vaddr(addr_diff_states_t_lp1_reg), p);
+            if (!rnn_.is_lstm_projection) {
+                uni_load(tmp1, vaddr(addr_diff_states_tp1_l_reg), p);
+                fadd(dHt.s, dHt.s, tmp1.s);
+            }
+
+            // compute dCt
+            mov(tmp1.d, one_vmm.d);
+            fmls(tmp1.s, pm, tanhCt.s, tanhCt.s);
+            fmul(tmp1.s, tmp1.s, dHt.s);
+            uni_load(dG3, vaddr(addr_ws_gates_reg, 3), p);
+            fmul(tmp1.s, tmp1.s, dG3.s);
+            uni_load(dCt, vaddr(addr_diff_c_states_tp1_l_reg), p);
+            fadd(dCt.s, dCt.s, tmp1.s);
+
+            // compute dG3
+            mov(tmp1.d, dG3.d);
+            fmls(dG3.s, pm, tmp1.s, tmp1.s);
+            fmul(dG3.s, dG3.s, dHt.s);
+            fmul(dG3.s, dG3.s, tanhCt.s);
+
+            // update dCt if lstm_peephole
+            if (rnn_.is_lstm_peephole) {
+                uni_load(tmp1, vaddr(addr_weights_peephole_reg, 2), p);
+                fmla(dCt.s, pm, tmp1.s, dG3.s);
+            }
+
+            // compute dG0
+            // we will reuse G0 and G2 later for dG2
+            uni_load(G0, vaddr(addr_ws_gates_reg, 0), p);
+            uni_load(dG2, vaddr(addr_ws_gates_reg, 2), p);
+            mov(dG0.d, G0.d);
+            fmls(dG0.s, pm, G0.s, G0.s);
+            fmul(dG0.s, dG0.s, dCt.s);
+            fmul(dG0.s, dG0.s, dG2.s);
+
+            // compute dG1
+            uni_load(G1, vaddr(addr_ws_gates_reg, 1), p);
+            mov(dG1.d, G1.d);
+            fmls(dG1.s, pm, G1.s, G1.s);
+            fmul(dG1.s, dG1.s, dCt.s);
+            uni_load(tmp1, vaddr(addr_c_states_tm1_l_reg), p);
+            fmul(dG1.s, dG1.s, tmp1.s);
+
+            // compute dG2
+            mov(tmp1.d, one_vmm.d);
+            fmls(tmp1.s, pm, dG2.s, dG2.s);
+            fmul(G0.s, G0.s, dCt.s);
+            fmul(dG2.s, tmp1.s, G0.s);
+
+            // compute diff_state_t_l
+            fmul(dCt.s, dCt.s, G1.s);
+            if (rnn_.is_lstm_peephole) {
+                uni_load(tmp1, vaddr(addr_weights_peephole_reg, 1), p);
+                fmla(dCt.s, pm, tmp1.s, dG1.s);
+                uni_load(tmp1, vaddr(addr_weights_peephole_reg, 0), p);
+                fmla(dCt.s, pm, tmp1.s, dG0.s);
+            }
+            uni_store(vaddr(addr_diff_c_states_t_l_reg), dCt, p);
+
+            uni_store(vaddr(addr_scratch_gates_reg, 0), dG0, p);
+            uni_store(vaddr(addr_scratch_gates_reg, 1), dG1, p);
+            uni_store(vaddr(addr_scratch_gates_reg, 2), dG2, p);
+            uni_store(vaddr(addr_scratch_gates_reg, 3), dG3, p);
+        });
+
+        postamble();
+
+        tanh_injector_->prepare_table();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,76 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_LSTM_CELL_PROJECTION_POSTGEMM_FWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_LSTM_CELL_PROJECTION_POSTGEMM_FWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+// For f32 the projection GEMM writes its output straight to dst_layer, so
+// the only work left is the copy of the projected state to dst_iter.
+template <cpu_isa_t isa>
+struct jit_uni_lstm_cell_projection_postgemm_fwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_lstm_cell_projection_postgemm_fwd)
+
+    jit_uni_lstm_cell_projection_postgemm_fwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        projection_ = true;
+        return create_kernel();
+    }
+
+protected:
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        // Register map
+        const TReg in(16);
+
+        const XReg addr_states_t_l_reg = abi_param4;
+        const XReg addr_states_t_l_copy_reg = abi_param5;
+
+        // We start code generations here
+        preamble();
+
+        Label end_label;
+        // if states_t_l_copy is a null ptr, there is nothing to do
+        cbz(addr_states_t_l_copy_reg, end_label);
+        vec_loop(rnn_.dic, [&](const PReg &p) {
+            uni_load(in, vaddr(addr_states_t_l_reg), p);
+            uni_store(vaddr(addr_states_t_l_copy_reg), in, p);
+        });
+        L(end_label);
+
+        postamble();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
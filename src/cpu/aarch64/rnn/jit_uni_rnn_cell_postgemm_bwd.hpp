@@ -0,0 +1,109 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_RNN_CELL_POSTGEMM_BWD_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_RNN_CELL_POSTGEMM_BWD_HPP
+
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_rnn_cell_postgemm_bwd : public jit_uni_rnn_postgemm {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_rnn_cell_postgemm_bwd)
+
+    jit_uni_rnn_cell_postgemm_bwd(
+            const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : jit_uni_rnn_postgemm(rnn, pd) {}
+
+    status_t init(data_type_t sdt) override {
+        CHECK(jit_uni_rnn_postgemm::init(sdt));
+        return create_kernel();
+    }
+
+protected:
+    void generate() override {
+        using namespace Xbyak_aarch64;
+
+        // Register map
+        // Here we do no unrolling, loop overhead should not be that dramatic
+        const TReg G(16), dG(17), dHt(18), tmp1(19), one(20), alpha(21);
+        const PReg p_cmp(3);
+
+        const XReg addr_ws_gates_reg = abi_param1;
+        const XReg addr_scratch_gates_reg = abi_param2;
+        const XReg addr_diff_states_t_lp1_reg = abi_param3;
+        const XReg addr_diff_states_tp1_l_reg = abi_param4;
+
+        // We start code generations here
+        preamble();
+
+        set_const(one, 1.0f);
+        if (pd_->activation_kind() == alg_kind::eltwise_relu)
+            set_const(alpha, pd_->desc()->alpha);
+
+        vec_loop(rnn_.dhc, [&](const PReg &p) {
+            const auto pm = P_ALL_ONE / T_m;
+
+            uni_load(G, vaddr(addr_ws_gates_reg), p);
+
+            // compute dHt
+            uni_load(dHt, vaddr(addr_diff_states_tp1_l_reg), p);
+            uni_load(tmp1, vaddr(addr_diff_states_t_lp1_reg), p);
+            fadd(dHt.s, dHt.s, tmp1.s);
+
+            // compute dG
+            switch (pd_->activation_kind()) {
+                case alg_kind::eltwise_relu:
+                    // G > 0 ? 1 : alpha
+                    fcmgt(p_cmp.s, P_ALL_ONE / T_z, G.s, 0.0);
+                    sel(dG.s, p_cmp, one.s, alpha.s);
+                    break;
+                case alg_kind::eltwise_tanh:
+                    // 1 - G^2
+                    mov(dG.d, one.d);
+                    fmls(dG.s, pm, G.s, G.s);
+                    break;
+                case alg_kind::eltwise_logistic:
+                    // G - G^2
+                    mov(dG.d, G.d);
+                    fmls(dG.s, pm, G.s, G.s);
+                    break;
+                default: assert(!"unsupported");
+            }
+
+            // dG = dG * dHt
+            fmul(dG.s, dG.s, dHt.s);
+
+            // write data
+            uni_store(vaddr(addr_scratch_gates_reg), dG, p);
+        });
+
+        postamble();
+    }
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,342 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_AARCH64_RNN_JIT_UNI_RNN_COMMON_POSTGEMM_HPP
+#define CPU_AARCH64_RNN_JIT_UNI_RNN_COMMON_POSTGEMM_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/rnn_pd.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/aarch64/jit_generator.hpp"
+
+#include "cpu/aarch64/injectors/jit_uni_eltwise_injector.hpp"
+
+#include "cpu/rnn/rnn_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace aarch64 {
+
+// Base class of the SVE post-GEMM kernels. Only f32 is supported: the
+// kernels read and write every state, gate and bias as f32, other data types
+// are handled by the reference post-GEMM functions.
+struct jit_uni_rnn_postgemm : public jit_generator {
+
+    jit_uni_rnn_postgemm(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+        : rnn_(rnn), pd_(pd), projection_(false) {}
+
+    bool is_projection() const { return projection_; };
+
+    virtual status_t init(data_type_t src_data_t) {
+        assert(src_data_t == data_type::f32);
+        return status::success;
+    }
+
+    template <typename dst_layer_t, typename dst_iter_t, typename src_iter_t,
+            typename gemm_acc_t, typename gates_t, typename scratch_t>
+    rnn_postgemm_sig(execute) {
+        if (pd_->desc()->prop_kind == prop_kind::backward)
+            execute_bwd(rnn, cell_position, ws_gates_, scratch_gates_,
+                    dst_layer_, dst_iter_c_, src_iter_, src_iter_c_,
+                    diff_src_layer_, diff_src_iter_, diff_src_iter_c_,
+                    diff_dst_layer_, diff_dst_iter_, diff_dst_iter_c_,
+                    weights_peephole_, bias_, ws_grid_, scratch_cell_,
+                    dst_iter_, weights_scales_, block_step);
+        else
+            execute_fwd(rnn, cell_position, ws_gates_, scratch_gates_,
+                    dst_layer_, dst_iter_c_, src_iter_, src_iter_c_,
+                    diff_src_layer_, diff_src_iter_, diff_src_iter_c_,
+                    diff_dst_layer_, diff_dst_iter_, diff_dst_iter_c_,
+                    weights_peephole_, bias_, ws_grid_, scratch_cell_,
+                    dst_iter_, weights_scales_, block_step);
+    }
+
+    template <typename dst_layer_t, typename dst_iter_t, typename src_iter_t,
+            typename gemm_acc_t, typename gates_t, typename scratch_t>
+    rnn_postgemm_sig(execute_fwd) {
+        using namespace rnn_utils;
+        // brgemm based RNN is x64 only, so the kernel always processes a
+        // whole row of dhc elements
+        assert(!rnn.is_brgemm);
+
+        rnn_utils::ws_gates_aoc<gates_t> ws_gates(rnn, ws_gates_);
+        rnn_utils::scratch_gates_aoc<scratch_t> scratch_gates(
+                rnn, scratch_gates_);
+        rnn_utils::weights_peephole_aoc_t<const float> weights_peephole(
+                rnn, weights_peephole_);
+        rnn_utils::bias_aoc_t bias(rnn, bias_);
+
+        auto src_iter_ld = rnn.src_iter_ld(cell_position);
+        auto dst_iter_c_ld = rnn.dst_iter_c_ld(cell_position);
+        auto dst_layer_ld = rnn.dst_layer_ld(cell_position, is_projection());
+        auto dst_iter_ld = rnn.dst_iter_ld(cell_position);
+        auto src_iter_c_ld = rnn.src_iter_c_ld(cell_position);
+
+        rnn_utils::ws_states_layer_aoc<dst_layer_t> dst_layer(
+                rnn, dst_layer_, dst_layer_ld);
+        rnn_utils::ws_states_iter_aoc<dst_iter_t> dst_iter(
+                rnn, dst_iter_, dst_iter_ld);
+        rnn_utils::ws_states_iter_aoc<const src_iter_t> src_iter(
+                rnn, src_iter_, src_iter_ld);
+        rnn_utils::ws_states_iter_c_aoc<float> dst_iter_c(
+                rnn, dst_iter_c_, dst_iter_c_ld);
+        rnn_utils::ws_states_iter_c_aoc<const float> src_iter_c(
+                rnn, src_iter_c_, src_iter_c_ld);
+        rnn_utils::ws_gates_aoc<scratch_t> scratch_cell(rnn, scratch_cell_);
+        utils::array_offset_calculator<gates_t, 2> ws_Wh_b(
+                ws_grid_, rnn.mb, rnn.dhc);
+
+        // Todo: add parallelization on dhc for the batch 1 case
+        // Assumption: the kernel runs a loop on dhc elements
+        parallel_nd(rnn.mb, [&](int i) {
+            void *param1_ = &ws_gates(i, 0, 0); // RNN, LSTM, GRU
+            void *param2_ = &scratch_gates(i, 0, 0); // RNN, LSTM, GRU
+            const void *param3_ = &bias(0, 0); // RNN, LSTM, GRU
+            void *param4_ = &dst_layer(i, 0); // RNN, LSTM, GRU
+            void *param5_ = dst_iter_ ? &dst_iter(i, 0) : dst_iter_;
+            const void *param6_;
+            void *param7_, *param8_;
+
+            switch (pd_->cell_kind()) {
+                case alg_kind::vanilla_lstm:
+                    param6_ = is_projection() ? src_iter_c_
+                                              : &src_iter_c(i, 0);
+                    param7_ = &dst_iter_c(i, 0);
+                    param8_ = (void *)&weights_peephole(0, 0);
+                    break;
+                case alg_kind::lbr_gru:
+                    param6_ = &src_iter(i, 0);
+                    param7_ = &scratch_cell(i, 0, 0);
+                    param8_ = &ws_Wh_b(i, 0);
+                    break;
+                case alg_kind::vanilla_gru:
+                    param6_ = &src_iter(i, 0);
+                    param7_ = nullptr;
+                    param8_ = nullptr;
+                    break;
+                default:
+                    param6_ = nullptr;
+                    param7_ = nullptr;
+                    param8_ = nullptr;
+                    break;
+            }
+            this->operator()(param1_, param2_, param3_, param4_, param5_,
+                    param6_, param7_, param8_, (void *)nullptr, (size_t)0);
+        });
+    }
+
+    template <typename dst_layer_t, typename dst_iter_t, typename src_iter_t,
+            typename gemm_acc_t, typename gates_t, typename scratch_t>
+    rnn_postgemm_sig(execute_bwd) {
+        using namespace rnn_utils;
+        auto dst_iter_c_ld = rnn.dst_iter_c_ld(cell_position);
+        auto src_iter_c_ld = rnn.src_iter_c_ld(cell_position);
+        auto src_iter_ld = rnn.src_iter_ld(cell_position);
+
+        rnn_utils::weights_peephole_aoc_t<const float> weights_peephole(
+                rnn, weights_peephole_);
+        rnn_utils::ws_gates_aoc<gates_t> ws_gates(rnn, ws_gates_);
+        rnn_utils::ws_gates_aoc<scratch_t> scratch_gates(rnn, scratch_gates_);
+        rnn_utils::ws_diff_states_layer_aoc<gemm_acc_t> diff_src_layer(
+                rnn, diff_src_layer_);
+        rnn_utils::ws_diff_states_iter_aoc<gemm_acc_t> diff_src_iter(
+                rnn, diff_src_iter_);
+        rnn_utils::ws_diff_states_iter_c_aoc<gemm_acc_t> diff_src_iter_c(
+                rnn, diff_src_iter_c_);
+        rnn_utils::ws_diff_states_layer_aoc<gemm_acc_t> diff_dst_layer(
+                rnn, diff_dst_layer_);
+        rnn_utils::ws_diff_states_iter_aoc<gemm_acc_t> diff_dst_iter(
+                rnn, diff_dst_iter_);
+        rnn_utils::ws_diff_states_iter_c_aoc<gemm_acc_t> diff_dst_iter_c(
+                rnn, diff_dst_iter_c_);
+        rnn_utils::ws_states_iter_c_aoc<float> dst_iter_c(
+                rnn, dst_iter_c_, dst_iter_c_ld);
+        rnn_utils::ws_states_iter_c_aoc<const float> src_iter_c(
+                rnn, src_iter_c_, src_iter_c_ld);
+
+        ws_states_iter_aoc<const src_iter_t> src_iter(
+                rnn, src_iter_, src_iter_ld);
+        ws_gates_aoc<scratch_t> scratch_cell(rnn, scratch_cell_);
+        utils::array_offset_calculator<scratch_t, 2> hG1(
+                scratch_cell_, rnn.ws_states_layer_nld, rnn.ws_states_layer_ld);
+        utils::array_offset_calculator<gates_t, 2> ws_grid(
+                ws_grid_, rnn.mb, rnn.dhc);
+
+        // Todo: add parallelization on dhc for the batch 1 case
+        // Assumption: the kernel runs a loop on dhc elements
+        parallel_nd(rnn.mb, [&](int i) {
+            void *param1_, *param2_, *param4_, *param5_, *param7_, *param8_,
+                    *param9_;
+            const void *param3_, *param6_;
+            switch (pd_->cell_kind()) {
+                case alg_kind::vanilla_lstm:
+                    param1_ = &ws_gates(i, 0, 0);
+                    param2_ = &scratch_gates(i, 0, 0);
+                    param3_ = &diff_dst_layer(i, 0);
+                    param4_ = &diff_dst_iter(i, 0);
+                    param5_ = &diff_src_iter_c(i, 0);
+                    param6_ = &diff_dst_iter_c(i, 0);
+                    param7_ = (float *)&src_iter_c(i, 0);
+                    param8_ = &dst_iter_c(i, 0);
+                    param9_ = (void *)&weights_peephole(0, 0);
+                    break;
+                case alg_kind::lbr_gru:
+                    param1_ = &ws_gates(i, 0, 0);
+                    param2_ = &scratch_gates(i, 0, 0);
+                    param3_ = &diff_dst_layer(i, 0);
+                    param4_ = &diff_dst_iter(i, 0);
+                    param5_ = &diff_src_iter(i, 0);
+                    param6_ = &src_iter(i, 0);
+                    param7_ = &scratch_cell(i, 0, 0);
+                    param8_ = &ws_grid(i, 0);
+                    param9_ = nullptr;
+                    break;
+                case alg_kind::vanilla_gru:
+                    // TODO: split part1 and part2 execute functions
+                    param1_ = &ws_gates(i, 0, 0);
+                    param2_ = &scratch_gates(i, 0, 0); // RNN, LSTM, GRU
+                    param3_ = &diff_dst_layer(i, 0); // not needed for part2
+                    param4_ = &diff_dst_iter(i, 0); // not needed for part2
+                    param5_ = &diff_src_iter(i, 0);
+                    param6_ = &src_iter(i, 0);
+                    param7_ = &hG1(i, 0); // not needed for part1
+                    param8_ = &ws_grid(i, 0); // not needed in part1
+                    param9_ = &diff_src_layer(i, 0); // not needed for part1
+                    break;
+                case alg_kind::vanilla_rnn:
+                    param1_ = &ws_gates(i, 0, 0);
+                    param2_ = &scratch_gates(i, 0, 0);
+                    param3_ = &diff_dst_layer(i, 0);
+                    param4_ = &diff_dst_iter(i, 0);
+                    param5_ = nullptr;
+                    param6_ = nullptr;
+                    param7_ = nullptr;
+                    param8_ = nullptr;
+                    param9_ = nullptr;
+                    break;
+                default:
+                    assert(!"unsupported");
+                    param1_ = nullptr;
+                    param2_ = nullptr;
+                    param3_ = nullptr;
+                    param4_ = nullptr;
+                    param5_ = nullptr;
+                    param6_ = nullptr;
+                    param7_ = nullptr;
+                    param8_ = nullptr;
+                    param9_ = nullptr;
+                    break;
+            }
+            this->operator()(param1_, param2_, param3_, param4_, param5_,
+                    param6_, param7_, param8_, param9_, (size_t)0);
+        });
+    }
+
+protected:
+    using TReg = typename cpu_isa_traits<sve_512>::TReg;
+    using injector_t = jit_uni_eltwise_injector_f32<sve_512>;
+
+    static constexpr int simd_w = cpu_isa_traits<sve_512>::vlen / sizeof(float);
+
+    // Kernel parameters past the eighth one are passed on the stack, x29
+    // holds the stack pointer of the caller minus the 16 bytes of the frame
+    // record pushed by preamble().
+    void load_stack_param(const Xbyak_aarch64::XReg &reg, int param_idx) {
+        assert(param_idx > 8);
+        ldr(reg, ptr(x29, 16 + 8 * (param_idx - 9)));
+    }
+
+    // Emits body(p) for every vector of a row of n_elems f32 values: a loop
+    // over the full vectors followed by a single tail with a partial
+    // predicate. Inside body, vectors are addressed with vaddr().
+    template <typename F>
+    void vec_loop(int n_elems, F body) {
+        using namespace Xbyak_aarch64;
+        const int nvecs = n_elems / simd_w;
+        const int tail = n_elems % simd_w;
+
+        mov(reg_off_, 0);
+        if (nvecs > 0) {
+            Label loop_label;
+            mov_imm(reg_loop_cnt_, nvecs);
+            L_aligned(loop_label, 64);
+            {
+                body(P_ALL_ONE);
+                add_imm(reg_off_, reg_off_, simd_w, X_TMP_0);
+                subs(reg_loop_cnt_, reg_loop_cnt_, 1);
+                b(NE, loop_label);
+            }
+        }
+        if (tail > 0) {
+            mov_imm(X_TMP_0, tail);
+            whilelt(p_tail_.s, xzr, X_TMP_0);
+            body(p_tail_);
+        }
+    }
+
+    // Address of the current vector of gate `gate` in a row starting at
+    // base. Gates are dhc elements apart.
+    Xbyak_aarch64::AdrReg vaddr(const Xbyak_aarch64::XReg &base, int gate = 0) {
+        using namespace Xbyak_aarch64;
+        if (gate == 0) return ptr(base, reg_off_, LSL, 2);
+        add_imm(X_DEFAULT_ADDR, base, gate * rnn_.dhc * sizeof(float),
+                X_TMP_0);
+        return ptr(X_DEFAULT_ADDR, reg_off_, LSL, 2);
+    }
+
+    void uni_load(const TReg &v, const Xbyak_aarch64::AdrReg &addr,
+            const Xbyak_aarch64::PReg &p) {
+        ld1w(v.s, p / Xbyak_aarch64::T_z, addr);
+    }
+    void uni_store(const Xbyak_aarch64::AdrReg &addr, const TReg &v,
+            const Xbyak_aarch64::PReg &p) {
+        st1w(v.s, p, addr);
+    }
+
+    void set_const(const TReg &v, float val) {
+        mov_imm(W_TMP_0, float2int(val));
+        dup(v.s, W_TMP_0);
+    }
+
+    // Creates an eltwise injector that does not save its auxiliary vectors:
+    // the kernels keep their data in z16-z31 and leave the lower half of the
+    // register file to the injectors.
+    injector_t *create_injector(alg_kind_t alg, float alpha,
+            const Xbyak_aarch64::XReg &x_table) {
+        return new injector_t(this, alg, alpha, 0.0f, 1.0f, false, x_table);
+    }
+
+    const rnn_utils::rnn_conf_t &rnn_;
+    const rnn_pd_t *pd_;
+    bool projection_;
+
+    // element offset of the current vector, shared by all rows
+    const Xbyak_aarch64::XReg reg_off_ = x16;
+    const Xbyak_aarch64::XReg reg_loop_cnt_ = x17;
+    const Xbyak_aarch64::PReg p_tail_ = Xbyak_aarch64::PReg(2);
+};
+
+} // namespace aarch64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,467 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_CONCAT_UTILS_HPP
+#define CPU_CONCAT_UTILS_HPP
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/concat_pd.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/nstl.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/platform.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace concat_utils {
+
+// Helpers for the JIT concat implementations. The data is copied byte-wise,
+// so the kernels do not depend on the data type.
+//
+// The tensors are seen as [outer][rows][row], and the part of an input copied
+// to every row of dst is described by a segment. A kernel call copies a few
+// rows of all the segments at once, so that a single call covers all the
+// inputs however many they are.
+// - Dense layout: the inputs have images in dst (the case of simple_concat),
+//   so a row of dst is the concatenation of the rows of the inputs and every
+//   input makes a single segment. There is no outer dimension.
+// - Blocked layout: the concat dimension is the only blocked one, and the
+//   sizes of the inputs are not multiples of the block. The outer dimensions
+//   go before the concat one, and the rows are the points of the dimensions
+//   that follow it. An input makes a segment for every range of its channels
+//   that lies within a single block of both the input and dst, and an extra
+//   segment zeroes the padded channels of dst.
+
+// The blocks of the blocked layout are limited to the size of the buffer the
+// padded channels of dst are zeroed from.
+constexpr dim_t max_block_bytes = 64;
+// Keeps the kernel calls large enough to amortize them.
+constexpr dim_t min_call_bytes = 4096;
+
+struct job_t {
+    // keep all sizes at 8 bytes -- jit code expects this
+    const char *src;
+    char *dst;
+    size_t bytes;
+    size_t src_stride; // between the rows
+    size_t dst_stride;
+};
+
+struct call_params_t {
+    // keep all sizes at 8 bytes -- jit code expects this
+    const job_t *jobs;
+    size_t njobs;
+    size_t nrows; // rows to copy for every job
+};
+
+// The offsets are in bytes from the first row of the input and of dst. The
+// zero-padding segment has input == -1.
+struct segment_t {
+    int input;
+    dim_t src_off;
+    dim_t dst_off;
+    dim_t bytes;
+};
+
+struct conf_t {
+    bool is_blocked;
+
+    dim_t outer, nrows;
+    // Strides in bytes, the src ones are indexed by the input.
+    dim_t dst_outer_stride, dst_row_stride;
+    std::vector<dim_t> src_outer_strides, src_row_strides;
+    std::vector<segment_t> segments;
+    // Bytes of dst covered by a row of the segments.
+    dim_t row_bytes;
+
+    // A kernel call copies row_block rows of an outer index. When there are
+    // fewer rows than threads, the rows are also split into nparts parts.
+    dim_t row_block;
+    dim_t nparts;
+
+    // Bypass the caches with dst that does not fit in the last level cache.
+    bool use_nt_stores;
+};
+
+// Checks that the dimensions at positions [begin, end) of the order can be
+// collapsed into a single one and returns its stride in elements (0 if the
+// dimensions are all of size 1).
+inline bool collapse_dims(const memory_desc_wrapper &mdw, const dims_t phys,
+        const std::vector<int> &order, int begin, int end, dim_t &stride) {
+    const auto &strides = mdw.blocking_desc().strides;
+    stride = 0;
+    dim_t next_stride = 0;
+    for (int p = end - 1; p >= begin; --p) {
+        const int d = order[p];
+        if (phys[d] == 1) continue;
+        if (stride == 0)
+            stride = strides[d];
+        else if (strides[d] != next_stride)
+            return false;
+        next_stride = strides[d] * phys[d];
+    }
+    return true;
+}
+
+// Returns the order of the dimensions of dst from the outermost to the
+// innermost one.
+inline std::vector<int> get_dims_order(const memory_desc_wrapper &dst_d) {
+    const auto &strides = dst_d.blocking_desc().strides;
+    std::vector<int> order(dst_d.ndims());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+            [&](int a, int b) { return strides[a] > strides[b]; });
+    return order;
+}
+
+// Returns the size of the block of the concat dimension if it is the only
+// blocked dimension, and 0 otherwise.
+inline dim_t get_concat_block(const memory_desc_wrapper &mdw, int concat_dim) {
+    if (!mdw.is_blocking_desc() || mdw.is_additional_buffer()) return 0;
+    const auto &bd = mdw.blocking_desc();
+    if (bd.inner_nblks != 1 || bd.inner_idxs[0] != concat_dim) return 0;
+    return bd.inner_blks[0];
+}
+
+// Initializes dst with the layout of the inputs when they all have the same
+// single block on the concat dimension. Otherwise, concat_pd_t would pick a
+// plain dst for the inputs that are not block-aligned.
+inline status_t init_dst_md(memory_desc_t &dst_md, const concat_pd_t *pd) {
+    if (dst_md.format_kind != format_kind::any) return status::success;
+
+    const int concat_dim = pd->concat_dim();
+    const memory_desc_wrapper src0_d(pd->src_md(0));
+    const dim_t block = get_concat_block(src0_d, concat_dim);
+    if (block <= 1) return status::success;
+
+    // The order of the dimensions is taken from the largest input: with a
+    // single block along the concat dimension, its stride is ambiguous.
+    int largest = 0;
+    const bool ignore_strides = true;
+    for (int i = 1; i < pd->n_inputs(); ++i) {
+        const memory_desc_wrapper i_d(pd->src_md(i));
+        if (get_concat_block(i_d, concat_dim) != block
+                || !types::blocking_desc_is_equal(
+                        *i_d.md_, *src0_d.md_, ignore_strides))
+            return status::success;
+        if (i_d.dims()[concat_dim] > pd->src_md(largest)->dims[concat_dim])
+            largest = i;
+    }
+    return memory_desc_init_by_blocking_desc(
+            dst_md, pd->src_md(largest)->format_desc.blocking);
+}
+
+inline status_t init_dense_conf(conf_t &conf, const concat_pd_t *pd) {
+    const memory_desc_wrapper dst_d(pd->dst_md());
+    const int ndims = dst_d.ndims();
+    const int concat_dim = pd->concat_dim();
+    const dim_t dsz = types::data_type_size(dst_d.data_type());
+
+    const bool ignore_strides = true;
+    for (int i = 0; i < pd->n_inputs(); ++i) {
+        const memory_desc_wrapper i_d(pd->src_md(i));
+        const memory_desc_wrapper o_d(pd->src_image_md(i));
+        const bool ok = i_d.data_type() == dst_d.data_type()
+                && utils::everyone_is(format_kind::blocked, i_d.format_kind(),
+                        o_d.format_kind())
+                && types::blocking_desc_is_equal(
+                        *i_d.md_, *o_d.md_, ignore_strides)
+                && types::blocking_desc_is_equal(
+                        *i_d.md_, *dst_d.md_, ignore_strides)
+                && !i_d.is_additional_buffer();
+        if (!ok) return status::unimplemented;
+    }
+
+    dims_t blocks, phys;
+    dst_d.compute_blocks(blocks);
+    for (int d = 0; d < ndims; ++d)
+        phys[d] = dst_d.padded_dims()[d] / blocks[d];
+    const std::vector<int> order = get_dims_order(dst_d);
+    const int k = (int)(std::find(order.begin(), order.end(), concat_dim)
+            - order.begin());
+
+    // The dimensions from the concat one on make the rows, which must be
+    // dense and laid out the same way in the inputs and in dst.
+    auto row_nelems = [&](const memory_desc_wrapper &mdw) {
+        dim_t nelems = 1;
+        for (int p = k; p < ndims; ++p)
+            nelems *= mdw.padded_dims()[order[p]] / blocks[order[p]];
+        for (int d = 0; d < ndims; ++d)
+            nelems *= blocks[d];
+        return nelems;
+    };
+    const auto &dst_strides = dst_d.blocking_desc().strides;
+    if (row_nelems(dst_d) != phys[concat_dim] * dst_strides[concat_dim])
+        return status::unimplemented;
+
+    dim_t dst_row_stride;
+    if (!collapse_dims(dst_d, phys, order, 0, k, dst_row_stride))
+        return status::unimplemented;
+
+    conf.is_blocked = false;
+    conf.outer = 1;
+    conf.nrows = 1;
+    for (int p = 0; p < k; ++p)
+        conf.nrows *= phys[order[p]];
+    conf.dst_outer_stride = 0;
+    conf.dst_row_stride = dst_row_stride * dsz;
+    conf.row_bytes = row_nelems(dst_d) * dsz;
+
+    for (int i = 0; i < pd->n_inputs(); ++i) {
+        const memory_desc_wrapper i_d(pd->src_md(i));
+        const memory_desc_wrapper o_d(pd->src_image_md(i));
+        for (int p = k; p < ndims; ++p)
+            if (i_d.blocking_desc().strides[order[p]]
+                    != dst_strides[order[p]])
+                return status::unimplemented;
+
+        dim_t src_row_stride;
+        if (!collapse_dims(i_d, phys, order, 0, k, src_row_stride))
+            return status::unimplemented;
+        conf.src_outer_strides.push_back(0);
+        conf.src_row_strides.push_back(src_row_stride * dsz);
+
+        const dim_t bytes = row_nelems(i_d) * dsz;
+        if (bytes == 0) continue;
+        conf.segments.push_back({i, i_d.offset0() * dsz,
+                (o_d.offset0() - dst_d.offset0()) * dsz, bytes});
+    }
+
+    return status::success;
+}
+
+inline status_t init_blocked_conf(conf_t &conf, const concat_pd_t *pd) {
+    const memory_desc_wrapper dst_d(pd->dst_md());
+    const int ndims = dst_d.ndims();
+    const int concat_dim = pd->concat_dim();
+    const dim_t dsz = types::data_type_size(dst_d.data_type());
+
+    const dim_t block = get_concat_block(dst_d, concat_dim);
+    if (block <= 1 || block * dsz > max_block_bytes)
+        return status::unimplemented;
+
+    const std::vector<int> order = get_dims_order(dst_d);
+    const int k = (int)(std::find(order.begin(), order.end(), concat_dim)
+            - order.begin());
+
+    // Splits a tensor into [outer][concat][inner][block], the inner points
+    // must be dense.
+    auto init_layout = [&](const memory_desc_wrapper &mdw, dim_t &outer_stride,
+                               dim_t &concat_stride) {
+        if (get_concat_block(mdw, concat_dim) != block
+                || mdw.data_type() != dst_d.data_type())
+            return false;
+        dims_t phys;
+        for (int d = 0; d < ndims; ++d) {
+            if (d != concat_dim && mdw.padded_dims()[d] != mdw.dims()[d])
+                return false;
+            phys[d] = mdw.padded_dims()[d];
+        }
+        phys[concat_dim] /= block;
+
+        dim_t inner_stride;
+        if (!collapse_dims(mdw, phys, order, k + 1, ndims, inner_stride)
+                || !utils::one_of(inner_stride, 0, block)
+                || !collapse_dims(mdw, phys, order, 0, k, outer_stride))
+            return false;
+        concat_stride = mdw.blocking_desc().strides[concat_dim];
+        return true;
+    };
+
+    dim_t dst_outer_stride, dst_concat_stride;
+    if (!init_layout(dst_d, dst_outer_stride, dst_concat_stride))
+        return status::unimplemented;
+
+    conf.is_blocked = true;
+    conf.outer = 1;
+    conf.nrows = 1;
+    for (int p = 0; p < ndims; ++p) {
+        if (p < k) conf.outer *= dst_d.dims()[order[p]];
+        if (p > k) conf.nrows *= dst_d.dims()[order[p]];
+    }
+    conf.dst_outer_stride = dst_outer_stride * dsz;
+    conf.dst_row_stride = block * dsz;
+    conf.row_bytes = block * dsz;
+
+    // Offset of a channel from the first row of a tensor.
+    auto channel_off = [&](dim_t c, dim_t concat_stride) {
+        return ((c / block) * concat_stride + c % block) * dsz;
+    };
+
+    dim_t dst_c = 0;
+    for (int i = 0; i < pd->n_inputs(); ++i) {
+        const memory_desc_wrapper i_d(pd->src_md(i));
+        dim_t src_outer_stride, src_concat_stride;
+        if (!init_layout(i_d, src_outer_stride, src_concat_stride))
+            return status::unimplemented;
+        conf.src_outer_strides.push_back(src_outer_stride * dsz);
+        conf.src_row_strides.push_back(block * dsz);
+
+        const dim_t channels = i_d.dims()[concat_dim];
+        for (dim_t c = 0; c < channels;) {
+            const dim_t len = nstl::min(channels - c,
+                    nstl::min(block - c % block, block - dst_c % block));
+            conf.segments.push_back({i,
+                    i_d.offset0() * dsz + channel_off(c, src_concat_stride),
+                    channel_off(dst_c, dst_concat_stride), len * dsz});
+            c += len;
+            dst_c += len;
+        }
+    }
+
+    const dim_t padded_c = dst_d.padded_dims()[concat_dim];
+    if (dst_c < padded_c)
+        conf.segments.push_back({-1, 0, channel_off(dst_c, dst_concat_stride),
+                (padded_c - dst_c) * dsz});
+
+    return status::success;
+}
+
+// Initializes the segments and the work split. The dense layout requires the
+// images of the inputs, i.e. a successful concat_pd_t::init().
+inline status_t init_conf(
+        conf_t &conf, const concat_pd_t *pd, bool has_src_images) {
+    const memory_desc_wrapper dst_d(pd->dst_md());
+    bool ok = pd->attr()->has_default_values() && dst_d.is_blocking_desc()
+            && !dst_d.is_additional_buffer()
+            && !dst_d.has_runtime_dims_or_strides();
+    for (int i = 0; i < pd->n_inputs(); ++i)
+        ok = ok
+                && !memory_desc_wrapper(pd->src_md(i))
+                            .has_runtime_dims_or_strides();
+    if (!ok) return status::unimplemented;
+
+    conf = conf_t();
+    if (dst_d.has_zero_dim()) {
+        conf.outer = conf.nrows = 0;
+        conf.row_block = conf.nparts = 1;
+        return status::success;
+    }
+
+    if (has_src_images)
+        CHECK(init_dense_conf(conf, pd));
+    else
+        CHECK(init_blocked_conf(conf, pd));
+
+    const int nthr = dnnl_get_max_threads();
+    dim_t nchunks = nstl::min<dim_t>(
+            conf.nrows, utils::div_up<dim_t>(4 * nthr, conf.outer));
+    nchunks = nstl::min(nchunks,
+            nstl::max<dim_t>(1, conf.nrows * conf.row_bytes / min_call_bytes));
+    conf.row_block = utils::div_up(conf.nrows, nchunks);
+
+    conf.nparts = 1;
+    if (!conf.is_blocked && conf.outer * conf.nrows < nthr)
+        conf.nparts = nstl::max<dim_t>(1,
+                nstl::min<dim_t>(utils::div_up(nthr, conf.outer * conf.nrows),
+                        conf.row_bytes / min_call_bytes));
+
+    // The rows of the blocked layout are too short for the non-temporal
+    // stores to fill whole cache lines.
+    const size_t llc_size
+            = (size_t)platform::get_per_core_cache_size(3) * nthr;
+    conf.use_nt_stores = !conf.is_blocked && dst_d.size() > llc_size;
+
+    return status::success;
+}
+
+inline void init_scratchpad(
+        memory_tracking::registrar_t &scratchpad, const conf_t &conf) {
+    if (conf.segments.empty()) return;
+    scratchpad.template book<job_t>(memory_tracking::names::key_concat_jobs,
+            dnnl_get_max_threads() * conf.segments.size());
+}
+
+// Copies the inputs to dst with a kernel that takes call_params_t. The dst
+// pointer includes the offset of its memory descriptor, while the offsets of
+// the inputs are in the segments. The scratchpad holds the jobs of the
+// threads.
+template <typename kernel_t>
+void execute(const conf_t &conf, const kernel_t &kernel,
+        const std::vector<const char *> &srcs, char *dst, job_t *scratchpad) {
+    static const char zeros[max_block_bytes] = {};
+
+    const dim_t nsegments = (dim_t)conf.segments.size();
+    if (nsegments == 0 || conf.outer == 0 || conf.nrows == 0) return;
+
+    const dim_t nchunks = utils::div_up(conf.nrows, conf.row_block);
+    // Keep the parts at whole cache lines of dst.
+    const dim_t part_bytes
+            = utils::rnd_up(utils::div_up(conf.row_bytes, conf.nparts), 64);
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        job_t *jobs = scratchpad + ithr * nsegments;
+        for_nd(ithr, nthr, conf.outer, nchunks, conf.nparts,
+                [&](dim_t o, dim_t ch, dim_t part) {
+                    const dim_t r0 = ch * conf.row_block;
+                    const dim_t p0 = part * part_bytes;
+                    const dim_t p1
+                            = nstl::min(conf.row_bytes, p0 + part_bytes);
+
+                    size_t njobs = 0;
+                    for (const auto &s : conf.segments) {
+                        // Only the dense rows are split into parts.
+                        dim_t b0 = s.dst_off, b1 = s.dst_off + s.bytes;
+                        if (conf.nparts > 1) {
+                            b0 = nstl::max(b0, p0);
+                            b1 = nstl::min(b1, p1);
+                            if (b0 >= b1) continue;
+                        }
+
+                        job_t &j = jobs[njobs++];
+                        if (s.input < 0) {
+                            j.src = zeros;
+                            j.src_stride = 0;
+                        } else {
+                            j.src = srcs[s.input] + s.src_off
+                                    + o * conf.src_outer_strides[s.input]
+                                    + r0 * conf.src_row_strides[s.input]
+                                    + (b0 - s.dst_off);
+                            j.src_stride = conf.src_row_strides[s.input];
+                        }
+                        j.dst = dst + b0 + o * conf.dst_outer_stride
+                                + r0 * conf.dst_row_stride;
+                        j.bytes = b1 - b0;
+                        j.dst_stride = conf.dst_row_stride;
+                    }
+                    if (njobs == 0) return;
+
+                    call_params_t p;
+                    p.jobs = jobs;
+                    p.njobs = njobs;
+                    p.nrows = nstl::min(conf.row_block, conf.nrows - r0);
+                    kernel(&p);
+                });
+    });
+}
+
+} // namespace concat_utils
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
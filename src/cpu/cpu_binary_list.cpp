@@ -21,6 +21,9 @@
 #if DNNL_X64
 #include "cpu/x64/jit_uni_binary.hpp"
 using namespace dnnl::impl::cpu::x64;
+#elif DNNL_AARCH64
+#include "cpu/aarch64/jit_uni_binary.hpp"
+using namespace dnnl::impl::cpu::aarch64;
 #endif
 
 namespace dnnl {
@@ -33,6 +36,7 @@ using namespace dnnl::impl::data_type;
 // clang-format off
 const impl_list_item_t impl_list[] = {
         CPU_INSTANCE_X64(jit_uni_binary_t)
+        CPU_INSTANCE_AARCH64(jit_uni_binary_t<sve_512>)
         CPU_INSTANCE(ref_binary_t<f32>)
         CPU_INSTANCE(ref_binary_t<bf16>)
         CPU_INSTANCE(ref_binary_t<s8, s8, s8>)
@@ -20,6 +20,14 @@
 #include "cpu/ref_concat.hpp"
 #include "cpu/simple_concat.hpp"
 
+#if DNNL_X64
+#include "cpu/x64/jit_uni_concat.hpp"
+using namespace dnnl::impl::cpu::x64;
+#elif DNNL_AARCH64
+#include "cpu/aarch64/jit_uni_concat.hpp"
+using namespace dnnl::impl::cpu::aarch64;
+#endif
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -28,8 +36,13 @@ namespace {
 #define INSTANCE(...) \
     impl_list_item_t(impl_list_item_t::concat_type_deduction_helper_t< \
             __VA_ARGS__::pd_t>()),
+#define INSTANCE_X64(...) DNNL_X64_ONLY(INSTANCE(__VA_ARGS__))
+#define INSTANCE_AARCH64(...) DNNL_AARCH64_ONLY(INSTANCE(__VA_ARGS__))
 // clang-format off
 const impl_list_item_t cpu_concat_impl_list[] = {
+        INSTANCE_X64(jit_uni_concat_t<avx512_core>)
+        INSTANCE_X64(jit_uni_concat_t<avx2>)
+        INSTANCE_AARCH64(jit_uni_concat_t<sve_512>)
         INSTANCE(simple_concat_t<data_type::f32>)
         INSTANCE(simple_concat_t<data_type::u8>)
         INSTANCE(simple_concat_t<data_type::s8>)
@@ -39,6 +52,8 @@ const impl_list_item_t cpu_concat_impl_list[] = {
         nullptr,
 };
 // clang-format on
+#undef INSTANCE_AARCH64
+#undef INSTANCE_X64
 #undef INSTANCE
 } // namespace
 
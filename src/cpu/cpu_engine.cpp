@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2016-2020 Intel Corporation
+* Copyright 2016-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -29,7 +29,9 @@ namespace cpu {
 
 status_t cpu_engine_t::create_memory_storage(
         memory_storage_t **storage, unsigned flags, size_t size, void *handle) {
-    auto _storage = new cpu_memory_storage_t(this);
+    auto _storage = new cpu_memory_storage_t(this,
+            flags & memory_flags_t::scratchpad ? allocation_kind::scratchpad
+                                               : allocation_kind::memory);
     if (_storage == nullptr) return status::out_of_memory;
     status_t status = _storage->init(flags, size, handle);
     if (status != status::success) {
@@ -46,9 +48,9 @@ status_t cpu_engine_t::create_stream(stream_t **stream, unsigned flags) {
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
 status_t cpu_engine_t::create_stream(stream_t **stream,
-        dnnl::threadpool_interop::threadpool_iface *threadpool) {
+        dnnl::threadpool_interop::threadpool_iface *threadpool, bool async) {
     return safe_ptr_assign<stream_t>(
-            *stream, new cpu_stream_t(this, threadpool));
+            *stream, new cpu_stream_t(this, threadpool, async));
 }
 #endif
 
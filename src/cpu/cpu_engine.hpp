@@ -50,7 +50,7 @@ DECLARE_IMPL_LIST(convolution);
 DECLARE_IMPL_LIST(deconvolution);
 DECLARE_IMPL_LIST(eltwise);
 DECLARE_IMPL_LIST(inner_product);
-DECLARE_IMPL_LIST(layer_normalization);
+DECLARE_IMPL_LIST(layer_normalization_v2);
 DECLARE_IMPL_LIST(lrn);
 DECLARE_IMPL_LIST(logsoftmax);
 DECLARE_IMPL_LIST(matmul);
@@ -86,7 +86,8 @@ public:
             CASE(deconvolution);
             CASE(eltwise);
             CASE(inner_product);
-            CASE(layer_normalization);
+            case primitive_kind::layer_normalization:
+            CASE(layer_normalization_v2);
             CASE(lrn);
             CASE(logsoftmax);
             CASE(matmul);
@@ -118,7 +119,8 @@ public:
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     status_t create_stream(stream_t **stream,
-            dnnl::threadpool_interop::threadpool_iface *threadpool) override;
+            dnnl::threadpool_interop::threadpool_iface *threadpool,
+            bool async) override;
 #endif
 
     const impl_list_item_t *get_concat_implementation_list() const override {
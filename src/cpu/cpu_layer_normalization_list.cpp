@@ -42,8 +42,8 @@ const impl_list_item_t impl_list[] = {
 // clang-format on
 } // namespace
 
-const impl_list_item_t *get_layer_normalization_impl_list(
-        const layer_normalization_desc_t *desc) {
+const impl_list_item_t *get_layer_normalization_v2_impl_list(
+        const layer_normalization_v2_desc_t *desc) {
     UNUSED(desc);
     return impl_list;
 }
@@ -17,6 +17,7 @@
 #ifndef CPU_CPU_MEMORY_STORAGE_HPP
 #define CPU_CPU_MEMORY_STORAGE_HPP
 
+#include <functional>
 #include <memory>
 
 #include "common/c_types_map.hpp"
@@ -33,8 +34,9 @@ namespace cpu {
 
 class cpu_memory_storage_t : public memory_storage_t {
 public:
-    cpu_memory_storage_t(engine_t *engine)
-        : memory_storage_t(engine), data_(nullptr, release) {}
+    cpu_memory_storage_t(engine_t *engine,
+            allocation_kind_t kind = allocation_kind::memory)
+        : memory_storage_t(engine), kind_(kind), data_(nullptr, release) {}
 
     status_t get_data_handle(void **handle) const override {
         *handle = data_.get();
@@ -86,14 +88,31 @@ public:
 
 protected:
     status_t init_allocate(size_t size) override {
-        void *ptr = malloc(size, platform::get_cache_line_size());
+        const size_t alignment = platform::get_cache_line_size();
+        const engine_allocator_t &allocator = engine()->allocator();
+        if (allocator.allocate) {
+            void *ptr = allocator.allocate(
+                    size, alignment, kind_, allocator.user_data);
+            if (!ptr) return status::out_of_memory;
+            // The memory is freed with the allocator it comes from even if
+            // the engine allocator is changed later
+            const auto deallocate = allocator.deallocate;
+            const auto kind = kind_;
+            void *user_data = allocator.user_data;
+            data_ = decltype(data_)(ptr, [=](void *p) {
+                deallocate(p, kind, user_data);
+            });
+            return status::success;
+        }
+        void *ptr = malloc(size, (int)alignment);
         if (!ptr) return status::out_of_memory;
         data_ = decltype(data_)(ptr, destroy);
         return status::success;
     }
 
 private:
-    std::unique_ptr<void, void (*)(void *)> data_;
+    allocation_kind_t kind_;
+    std::unique_ptr<void, std::function<void(void *)>> data_;
 
     DNNL_DISALLOW_COPY_AND_ASSIGN(cpu_memory_storage_t);
 
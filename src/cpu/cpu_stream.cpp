@@ -0,0 +1,140 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "oneapi/dnnl/dnnl_config.h"
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "common/primitive.hpp"
+#include "common/primitive_exec_types.hpp"
+
+#include "cpu/cpu_stream.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+bool async_dispatcher_t::is_supported(
+        dnnl::threadpool_interop::threadpool_iface *threadpool) {
+    using dnnl::threadpool_interop::threadpool_iface;
+    return threadpool
+            && (threadpool->get_flags() & threadpool_iface::ASYNCHRONOUS)
+            && threadpool->get_num_threads() > 1;
+}
+
+async_dispatcher_t::async_dispatcher_t(engine_t *engine,
+        dnnl::threadpool_interop::threadpool_iface *threadpool)
+    : engine_(engine), threadpool_(threadpool) {}
+
+async_dispatcher_t::~async_dispatcher_t() {
+    wait();
+}
+
+void async_dispatcher_t::submit_primitive(
+        const primitive_iface_t *primitive_iface, const exec_ctx_t &ctx) {
+    // The primitive is kept alive until its execution is done. The context
+    // is copied since the caller's one is destroyed once submission returns.
+    auto *p_iface = const_cast<primitive_iface_t *>(primitive_iface);
+    p_iface->retain();
+    const thread_team_t *team = ctx.stream()->thread_team();
+    submit([this, p_iface, ctx, team]() {
+        exec_ctx_t task_ctx(ctx);
+        if (team) thread_team_utils::activate_thread_team(team);
+        threadpool_utils::activate_threadpool(threadpool_);
+        threadpool_utils::activate_worker_task();
+        status_t status = p_iface->execute(task_ctx);
+        threadpool_utils::deactivate_worker_task();
+        threadpool_utils::deactivate_threadpool();
+        if (team) thread_team_utils::deactivate_thread_team();
+        p_iface->release();
+        set_status(status);
+    });
+}
+
+void async_dispatcher_t::submit_callback(
+        dnnl_threadpool_interop_callback_t callback, void *user_data) {
+    submit([this, callback, user_data]() {
+        status_t status = status::success;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::swap(status, callback_status_);
+        }
+        callback(status, user_data);
+    });
+}
+
+status_t async_dispatcher_t::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return !running_; });
+    status_t status = status::success;
+    std::swap(status, wait_status_);
+    return status;
+}
+
+status_t async_dispatcher_t::get_scratchpad_storage(
+        size_t size, const memory_storage_t **storage) {
+    // Only called from the drain task, no need to lock
+    if (!scratchpad_ || scratchpad_->size() < size) {
+        scratchpad_.reset();
+        scratchpad_.reset(create_scratchpad(engine_, size, false));
+        if (!scratchpad_ || !scratchpad_->get_memory_storage()
+                || scratchpad_->size() < size) {
+            scratchpad_.reset();
+            return status::out_of_memory;
+        }
+    }
+    *storage = scratchpad_->get_memory_storage();
+    return status::success;
+}
+
+void async_dispatcher_t::submit(std::function<void()> &&task) {
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+        if (!running_) running_ = schedule = true;
+    }
+    // The threadpool is asynchronous, so the submitting thread does not wait
+    // for the drain task
+    if (schedule) threadpool_->parallel_for(1, [this](int, int) { drain(); });
+}
+
+void async_dispatcher_t::set_status(status_t status) {
+    if (status == status::success) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (wait_status_ == status::success) wait_status_ = status;
+    if (callback_status_ == status::success) callback_status_ = status;
+}
+
+void async_dispatcher_t::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!tasks_.empty()) {
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+    running_ = false;
+    done_cv_.notify_all();
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2019-2020 Intel Corporation
+* Copyright 2019-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -20,6 +20,12 @@
 #include "oneapi/dnnl/dnnl_config.h"
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
 #endif
 
@@ -27,8 +33,65 @@
 #include "common/dnnl_thread.hpp"
 #include "common/stream.hpp"
 
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "common/scratchpad.hpp"
+#endif
+
 namespace dnnl {
 namespace impl {
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+namespace cpu {
+
+// Executes the tasks submitted to an asynchronous threadpool stream in order,
+// so that the submitting thread never waits for the computations. Whenever
+// the queue is not empty, a task draining it is scheduled on the threadpool.
+// A single drain task runs at a time, so the dispatcher also owns the
+// scratchpad used by the primitives it executes.
+struct async_dispatcher_t {
+    async_dispatcher_t(engine_t *engine,
+            dnnl::threadpool_interop::threadpool_iface *threadpool);
+    ~async_dispatcher_t();
+
+    // Returns true if the tasks can run asynchronously on `threadpool`: its
+    // parallel_for() must return without waiting, and the drain task must
+    // leave other workers for the parallel sections of the primitives.
+    static bool is_supported(
+            dnnl::threadpool_interop::threadpool_iface *threadpool);
+
+    void submit_primitive(
+            const primitive_iface_t *primitive_iface, const exec_ctx_t &ctx);
+    void submit_callback(
+            dnnl_threadpool_interop_callback_t callback, void *user_data);
+
+    // Blocks until all the submitted tasks are done and returns the status of
+    // the first primitive failed since the previous call
+    status_t wait();
+
+    status_t get_scratchpad_storage(
+            size_t size, const memory_storage_t **storage);
+
+private:
+    engine_t *engine_;
+    dnnl::threadpool_interop::threadpool_iface *threadpool_;
+    std::unique_ptr<scratchpad_t> scratchpad_;
+
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+    std::deque<std::function<void()>> tasks_;
+    // True while a drain task is scheduled or running
+    bool running_ = false;
+    status_t wait_status_ = status::success;
+    status_t callback_status_ = status::success;
+
+    void submit(std::function<void()> &&task);
+    void set_status(status_t status);
+    void drain();
+};
+
+} // namespace cpu
+#endif
+
 namespace cpu {
 
 struct cpu_stream_t : public stream_t {
@@ -36,24 +99,75 @@ struct cpu_stream_t : public stream_t {
     virtual ~cpu_stream_t() = default;
 
     dnnl::impl::status_t wait() override {
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        if (dispatcher_) return dispatcher_->wait();
+#endif
         // CPU execution is synchronous so return immediately
         return dnnl::impl::status::success;
     }
 
-#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
-    cpu_stream_t(engine_t *engine,
-            dnnl::threadpool_interop::threadpool_iface *threadpool)
-        : stream_t(engine, threadpool) {}
-
     void before_exec_hook() override {
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        // The thread team and the threadpool are activated in the dispatcher
+        // task for asynchronous streams
+        if (dispatcher_) return;
+#endif
+        if (thread_team_)
+            thread_team_utils::activate_thread_team(thread_team_.get());
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
         dnnl::threadpool_interop::threadpool_iface *tp;
         auto rc = this->get_threadpool(&tp);
         if (rc == status::success) threadpool_utils::activate_threadpool(tp);
+#endif
     }
 
     void after_exec_hook() override {
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        if (dispatcher_) return;
+#endif
+        if (thread_team_) thread_team_utils::deactivate_thread_team();
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
         threadpool_utils::deactivate_threadpool();
+#endif
     }
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    cpu_stream_t(engine_t *engine,
+            dnnl::threadpool_interop::threadpool_iface *threadpool,
+            bool async = false)
+        : stream_t(engine, threadpool) {
+        // Otherwise the stream executes the primitives synchronously
+        if (async && async_dispatcher_t::is_supported(threadpool))
+            dispatcher_.reset(new async_dispatcher_t(engine, threadpool));
+    }
+
+    status_t enqueue_primitive(const primitive_iface_t *primitive_iface,
+            exec_ctx_t &ctx) override {
+        if (!dispatcher_)
+            return stream_t::enqueue_primitive(primitive_iface, ctx);
+        dispatcher_->submit_primitive(primitive_iface, ctx);
+        return status::success;
+    }
+
+    status_t enqueue_callback(dnnl_threadpool_interop_callback_t callback,
+            void *user_data) override {
+        if (!dispatcher_)
+            return stream_t::enqueue_callback(callback, user_data);
+        dispatcher_->submit_callback(callback, user_data);
+        return status::success;
+    }
+
+    status_t get_scratchpad_storage(
+            size_t size, const memory_storage_t **storage) override {
+        if (!dispatcher_)
+            return stream_t::get_scratchpad_storage(size, storage);
+        return dispatcher_->get_scratchpad_storage(size, storage);
+    }
+
+private:
+    // Destroyed first so that the queued primitives complete while the
+    // stream is still alive
+    std::unique_ptr<async_dispatcher_t> dispatcher_;
 #endif
 };
 
@@ -44,6 +44,12 @@
 #include "cpu/x64/gemm/gemm_driver.hpp"
 
 using namespace dnnl::impl::cpu::x64;
+#elif DNNL_AARCH64
+#include "cpu/aarch64/cpu_isa_traits.hpp"
+
+#include "cpu/aarch64/gemm/gemm_driver.hpp"
+
+using namespace dnnl::impl::cpu::aarch64;
 #endif
 
 namespace dnnl {
@@ -132,6 +138,14 @@ dnnl_status_t extended_sgemm(const char *transa, const char *transb,
                 A, lda, dummy_ao, B, ldb, dummy_bo, beta, C, ldc, bias,
                 force_jit_nocopy_gemm);
     }
+#elif DNNL_AARCH64
+    if (mayiuse(sve_512)) {
+        float *dummy_ao = nullptr;
+        float *dummy_bo = nullptr;
+        return gemm_driver(transa, transb, bias ? "C" : nullptr, M, N, K, alpha,
+                A, lda, dummy_ao, B, ldb, dummy_bo, beta, C, ldc, bias,
+                force_jit_nocopy_gemm);
+    }
 #endif
 
     return ref_gemm<float>(
@@ -194,6 +208,10 @@ dnnl_status_t gemm_s8x8s32(const char *transa, const char *transb,
     if (mayiuse(sse41) && !mayiuse(avx512_mic))
         return gemm_driver(transa, transb, offsetc, M, N, K, alpha, A, LDA, ao,
                 B, LDB, bo, beta, C, LDC, co, false);
+#elif DNNL_AARCH64
+    if (mayiuse(sve_512))
+        return gemm_driver(transa, transb, offsetc, M, N, K, alpha, A, LDA, ao,
+                B, LDB, bo, beta, C, LDC, co, false);
 #endif
 
     return ref_gemm_s8x8s32(transa, transb, offsetc, M, N, K, alpha, A, LDA, ao,
@@ -224,6 +242,10 @@ dnnl_status_t gemm_s8x8s32(const char *transa, const char *transb,
     else if (use_s8u8)
         return simple_gemm_s8s8s32(transa, transb, offsetc, M, N, K, alpha, A,
                 LDA, ao, B, LDB, bo, beta, C, LDC, co);
+#elif DNNL_AARCH64
+    if (mayiuse(sve_512))
+        return gemm_driver(transa, transb, offsetc, M, N, K, alpha, A, LDA, ao,
+                B, LDB, bo, beta, C, LDC, co, false);
 #endif
 
     return ref_gemm_s8x8s32(transa, transb, offsetc, M, N, K, alpha, A, LDA, ao,
@@ -0,0 +1,418 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdint>
+#include <type_traits>
+
+#include "oneapi/dnnl/dnnl_types.h"
+
+#include "common/dnnl_thread.hpp"
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/platform.hpp"
+#include "cpu/simple_q10n.hpp"
+
+#include "cpu/gemm/f32/gemm_utils_f32.hpp"
+#include "cpu/gemm/gemm_msan_unpoison.hpp"
+
+#include "cpu/gemm/s8x8s32/blocked_gemm_s8x8s32.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using namespace dnnl::impl::utils;
+
+namespace {
+
+// Cache blocking of the packed panels (in elements, the k-block is a multiple
+// of the dot-product group of 4).
+constexpr dim_t igemm_bm = 192;
+constexpr dim_t igemm_bn = 384;
+constexpr dim_t igemm_bk = 512;
+
+constexpr dim_t ref_unroll_m = 16;
+constexpr dim_t ref_unroll_n = 4;
+
+template <bool beta_zero>
+void gemm_s8x8s32_ref_kern(dim_t m, dim_t n, dim_t k, const int8_t *a,
+        const int8_t *b, int32_t *c, dim_t ldc) {
+    int32_t acc[ref_unroll_n][ref_unroll_m] = {{0}};
+
+    for (dim_t kk = 0; kk < k; kk += 4) {
+        for (dim_t j = 0; j < ref_unroll_n; j++) {
+            const int32_t b0 = b[4 * j + 0], b1 = b[4 * j + 1],
+                          b2 = b[4 * j + 2], b3 = b[4 * j + 3];
+            PRAGMA_OMP_SIMD()
+            for (dim_t i = 0; i < ref_unroll_m; i++) {
+                acc[j][i] += a[4 * i + 0] * b0 + a[4 * i + 1] * b1
+                        + a[4 * i + 2] * b2 + a[4 * i + 3] * b3;
+            }
+        }
+        a += 4 * ref_unroll_m;
+        b += 4 * ref_unroll_n;
+    }
+
+    for (dim_t j = 0; j < n; j++) {
+        int32_t *c_j = c + j * ldc;
+        for (dim_t i = 0; i < m; i++)
+            c_j[i] = beta_zero ? acc[j][i] : c_j[i] + acc[j][i];
+    }
+}
+
+// Packs an (m x k) block of op(A) into panels of um rows, [k / 4][um][4].
+void pack_a(bool trans, dim_t m, dim_t k, const int8_t *a, dim_t lda,
+        dim_t um, int8_t *ws) {
+    const dim_t k4 = rnd_up(k, 4);
+    for (dim_t i0 = 0; i0 < m; i0 += um) {
+        const dim_t mu = nstl::min(um, m - i0);
+        for (dim_t kk = 0; kk < k4; kk += 4) {
+            const dim_t ku = nstl::min<dim_t>(4, k - kk);
+            for (dim_t i = 0; i < um; i++) {
+                for (dim_t t = 0; t < 4; t++) {
+                    const bool in = i < mu && t < ku;
+                    const dim_t off = trans ? (i0 + i) * lda + (kk + t)
+                                            : (i0 + i) + (kk + t) * lda;
+                    ws[4 * i + t] = in ? a[off] : 0;
+                }
+            }
+            ws += 4 * um;
+        }
+    }
+}
+
+// Packs a (k x n) block of op(B) - b_shift into panels of un columns,
+// [k / 4][un][4].
+template <typename b_dt>
+void pack_b(bool trans, dim_t k, dim_t n, const b_dt *b, dim_t ldb,
+        dim_t un, int32_t b_shift, int8_t *ws) {
+    const dim_t k4 = rnd_up(k, 4);
+    for (dim_t j0 = 0; j0 < n; j0 += un) {
+        const dim_t nu = nstl::min(un, n - j0);
+        for (dim_t kk = 0; kk < k4; kk += 4) {
+            const dim_t ku = nstl::min<dim_t>(4, k - kk);
+            for (dim_t j = 0; j < un; j++) {
+                for (dim_t t = 0; t < 4; t++) {
+                    const bool in = j < nu && t < ku;
+                    const dim_t off = trans ? (j0 + j) + (kk + t) * ldb
+                                            : (j0 + j) * ldb + (kk + t);
+                    ws[4 * j + t] = in ? (int8_t)((int32_t)b[off] - b_shift)
+                                       : 0;
+                }
+            }
+            ws += 4 * un;
+        }
+    }
+}
+
+// Single-threaded C (+)= op(A) * (op(B) - b_shift) with s32 accumulation.
+template <typename b_dt>
+void gemm_s8x8s32_ithr(const gemm_s8x8s32_ukernel_t &ukernel, bool trans_a,
+        bool trans_b, dim_t m, dim_t n, dim_t k, const int8_t *a, dim_t lda,
+        const b_dt *b, dim_t ldb, int32_t b_shift, bool beta_zero, int32_t *c,
+        dim_t ldc, int8_t *ws_a, int8_t *ws_b) {
+    if (m <= 0 || n <= 0) return;
+
+    if (k <= 0) {
+        if (beta_zero)
+            for (dim_t j = 0; j < n; j++)
+                for (dim_t i = 0; i < m; i++)
+                    c[i + j * ldc] = 0;
+        return;
+    }
+
+    const dim_t um = ukernel.unroll_m, un = ukernel.unroll_n;
+    const dim_t bm = rnd_up(igemm_bm, um);
+    const dim_t bn = rnd_up(igemm_bn, un);
+
+    for (dim_t k0 = 0; k0 < k; k0 += igemm_bk) {
+        const dim_t kb = nstl::min(igemm_bk, k - k0);
+        const dim_t kb4 = rnd_up(kb, 4);
+        const auto ker = (beta_zero && k0 == 0) ? ukernel.ker_beta0
+                                                : ukernel.ker_beta1;
+
+        for (dim_t n0 = 0; n0 < n; n0 += bn) {
+            const dim_t nb = nstl::min(bn, n - n0);
+            const b_dt *b_blk = trans_b ? b + n0 + k0 * ldb : b + k0 + n0 * ldb;
+            pack_b(trans_b, kb, nb, b_blk, ldb, un, b_shift, ws_b);
+
+            for (dim_t m0 = 0; m0 < m; m0 += bm) {
+                const dim_t mb = nstl::min(bm, m - m0);
+                const int8_t *a_blk
+                        = trans_a ? a + k0 + m0 * lda : a + m0 + k0 * lda;
+                pack_a(trans_a, mb, kb, a_blk, lda, um, ws_a);
+
+                for (dim_t j = 0; j < nb; j += un) {
+                    const dim_t nu = nstl::min(un, nb - j);
+                    for (dim_t i = 0; i < mb; i += um) {
+                        const dim_t mu = nstl::min(um, mb - i);
+                        ker(mu, nu, kb4, ws_a + i * kb4, ws_b + j * kb4,
+                                c + (m0 + i) + (n0 + j) * ldc, ldc);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+const gemm_s8x8s32_ukernel_t &gemm_s8x8s32_ref_ukernel() {
+    static const gemm_s8x8s32_ukernel_t ukernel = {ref_unroll_m, ref_unroll_n,
+            gemm_s8x8s32_ref_kern<true>, gemm_s8x8s32_ref_kern<false>};
+    return ukernel;
+}
+
+template <typename b_dt>
+dnnl_status_t blocked_gemm_s8x8s32(const gemm_s8x8s32_ukernel_t &ukernel,
+        const char *transa, const char *transb, const char *offsetc,
+        const dim_t *M, const dim_t *N, const dim_t *K, const float *alpha,
+        const int8_t *A, const dim_t *LDA, const int8_t *ao, const b_dt *B,
+        const dim_t *LDB, const b_dt *bo, const float *beta, int32_t *C,
+        const dim_t *LDC, const int32_t *co) {
+    if (!(utils::one_of(*transa, 'n', 'N', 't', 'T')
+                && utils::one_of(*transb, 'n', 'N', 't', 'T')))
+        return dnnl_unimplemented;
+
+    const dim_t m = *M, n = *N, k = *K, lda = *LDA, ldb = *LDB, ldc = *LDC;
+    if (m == 0 || n == 0) return dnnl_success;
+
+    const bool trans_a = utils::one_of(*transa, 't', 'T');
+    const bool trans_b = utils::one_of(*transb, 't', 'T');
+    const bool OCisR = utils::one_of(*offsetc, 'R', 'r');
+    const bool OCisC = utils::one_of(*offsetc, 'C', 'c');
+
+    // Unsigned B is packed as signed (b - 128), the shift goes into bo.
+    const int32_t b_shift = std::is_same<b_dt, uint8_t>::value ? 128 : 0;
+    const int32_t ao_s32 = *ao;
+    const int32_t bo_s32 = (int32_t)*bo - b_shift;
+    const float alpha_f = *alpha, beta_f = *beta;
+
+    // With alpha == 1 and beta in {0, 1} everything is exact in s32, so the
+    // results are accumulated directly into C. Otherwise the raw products go
+    // to an intermediate buffer followed by a floating-point post-processing.
+    const bool direct = alpha_f == 1.f && utils::one_of(beta_f, 0.f, 1.f);
+
+    int nthr_m, nthr_n, nthr_k;
+    dim_t MB, NB, KB;
+    gemm_utils::calc_nthr_nocopy_avx512_common(m, n, k,
+            dnnl_get_current_num_threads(), &nthr_m, &nthr_n, &nthr_k, &MB,
+            &NB, &KB);
+    MB = rnd_up(nstl::max<dim_t>(MB, 1), ukernel.unroll_m);
+    NB = rnd_up(nstl::max<dim_t>(NB, 1), ukernel.unroll_n);
+    KB = rnd_up(nstl::max<dim_t>(KB, 1), 4);
+    nthr_m = (int)div_up(m, MB);
+    nthr_n = (int)div_up(n, NB);
+    nthr_k = k > 0 ? (int)div_up(k, KB) : 1;
+    assert(IMPLICATION(!dnnl_thr_syncable(), nthr_k == 1));
+
+    const int nthr_mn = nthr_m * nthr_n;
+    const int nthr = nthr_mn * nthr_k;
+
+    const dim_t bm = rnd_up(igemm_bm, ukernel.unroll_m);
+    const dim_t bn = rnd_up(igemm_bn, ukernel.unroll_n);
+    const size_t ws_a_size = bm * igemm_bk;
+    const size_t ws_size_per_thr = rnd_up(ws_a_size + igemm_bk * bn, PAGE_4K);
+
+    int8_t *ws_buffers = (int8_t *)malloc(ws_size_per_thr * nthr, PAGE_4K);
+    int32_t *sums = (int32_t *)malloc(sizeof(int32_t) * (m + n), PAGE_4K);
+    int32_t *acc = direct
+            ? nullptr
+            : (int32_t *)malloc(sizeof(int32_t) * m * n, PAGE_4K);
+    int32_t *c_buffers = nthr_k > 1 ? (int32_t *)malloc(sizeof(int32_t)
+                                         * nthr_mn * (nthr_k - 1) * MB * NB,
+                                 PAGE_4K)
+                                    : nullptr;
+    if (!ws_buffers || !sums || (!direct && !acc)
+            || (nthr_k > 1 && !c_buffers)) {
+        free(ws_buffers);
+        free(sums);
+        free(acc);
+        free(c_buffers);
+        return dnnl_out_of_memory;
+    }
+
+    // row_sum[i] = sum_k op(A)(i, k), col_sum[j] = sum_k (op(B)(k, j) - shift)
+    int32_t *row_sum = sums;
+    int32_t *col_sum = sums + m;
+    constexpr dim_t sum_blk = 64;
+    parallel_nd(div_up(m, sum_blk), [&](dim_t ib) {
+        const dim_t i_s = ib * sum_blk, i_e = nstl::min(m, i_s + sum_blk);
+        for (dim_t i = i_s; i < i_e; i++)
+            row_sum[i] = 0;
+        for (dim_t kk = 0; kk < k; kk++) {
+            PRAGMA_OMP_SIMD()
+            for (dim_t i = i_s; i < i_e; i++)
+                row_sum[i] += trans_a ? A[kk + i * lda] : A[i + kk * lda];
+        }
+    });
+    parallel_nd(div_up(n, sum_blk), [&](dim_t jb) {
+        const dim_t j_s = jb * sum_blk, j_e = nstl::min(n, j_s + sum_blk);
+        for (dim_t j = j_s; j < j_e; j++)
+            col_sum[j] = -b_shift * (int32_t)k;
+        for (dim_t kk = 0; kk < k; kk++) {
+            PRAGMA_OMP_SIMD()
+            for (dim_t j = j_s; j < j_e; j++)
+                col_sum[j] += trans_b ? B[j + kk * ldb] : B[kk + j * ldb];
+        }
+    });
+
+    // sum_k (a - ao) * (b' - bo') = sum_k a * b' + compensation(i, j)
+    const int32_t comp_fixed = (int32_t)k * ao_s32 * bo_s32;
+    auto compensation = [&](dim_t i, dim_t j) {
+        return comp_fixed - bo_s32 * row_sum[i] - ao_s32 * col_sum[j];
+    };
+    auto c_offset = [&](dim_t i, dim_t j) {
+        return OCisR ? co[j] : OCisC ? co[i] : co[0];
+    };
+
+    auto get_thr_block = [](dim_t &from, dim_t &size, dim_t blk, dim_t total,
+                                 int ithr) {
+        from = nstl::min(blk * ithr, total);
+        size = nstl::min(blk, total - from);
+    };
+
+    parallel(nthr, [&](int ithr, int nthr_) {
+        assert(nthr == nthr_);
+        MAYBE_UNUSED(nthr_);
+
+        const int ithr_mn = ithr % nthr_mn;
+        const int ithr_m = ithr_mn % nthr_m;
+        const int ithr_n = ithr_mn / nthr_m;
+        const int ithr_k = ithr / nthr_mn;
+
+        dim_t m_from, my_m, n_from, my_n, k_from, my_k;
+        get_thr_block(m_from, my_m, MB, m, ithr_m);
+        get_thr_block(n_from, my_n, NB, n, ithr_n);
+        get_thr_block(k_from, my_k, KB, k, ithr_k);
+        if (my_m <= 0 || my_n <= 0) return;
+
+        int8_t *ws_a = ws_buffers + ithr * ws_size_per_thr;
+        int8_t *ws_b = ws_a + ws_a_size;
+
+        const int8_t *my_a = trans_a ? A + k_from + m_from * lda
+                                     : A + m_from + k_from * lda;
+        const b_dt *my_b = trans_b ? B + n_from + k_from * ldb
+                                   : B + k_from + n_from * ldb;
+
+        int32_t *my_c;
+        dim_t my_ldc;
+        bool beta_zero = true;
+        if (ithr_k > 0) {
+            my_c = c_buffers + MB * NB * (ithr_mn * (nthr_k - 1) + ithr_k - 1);
+            my_ldc = MB;
+        } else if (direct) {
+            my_c = C + m_from + n_from * ldc;
+            my_ldc = ldc;
+            for (dim_t j = 0; j < my_n; j++) {
+                int32_t *c_j = my_c + j * ldc;
+                for (dim_t i = 0; i < my_m; i++) {
+                    const dim_t gi = m_from + i, gj = n_from + j;
+                    const int32_t c_init = beta_f == 0.f ? 0 : c_j[i];
+                    c_j[i] = c_init + c_offset(gi, gj) + compensation(gi, gj);
+                }
+            }
+            beta_zero = false;
+        } else {
+            my_c = acc + m_from + n_from * m;
+            my_ldc = m;
+        }
+
+        gemm_s8x8s32_ithr(ukernel, trans_a, trans_b, my_m, my_n, my_k, my_a,
+                lda, my_b, ldb, b_shift, beta_zero, my_c, my_ldc, ws_a, ws_b);
+    });
+
+    if (nthr_k > 1) {
+        parallel(nthr, [&](int ithr, int nthr_) {
+            assert(nthr == nthr_);
+            MAYBE_UNUSED(nthr_);
+
+            const int ithr_mn = ithr % nthr_mn;
+            const int ithr_m = ithr_mn % nthr_m;
+            const int ithr_n = ithr_mn / nthr_m;
+            const int ithr_k = ithr / nthr_mn;
+
+            dim_t m_from, my_m, n_from, my_n;
+            get_thr_block(m_from, my_m, MB, m, ithr_m);
+            get_thr_block(n_from, my_n, NB, n, ithr_n);
+            if (my_m <= 0 || my_n <= 0) return;
+
+            int32_t *dst = direct ? C + m_from + n_from * ldc
+                                  : acc + m_from + n_from * m;
+            const dim_t ld_dst = direct ? ldc : m;
+
+            // Every thread of a K-group reduces its own slice of columns.
+            dim_t offset = 0, block = 0;
+            gemm_utils::partition_unit_diff(
+                    ithr_k, nthr_k, my_n, &offset, &block);
+            for (int ik = 1; ik < nthr_k; ik++) {
+                const int32_t *src = c_buffers
+                        + MB
+                                * (NB * (ithr_mn * (nthr_k - 1) + ik - 1)
+                                        + offset);
+                for (dim_t j = 0; j < block; j++) {
+                    int32_t *d = dst + (offset + j) * ld_dst;
+                    const int32_t *s = src + j * MB;
+                    PRAGMA_OMP_SIMD()
+                    for (dim_t i = 0; i < my_m; i++)
+                        d[i] += s[i];
+                }
+            }
+        });
+    }
+
+    if (!direct) {
+        parallel_nd(n, [&](dim_t j) {
+            int32_t *c_j = C + j * ldc;
+            const int32_t *acc_j = acc + j * m;
+            for (dim_t i = 0; i < m; i++) {
+                const double val = (double)alpha_f
+                                * (double)(acc_j[i] + compensation(i, j))
+                        + (beta_f == 0.f ? 0.0 : (double)beta_f * c_j[i])
+                        + (double)c_offset(i, j);
+                c_j[i] = out_round<int32_t>(saturate<int32_t>(val));
+            }
+        });
+    }
+
+    free(ws_buffers);
+    free(sums);
+    free(acc);
+    free(c_buffers);
+
+    msan_unpoison_matrix(C, m, n, ldc, sizeof(*C));
+
+    return dnnl_success;
+}
+
+template dnnl_status_t blocked_gemm_s8x8s32<uint8_t>(
+        const gemm_s8x8s32_ukernel_t &ukernel, const char *transa,
+        const char *transb, const char *offsetc, const dim_t *M, const dim_t *N,
+        const dim_t *K, const float *alpha, const int8_t *A, const dim_t *LDA,
+        const int8_t *ao, const uint8_t *B, const dim_t *LDB, const uint8_t *bo,
+        const float *beta, int32_t *C, const dim_t *LDC, const int32_t *co);
+
+template dnnl_status_t blocked_gemm_s8x8s32<int8_t>(
+        const gemm_s8x8s32_ukernel_t &ukernel, const char *transa,
+        const char *transb, const char *offsetc, const dim_t *M, const dim_t *N,
+        const dim_t *K, const float *alpha, const int8_t *A, const dim_t *LDA,
+        const int8_t *ao, const int8_t *B, const dim_t *LDB, const int8_t *bo,
+        const float *beta, int32_t *C, const dim_t *LDC, const int32_t *co);
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
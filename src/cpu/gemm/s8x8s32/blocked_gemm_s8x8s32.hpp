@@ -0,0 +1,72 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_GEMM_S8X8S32_BLOCKED_GEMM_S8X8S32_HPP
+#define CPU_GEMM_S8X8S32_BLOCKED_GEMM_S8X8S32_HPP
+
+#include <cstdint>
+
+#include "oneapi/dnnl/dnnl_types.h"
+
+#include "common/c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Micro-kernel used by blocked_gemm_s8x8s32().
+//
+// Computes C[m x n] (+)= A[m x k] * B[k x n] with s32 accumulation, where
+// m <= unroll_m, n <= unroll_n and k is a positive multiple of 4.
+//
+// Both A and B are packed as signed 8-bit values in groups of 4 consecutive
+// k-elements (zero padded):
+// - A: panels of unroll_m rows, [k / 4][unroll_m][4]
+// - B: panels of unroll_n columns, [k / 4][unroll_n][4]
+// which maps to dot-product instructions (e.g. SVE sdot) one-to-one.
+struct gemm_s8x8s32_ukernel_t {
+    using func_t = void (*)(dim_t m, dim_t n, dim_t k, const int8_t *a,
+            const int8_t *b, int32_t *c, dim_t ldc);
+
+    dim_t unroll_m;
+    dim_t unroll_n;
+    func_t ker_beta0; // C = A * B
+    func_t ker_beta1; // C += A * B
+};
+
+// Portable micro-kernel, written to be auto-vectorized by the compiler.
+const gemm_s8x8s32_ukernel_t &gemm_s8x8s32_ref_ukernel();
+
+// Blocked and threaded integer GEMM:
+// C = alpha * (op(A) - ao) * (op(B) - bo) + beta * C + co
+//
+// A and B are packed into signed 8-bit panels (unsigned B is shifted by -128
+// and the shift is folded into the offsets), the products are accumulated in
+// s32 by the micro-kernel and the offsets are applied through row/column sums
+// of A and B.
+template <typename b_dt>
+dnnl_status_t blocked_gemm_s8x8s32(const gemm_s8x8s32_ukernel_t &ukernel,
+        const char *transa, const char *transb, const char *offsetc,
+        const dim_t *M, const dim_t *N, const dim_t *K, const float *alpha,
+        const int8_t *A, const dim_t *LDA, const int8_t *ao, const b_dt *B,
+        const dim_t *LDB, const b_dt *bo, const float *beta, int32_t *C,
+        const dim_t *LDC, const int32_t *co);
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif // CPU_GEMM_S8X8S32_BLOCKED_GEMM_S8X8S32_HPP
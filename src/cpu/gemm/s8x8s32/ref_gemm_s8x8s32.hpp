@@ -19,6 +19,7 @@
 
 #include <cstdint>
 
+#include "oneapi/dnnl/dnnl_config.h"
 #include "oneapi/dnnl/dnnl_types.h"
 
 #include "common/c_types_map.hpp"
@@ -28,7 +29,7 @@ namespace impl {
 namespace cpu {
 
 template <typename b_dt>
-dnnl_status_t ref_gemm_s8x8s32(const char *transa, const char *transb,
+dnnl_status_t DNNL_API ref_gemm_s8x8s32(const char *transa, const char *transb,
         const char *offsetc, const dim_t *M, const dim_t *N, const dim_t *K,
         const float *alpha, const int8_t *A, const dim_t *LDA, const int8_t *ao,
         const b_dt *B, const dim_t *LDB, const b_dt *bo, const float *beta,
@@ -0,0 +1,323 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_REDUCTION_UTILS_HPP
+#define CPU_REDUCTION_UTILS_HPP
+
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/nstl.hpp"
+#include "common/reduction_pd.hpp"
+#include "common/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace reduction_utils {
+
+// Helpers for the JIT reduction implementations. A reduction over dense
+// tensors whose reduced physical dimensions are adjacent is computed in the
+// canonical form
+//
+//     dst[o][i] = reduce_{r} src[o][r][i],
+//
+// where o, r and i run over the (collapsed) physical dimensions of src that
+// precede the reduced ones, the reduced ones and those that follow them. The
+// kernels only accumulate: they compute the "reduce" part of the algorithm
+// (sum of |src|^p for norm_lp algorithms), and the finalization is done by
+// the driver below.
+//
+// When inner == 1 (horizontal reduction) the kernel reduces contiguous rows
+// and returns a vector of simd_w partial results per row. Otherwise (vertical
+// reduction) the kernel processes vectors along i and returns the final
+// accumulators.
+
+struct conf_t {
+    alg_kind_t alg;
+    float p, eps;
+
+    dim_t outer, reduce, inner;
+    // Kernel vector length, in floats.
+    int simd_w;
+
+    // The reduced dimension is split into nchunks chunks of chunk_size
+    // elements to occupy the threads when outer * inner is small.
+    dim_t nchunks;
+    dim_t chunk_size;
+
+    bool is_horizontal() const { return inner == 1; }
+    // Number of accumulators per row of the canonical dst.
+    dim_t acc_inner() const { return is_horizontal() ? simd_w : inner; }
+};
+
+struct call_params_t {
+    // keep all sizes at 8 bytes -- jit code expects this
+    const float *src;
+    float *acc;
+    size_t n_outer; // horizontal only, the rows are reduce elements apart
+    size_t n_reduce; // the reduce elements are inner elements apart
+    size_t n_inner; // vertical only
+};
+
+// Number of vectors processed at once by the kernels.
+static constexpr int unroll = 4;
+// Number of rows of the horizontal reduction processed by a kernel call.
+static constexpr dim_t outer_block = 64;
+// Maximum kernel vector length, in floats.
+static constexpr int max_simd_w = 16;
+
+inline bool is_sum_like(alg_kind_t alg) {
+    using namespace alg_kind;
+    return !utils::one_of(alg, reduction_max, reduction_min, reduction_mul);
+}
+
+inline bool is_norm(alg_kind_t alg) {
+    using namespace alg_kind;
+    return utils::one_of(alg, reduction_norm_lp_max, reduction_norm_lp_sum,
+            reduction_norm_lp_power_p_max, reduction_norm_lp_power_p_sum);
+}
+
+inline float neutral(alg_kind_t alg) {
+    using namespace alg_kind;
+    switch (alg) {
+        case reduction_max: return nstl::numeric_limits<float>::lowest();
+        case reduction_min: return nstl::numeric_limits<float>::max();
+        case reduction_mul: return 1.f;
+        default: return 0.f;
+    }
+}
+
+inline float combine(alg_kind_t alg, float a, float b) {
+    using namespace alg_kind;
+    switch (alg) {
+        case reduction_max: return nstl::max(a, b);
+        case reduction_min: return nstl::min(a, b);
+        case reduction_mul: return a * b;
+        default: return a + b;
+    }
+}
+
+inline float finalize(const conf_t &conf, float acc) {
+    using namespace alg_kind;
+    switch (conf.alg) {
+        case reduction_mean: return acc / conf.reduce;
+        case reduction_norm_lp_max:
+            return powf(nstl::max(acc, conf.eps), 1.f / conf.p);
+        case reduction_norm_lp_sum: return powf(acc + conf.eps, 1.f / conf.p);
+        case reduction_norm_lp_power_p_max: return nstl::max(acc, conf.eps);
+        case reduction_norm_lp_power_p_sum: return acc + conf.eps;
+        default: return acc;
+    }
+}
+
+struct axis_t {
+    int dim;
+    dim_t size;
+    bool operator==(const axis_t &rhs) const {
+        return dim == rhs.dim && size == rhs.size;
+    }
+};
+
+// Returns the physical axes of a dense memory descriptor without padding from
+// the outermost to the innermost one. Axes of size 1 are skipped.
+inline bool get_axes(
+        const memory_desc_wrapper &mdw, std::vector<axis_t> &axes) {
+    if (!mdw.is_blocking_desc() || mdw.offset0() != 0) return false;
+    const int ndims = mdw.ndims();
+    for (int d = 0; d < ndims; ++d)
+        if (mdw.padded_dims()[d] != mdw.dims()[d]) return false;
+
+    const auto &bd = mdw.blocking_desc();
+    dims_t blocks;
+    mdw.compute_blocks(blocks);
+
+    std::vector<int> outer_dims;
+    for (int d = 0; d < ndims; ++d)
+        if (mdw.dims()[d] / blocks[d] > 1) outer_dims.push_back(d);
+    std::stable_sort(outer_dims.begin(), outer_dims.end(),
+            [&](int a, int b) { return bd.strides[a] > bd.strides[b]; });
+
+    axes.clear();
+    dim_t stride = 1;
+    for (int b = 0; b < bd.inner_nblks; ++b)
+        stride *= bd.inner_blks[b];
+    // The outer axes must be dense, the innermost one goes first here.
+    for (auto it = outer_dims.rbegin(); it != outer_dims.rend(); ++it) {
+        if (bd.strides[*it] != stride) return false;
+        stride *= mdw.dims()[*it] / blocks[*it];
+    }
+
+    for (int d : outer_dims)
+        axes.push_back({d, mdw.dims()[d] / blocks[d]});
+    for (int b = 0; b < bd.inner_nblks; ++b)
+        if (bd.inner_blks[b] > 1)
+            axes.push_back({(int)bd.inner_idxs[b], bd.inner_blks[b]});
+    return true;
+}
+
+// Initializes the canonical form of the reduction and the work split.
+// Returns unimplemented if the layouts do not allow the canonical form.
+inline status_t init_conf(conf_t &conf, const reduction_pd_t *pd, int simd_w) {
+    const memory_desc_wrapper src_d(pd->src_md());
+    const memory_desc_wrapper dst_d(pd->dst_md());
+
+    std::vector<axis_t> src_axes, dst_axes;
+    if (!get_axes(src_d, src_axes) || !get_axes(dst_d, dst_axes))
+        return status::unimplemented;
+
+    // Collapse the src axes into [outer][reduce][inner]. The axes that are
+    // not reduced must go in the same order in dst.
+    dim_t sizes[3] = {1, 1, 1};
+    int group = 0;
+    std::vector<axis_t> idle_axes;
+    for (const auto &a : src_axes) {
+        const bool is_reduced = src_d.dims()[a.dim] != dst_d.dims()[a.dim];
+        if (is_reduced && group == 0) group = 1;
+        if (!is_reduced && group == 1) group = 2;
+        if (is_reduced && group == 2) return status::unimplemented;
+        sizes[group] *= a.size;
+        if (!is_reduced) idle_axes.push_back(a);
+    }
+    if (idle_axes != dst_axes) return status::unimplemented;
+
+    conf.alg = pd->desc()->alg_kind;
+    conf.p = pd->desc()->p;
+    conf.eps = pd->desc()->eps;
+    conf.outer = sizes[0];
+    conf.reduce = sizes[1];
+    conf.inner = sizes[2];
+    conf.simd_w = simd_w;
+
+    const int nthr = dnnl_get_max_threads();
+    const dim_t inner_block = nstl::min<dim_t>(conf.inner, unroll * simd_w);
+    const dim_t work = conf.is_horizontal()
+            ? utils::div_up(conf.outer, outer_block)
+            : conf.outer * utils::div_up(conf.inner, inner_block);
+
+    conf.nchunks = 1;
+    conf.chunk_size = conf.reduce;
+    if (work < nthr) {
+        // Keep the chunks large enough to amortize the combining pass.
+        const dim_t min_chunk_size
+                = utils::div_up(4096, conf.is_horizontal() ? 1 : inner_block);
+        const dim_t nchunks = nstl::min<dim_t>(
+                nthr / work, utils::div_up(conf.reduce, min_chunk_size));
+        if (nchunks > 1) {
+            conf.chunk_size = utils::div_up(conf.reduce, nchunks);
+            conf.nchunks = utils::div_up(conf.reduce, conf.chunk_size);
+        }
+    }
+
+    return status::success;
+}
+
+inline void init_scratchpad(
+        memory_tracking::registrar_t &scratchpad, const conf_t &conf) {
+    if (conf.nchunks == 1) return;
+    scratchpad.template book<float>(memory_tracking::names::key_reduction,
+            conf.nchunks * conf.outer * conf.acc_inner());
+}
+
+// Computes the reduction in the canonical form with a kernel that takes
+// call_params_t. The scratchpad is required when conf.nchunks > 1.
+template <typename kernel_t>
+void execute(const conf_t &conf, const kernel_t &kernel, const float *src,
+        float *dst, float *scratchpad) {
+    const dim_t outer = conf.outer, reduce = conf.reduce, inner = conf.inner;
+    const dim_t acc_inner = conf.acc_inner();
+    const dim_t inner_block = nstl::min<dim_t>(inner, unroll * conf.simd_w);
+    const dim_t ninner_blocks = utils::div_up(inner, inner_block);
+
+    auto call = [&](const float *s, float *acc, dim_t n_outer, dim_t n_reduce,
+                        dim_t n_inner) {
+        call_params_t p;
+        p.src = s;
+        p.acc = acc;
+        p.n_outer = n_outer;
+        p.n_reduce = n_reduce;
+        p.n_inner = n_inner;
+        kernel(&p);
+    };
+
+    auto reduce_acc = [&](const float *acc, dim_t n, dim_t stride) {
+        float res = acc[0];
+        for (dim_t k = 1; k < n; ++k)
+            res = combine(conf.alg, res, acc[k * stride]);
+        return res;
+    };
+
+    if (conf.nchunks == 1 && !conf.is_horizontal()) {
+        parallel_nd(outer, ninner_blocks, [&](dim_t o, dim_t ib) {
+            const dim_t i0 = ib * inner_block;
+            const dim_t n_inner = nstl::min(inner_block, inner - i0);
+            float *d = dst + o * inner + i0;
+            call(src + o * reduce * inner + i0, d, 1, reduce, n_inner);
+            for (dim_t i = 0; i < n_inner; ++i)
+                d[i] = finalize(conf, d[i]);
+        });
+    } else if (conf.nchunks == 1) {
+        const dim_t nouter_blocks = utils::div_up(outer, outer_block);
+        parallel_nd(nouter_blocks, [&](dim_t ob) {
+            float acc[outer_block * max_simd_w];
+            const dim_t o0 = ob * outer_block;
+            const dim_t n_outer = nstl::min(outer_block, outer - o0);
+            call(src + o0 * reduce, acc, n_outer, reduce, 1);
+            for (dim_t o = 0; o < n_outer; ++o)
+                dst[o0 + o] = finalize(
+                        conf, reduce_acc(acc + o * acc_inner, acc_inner, 1));
+        });
+    } else {
+        // The partial results for each chunk of the reduced dimension go to
+        // the scratchpad, which is then reduced over the chunks.
+        const dim_t nchunks = conf.nchunks, chunk_size = conf.chunk_size;
+        const dim_t chunk_stride = outer * acc_inner;
+        parallel_nd(nchunks, outer, ninner_blocks,
+                [&](dim_t c, dim_t o, dim_t ib) {
+                    const dim_t r0 = c * chunk_size;
+                    const dim_t n_reduce = nstl::min(chunk_size, reduce - r0);
+                    const dim_t i0 = ib * inner_block;
+                    const dim_t n_inner = nstl::min(inner_block, inner - i0);
+                    call(src + (o * reduce + r0) * inner + i0,
+                            scratchpad + c * chunk_stride + o * acc_inner + i0,
+                            1, n_reduce, n_inner);
+                });
+        parallel_nd(outer, inner, [&](dim_t o, dim_t i) {
+            const float *acc = scratchpad + o * acc_inner + i;
+            float res = reduce_acc(acc, nchunks, chunk_stride);
+            if (conf.is_horizontal()) {
+                for (dim_t k = 1; k < acc_inner; ++k)
+                    res = combine(conf.alg, res,
+                            reduce_acc(acc + k, nchunks, chunk_stride));
+            }
+            dst[o * inner + i] = finalize(conf, res);
+        });
+    }
+}
+
+} // namespace reduction_utils
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
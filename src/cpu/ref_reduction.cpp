@@ -75,6 +75,25 @@ void ref_reduction_t<src_type, dst_type, acc_type>::accumulate(
     }
 }
 
+template <data_type_t src_type, data_type_t dst_type, data_type_t acc_type>
+void ref_reduction_t<src_type, dst_type, acc_type>::combine(
+        acc_t &acc, const acc_t &partial, alg_kind_t alg) const {
+    using namespace alg_kind;
+
+    switch (alg) {
+        case reduction_max: acc = nstl::max(acc, partial); break;
+        case reduction_min: acc = nstl::min(acc, partial); break;
+        case reduction_mul: acc *= partial; break;
+        case reduction_mean:
+        case reduction_sum:
+        case reduction_norm_lp_max:
+        case reduction_norm_lp_sum:
+        case reduction_norm_lp_power_p_max:
+        case reduction_norm_lp_power_p_sum: acc += partial; break;
+        default: assert(!"unknown alg");
+    }
+}
+
 template <data_type_t src_type, data_type_t dst_type, data_type_t acc_type>
 void ref_reduction_t<src_type, dst_type, acc_type>::finalize(
         float &acc_f32, alg_kind_t alg, float p, float eps, dim_t n) const {
@@ -129,19 +148,25 @@ status_t ref_reduction_t<src_type, dst_type, acc_type>::execute_ref(
         }
     }
 
-    parallel_nd(idle_size, [&](dim_t l_offset) {
+    auto reduce = [&](dim_t l_offset, dim_t r_start, dim_t r_end) {
         dims_t idle_pos, reduce_pos;
         utils::l_dims_by_l_offset(idle_pos, l_offset, dst_mdw.dims(), ndims);
-        const dim_t dst_off = dst_mdw.off_v(idle_pos);
         const dim_t src_idle_off = src_mdw.off_v(idle_pos);
         acc_t acc {0};
         init_acc(acc, alg);
-        for (dim_t r = 0; r < reduce_size; ++r) {
+        for (dim_t r = r_start; r < r_end; ++r) {
             utils::l_dims_by_l_offset(reduce_pos, r, reduce_dims, ndims);
             const dim_t src_reduce_off = src_mdw.off_v(reduce_pos);
             const dim_t src_off = src_idle_off + src_reduce_off;
             accumulate(acc, src[src_off], alg, p);
         }
+        return acc;
+    };
+
+    auto store = [&](dim_t l_offset, acc_t acc) {
+        dims_t idle_pos;
+        utils::l_dims_by_l_offset(idle_pos, l_offset, dst_mdw.dims(), ndims);
+        const dim_t dst_off = dst_mdw.off_v(idle_pos);
         float acc_f32 = static_cast<float>(acc);
         finalize(acc_f32, alg, p, eps, reduce_size);
 
@@ -153,6 +178,33 @@ status_t ref_reduction_t<src_type, dst_type, acc_type>::execute_ref(
         ref_post_ops->execute(acc_f32, args);
 
         dst[dst_off] = saturate_and_round<dst_t>(acc_f32);
+    };
+
+    const dim_t nchunks = pd()->nchunks_;
+    if (nchunks == 1) {
+        parallel_nd(idle_size, [&](dim_t l_offset) {
+            store(l_offset, reduce(l_offset, 0, reduce_size));
+        });
+        return status::success;
+    }
+
+    // Each chunk of the reduced dimensions is reduced into a partial result,
+    // the partial results are then combined for every dst point.
+    auto partials = ctx.get_scratchpad_grantor().template get<acc_t>(
+            memory_tracking::names::key_reduction);
+    const dim_t chunk_size = utils::div_up(reduce_size, nchunks);
+
+    parallel_nd(idle_size, nchunks, [&](dim_t l_offset, dim_t c) {
+        const dim_t r_start = nstl::min(c * chunk_size, reduce_size);
+        const dim_t r_end = nstl::min(r_start + chunk_size, reduce_size);
+        partials[l_offset * nchunks + c] = reduce(l_offset, r_start, r_end);
+    });
+
+    parallel_nd(idle_size, [&](dim_t l_offset) {
+        acc_t acc = partials[l_offset * nchunks];
+        for (dim_t c = 1; c < nchunks; ++c)
+            combine(acc, partials[l_offset * nchunks + c], alg);
+        store(l_offset, acc);
     });
 
     return status::success;
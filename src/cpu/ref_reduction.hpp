@@ -17,6 +17,8 @@
 #ifndef CPU_REF_REDUCTION_HPP
 #define CPU_REF_REDUCTION_HPP
 
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
 #include "common/primitive.hpp"
 #include "common/type_helpers.hpp"
 
@@ -49,8 +51,38 @@ struct ref_reduction_t : public primitive_t {
                     && attr()->has_default_values(sm::post_ops);
             if (!ok) return status::unimplemented;
 
+            init_scratchpad();
+
             return status::success;
         }
+
+        // The reduced dimensions are split into nchunks_ chunks when there
+        // are fewer dst points than threads.
+        dim_t nchunks_ = 1;
+
+    private:
+        void init_scratchpad() {
+            const memory_desc_wrapper src_d(src_md());
+            const memory_desc_wrapper dst_d(dst_md());
+            const dim_t idle_size = dst_d.nelems();
+            const dim_t reduce_size
+                    = src_d.nelems() / nstl::max(idle_size, dim_t(1));
+
+            // Chunks are kept large enough to amortize the combining pass.
+            const dim_t min_chunk_size = 1024;
+            const dim_t max_nchunks = reduce_size / min_chunk_size;
+            const int nthr = dnnl_get_max_threads();
+            nchunks_ = 1;
+            if (idle_size > 0 && idle_size < nthr)
+                nchunks_ = nstl::max(
+                        dim_t(1), nstl::min(nthr / idle_size, max_nchunks));
+            if (nchunks_ == 1) return;
+
+            auto scratchpad = scratchpad_registry().registrar();
+            scratchpad.template book<acc_t>(
+                    memory_tracking::names::key_reduction,
+                    idle_size * nchunks_);
+        }
     };
 
     ref_reduction_t(const pd_t *apd) : primitive_t(apd) {}
@@ -77,6 +109,7 @@ private:
 
     void accumulate(
             acc_t &acc, const src_t &src, alg_kind_t alg_kind, float p) const;
+    void combine(acc_t &acc, const acc_t &partial, alg_kind_t alg) const;
     void finalize(
             float &acc_f32, alg_kind_t alg, float p, float eps, dim_t n) const;
     void init_acc(acc_t &acc, alg_kind_t alg) const;
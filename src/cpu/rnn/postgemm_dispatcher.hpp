@@ -39,6 +39,19 @@
 #include "cpu/x64/rnn/jit_uni_rnn_cell_postgemm_bwd.hpp"
 #include "cpu/x64/rnn/jit_uni_rnn_cell_postgemm_fwd.hpp"
 #include "cpu/x64/rnn/jit_uni_rnn_common_postgemm.hpp"
+#elif DNNL_AARCH64
+#include "cpu/aarch64/rnn/jit_uni_gru_cell_postgemm_1_bwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_gru_cell_postgemm_1_fwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_gru_cell_postgemm_2_bwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_gru_cell_postgemm_2_fwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_gru_lbr_cell_postgemm_bwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_gru_lbr_cell_postgemm_fwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_lstm_cell_postgemm_bwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_lstm_cell_postgemm_fwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_lstm_cell_projection_postgemm_fwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_rnn_cell_postgemm_bwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_rnn_cell_postgemm_fwd.hpp"
+#include "cpu/aarch64/rnn/jit_uni_rnn_common_postgemm.hpp"
 #endif
 
 namespace dnnl {
@@ -114,7 +127,9 @@ struct rnn_postgemm_dispatcher {
             default: assert(!"Unsupported algorithm kind"); break;
         }
 
-        DNNL_X64_ONLY(initialize_jit(rnn));
+#if DNNL_X64 || DNNL_AARCH64
+        initialize_jit(rnn);
+#endif
     }
 
     ~rnn_postgemm_dispatcher() = default;
@@ -155,7 +170,7 @@ struct rnn_postgemm_dispatcher {
 
     // template <typename src_data_t, typename acc_data_t>
     rnn_postgemm_sig(execute) {
-#if DNNL_X64
+#if DNNL_X64 || DNNL_AARCH64
         if (rnn_postgemm_) {
             rnn_postgemm_->execute(rnn, cell_position, ws_gates_,
                     scratch_gates_, dst_layer_, dst_iter_c_, src_iter_,
@@ -182,7 +197,7 @@ struct rnn_postgemm_dispatcher {
 
     // template <typename src_data_t, typename acc_data_t>
     rnn_postgemm_sig(execute_part2) {
-#if DNNL_X64
+#if DNNL_X64 || DNNL_AARCH64
         if (rnn_postgemm_part2_) {
             rnn_postgemm_part2_->execute(rnn, cell_position, ws_gates_,
                     scratch_gates_, dst_layer_, dst_iter_c_, src_iter_,
@@ -268,6 +283,48 @@ private:
 #undef CREATE
 #undef CREATE_WITH_DIR
 
+        if (rnn_postgemm_) rnn_postgemm_->init(src_type);
+        if (rnn_postgemm_part2_) rnn_postgemm_part2_->init(src_type);
+    }
+#elif DNNL_AARCH64
+    std::unique_ptr<aarch64::jit_uni_rnn_postgemm> rnn_postgemm_;
+    std::unique_ptr<aarch64::jit_uni_rnn_postgemm> rnn_postgemm_part2_;
+
+    void initialize_jit(const rnn_utils::rnn_conf_t &rnn) {
+        using namespace dnnl::impl::cpu::aarch64;
+
+        if (pd_->attr()->rnn_tparams_.test_mode_) return;
+        if (!mayiuse(sve_512)) return;
+
+        // int8 and bf16 post-GEMMs are not implemented for SVE yet and use
+        // the reference functions
+        const bool jit_fwd = pd_->is_fwd() && src_type == data_type::f32;
+        const bool jit_bwd = !pd_->is_fwd() && src_type == data_type::f32;
+
+#define CREATE(k, ker_t) \
+    do { \
+        if (jit_fwd) k.reset(new CONCAT2(ker_t, _fwd)<sve_512>(rnn, pd_)); \
+        if (jit_bwd) k.reset(new CONCAT2(ker_t, _bwd)<sve_512>(rnn, pd_)); \
+    } while (0)
+
+        if (pd_->cell_kind() == alg_kind::vanilla_lstm) {
+            CREATE(rnn_postgemm_, jit_uni_lstm_cell_postgemm);
+            if (jit_fwd && pd_->is_lstm_projection())
+                rnn_postgemm_part2_.reset(
+                        new jit_uni_lstm_cell_projection_postgemm_fwd<sve_512>(
+                                rnn, pd_));
+        } else if (pd_->cell_kind() == alg_kind::vanilla_rnn) {
+            CREATE(rnn_postgemm_, jit_uni_rnn_cell_postgemm);
+        } else if (pd_->cell_kind() == alg_kind::vanilla_gru) {
+            CREATE(rnn_postgemm_, jit_uni_gru_cell_postgemm_part1);
+            CREATE(rnn_postgemm_part2_, jit_uni_gru_cell_postgemm_part2);
+        } else if (pd_->cell_kind() == alg_kind::lbr_gru) {
+            CREATE(rnn_postgemm_, jit_uni_gru_lbr_cell_postgemm);
+        } else
+            assert(!"Unsupported algorithm kind");
+
+#undef CREATE
+
         if (rnn_postgemm_) rnn_postgemm_->init(src_type);
         if (rnn_postgemm_part2_) rnn_postgemm_part2_->init(src_type);
     }
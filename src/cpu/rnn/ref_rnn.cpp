@@ -29,6 +29,8 @@
 
  */
 
+#include <vector>
+
 #include "common/dnnl_thread.hpp"
 
 #include "cpu/simple_q10n.hpp"
@@ -198,8 +200,170 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
     auto src_iter_c_mdw = memory_desc_wrapper(pd()->src_md(2));
     auto dst_iter_c_mdw = memory_desc_wrapper(pd()->dst_md(2));
 
+    // size of the scratch cell buffer of a single layer, in elements
+    const size_t scratch_cell_slot_size = rnn.scratch_cell_size
+            / (rnn.n_scratch_slots() * sizeof(scratch_t));
+
+    // Runs the cell (lay, iter) of direction dir, j being the position of
+    // the layer in the execution order
+    const auto execute_cell
+            = [&](int dir, int j, int lay, int iter) -> status_t {
+        // We set the FWD parameters to the cell execution
+        // call
+
+        // dst_layer is equal to dst_iter. To avoid
+        // duplication of memory access we hence use only
+        // dst_layer and set dst_iter to nullptr, unless we
+        // cannot for one of the following condition:
+        // - in the last layer and last iteration, we need to
+        //   copy ht in two tensors (dst_layer and dst_iter)
+        dst_layer_t *cell_dst_layer
+                = &(ws_states_layer(lay + 1, dir, iter + 1, 0));
+        dst_iter_t *cell_dst_iter = nullptr;
+        const src_layer_t *cell_src_layer
+                = &(ws_states_layer(lay, dir, iter + 1, 0));
+        const src_iter_t *cell_src_iter
+                = &(ws_states_iter(lay + 1, dir, iter, 0));
+
+        float *cell_dst_iter_c = &(ws_states_iter_c(lay + 1, dir, iter + 1, 0));
+        const float *cell_src_iter_c
+                = &(ws_states_iter_c(lay + 1, dir, iter, 0));
+
+        // the cell_position is used only when skip_data_copy is
+        // supported currently supported only for forward
+        cell_position_t cell_position = middle_cell;
+        if (iter == 0) cell_position |= first_iter;
+        if (lay == 0) cell_position |= first_layer;
+        if (iter == rnn.n_iter - 1) cell_position |= last_iter;
+        if (lay == rnn.n_layer - 1) cell_position |= last_layer;
+
+        // The dst_* paths should be before the src_* paths as
+        // the later will override cell_src_layer and
+        // cell_src_iter appropriately for 1st layer and 1st
+        // iter.
+        bool last_iter_skip_copy
+                = rnn.skip_dst_iter_copy() && (cell_position & last_iter);
+        if (last_iter_skip_copy) {
+            cell_dst_layer = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
+            cell_src_layer = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
+        }
+
+        if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
+            // Note: for last layer and last iter, the output is in dst_layer
+            // and still need to be copied to dst_iter
+            cell_dst_layer = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
+            cell_dst_iter = last_iter_skip_copy
+                    ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
+                    : nullptr;
+            cell_src_iter = (iter != 0)
+                    ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
+                    : cell_src_iter;
+        }
+        if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
+            cell_src_iter = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
+
+        if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
+            cell_src_layer = src_layer_ + src_layer_mdw.off(iter, 0, 0);
+
+        // because the c state is always f32 and require no
+        // conversion, we can always skip to copy for the 1st
+        // and last iteration
+        if (iter == 0 && src_iter_c_) {
+            cell_src_iter_c = src_iter_c_ + src_iter_c_mdw.off(lay, dir, 0, 0);
+            cell_position |= c_state_first_iter;
+        }
+        if (iter == rnn.n_iter - 1 && dst_iter_c_) {
+            cell_dst_iter_c = dst_iter_c_ + dst_iter_c_mdw.off(lay, dir, 0, 0);
+            cell_position |= c_state_last_iter;
+        }
+
+        // when the wavefront is used, each layer has its own scratch buffers
+        const int slot = rnn.use_wavefront ? lay : 0;
+        auto cell_scratch_gates = scratch_gates_
+                + ((size_t)slot * rnn.n_iter_scratch_gates
+                          + (rnn.n_iter_scratch_gates == 1 ? 0 : iter))
+                        * rnn.scratch_gates_nld * rnn.scratch_gates_ld;
+        auto cell_scratch_cell = scratch_cell_ + slot * scratch_cell_slot_size;
+
+        dst_iter_t *proj_ht = nullptr;
+        if (rnn.is_lstm_projection) {
+            if (rnn.is_training)
+                proj_ht = &(ws_ht(lay, dir, iter, 0));
+            else
+                proj_ht = scratch_ht_;
+        }
+
+#if DNNL_X64
+        CHECK((this->*cell_func)(rnn, cell_position, cell_dst_layer,
+                cell_dst_iter_c, &(ws_diff_states_layer(lay, dir, iter, 0)),
+                &(ws_diff_states_iter(lay, dir, iter, 0)),
+                &(ws_diff_states_iter_c(lay, dir, iter, 0)),
+                &(weights_layer(lay, dir, 0)), &(weights_iter(lay, dir, 0)),
+                &(weights_projection(lay, dir)),
+                &(weights_peephole(lay, dir, 0)),
+                w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic,
+                &(bias(lay, dir, 0)), cell_src_layer, cell_src_iter,
+                cell_src_iter_c, &(ws_diff_states_layer(lay + 1, dir, iter, 0)),
+                &(ws_diff_states_iter(lay, dir, iter + 1, 0)),
+                &(ws_diff_states_iter_c(lay, dir, iter + 1, 0)),
+                &(diff_weights_layer(lay, dir, 0)),
+                &(diff_weights_iter(lay, dir, 0)),
+                &(diff_weights_projection(lay, dir, 0)),
+                &(diff_weights_peephole(lay, dir, 0)),
+                &(diff_bias(lay, dir, 0)),
+                &(ws_gates(lay, dir, iter, 0)), cell_scratch_gates, proj_ht,
+                scratch_diff_ht_, &(ws_grid(lay, dir, iter, 0)),
+                cell_scratch_cell, cell_dst_iter, amx_scratchpad,
+                addr_batch_global));
+#else
+        CHECK((this->*cell_func)(rnn, cell_position, cell_dst_layer,
+                cell_dst_iter_c, &(ws_diff_states_layer(lay, dir, iter, 0)),
+                &(ws_diff_states_iter(lay, dir, iter, 0)),
+                &(ws_diff_states_iter_c(lay, dir, iter, 0)),
+                &(weights_layer(lay, dir, 0)), &(weights_iter(lay, dir, 0)),
+                &(weights_projection(lay, dir)),
+                &(weights_peephole(lay, dir, 0)),
+                w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic,
+                &(bias(lay, dir, 0)), cell_src_layer, cell_src_iter,
+                cell_src_iter_c, &(ws_diff_states_layer(lay + 1, dir, iter, 0)),
+                &(ws_diff_states_iter(lay, dir, iter + 1, 0)),
+                &(ws_diff_states_iter_c(lay, dir, iter + 1, 0)),
+                &(diff_weights_layer(lay, dir, 0)),
+                &(diff_weights_iter(lay, dir, 0)),
+                &(diff_weights_projection(lay, dir, 0)),
+                &(diff_weights_peephole(lay, dir, 0)),
+                &(diff_bias(lay, dir, 0)),
+                &(ws_gates(lay, dir, iter, 0)), cell_scratch_gates, proj_ht,
+                scratch_diff_ht_, &(ws_grid(lay, dir, iter, 0)),
+                cell_scratch_cell, cell_dst_iter, amx_scratchpad));
+#endif
+        return dnnl_success;
+    };
+
     // We run the grid of computation
     for (int dir = 0; dir < rnn.n_dir; dir++) {
+        if (rnn.use_wavefront) {
+            // Wavefront execution (forward only): the cell (lay, iter)
+            // depends on (lay - 1, iter) and (lay, iter - 1), so all the cells
+            // of an anti-diagonal lay + iter = d can run concurrently once the
+            // previous anti-diagonal is done. Each cell is given to a single
+            // thread: the wavefront is only used when the widest
+            // anti-diagonal has at least as many cells as there are threads.
+            std::vector<status_t> cell_status(rnn.n_layer, status::success);
+            const int n_diags = rnn.n_layer + rnn.n_iter - 1;
+            for (int d = 0; d < n_diags; d++) {
+                const int lay_start = nstl::max(0, d - rnn.n_iter + 1);
+                const int lay_end = nstl::min(rnn.n_layer, d + 1);
+                parallel_nd(lay_end - lay_start, [&](int l) {
+                    const int lay = lay_start + l;
+                    cell_status[lay] = execute_cell(dir, lay, lay, d - lay);
+                });
+                for (int lay = lay_start; lay < lay_end; lay++)
+                    CHECK(cell_status[lay]);
+            }
+            continue;
+        }
+
         for (int j = 0; j < rnn.n_layer; j++) {
             int lay = (aprop == prop_kind::forward) ? j : rnn.n_layer - j - 1;
 
@@ -232,147 +396,7 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
             for (int i = 0; i < rnn.n_iter; i++) {
                 int iter = (aprop == prop_kind::forward) ? i
                                                          : rnn.n_iter - i - 1;
-
-                // We set the FWD parameters to the cell execution
-                // call
-
-                // dst_layer is equal to dst_iter. To avoid
-                // duplication of memory access we hence use only
-                // dst_layer and set dst_iter to nullptr, unless we
-                // cannot for one of the following condition:
-                // - in the last layer and last iteration, we need to
-                //   copy ht in two tensors (dst_layer and dst_iter)
-                dst_layer_t *cell_dst_layer
-                        = &(ws_states_layer(lay + 1, dir, iter + 1, 0));
-                dst_iter_t *cell_dst_iter = nullptr;
-                const src_layer_t *cell_src_layer
-                        = &(ws_states_layer(lay, dir, iter + 1, 0));
-                const src_iter_t *cell_src_iter
-                        = &(ws_states_iter(lay + 1, dir, iter, 0));
-
-                float *cell_dst_iter_c
-                        = &(ws_states_iter_c(lay + 1, dir, iter + 1, 0));
-                const float *cell_src_iter_c
-                        = &(ws_states_iter_c(lay + 1, dir, iter, 0));
-
-                // the cell_position is used only when skip_data_copy is
-                // supported currently supported only for forward
-                cell_position_t cell_position = middle_cell;
-                if (iter == 0) cell_position |= first_iter;
-                if (lay == 0) cell_position |= first_layer;
-                if (iter == rnn.n_iter - 1) cell_position |= last_iter;
-                if (lay == rnn.n_layer - 1) cell_position |= last_layer;
-
-                // The dst_* paths should be before the src_* paths as
-                // the later will override cell_src_layer and
-                // cell_src_iter appropriately for 1st layer and 1st
-                // iter.
-                bool last_iter_skip_copy = rnn.skip_dst_iter_copy()
-                        && (cell_position & last_iter);
-                if (last_iter_skip_copy) {
-                    cell_dst_layer
-                            = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
-                    cell_src_layer
-                            = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
-                }
-
-                if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
-                    // Note: for last layer and last iter, the output is in dst_layer
-                    // and still need to be copied to dst_iter
-                    cell_dst_layer = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
-                    cell_dst_iter = last_iter_skip_copy
-                            ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
-                            : nullptr;
-                    cell_src_iter = (iter != 0)
-                            ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
-                            : cell_src_iter;
-                }
-                if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
-                    cell_src_iter
-                            = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
-
-                if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
-                    cell_src_layer = src_layer_ + src_layer_mdw.off(iter, 0, 0);
-
-                // because the c state is always f32 and require no
-                // conversion, we can always skip to copy for the 1st
-                // and last iteration
-                if (iter == 0 && src_iter_c_) {
-                    cell_src_iter_c
-                            = src_iter_c_ + src_iter_c_mdw.off(lay, dir, 0, 0);
-                    cell_position |= c_state_first_iter;
-                }
-                if (iter == rnn.n_iter - 1 && dst_iter_c_) {
-                    cell_dst_iter_c
-                            = dst_iter_c_ + dst_iter_c_mdw.off(lay, dir, 0, 0);
-                    cell_position |= c_state_last_iter;
-                }
-
-                auto cell_scratch_gates = rnn.n_iter_scratch_gates == 1
-                        ? scratch_gates_
-                        : scratch_gates_
-                                + iter * rnn.scratch_gates_nld
-                                        * rnn.scratch_gates_ld;
-
-                dst_iter_t *proj_ht = nullptr;
-                if (rnn.is_lstm_projection) {
-                    if (rnn.is_training)
-                        proj_ht = &(ws_ht(lay, dir, iter, 0));
-                    else
-                        proj_ht = scratch_ht_;
-                }
-
-#if DNNL_X64
-                CHECK((this->*cell_func)(rnn, cell_position, cell_dst_layer,
-                        cell_dst_iter_c,
-                        &(ws_diff_states_layer(lay, dir, iter, 0)),
-                        &(ws_diff_states_iter(lay, dir, iter, 0)),
-                        &(ws_diff_states_iter_c(lay, dir, iter, 0)),
-                        &(weights_layer(lay, dir, 0)),
-                        &(weights_iter(lay, dir, 0)),
-                        &(weights_projection(lay, dir)),
-                        &(weights_peephole(lay, dir, 0)),
-                        w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic,
-                        &(bias(lay, dir, 0)), cell_src_layer, cell_src_iter,
-                        cell_src_iter_c,
-                        &(ws_diff_states_layer(lay + 1, dir, iter, 0)),
-                        &(ws_diff_states_iter(lay, dir, iter + 1, 0)),
-                        &(ws_diff_states_iter_c(lay, dir, iter + 1, 0)),
-                        &(diff_weights_layer(lay, dir, 0)),
-                        &(diff_weights_iter(lay, dir, 0)),
-                        &(diff_weights_projection(lay, dir, 0)),
-                        &(diff_weights_peephole(lay, dir, 0)),
-                        &(diff_bias(lay, dir, 0)),
-                        &(ws_gates(lay, dir, iter, 0)), cell_scratch_gates,
-                        proj_ht, scratch_diff_ht_,
-                        &(ws_grid(lay, dir, iter, 0)), scratch_cell_,
-                        cell_dst_iter, amx_scratchpad, addr_batch_global));
-#else
-                CHECK((this->*cell_func)(rnn, cell_position, cell_dst_layer,
-                        cell_dst_iter_c,
-                        &(ws_diff_states_layer(lay, dir, iter, 0)),
-                        &(ws_diff_states_iter(lay, dir, iter, 0)),
-                        &(ws_diff_states_iter_c(lay, dir, iter, 0)),
-                        &(weights_layer(lay, dir, 0)),
-                        &(weights_iter(lay, dir, 0)),
-                        &(weights_projection(lay, dir)),
-                        &(weights_peephole(lay, dir, 0)),
-                        w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic,
-                        &(bias(lay, dir, 0)), cell_src_layer, cell_src_iter,
-                        cell_src_iter_c,
-                        &(ws_diff_states_layer(lay + 1, dir, iter, 0)),
-                        &(ws_diff_states_iter(lay, dir, iter + 1, 0)),
-                        &(ws_diff_states_iter_c(lay, dir, iter + 1, 0)),
-                        &(diff_weights_layer(lay, dir, 0)),
-                        &(diff_weights_iter(lay, dir, 0)),
-                        &(diff_weights_projection(lay, dir, 0)),
-                        &(diff_weights_peephole(lay, dir, 0)),
-                        &(diff_bias(lay, dir, 0)),
-                        &(ws_gates(lay, dir, iter, 0)), cell_scratch_gates,
-                        proj_ht, scratch_diff_ht_,
-                        &(ws_grid(lay, dir, iter, 0)), scratch_cell_,
-                        cell_dst_iter, amx_scratchpad));
-#endif
+                CHECK(execute_cell(dir, j, lay, iter));
             }
 
             if ((aprop == prop_kind::backward) && rnn.merge_gemm_layer) {
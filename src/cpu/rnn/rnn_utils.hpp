@@ -20,6 +20,7 @@
 #include <type_traits>
 
 #include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
 #include "common/memory_desc_wrapper.hpp"
 #include "common/utils.hpp"
 
@@ -279,6 +280,10 @@ struct rnn_conf_t {
     bool merge_gemm_iter, merge_gemm_layer, force_nocopy, use_layer_packed_gemm,
             use_iter_packed_gemm, use_projection_packed_gemm;
     int n_iter_scratch_gates;
+    // Run the cells of a direction along anti-diagonals (lay + iter) of the
+    // grid instead of layer by layer. Each layer then owns its own slice of
+    // the scratch gates and scratch cell buffers.
+    bool use_wavefront;
 
     inline bool is_int8() const {
         return is_signed_int8() || is_unsigned_int8();
@@ -308,6 +313,10 @@ struct rnn_conf_t {
     }
     inline bool is_f32() const { return dt_conf == all_f32; }
 
+    // Number of independent scratch gates/cell buffers: one per layer when
+    // the cells of several layers run concurrently, a single one otherwise.
+    inline int n_scratch_slots() const { return use_wavefront ? n_layer : 1; }
+
     inline bool skip_src_layer_copy() const {
         // Note: this currently always returns true
         return (exec_dir == l2r)
@@ -658,6 +667,20 @@ bool init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.merge_gemm_iter = (!rnn.is_brgemm)
             ? dst_layer_is_trivial_stride && !(rnn.is_fwd || is_gru)
             : false;
+
+    /* Decide to run the grid as a wavefront: cells (lay, iter) with the same
+     * lay + iter are independent, so for small problems that cannot keep all
+     * threads busy inside a single cell we run them concurrently. Each cell
+     * is run by a single thread, so the widest anti-diagonal must provide a
+     * cell to every thread, otherwise the threads left without a cell idle
+     * and the merged layer gemm, which the wavefront requires to be done
+     * per cell, is the better choice. */
+    const int wavefront_width = nstl::min(rnn.n_layer, rnn.n_iter);
+    const int nthr = dnnl_get_max_threads();
+    rnn.use_wavefront = !rnn.is_brgemm && rnn.is_fwd
+            && !rnn.is_lstm_projection && nthr > 1 && wavefront_width >= nthr
+            && (dim_t)rnn.mb * rnn.dhc <= (dim_t)256 * nthr;
+    if (rnn.use_wavefront) rnn.merge_gemm_layer = false;
     rnn.force_nocopy = false;
 #if DNNL_X64
     rnn.force_nocopy = !x64::mayiuse(x64::avx512_mic) && x64::mayiuse(x64::avx)
@@ -880,7 +903,8 @@ void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
             : (size_t)0;
     rnn.n_iter_scratch_gates
             = (rnn.merge_gemm_layer || rnn.merge_gemm_iter) ? rnn.n_iter : 1;
-    rnn.scratch_gates_size = rnn.n_iter_scratch_gates * rnn.scratch_gates_nld
+    rnn.scratch_gates_size = (size_t)rnn.n_scratch_slots()
+            * rnn.n_iter_scratch_gates * rnn.scratch_gates_nld
             * rnn.scratch_gates_ld * sizeof(typename T::scratch_t);
     rnn.scratch_ht_size
             = rnn.scratch_ht_nld * rnn.scratch_ht_ld * sizeof(typename T::ht_t);
@@ -890,7 +914,7 @@ void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
 
     /* set other sizes */
     /// scratchpad buffer for each cell to hold intermediate data in gru/lbr_gru
-    rnn.scratch_cell_size = rnn.is_lbr
+    const size_t scratch_cell_slot_size = rnn.is_lbr
             ? (size_t)rnn.scratch_gates_nld * rnn.scratch_gates_ld
                     * sizeof(typename T::gemm_acc_t)
             : (rd.cell_kind == alg_kind::vanilla_gru
@@ -898,6 +922,7 @@ void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                                     * rnn.ws_states_layer_ld
                                     * sizeof(typename T::gemm_acc_t)
                             : 0);
+    rnn.scratch_cell_size = rnn.n_scratch_slots() * scratch_cell_slot_size;
     /// workspace needed for lbr GRU
     rnn.ws_per_cell = (size_t)rnn.is_lbr * rnn.mb * rnn.dhc
             * sizeof(typename T::gemm_acc_t);
@@ -24,6 +24,8 @@
 
 #include "cpu/cpu_batch_normalization_utils.hpp"
 #include "cpu/cpu_engine.hpp"
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/simple_q10n.hpp"
 
 #include "cpu/simple_layer_normalization.hpp"
 
@@ -47,6 +49,44 @@ status_t fill_compatible_stats_md(
             stat_md, src_md.format_desc.blocking);
 }
 
+template <typename data_t>
+void add_residual(
+        data_t *dst, const data_t *src, const data_t *residual, dim_t len) {
+    PRAGMA_OMP_SIMD()
+    for (dim_t i = 0; i < len; i++)
+        dst[i] = static_cast<float>(src[i]) + static_cast<float>(residual[i]);
+}
+
+template <typename out_t, typename data_t>
+void scale_and_convert(out_t *dst, const data_t *src, dim_t len, float scale) {
+    PRAGMA_OMP_SIMD()
+    for (dim_t i = 0; i < len; i++)
+        dst[i] = saturate_and_round<out_t>(scale * static_cast<float>(src[i]));
+}
+
+template <typename data_t>
+void store_dst(data_type_t dst_dt, void *dst, dim_t off, const data_t *src,
+        dim_t len, float scale) {
+    switch (dst_dt) {
+        case f32:
+            scale_and_convert(&static_cast<float *>(dst)[off], src, len, scale);
+            break;
+        case bf16:
+            scale_and_convert(
+                    &static_cast<bfloat16_t *>(dst)[off], src, len, scale);
+            break;
+        case s8:
+            scale_and_convert(
+                    &static_cast<int8_t *>(dst)[off], src, len, scale);
+            break;
+        case u8:
+            scale_and_convert(
+                    &static_cast<uint8_t *>(dst)[off], src, len, scale);
+            break;
+        default: assert(!"unsupported data type");
+    }
+}
+
 } // namespace
 
 template <data_type_t data_type>
@@ -55,15 +95,20 @@ status_t simple_layer_normalization_fwd_t<data_type>::pd_t::init(
     using namespace data_type;
     const memory_desc_wrapper src_d(src_md());
 
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
     const bool ok = is_fwd() && !has_zero_dim_memory()
             && platform::has_data_type_support(data_type)
-            && utils::everyone_is(
-                    data_type, src_md()->data_type, dst_md()->data_type)
+            && src_md()->data_type == data_type
+            && utils::one_of(dst_md()->data_type, data_type, s8, u8)
             && (f32 == stat_md()->data_type) && check_scale_shift_data_type()
             && src_d.is_blocking_desc()
             && src_d.blocking_desc().strides[ndims() - 1]
                     == 1 // plain format, last logical dim is last physical
-            && attr()->has_default_values() && set_default_formats_common();
+            && attr()->has_default_values(
+                    skip_mask_t::oscale_runtime | skip_mask_t::post_ops)
+            && attr()->output_scales_.mask_ == 0 && post_ops_ok()
+            && set_default_formats_common()
+            && src_d.similar_to(*dst_md(), true, false);
     if (!ok) return status::unimplemented;
 
     CHECK(fill_compatible_stats_md(*src_md(), reordered_stat_md_));
@@ -87,7 +132,12 @@ status_t simple_layer_normalization_fwd_t<data_type>::execute_forward(
 
     auto scratchpad = ctx.get_scratchpad_grantor();
     auto src = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
-    auto dst = CTX_OUT_MEM(data_t *, DNNL_ARG_DST);
+    auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+    auto residual = pd()->with_residual()
+            ? CTX_IN_MEM(const data_t *,
+                    DNNL_ARG_ATTR_MULTIPLE_POST_OP(0) | DNNL_ARG_SRC_1)
+            : nullptr;
+    DEFINE_SCALES_BUFFER(oscales);
 
     const memory_desc_wrapper ss_d(pd()->weights_md());
     const size_t shift_off
@@ -113,17 +163,56 @@ status_t simple_layer_normalization_fwd_t<data_type>::execute_forward(
     }
 
     const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
 
     const dim_t N = pd()->across_axis();
     const dim_t C_padded = src_d.padded_dims()[pd()->ndims() - 1];
 
-    parallel(0, [&](const int ithr, const int nthr) {
+    if (!pd()->use_tmp_data()) {
+        parallel(0, [&](const int ithr, const int nthr) {
+            dim_t N_start = 0, N_end = 0;
+            balance211(N, nthr, ithr, N_start, N_end);
+            const int block_size = N_end - N_start;
+            (*stat_and_data_kernel_)(&src[N_start * C_padded],
+                    &static_cast<data_t *>(dst)[N_start * C_padded], scale,
+                    shift, &mean[N_start], &variance[N_start], block_size);
+        });
+        return status::success;
+    }
+
+    // Fused flavor: every block of rows is summed with the residual, then
+    // normalized and finally scaled and converted to dst while it is still
+    // in cache, so the data goes through memory once.
+    const bool store_to_tmp = pd()->with_oscale()
+            || dst_d.data_type() != data_type;
+    const dim_t tmp_rows = pd()->tmp_data_rows();
+    data_t *tmp_data = scratchpad.template get<data_t>(key_lnorm_tmp_data);
+    assert(pd()->tmp_data_row_size() == C_padded);
+    // One buffer is booked per thread available at creation
+    const int tmp_nthr = nstl::min(pd()->nthr(), dnnl_get_max_threads());
+
+    parallel(tmp_nthr, [&](const int ithr, const int nthr) {
         dim_t N_start = 0, N_end = 0;
         balance211(N, nthr, ithr, N_start, N_end);
-        const int block_size = N_end - N_start;
-        (*stat_and_data_kernel_)(&src[N_start * C_padded],
-                &dst[N_start * C_padded], scale, shift, &mean[N_start],
-                &variance[N_start], block_size);
+        data_t *tmp = &tmp_data[ithr * tmp_rows * C_padded];
+
+        for (dim_t n = N_start; n < N_end; n += tmp_rows) {
+            const dim_t block_size = nstl::min(tmp_rows, N_end - n);
+            const dim_t off = n * C_padded;
+            const dim_t len = block_size * C_padded;
+
+            const data_t *block_src = &src[off];
+            if (residual) {
+                add_residual(tmp, block_src, &residual[off], len);
+                block_src = tmp;
+            }
+            data_t *block_dst
+                    = store_to_tmp ? tmp : &static_cast<data_t *>(dst)[off];
+            (*stat_and_data_kernel_)(block_src, block_dst, scale, shift,
+                    &mean[n], &variance[n], block_size);
+            if (store_to_tmp)
+                store_dst(dst_d.data_type(), dst, off, tmp, len, oscales[0]);
+        }
     });
     return status::success;
 }
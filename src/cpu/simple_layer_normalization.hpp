@@ -28,6 +28,7 @@
 #include "common/utils.hpp"
 
 #include "cpu/cpu_layer_normalization_pd.hpp"
+#include "cpu/platform.hpp"
 #include "cpu/simple_layer_normalization_kernels.hpp"
 
 namespace dnnl {
@@ -37,7 +38,7 @@ namespace cpu {
 template <data_type_t data_type>
 struct simple_layer_normalization_fwd_t : public primitive_t {
     struct pd_t : public cpu_layer_normalization_fwd_pd_t {
-        pd_t(const layer_normalization_desc_t *adesc,
+        pd_t(const layer_normalization_v2_desc_t *adesc,
                 const primitive_attr_t *attr,
                 const layer_normalization_fwd_pd_t *hint_fwd_pd)
             : cpu_layer_normalization_fwd_pd_t(adesc, attr, hint_fwd_pd) {}
@@ -52,10 +53,47 @@ struct simple_layer_normalization_fwd_t : public primitive_t {
 
         bool use_tmp_stats() const { return reorder_pd_ || stats_are_tmp(); }
 
+        // A binary add post-op is applied to src before normalization. It
+        // fuses the residual connection that usually precedes the layer
+        // normalization.
+        bool with_residual() const { return attr()->post_ops_.len() > 0; }
+        bool with_oscale() const {
+            return !attr()->output_scales_.has_default_values();
+        }
+        // Rows are staged in a per thread buffer if src has to be combined
+        // with the residual or dst has to be scaled or converted.
+        bool use_tmp_data() const {
+            return with_residual() || with_oscale()
+                    || dst_md()->data_type != data_type;
+        }
+        // Number of rows staged at once, chosen for the buffer to stay in L1.
+        dim_t tmp_data_rows() const {
+            const dim_t row_size = norm_axis() * sizeof(data_t);
+            const dim_t rows = platform::get_per_core_cache_size(1) / 2
+                    / nstl::max<dim_t>(row_size, 1);
+            return nstl::max<dim_t>(1, nstl::min(rows, across_axis()));
+        }
+        // Rows are stored with the padded stride of src.
+        dim_t tmp_data_row_size() const {
+            return memory_desc_wrapper(src_md()).padded_dims()[ndims() - 1];
+        }
         std::shared_ptr<primitive_desc_t> reorder_pd_;
         memory_desc_t reordered_stat_md_;
 
     private:
+        using data_t = typename prec_traits<data_type>::type;
+
+        bool post_ops_ok() const {
+            const auto &po = attr()->post_ops_;
+            if (po.len() == 0) return true;
+            if (po.len() != 1 || !po.entry_[0].is_binary()
+                    || po.entry_[0].binary.alg != alg_kind::binary_add)
+                return false;
+            const memory_desc_wrapper src1_d(po.entry_[0].binary.src1_desc);
+            return src1_d.data_type() == data_type
+                    && src1_d.similar_to(*src_md(), true, false);
+        }
+
         void init_scratchpad() {
             using namespace memory_tracking::names;
             auto scratchpad = scratchpad_registry().registrar();
@@ -65,6 +103,10 @@ struct simple_layer_normalization_fwd_t : public primitive_t {
                 scratchpad.template book<float>(
                         key_lnorm_tmp_var, across_axis());
             }
+            if (use_tmp_data()) {
+                scratchpad.template book<data_t>(key_lnorm_tmp_data,
+                        tmp_data_rows() * tmp_data_row_size() * nthr());
+            }
             if (reordered_stat_md_ != *stat_md() && !stats_are_tmp()) {
                 scratchpad.book(key_nested, reorder_pd_->scratchpad_registry());
             }
@@ -143,7 +185,7 @@ private:
 template <data_type_t data_type>
 struct simple_layer_normalization_bwd_t : public primitive_t {
     struct pd_t : public cpu_layer_normalization_bwd_pd_t {
-        pd_t(const layer_normalization_desc_t *adesc,
+        pd_t(const layer_normalization_v2_desc_t *adesc,
                 const primitive_attr_t *attr,
                 const layer_normalization_fwd_pd_t *hint_fwd_pd)
             : cpu_layer_normalization_bwd_pd_t(adesc, attr, hint_fwd_pd) {}
@@ -21,6 +21,8 @@
 
 #if DNNL_X64
 #include "cpu/x64/jit_uni_layer_normalization_kernels.hpp"
+#elif DNNL_AARCH64
+#include "cpu/aarch64/jit_uni_layer_normalization_kernels.hpp"
 #endif
 
 #include "cpu/simple_layer_normalization_kernels.hpp"
@@ -212,6 +214,11 @@ stat_and_data_kernel_t<data_type> *stat_and_data_kernel_t<data_type>::create(
     if (auto *res
             = x64::lnorm_utils::stat_and_data_kernel_create<data_type>(pd))
         return res;
+#elif DNNL_AARCH64
+    if (auto *res
+            = aarch64::lnorm_utils::stat_and_data_kernel_create<data_type>(
+                    pd))
+        return res;
 #endif
     if (data_type == bf16) {
         assert(!"No default stat_and_data_kernel_t for bf16 input!");
@@ -226,6 +233,10 @@ diff_ss_kernel_t<data_type> *diff_ss_kernel_t<data_type>::create(
 #if DNNL_X64
     if (auto *res = x64::lnorm_utils::diff_ss_kernel_create<data_type>(pd))
         return res;
+#elif DNNL_AARCH64
+    if (auto *res
+            = aarch64::lnorm_utils::diff_ss_kernel_create<data_type>(pd))
+        return res;
 #endif
     if (data_type == bf16) {
         assert(!"No default diff_ss_kernel_t for bf16 input!");
@@ -240,6 +251,10 @@ diff_data_kernel_t<data_type> *diff_data_kernel_t<data_type>::create(
 #if DNNL_X64
     if (auto *res = x64::lnorm_utils::diff_data_kernel_create<data_type>(pd))
         return res;
+#elif DNNL_AARCH64
+    if (auto *res
+            = aarch64::lnorm_utils::diff_data_kernel_create<data_type>(pd))
+        return res;
 #endif
     if (data_type == bf16) {
         assert(!"No default diff_data_kernel_t for bf16 input!");
@@ -0,0 +1,181 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_uni_concat_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace Xbyak;
+
+#define GET_OFF(field) offsetof(concat_utils::call_params_t, field)
+#define GET_JOB_OFF(field) offsetof(concat_utils::job_t, field)
+
+template <cpu_isa_t isa>
+void jit_uni_concat_kernel_t<isa>::store(const Address &addr, const Vmm &v) {
+    if (use_nt_stores_)
+        uni_vmovntps(addr, v);
+    else
+        uni_vmovups(addr, v);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_concat_kernel_t<isa>::copy_row() {
+    Label l_align, l_unroll_loop, l_loop, l_tail, l_end;
+
+    if (use_nt_stores_) {
+        // The non-temporal stores require dst aligned to the vector length.
+        L(l_align);
+        {
+            cmp(reg_bytes, 0);
+            je(l_end, T_NEAR);
+            test(reg_dst, vlen - 1);
+            jz(l_unroll_loop, T_NEAR);
+            mov(reg_tmp.cvt8(), ptr[reg_src]);
+            mov(ptr[reg_dst], reg_tmp.cvt8());
+            inc(reg_src);
+            inc(reg_dst);
+            dec(reg_bytes);
+            jmp(l_align, T_NEAR);
+        }
+    }
+
+    L(l_unroll_loop);
+    {
+        cmp(reg_bytes, unroll * vlen);
+        jl(l_loop, T_NEAR);
+        for (int i = 0; i < unroll; ++i)
+            uni_vmovups(Vmm(i), ptr[reg_src + i * vlen]);
+        for (int i = 0; i < unroll; ++i)
+            store(ptr[reg_dst + i * vlen], Vmm(i));
+        add(reg_src, unroll * vlen);
+        add(reg_dst, unroll * vlen);
+        sub(reg_bytes, unroll * vlen);
+        jmp(l_unroll_loop, T_NEAR);
+    }
+
+    L(l_loop);
+    {
+        cmp(reg_bytes, vlen);
+        jl(l_tail, T_NEAR);
+        uni_vmovups(Vmm(0), ptr[reg_src]);
+        store(ptr[reg_dst], Vmm(0));
+        add(reg_src, vlen);
+        add(reg_dst, vlen);
+        sub(reg_bytes, vlen);
+        jmp(l_loop, T_NEAR);
+    }
+
+    L(l_tail);
+    if (isa == avx512_core) {
+        cmp(reg_bytes, 0);
+        je(l_end, T_NEAR);
+        mov(reg_tmp, -1);
+        bzhi(reg_tmp, reg_tmp, reg_bytes);
+        kmovq(ktail_mask, reg_tmp);
+        vmovdqu8(Zmm(0) | ktail_mask | T_z, ptr[reg_src]);
+        vmovdqu8(ptr[reg_dst] | ktail_mask, Zmm(0));
+    } else {
+        Label l_tail_byte;
+        cmp(reg_bytes, 8);
+        jl(l_tail_byte, T_NEAR);
+        mov(reg_tmp, ptr[reg_src]);
+        mov(ptr[reg_dst], reg_tmp);
+        add(reg_src, 8);
+        add(reg_dst, 8);
+        sub(reg_bytes, 8);
+        jmp(l_tail, T_NEAR);
+
+        L(l_tail_byte);
+        cmp(reg_bytes, 0);
+        je(l_end, T_NEAR);
+        mov(reg_tmp.cvt8(), ptr[reg_src]);
+        mov(ptr[reg_dst], reg_tmp.cvt8());
+        inc(reg_src);
+        inc(reg_dst);
+        dec(reg_bytes);
+        jmp(l_tail_byte, T_NEAR);
+    }
+    L(l_end);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_concat_kernel_t<isa>::generate() {
+    preamble();
+
+    mov(reg_jobs, ptr[reg_param + GET_OFF(jobs)]);
+    mov(reg_njobs, ptr[reg_param + GET_OFF(njobs)]);
+    mov(reg_nrows, ptr[reg_param + GET_OFF(nrows)]);
+
+    Label l_row_loop, l_job_loop, l_end;
+
+    cmp(reg_njobs, 0);
+    je(l_end, T_NEAR);
+    cmp(reg_nrows, 0);
+    je(l_end, T_NEAR);
+    xor_(reg_row, reg_row);
+
+    // The jobs are processed row by row, so that the rows of dst are written
+    // one after another.
+    L(l_row_loop);
+    {
+        mov(reg_job, reg_jobs);
+        mov(reg_j, reg_njobs);
+
+        L(l_job_loop);
+        {
+            mov(reg_src, ptr[reg_job + GET_JOB_OFF(src_stride)]);
+            imul(reg_src, reg_row);
+            add(reg_src, ptr[reg_job + GET_JOB_OFF(src)]);
+            mov(reg_dst, ptr[reg_job + GET_JOB_OFF(dst_stride)]);
+            imul(reg_dst, reg_row);
+            add(reg_dst, ptr[reg_job + GET_JOB_OFF(dst)]);
+            mov(reg_bytes, ptr[reg_job + GET_JOB_OFF(bytes)]);
+
+            copy_row();
+
+            add(reg_job, sizeof(concat_utils::job_t));
+            dec(reg_j);
+            jnz(l_job_loop, T_NEAR);
+        }
+
+        inc(reg_row);
+        cmp(reg_row, reg_nrows);
+        jl(l_row_loop, T_NEAR);
+    }
+    L(l_end);
+
+    if (use_nt_stores_) sfence();
+
+    postamble();
+}
+
+#undef GET_JOB_OFF
+#undef GET_OFF
+
+template struct jit_uni_concat_kernel_t<avx2>;
+template struct jit_uni_concat_kernel_t<avx512_core>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
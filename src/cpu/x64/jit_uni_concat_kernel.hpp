@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_CONCAT_KERNEL_HPP
+#define CPU_X64_JIT_UNI_CONCAT_KERNEL_HPP
+
+#include "common/c_types_map.hpp"
+
+#include "cpu/concat_utils.hpp"
+#include "cpu/x64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Copies the rows of the jobs, see cpu/concat_utils.hpp for the description
+// of the call parameters.
+template <cpu_isa_t isa>
+struct jit_uni_concat_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_concat_kernel_t)
+
+    jit_uni_concat_kernel_t(const concat_utils::conf_t &conf)
+        : jit_generator(nullptr, MAX_CODE_SIZE, true, isa)
+        , use_nt_stores_(conf.use_nt_stores) {}
+
+    void operator()(const concat_utils::call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    using Reg64 = Xbyak::Reg64;
+
+    static constexpr int vlen = cpu_isa_traits<isa>::vlen;
+    static constexpr int unroll = 4;
+
+    void generate() override;
+
+    void store(const Xbyak::Address &addr, const Vmm &v);
+    void copy_row();
+
+    const bool use_nt_stores_;
+
+    Reg64 reg_param = abi_param1;
+    Reg64 reg_jobs = r8;
+    Reg64 reg_njobs = r9;
+    Reg64 reg_nrows = r10;
+    Reg64 reg_row = r11;
+    Reg64 reg_job = r12;
+    Reg64 reg_j = r13;
+    Reg64 reg_src = r14;
+    Reg64 reg_dst = r15;
+    Reg64 reg_bytes = rbx;
+    Reg64 reg_tmp = rax;
+
+    Xbyak::Opmask ktail_mask = Xbyak::Opmask(1);
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_REDUCTION_HPP
+#define CPU_X64_JIT_UNI_REDUCTION_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_reduction_pd.hpp"
+#include "cpu/reduction_utils.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/jit_uni_reduction_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+template <cpu_isa_t isa>
+struct jit_uni_reduction_t : public primitive_t {
+    struct pd_t : public cpu_reduction_pd_t {
+        using cpu_reduction_pd_t::cpu_reduction_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", isa, ""), jit_uni_reduction_t);
+
+        status_t init(engine_t *engine) {
+            using namespace alg_kind;
+            using namespace data_type;
+
+            bool ok = mayiuse(isa) && src_md()->data_type == f32
+                    && dst_md()->data_type == f32
+                    && set_default_params() == status::success
+                    && !memory_desc_wrapper(src_md()).has_zero_dim()
+                    && IMPLICATION(reduction_utils::is_norm(desc()->alg_kind),
+                            utils::one_of(desc()->p, 1.f, 2.f))
+                    && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            CHECK(reduction_utils::init_conf(conf_, this,
+                    jit_uni_reduction_kernel_t<isa>::simd_w));
+
+            auto scratchpad = scratchpad_registry().registrar();
+            reduction_utils::init_scratchpad(scratchpad, conf_);
+
+            return status::success;
+        }
+
+        reduction_utils::conf_t conf_;
+    };
+
+    jit_uni_reduction_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<jit_uni_reduction_kernel_t<isa>> kernel_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
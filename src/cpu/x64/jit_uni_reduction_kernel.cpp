@@ -0,0 +1,290 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_uni_reduction_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace Xbyak;
+
+#define GET_OFF(field) offsetof(reduction_utils::call_params_t, field)
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::prepare_tail_mask(const Reg64 &reg_n) {
+    // The table holds simd_w ones followed by simd_w zeros, the mask for n
+    // elements starts at (simd_w - n).
+    mov(reg_tmp, simd_w);
+    sub(reg_tmp, reg_n);
+    uni_vmovups(vtail_mask, ptr[reg_table + reg_tmp * sizeof(float)]);
+    if (isa == avx512_common)
+        vptestmd(ktail_mask, vtail_mask, vtail_mask);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::load(
+        const Vmm &v, const Address &addr, bool tail) {
+    const bool is_sum_like = reduction_utils::is_sum_like(conf_.alg);
+    if (!tail) {
+        uni_vmovups(v, addr);
+    } else if (isa == avx512_common) {
+        const Zmm z(v.getIdx());
+        if (is_sum_like) {
+            vmovups(z | ktail_mask | T_z, addr);
+        } else {
+            vmovups(z, Zmm(vneutral.getIdx()));
+            vmovups(z | ktail_mask, addr);
+        }
+    } else {
+        // Masked out elements are zeroed, which is neutral for sum-like
+        // algorithms only.
+        vmaskmovps(v, vtail_mask, addr);
+        if (!is_sum_like) vblendvps(v, vneutral, v, vtail_mask);
+    }
+
+    if (reduction_utils::is_norm(conf_.alg)) {
+        if (conf_.p == 1.f)
+            uni_vandps(v, v, vabs_mask);
+        else
+            uni_vmulps(v, v, v);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::accumulate(const Vmm &acc, const Vmm &v) {
+    using namespace alg_kind;
+    switch (conf_.alg) {
+        case reduction_max: uni_vmaxps(acc, acc, v); break;
+        case reduction_min: uni_vminps(acc, acc, v); break;
+        case reduction_mul: uni_vmulps(acc, acc, v); break;
+        default: uni_vaddps(acc, acc, v); break;
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::compute_vertical(int nvecs, bool tail) {
+    // With a few vectors along the inner dimension the rows are distributed
+    // over several sets of accumulators to hide the latency of the operation.
+    const int nsets = unroll / nvecs;
+
+    for (int i = 0; i < nsets * nvecs; ++i)
+        uni_vmovups(vacc(i), vneutral);
+
+    Label l_unroll_loop, l_loop, l_end;
+
+    mov(reg_src_r, reg_src);
+    mov(reg_r, reg_n_reduce);
+
+    if (nsets > 1) {
+        L(l_unroll_loop);
+        {
+            cmp(reg_r, nsets);
+            jl(l_loop, T_NEAR);
+            for (int s = 0; s < nsets; ++s) {
+                for (int i = 0; i < nvecs; ++i) {
+                    const int idx = s * nvecs + i;
+                    load(vtmp(idx), ptr[reg_src_r + i * vlen], tail);
+                    accumulate(vacc(idx), vtmp(idx));
+                }
+                add(reg_src_r, reg_stride);
+            }
+            sub(reg_r, nsets);
+            jmp(l_unroll_loop, T_NEAR);
+        }
+    }
+
+    L(l_loop);
+    {
+        cmp(reg_r, 0);
+        jle(l_end, T_NEAR);
+        for (int i = 0; i < nvecs; ++i) {
+            load(vtmp(i), ptr[reg_src_r + i * vlen], tail);
+            accumulate(vacc(i), vtmp(i));
+        }
+        add(reg_src_r, reg_stride);
+        dec(reg_r);
+        jmp(l_loop, T_NEAR);
+    }
+    L(l_end);
+
+    for (int s = 1; s < nsets; ++s)
+        for (int i = 0; i < nvecs; ++i)
+            accumulate(vacc(i), vacc(s * nvecs + i));
+
+    for (int i = 0; i < nvecs; ++i) {
+        const auto addr = ptr[reg_acc + i * vlen];
+        if (!tail)
+            uni_vmovups(addr, vacc(i));
+        else if (isa == avx512_common)
+            vmovups(addr | ktail_mask, Zmm(vacc(i).getIdx()));
+        else
+            vmaskmovps(addr, vtail_mask, vacc(i));
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::vertical() {
+    Label l_unroll_loop, l_loop, l_tail, l_end;
+
+    // The rows are inner elements apart.
+    mov(reg_stride, conf_.inner * sizeof(float));
+
+    L(l_unroll_loop);
+    {
+        cmp(reg_n_inner, unroll * simd_w);
+        jl(l_loop, T_NEAR);
+        compute_vertical(unroll, false);
+        add(reg_src, unroll * vlen);
+        add(reg_acc, unroll * vlen);
+        sub(reg_n_inner, unroll * simd_w);
+        jmp(l_unroll_loop, T_NEAR);
+    }
+
+    L(l_loop);
+    {
+        cmp(reg_n_inner, simd_w);
+        jl(l_tail, T_NEAR);
+        compute_vertical(1, false);
+        add(reg_src, vlen);
+        add(reg_acc, vlen);
+        sub(reg_n_inner, simd_w);
+        jmp(l_loop, T_NEAR);
+    }
+
+    L(l_tail);
+    {
+        cmp(reg_n_inner, 0);
+        jle(l_end, T_NEAR);
+        prepare_tail_mask(reg_n_inner);
+        compute_vertical(1, true);
+    }
+    L(l_end);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::horizontal() {
+    Label l_outer_loop, l_unroll_loop, l_loop, l_tail, l_store, l_end;
+
+    // The rows are reduce elements apart.
+    mov(reg_stride, conf_.reduce * sizeof(float));
+
+    L(l_outer_loop);
+    {
+        cmp(reg_n_outer, 0);
+        jle(l_end, T_NEAR);
+
+        for (int i = 0; i < unroll; ++i)
+            uni_vmovups(vacc(i), vneutral);
+        mov(reg_src_r, reg_src);
+        mov(reg_r, reg_n_reduce);
+
+        L(l_unroll_loop);
+        {
+            cmp(reg_r, unroll * simd_w);
+            jl(l_loop, T_NEAR);
+            for (int i = 0; i < unroll; ++i) {
+                load(vtmp(i), ptr[reg_src_r + i * vlen], false);
+                accumulate(vacc(i), vtmp(i));
+            }
+            add(reg_src_r, unroll * vlen);
+            sub(reg_r, unroll * simd_w);
+            jmp(l_unroll_loop, T_NEAR);
+        }
+
+        L(l_loop);
+        {
+            cmp(reg_r, simd_w);
+            jl(l_tail, T_NEAR);
+            load(vtmp(0), ptr[reg_src_r], false);
+            accumulate(vacc(0), vtmp(0));
+            add(reg_src_r, vlen);
+            sub(reg_r, simd_w);
+            jmp(l_loop, T_NEAR);
+        }
+
+        L(l_tail);
+        {
+            cmp(reg_r, 0);
+            jle(l_store, T_NEAR);
+            prepare_tail_mask(reg_r);
+            load(vtmp(0), ptr[reg_src_r], true);
+            accumulate(vacc(0), vtmp(0));
+        }
+
+        L(l_store);
+        accumulate(vacc(0), vacc(1));
+        accumulate(vacc(2), vacc(3));
+        accumulate(vacc(0), vacc(2));
+        uni_vmovups(ptr[reg_acc], vacc(0));
+
+        add(reg_src, reg_stride);
+        add(reg_acc, vlen);
+        dec(reg_n_outer);
+        jmp(l_outer_loop, T_NEAR);
+    }
+    L(l_end);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_kernel_t<isa>::generate() {
+    preamble();
+
+    mov(reg_src, ptr[reg_param + GET_OFF(src)]);
+    mov(reg_acc, ptr[reg_param + GET_OFF(acc)]);
+    mov(reg_n_outer, ptr[reg_param + GET_OFF(n_outer)]);
+    mov(reg_n_reduce, ptr[reg_param + GET_OFF(n_reduce)]);
+    mov(reg_n_inner, ptr[reg_param + GET_OFF(n_inner)]);
+    mov(reg_table, l_table);
+
+    const Xmm xtmp(vtmp(0).getIdx());
+    mov(reg_tmp.cvt32(), float2int(reduction_utils::neutral(conf_.alg)));
+    uni_vmovd(xtmp, reg_tmp.cvt32());
+    uni_vbroadcastss(vneutral, xtmp);
+    mov(reg_tmp.cvt32(), 0x7fffffff);
+    uni_vmovd(xtmp, reg_tmp.cvt32());
+    uni_vbroadcastss(vabs_mask, xtmp);
+
+    if (conf_.is_horizontal())
+        horizontal();
+    else
+        vertical();
+
+    postamble();
+
+    align(64);
+    L(l_table);
+    for (int i = 0; i < simd_w; ++i)
+        dd(0xffffffff);
+    for (int i = 0; i < simd_w; ++i)
+        dd(0);
+}
+
+#undef GET_OFF
+
+template struct jit_uni_reduction_kernel_t<avx2>;
+template struct jit_uni_reduction_kernel_t<avx512_common>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_REDUCTION_KERNEL_HPP
+#define CPU_X64_JIT_UNI_REDUCTION_KERNEL_HPP
+
+#include "common/c_types_map.hpp"
+
+#include "cpu/reduction_utils.hpp"
+#include "cpu/x64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Accumulates src[o][r][i] over r, see cpu/reduction_utils.hpp for the
+// description of the canonical form and of the call parameters.
+template <cpu_isa_t isa>
+struct jit_uni_reduction_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_reduction_kernel_t)
+
+    jit_uni_reduction_kernel_t(const reduction_utils::conf_t &conf)
+        : jit_generator(nullptr, MAX_CODE_SIZE, true, isa), conf_(conf) {}
+
+    void operator()(const reduction_utils::call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    using Reg64 = Xbyak::Reg64;
+
+    static constexpr int vlen = cpu_isa_traits<isa>::vlen;
+    static constexpr int unroll = reduction_utils::unroll;
+
+    void generate() override;
+
+    void prepare_tail_mask(const Reg64 &reg_n);
+    void load(const Vmm &v, const Xbyak::Address &addr, bool tail);
+    void accumulate(const Vmm &acc, const Vmm &v);
+    void compute_vertical(int nvecs, bool tail);
+    void vertical();
+    void horizontal();
+
+    const reduction_utils::conf_t conf_;
+
+    Reg64 reg_param = abi_param1;
+    Reg64 reg_src = r8;
+    Reg64 reg_acc = r9;
+    Reg64 reg_n_outer = r10;
+    Reg64 reg_n_reduce = r11;
+    Reg64 reg_n_inner = r12;
+    Reg64 reg_src_r = r13;
+    Reg64 reg_r = r14;
+    Reg64 reg_table = r15;
+    Reg64 reg_stride = rbx;
+    Reg64 reg_tmp = rax;
+
+    Vmm vacc(int idx) const { return Vmm(idx); }
+    Vmm vtmp(int idx) const { return Vmm(unroll + idx); }
+    Vmm vneutral = Vmm(2 * unroll);
+    Vmm vtail_mask = Vmm(2 * unroll + 1);
+    Vmm vabs_mask = Vmm(2 * unroll + 2);
+    Xbyak::Opmask ktail_mask = Xbyak::Opmask(1);
+
+    Xbyak::Label l_table;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -60,6 +60,8 @@ const char *driver_name = "";
 double max_ms_per_prb {3e3};
 int min_times_per_prb {5};
 int fix_times_per_prb {0};
+double peak_gflops {0};
+double peak_bandwidth {0};
 
 bool fast_ref_gpu {true};
 bool allow_enum_tags_only {true};
@@ -77,6 +79,7 @@ int main(int argc, char **argv) {
     ++argv;
 
     init_fp_mode();
+    init_tlb_miss_counter();
 
     for (; argc > 0; --argc, ++argv)
         if (!parse_bench_settings(argv[0])) break;
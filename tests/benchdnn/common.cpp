@@ -92,6 +92,49 @@ unsigned long long ticks_now() {
 }
 #endif
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int tlb_miss_counter_fd = -1;
+
+void init_tlb_miss_counter() {
+    if (tlb_miss_counter_fd >= 0) return;
+
+    // Data TLB load misses of the process. The counter is inherited by the
+    // threads created afterwards, so it must be opened before the library
+    // creates its threads.
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    tlb_miss_counter_fd
+            = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+unsigned long long tlb_misses_now() {
+    uint64_t value = 0;
+    if (tlb_miss_counter_fd < 0
+            || read(tlb_miss_counter_fd, &value, sizeof(value))
+                    != sizeof(value))
+        return 0;
+    return (unsigned long long)value;
+}
+#else
+void init_tlb_miss_counter() {}
+
+unsigned long long tlb_misses_now() {
+    return (unsigned long long)0;
+}
+#endif
+
 void benchdnn_timer_t::reset() {
     times_ = 0;
     for (int i = 0; i < n_modes; ++i)
@@ -100,6 +143,9 @@ void benchdnn_timer_t::reset() {
     for (int i = 0; i < n_modes; ++i)
         ms_[i] = 0;
     ms_start_ = 0;
+    for (int i = 0; i < n_modes; ++i)
+        tlb_misses_[i] = 0;
+    tlb_misses_start_ = 0;
 
     start();
 }
@@ -107,6 +153,7 @@ void benchdnn_timer_t::reset() {
 void benchdnn_timer_t::start() {
     ticks_start_ = ticks_now();
     ms_start_ = ms_now();
+    tlb_misses_start_ = tlb_misses_now();
 }
 
 void benchdnn_timer_t::stop(int add_times) {
@@ -114,15 +161,19 @@ void benchdnn_timer_t::stop(int add_times) {
 
     unsigned long long d_ticks = ticks_now() - ticks_start_;
     double d_ms = ms_now() - ms_start_;
+    unsigned long long d_tlb_misses = tlb_misses_now() - tlb_misses_start_;
 
     ticks_start_ += d_ticks;
     ms_start_ += d_ms;
+    tlb_misses_start_ += d_tlb_misses;
 
     ms_[benchdnn_timer_t::avg] += d_ms;
     ticks_[benchdnn_timer_t::avg] += d_ticks;
+    tlb_misses_[benchdnn_timer_t::avg] += d_tlb_misses;
 
     d_ticks /= add_times;
     d_ms /= add_times;
+    d_tlb_misses /= add_times;
 
     ms_[benchdnn_timer_t::min]
             = times_ ? MIN2(ms_[benchdnn_timer_t::min], d_ms) : d_ms;
@@ -134,6 +185,13 @@ void benchdnn_timer_t::stop(int add_times) {
     ticks_[benchdnn_timer_t::max]
             = times_ ? MAX2(ticks_[benchdnn_timer_t::max], d_ticks) : d_ticks;
 
+    tlb_misses_[benchdnn_timer_t::min] = times_
+            ? MIN2(tlb_misses_[benchdnn_timer_t::min], d_tlb_misses)
+            : d_tlb_misses;
+    tlb_misses_[benchdnn_timer_t::max] = times_
+            ? MAX2(tlb_misses_[benchdnn_timer_t::max], d_tlb_misses)
+            : d_tlb_misses;
+
     times_ += add_times;
 }
 
@@ -146,6 +204,9 @@ benchdnn_timer_t &benchdnn_timer_t::operator=(const benchdnn_timer_t &rhs) {
     for (int i = 0; i < n_modes; ++i)
         ms_[i] = rhs.ms_[i];
     ms_start_ = rhs.ms_start_;
+    for (int i = 0; i < n_modes; ++i)
+        tlb_misses_[i] = rhs.tlb_misses_[i];
+    tlb_misses_start_ = rhs.tlb_misses_start_;
     return *this;
 }
 
@@ -118,6 +118,8 @@ extern const char *driver_name;
 extern double max_ms_per_prb; /** maximum time spends per prb in ms */
 extern int min_times_per_prb; /** minimal amount of runs per prb */
 extern int fix_times_per_prb; /** if non-zero run prb that many times */
+extern double peak_gflops; /** peak GFLOPS for the roofline efficiency */
+extern double peak_bandwidth; /** peak GB/s for the roofline efficiency */
 
 extern bool fast_ref_gpu;
 extern bool allow_enum_tags_only;
@@ -151,13 +153,23 @@ struct benchdnn_timer_t {
         return ticks_[mode] / (mode == avg ? times() : 1);
     }
 
+    /** data TLB load misses, 0 if the counter is not available */
+    unsigned long long tlb_misses(mode_t mode = min) const {
+        if (!times()) return 0; // nothing to report
+        return tlb_misses_[mode] / (mode == avg ? times() : 1);
+    }
+
     benchdnn_timer_t &operator=(const benchdnn_timer_t &rhs);
 
     int times_;
     unsigned long long ticks_[n_modes], ticks_start_;
     double ms_[n_modes], ms_start_;
+    unsigned long long tlb_misses_[n_modes], tlb_misses_start_;
 };
 
+/* opens the data TLB miss counter used by benchdnn_timer_t */
+void init_tlb_miss_counter();
+
 /* global stats */
 struct stat_t {
     int tests;
@@ -202,6 +214,8 @@ struct res_t {
     std::string impl_name;
     skip_reason_t reason;
     size_t ibytes, obytes;
+    // Flops and bytes of the problem estimated by the library
+    double lib_ops, lib_bytes;
 };
 
 void parse_result(
@@ -685,6 +685,14 @@ int get_memory_footprint(const_dnnl_primitive_desc_t const_pd, res_t *res) {
             res->ibytes += get_md_size(dst_md);
         }
     }
+
+    // The estimates are 0 if the library does not provide them
+    res->lib_ops = 0;
+    res->lib_bytes = 0;
+    dnnl_primitive_desc_query(
+            const_pd, dnnl_query_flops_estimate_f64, 0, &res->lib_ops);
+    dnnl_primitive_desc_query(
+            const_pd, dnnl_query_bytes_estimate_f64, 0, &res->lib_bytes);
     return OK;
 }
 
@@ -273,6 +273,20 @@ static bool parse_fix_times_per_prb(
     return false;
 }
 
+static bool parse_peak_gflops(
+        const char *str, const std::string &option_name = "peak-gflops") {
+    if (parse_single_value_option(peak_gflops, 0., atof, str, option_name))
+        return peak_gflops = MAX2(0., peak_gflops), true;
+    return false;
+}
+
+static bool parse_peak_bandwidth(
+        const char *str, const std::string &option_name = "peak-bandwidth") {
+    if (parse_single_value_option(peak_bandwidth, 0., atof, str, option_name))
+        return peak_bandwidth = MAX2(0., peak_bandwidth), true;
+    return false;
+}
+
 static bool parse_verbose(
         const char *str, const std::string &option_name = "verbose") {
     const std::string pattern("-v"); // check short option first
@@ -373,7 +387,8 @@ bool parse_bench_settings(const char *str) {
     last_parsed_is_problem = false; // if start parsing, expect an option
 
     return parse_bench_mode(str) || parse_max_ms_per_prb(str)
-            || parse_fix_times_per_prb(str) || parse_verbose(str)
+            || parse_fix_times_per_prb(str) || parse_peak_gflops(str)
+            || parse_peak_bandwidth(str) || parse_verbose(str)
             || parse_engine(str) || parse_fast_ref_gpu(str)
             || parse_canonical(str) || parse_mem_check(str)
             || parse_skip_impl(str) || parse_allow_enum_tags_only(str)
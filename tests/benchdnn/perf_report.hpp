@@ -65,6 +65,28 @@ struct base_perf_report_t {
             return (r->ibytes + r->obytes) / t.sec(mode) / unit;
         };
 
+        auto get_lib_flops = [&]() -> double {
+            if (!t.sec(mode)) return 0;
+            return r->lib_ops / t.sec(mode) / unit;
+        };
+
+        auto get_lib_bw = [&]() -> double {
+            if (!t.sec(mode)) return 0;
+            return r->lib_bytes / t.sec(mode) / unit;
+        };
+
+        // The ratio of the time the problem takes at the performance the
+        // system can attain according to the roofline model to the actual
+        // time
+        auto get_roofline = [&]() -> double {
+            if (!t.sec(mode) || peak_gflops <= 0 || peak_bandwidth <= 0)
+                return 0;
+            const double attainable_sec
+                    = MAX2(r->lib_ops / (peak_gflops * 1e9),
+                            r->lib_bytes / (peak_bandwidth * 1e9));
+            return attainable_sec / t.sec(mode);
+        };
+
         auto get_freq = [&]() -> double {
             if (!t.sec(mode)) return 0;
             return t.ticks(mode) / t.sec(mode) / unit;
@@ -106,10 +128,16 @@ struct base_perf_report_t {
         HANDLE("freq", s << get_freq());
         HANDLE("ops", s << ops() / unit);
         HANDLE("time", s << t.ms(mode) / unit);
+        HANDLE("tlbm", s << t.tlb_misses(mode) / unit);
         HANDLE("impl", s << r->impl_name);
         HANDLE("ibytes", s << r->ibytes / unit);
         HANDLE("obytes", s << r->obytes / unit);
         HANDLE("iobytes", s << (r->ibytes + r->obytes) / unit);
+        HANDLE("lops", s << r->lib_ops / unit);
+        HANDLE("lflops", s << get_lib_flops());
+        HANDLE("lbytes", s << r->lib_bytes / unit);
+        HANDLE("lbw", s << get_lib_bw());
+        HANDLE("roofline", s << get_roofline());
         HANDLE("idx", s << benchdnn_stat.tests);
 
 #undef HANDLE
@@ -14,7 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cstdlib>
 #include <thread>
+#include <vector>
 
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
@@ -65,6 +67,65 @@ HANDLE_EXCEPTIONS_FOR_TEST_P(engine_test_t, TestMultithreading) {
     exe.join();
 }
 
+#if !defined(_WIN32) && DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+namespace {
+struct allocator_stats_t {
+    int nallocs[3] = {0, 0, 0};
+    int nfrees[3] = {0, 0, 0};
+};
+
+void *counting_allocate(size_t size, size_t alignment,
+        dnnl_allocation_kind_t kind, void *user_data) {
+    auto *stats = static_cast<allocator_stats_t *>(user_data);
+    stats->nallocs[kind]++;
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) return nullptr;
+    return ptr;
+}
+
+void counting_deallocate(
+        void *ptr, dnnl_allocation_kind_t kind, void *user_data) {
+    auto *stats = static_cast<allocator_stats_t *>(user_data);
+    stats->nfrees[kind]++;
+    free(ptr);
+}
+} // namespace
+
+TEST(engine_allocator_test_t, TestCustomAllocator) {
+    SKIP_IF(engine::get_count(engine::kind::cpu) == 0, "Engine is not found.");
+    engine eng(engine::kind::cpu, 0);
+    allocator_stats_t stats;
+    eng.set_allocator(counting_allocate, counting_deallocate, &stats);
+
+    memory::desc md({2, 16, 7, 7}, memory::data_type::f32,
+            memory::format_tag::nchw);
+    {
+        memory mem(md, eng);
+        ASSERT_EQ(stats.nallocs[dnnl_allocation_kind_memory], 1);
+        ASSERT_NE(mem.get_data_handle(), nullptr);
+    }
+    ASSERT_EQ(stats.nfrees[dnnl_allocation_kind_memory], 1);
+
+    // Memory objects with a user-provided buffer do not allocate
+    std::vector<float> buf(md.get_size() / sizeof(float));
+    { memory mem(md, eng, buf.data()); }
+    ASSERT_EQ(stats.nallocs[dnnl_allocation_kind_memory], 1);
+
+    // Restoring the default allocator does not affect buffers allocated
+    // before
+    memory mem(md, eng);
+    eng.set_allocator(nullptr, nullptr);
+    mem = memory();
+    ASSERT_EQ(stats.nfrees[dnnl_allocation_kind_memory], 2);
+    { memory mem2(md, eng); }
+    ASSERT_EQ(stats.nallocs[dnnl_allocation_kind_memory], 2);
+
+    ASSERT_EQ(dnnl_engine_set_allocator(
+                      eng.get(), counting_allocate, nullptr, nullptr),
+            dnnl_invalid_arguments);
+}
+#endif
+
 INSTANTIATE_TEST_SUITE_P(AllEngineKinds, engine_test_t,
         ::testing::Values(engine::kind::cpu, engine::kind::gpu));
 
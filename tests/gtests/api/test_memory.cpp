@@ -118,6 +118,41 @@ TEST_P(memory_test_cpp_t, OutOfMemory) {
     if (!is_sycl) FAIL() << "Expected exception.";
 }
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+TEST(memory_large_allocation_test_t, Policy) {
+    SKIP_IF(engine::get_count(engine::kind::cpu) == 0, "Engine is not found.");
+    size_t threshold = 0;
+    int use_huge_pages = 0;
+    dnnl_memory_placement_t placement;
+    DNNL_CHECK(dnnl_get_large_allocation_policy(
+            &threshold, &use_huge_pages, &placement));
+    ASSERT_EQ(dnnl_set_large_allocation_policy(
+                      1, 1, static_cast<dnnl_memory_placement_t>(3)),
+            dnnl_invalid_arguments);
+    ASSERT_EQ(dnnl_get_large_allocation_policy(nullptr, nullptr, nullptr),
+            dnnl_invalid_arguments);
+
+    engine eng(engine::kind::cpu, 0);
+    memory::desc md({3 << 20}, memory::data_type::u8, memory::format_tag::x);
+    for (auto p : {memory_placement::system, memory_placement::first_touch,
+                 memory_placement::interleave}) {
+        set_large_allocation_policy(1 << 20, true, p);
+        ASSERT_EQ(get_large_allocation_threshold(), (size_t)1 << 20);
+        memory mem(md, eng);
+        auto *ptr = static_cast<uint8_t *>(mem.get_data_handle());
+        ASSERT_NE(ptr, nullptr);
+#ifndef DNNL_ENABLE_MEM_DEBUG
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % (2 << 20), 0u);
+#endif
+        for (size_t i = 0; i < md.get_size(); i += 4096)
+            ptr[i] = 1;
+    }
+
+    DNNL_CHECK(dnnl_set_large_allocation_policy(
+            threshold, use_huge_pages, placement));
+}
+#endif
+
 namespace {
 struct print_to_string_param_name_t {
     template <class ParamType>
@@ -20,6 +20,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include <tuple>
+#include <vector>
 
 namespace dnnl {
 
@@ -133,6 +134,187 @@ TEST(stream_test_c_t, GetStream) {
     DNNL_CHECK(dnnl_engine_destroy(engine));
 }
 
+TEST(stream_test_c_t, ThreadTeamInvalidArguments) {
+    dnnl_engine_t engine;
+    DNNL_CHECK(dnnl_engine_create(&engine, dnnl_cpu, 0));
+
+    dnnl_stream_t stream;
+    const int cpus[] = {0, -1};
+    ASSERT_EQ(dnnl_stream_create_with_thread_team(&stream, engine,
+                      dnnl_stream_default_flags, 0, 0, nullptr),
+            dnnl_invalid_arguments);
+    ASSERT_EQ(dnnl_stream_create_with_thread_team(&stream, engine,
+                      dnnl_stream_default_flags, 1, 1, nullptr),
+            dnnl_invalid_arguments);
+    ASSERT_EQ(dnnl_stream_create_with_thread_team(&stream, engine,
+                      dnnl_stream_default_flags, 1, 2, cpus),
+            dnnl_invalid_arguments);
+    ASSERT_EQ(dnnl_set_current_thread_team(-1), dnnl_invalid_arguments);
+
+    DNNL_CHECK(dnnl_engine_destroy(engine));
+}
+
+TEST(stream_test_cpp_t, ThreadTeam) {
+    engine eng(engine::kind::cpu, 0);
+    set_current_thread_team(2);
+    stream s(eng, stream::flags::default_flags, 2, {0});
+
+    const memory::dim n = 1024;
+    memory::desc md({n}, memory::data_type::f32, memory::format_tag::a);
+    memory src(md, eng), dst(md, eng);
+    float *src_ptr = static_cast<float *>(src.get_data_handle());
+    for (memory::dim j = 0; j < n; j++)
+        src_ptr[j] = (j % 2 ? -1.f : 1.f) * (float)j;
+
+    auto pd = eltwise_forward::primitive_desc(
+            {prop_kind::forward_inference, algorithm::eltwise_relu, md, 0.f},
+            eng);
+    eltwise_forward(pd).execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    s.wait();
+    set_current_thread_team(0);
+
+    const float *dst_ptr = static_cast<float *>(dst.get_data_handle());
+    for (memory::dim j = 0; j < n; j++)
+        ASSERT_EQ(dst_ptr[j], j % 2 ? 0.f : (float)j);
+}
+
+// A primitive created for a single thread executes on a stream bound to a
+// larger team. Its per-thread scratchpad buffers are sized for one thread, so
+// the team must be clamped to it.
+TEST(stream_test_cpp_t, ThreadTeamLargerThanCreation) {
+    engine eng(engine::kind::cpu, 0);
+
+    const memory::dim outer = 64, c = 1000;
+    memory::desc src_md({outer, c}, memory::data_type::f32,
+            memory::format_tag::ab);
+    memory::desc dst_md({outer, 2 * c}, memory::data_type::f32,
+            memory::format_tag::ab);
+    primitive_attr attr;
+    attr.set_scratchpad_mode(scratchpad_mode::user);
+
+    set_current_thread_team(1);
+    auto pd = concat::primitive_desc(dst_md, 1, {src_md, src_md}, eng, attr);
+    concat concat_prim(pd);
+    set_current_thread_team(0);
+
+    // The scratchpad is followed by a guard that must stay untouched
+    const size_t scratchpad_size = pd.scratchpad_desc().get_size();
+    const memory::dim guard_size = 4096;
+    std::vector<uint8_t> scratchpad_buf(scratchpad_size + guard_size, 0xA5);
+    memory scratchpad(
+            {{(memory::dim)scratchpad_size + guard_size}, memory::data_type::u8,
+                    memory::format_tag::a},
+            eng, scratchpad_buf.data());
+
+    memory src0(src_md, eng), src1(src_md, eng), dst(dst_md, eng);
+    float *src0_ptr = static_cast<float *>(src0.get_data_handle());
+    float *src1_ptr = static_cast<float *>(src1.get_data_handle());
+    for (memory::dim i = 0; i < outer * c; i++) {
+        src0_ptr[i] = (float)i;
+        src1_ptr[i] = -(float)i;
+    }
+
+    stream s(eng, stream::flags::default_flags, 64);
+    concat_prim.execute(s,
+            {{DNNL_ARG_MULTIPLE_SRC, src0}, {DNNL_ARG_MULTIPLE_SRC + 1, src1},
+                    {DNNL_ARG_DST, dst}, {DNNL_ARG_SCRATCHPAD, scratchpad}});
+    s.wait();
+
+    for (size_t i = scratchpad_size; i < scratchpad_buf.size(); i++)
+        ASSERT_EQ(scratchpad_buf[i], 0xA5) << "scratchpad overrun at " << i;
+    const float *dst_ptr = static_cast<float *>(dst.get_data_handle());
+    for (memory::dim i = 0; i < outer; i++)
+        for (memory::dim j = 0; j < c; j++) {
+            ASSERT_EQ(dst_ptr[i * 2 * c + j], (float)(i * c + j));
+            ASSERT_EQ(dst_ptr[i * 2 * c + c + j], -(float)(i * c + j));
+        }
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+TEST(stream_test_cpp_t, AsyncThreadpoolStream) {
+    engine eng(engine::kind::cpu, 0);
+    stream s = threadpool_interop::make_async_stream(
+            eng, dnnl::testing::get_threadpool());
+
+    const memory::dim n = 1024;
+    const int niters = 16;
+    memory::desc md({n}, memory::data_type::f32, memory::format_tag::a);
+    std::vector<memory> src, dst;
+    for (int i = 0; i < niters; i++) {
+        src.emplace_back(md, eng);
+        dst.emplace_back(md, eng);
+        float *ptr = static_cast<float *>(src[i].get_data_handle());
+        for (memory::dim j = 0; j < n; j++)
+            ptr[j] = (j % 2 ? -1.f : 1.f) * (float)(i + j);
+    }
+
+    auto pd = eltwise_forward::primitive_desc(
+            {prop_kind::forward_inference, algorithm::eltwise_relu, md, 0.f},
+            eng);
+    eltwise_forward relu(pd);
+
+    // The primitives complete in order, after the callback they precede
+    struct done_t {
+        int ncalls = 0;
+        dnnl_status_t status = dnnl_runtime_error;
+    } done;
+    auto callback = [](dnnl_status_t status, void *user_data) {
+        auto *d = static_cast<done_t *>(user_data);
+        d->ncalls++;
+        d->status = status;
+    };
+    for (int i = 0; i < niters; i++)
+        relu.execute(s, {{DNNL_ARG_SRC, src[i]}, {DNNL_ARG_DST, dst[i]}});
+    threadpool_interop::enqueue_callback(s, callback, &done);
+    s.wait();
+
+    ASSERT_EQ(done.ncalls, 1);
+    ASSERT_EQ(done.status, dnnl_success);
+    for (int i = 0; i < niters; i++) {
+        const float *ptr = static_cast<float *>(dst[i].get_data_handle());
+        for (memory::dim j = 0; j < n; j++)
+            ASSERT_EQ(ptr[j], j % 2 ? 0.f : (float)(i + j));
+    }
+}
+
+// With more streams than threads, the tasks of the streams may occupy all the
+// workers while their primitives execute parallel sections
+TEST(stream_test_cpp_t, AsyncThreadpoolStreamsOversubscribed) {
+    engine eng(engine::kind::cpu, 0);
+    auto *tp = dnnl::testing::get_threadpool();
+    const int nstreams = 2 * tp->get_num_threads() + 1;
+
+    const memory::dim n = 1 << 16;
+    memory::desc md({n}, memory::data_type::f32, memory::format_tag::a);
+    std::vector<stream> streams;
+    std::vector<memory> src, dst;
+    for (int i = 0; i < nstreams; i++) {
+        streams.push_back(threadpool_interop::make_async_stream(eng, tp));
+        src.emplace_back(md, eng);
+        dst.emplace_back(md, eng);
+        float *ptr = static_cast<float *>(src[i].get_data_handle());
+        for (memory::dim j = 0; j < n; j++)
+            ptr[j] = (j % 2 ? -1.f : 1.f) * (float)(i + j);
+    }
+
+    auto pd = eltwise_forward::primitive_desc(
+            {prop_kind::forward_inference, algorithm::eltwise_relu, md, 0.f},
+            eng);
+    eltwise_forward relu(pd);
+    for (int i = 0; i < nstreams; i++)
+        relu.execute(
+                streams[i], {{DNNL_ARG_SRC, src[i]}, {DNNL_ARG_DST, dst[i]}});
+    for (int i = 0; i < nstreams; i++)
+        streams[i].wait();
+
+    for (int i = 0; i < nstreams; i++) {
+        const float *ptr = static_cast<float *>(dst[i].get_data_handle());
+        for (memory::dim j = 0; j < n; j++)
+            ASSERT_EQ(ptr[j], j % 2 ? 0.f : (float)(i + j));
+    }
+}
+#endif
+
 namespace {
 struct print_to_string_param_name_t {
     template <class ParamType>
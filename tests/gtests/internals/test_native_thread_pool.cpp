@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace dnnl {
+
+TEST(test_native_thread_pool, EachThreadIdIsCalledOnce) {
+    const int nthr = dnnl_get_max_threads();
+    ASSERT_GT(nthr, 0);
+    std::vector<int> calls(nthr, 0);
+    impl::parallel(nthr, [&](int ithr, int nthr_) {
+        ASSERT_EQ(nthr_, nthr);
+        ASSERT_TRUE(dnnl_in_parallel());
+        calls[ithr]++;
+    });
+    ASSERT_FALSE(dnnl_in_parallel());
+    for (int ithr = 0; ithr < nthr; ithr++)
+        ASSERT_EQ(calls[ithr], 1);
+}
+
+TEST(test_native_thread_pool, ParallelNdCoversAllWork) {
+    const int D0 = 37, D1 = 129;
+    std::vector<int> visits(D0 * D1, 0);
+    impl::parallel_nd(D0, D1, [&](int d0, int d1) { visits[d0 * D1 + d1]++; });
+    for (int v : visits)
+        ASSERT_EQ(v, 1);
+}
+
+TEST(test_native_thread_pool, NestedSectionsRunSequentially) {
+    const int nthr = dnnl_get_max_threads();
+    std::atomic<int> total {0};
+    impl::parallel(nthr, [&](int, int) {
+        ASSERT_EQ(dnnl_get_current_num_threads(), 1);
+        impl::parallel(4, [&](int, int nthr_inner) {
+            ASSERT_EQ(nthr_inner, 4);
+            total++;
+        });
+    });
+    ASSERT_EQ(total, 4 * nthr);
+}
+
+TEST(test_native_thread_pool, ConcurrentSubmitters) {
+    const int nsubmitters = 4, nsections = 100;
+    std::atomic<int> total {0};
+    std::vector<std::thread> submitters;
+    for (int s = 0; s < nsubmitters; s++)
+        submitters.emplace_back([&]() {
+            for (int i = 0; i < nsections; i++)
+                impl::parallel(0, [&](int, int) { total++; });
+        });
+    for (auto &t : submitters)
+        t.join();
+    ASSERT_EQ(total, nsubmitters * nsections * dnnl_get_max_threads());
+}
+
+} // namespace dnnl
+
+#endif
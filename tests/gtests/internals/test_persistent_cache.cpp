@@ -0,0 +1,65 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "src/common/persistent_cache.hpp"
+
+namespace dnnl {
+
+using impl::persistent_impl_cache_t;
+
+TEST(persistent_cache_test, TestDisabled) {
+    persistent_impl_cache_t cache("");
+    ASSERT_FALSE(cache.is_enabled());
+    cache.set_impl_idx(1, 2, "impl");
+    ASSERT_EQ(cache.get_impl_idx(1), -1);
+}
+
+TEST(persistent_cache_test, TestReload) {
+    std::string file_name;
+    {
+        persistent_impl_cache_t cache(".");
+        ASSERT_TRUE(cache.is_enabled());
+        file_name = cache.file_name();
+        // Start from an empty cache in case the file is left from a previous
+        // run.
+        remove(file_name.c_str());
+    }
+
+    {
+        persistent_impl_cache_t cache(".");
+        ASSERT_EQ(cache.get_impl_idx(0x1234), -1);
+        cache.set_impl_idx(0x1234, 3, "impl_a");
+        cache.set_impl_idx(0x5678, 0, "impl_b");
+        cache.set_impl_idx(0x5678, 7, "impl_c");
+        ASSERT_EQ(cache.get_impl_idx(0x1234), 3);
+        ASSERT_EQ(cache.get_impl_idx(0x5678), 7);
+    }
+
+    // A new instance (e.g. in another process) sees the recorded entries.
+    persistent_impl_cache_t cache(".");
+    ASSERT_EQ(cache.get_impl_idx(0x1234), 3);
+    ASSERT_EQ(cache.get_impl_idx(0x5678), 7);
+    ASSERT_EQ(cache.get_impl_idx(0x9abc), -1);
+
+    remove(file_name.c_str());
+}
+
+} // namespace dnnl
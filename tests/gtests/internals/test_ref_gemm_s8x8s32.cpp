@@ -0,0 +1,177 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "src/cpu/gemm/s8x8s32/ref_gemm_s8x8s32.hpp"
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#include "omp.h"
+#endif
+
+// ref_gemm_s8x8s32() is only reached through dnnl_gemm_*() on the platforms
+// with no JIT integer gemm, so it is tested directly against a naive loop.
+
+namespace dnnl {
+
+using impl::dim_t;
+
+struct ref_gemm_s8x8s32_params_t {
+    char transa, transb, offsetc;
+    dim_t M, N, K;
+    float alpha, beta;
+    int8_t ao;
+    int bo;
+    // Number of threads to run with, 0 to keep the default. With OpenMP
+    // a large enough number of threads splits K across the threads.
+    int nthr;
+};
+
+template <typename b_dt>
+class ref_gemm_s8x8s32_test_t
+    : public ::testing::TestWithParam<ref_gemm_s8x8s32_params_t> {
+protected:
+    void Test() {
+        const auto &p = GetParam();
+        const bool tr_a = p.transa == 'T', tr_b = p.transb == 'T';
+        // Padded leading dimensions to catch stride mistakes
+        const dim_t lda = (tr_a ? p.K : p.M) + 3;
+        const dim_t ldb = (tr_b ? p.N : p.K) + 5;
+        const dim_t ldc = p.M + 2;
+
+        const bool b_signed = std::is_signed<b_dt>::value;
+        std::vector<int8_t> A(lda * (tr_a ? p.M : p.K));
+        std::vector<b_dt> B(ldb * (tr_b ? p.K : p.N));
+        std::vector<int32_t> C(ldc * p.N), co(std::max(p.M, p.N));
+        for (size_t i = 0; i < A.size(); i++)
+            A[i] = (int8_t)((i * 7 + 3) % 17 - 8);
+        for (size_t i = 0; i < B.size(); i++)
+            B[i] = (b_dt)((i * 5 + 1) % 17 - (b_signed ? 8 : 0));
+        for (size_t i = 0; i < C.size(); i++)
+            C[i] = (int32_t)((i * 3) % 101) - 50;
+        for (size_t i = 0; i < co.size(); i++)
+            co[i] = (int32_t)(i % 13) - 6;
+
+        auto a = [&](dim_t i, dim_t k) {
+            return (int)(tr_a ? A[k + i * lda] : A[i + k * lda]);
+        };
+        auto b = [&](dim_t k, dim_t j) {
+            return (int)(tr_b ? B[j + k * ldb] : B[k + j * ldb]);
+        };
+        auto c_offset = [&](dim_t i, dim_t j) {
+            return p.offsetc == 'R' ? co[j] : p.offsetc == 'C' ? co[i] : co[0];
+        };
+
+        // Values stay well within 2^24, so every result is exactly
+        // representable and the rounding matches the library one.
+        std::vector<int32_t> C_ref(C);
+        for (dim_t j = 0; j < p.N; j++)
+            for (dim_t i = 0; i < p.M; i++) {
+                int64_t acc = 0;
+                for (dim_t k = 0; k < p.K; k++)
+                    acc += (int64_t)(a(i, k) - p.ao) * (b(k, j) - p.bo);
+                int32_t &c = C_ref[i + j * ldc];
+                const double val = (double)p.alpha * (double)acc
+                        + (p.beta == 0.f ? 0.0 : (double)p.beta * c)
+                        + (double)c_offset(i, j);
+                c = (int32_t)std::nearbyint(val);
+            }
+
+        const b_dt bo = (b_dt)p.bo;
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        const int nthr_saved = omp_get_max_threads();
+        if (p.nthr > 0) omp_set_num_threads(p.nthr);
+#endif
+        const dnnl_status_t status = impl::cpu::ref_gemm_s8x8s32<b_dt>(
+                &p.transa, &p.transb, &p.offsetc, &p.M, &p.N, &p.K, &p.alpha,
+                A.data(), &lda, &p.ao, B.data(), &ldb, &bo, &p.beta, C.data(),
+                &ldc, co.data());
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        omp_set_num_threads(nthr_saved);
+#endif
+        ASSERT_EQ(status, dnnl_success);
+
+        // The padding of C must stay untouched as well
+        for (size_t i = 0; i < C.size(); i++)
+            ASSERT_EQ(C[i], C_ref[i]) << "i: " << i % ldc << " j: " << i / ldc;
+    }
+};
+
+using ref_gemm_s8u8s32_test_t = ref_gemm_s8x8s32_test_t<uint8_t>;
+using ref_gemm_s8s8s32_test_t = ref_gemm_s8x8s32_test_t<int8_t>;
+
+TEST_P(ref_gemm_s8u8s32_test_t, TestsRefGemm) {
+    Test();
+}
+
+TEST_P(ref_gemm_s8s8s32_test_t, TestsRefGemm) {
+    Test();
+}
+
+// Cases valid for both signed and unsigned B: bo is within [0, 127]
+static auto ref_gemm_cases = ::testing::Values(
+        // Transpositions with the exact s32 path (alpha = 1, beta in {0, 1})
+        ref_gemm_s8x8s32_params_t {'N', 'N', 'F', 30, 20, 10, 1.f, 0.f, 0,
+                0, 0},
+        ref_gemm_s8x8s32_params_t {'N', 'T', 'F', 30, 20, 10, 1.f, 1.f, 0,
+                0, 0},
+        ref_gemm_s8x8s32_params_t {'T', 'N', 'F', 30, 20, 10, 1.f, 1.f, 0,
+                0, 0},
+        ref_gemm_s8x8s32_params_t {'T', 'T', 'F', 30, 20, 10, 1.f, 0.f, 0,
+                0, 0},
+        // Offsets of A, B and C
+        ref_gemm_s8x8s32_params_t {'N', 'N', 'F', 17, 9, 23, 1.f, 1.f, 3,
+                5, 0},
+        ref_gemm_s8x8s32_params_t {'N', 'T', 'R', 17, 9, 23, 1.f, 0.f, -4,
+                7, 0},
+        ref_gemm_s8x8s32_params_t {'T', 'N', 'C', 17, 9, 23, 1.f, 1.f, 2,
+                1, 0},
+        ref_gemm_s8x8s32_params_t {'T', 'T', 'R', 17, 9, 23, 1.f, 1.f, -1,
+                2, 0},
+        // Floating-point post-processing (alpha != 1 or beta not in {0, 1})
+        ref_gemm_s8x8s32_params_t {'N', 'N', 'C', 33, 19, 37, 0.5f, 0.f, 1,
+                3, 0},
+        ref_gemm_s8x8s32_params_t {'N', 'T', 'F', 33, 19, 37, 1.f, 2.f, -2,
+                0, 0},
+        ref_gemm_s8x8s32_params_t {'T', 'N', 'R', 33, 19, 37, 2.25f, -0.5f,
+                0, 4, 0},
+        ref_gemm_s8x8s32_params_t {'T', 'T', 'C', 33, 19, 37, 0.75f, 1.f, 5,
+                6, 0},
+        // K is not a multiple of the dot-product group and spans several
+        // cache blocks, M and N span several blocks and unroll remainders
+        ref_gemm_s8x8s32_params_t {'N', 'N', 'F', 211, 389, 1030, 1.f, 1.f,
+                1, 2, 0},
+        ref_gemm_s8x8s32_params_t {'T', 'N', 'R', 211, 389, 1030, 0.5f,
+                -0.5f, -3, 1, 0},
+        // K split across the threads, on both the exact and the
+        // post-processing paths
+        ref_gemm_s8x8s32_params_t {'N', 'N', 'F', 20, 10, 1001, 1.f, 1.f, 2,
+                3, 8},
+        ref_gemm_s8x8s32_params_t {'T', 'T', 'C', 20, 10, 1001, 1.f, 0.f, 0,
+                0, 16},
+        ref_gemm_s8x8s32_params_t {'N', 'T', 'R', 20, 10, 1001, 0.5f, 2.f,
+                -1, 4, 8});
+
+INSTANTIATE_TEST_SUITE_P(TestRefGemm, ref_gemm_s8u8s32_test_t, ref_gemm_cases);
+INSTANTIATE_TEST_SUITE_P(TestRefGemm, ref_gemm_s8s8s32_test_t, ref_gemm_cases);
+
+} // namespace dnnl
@@ -285,6 +285,14 @@ static auto cases_padded = []() {
                     {{4, 8, 5, 5}, {4, 3, 5, 5}}, {4, 11, 5, 5}},
             concat_test_params_t {1, {fmt::nChw8c, fmt::nChw16c}, fmt::nChw16c,
                     {{4, 8, 5, 5}, {4, 3, 5, 5}}, {4, 11, 5, 5}},
+            // many inputs
+            concat_test_params_t {1,
+                    {fmt::nChw16c, fmt::nChw16c, fmt::nChw16c, fmt::nChw16c,
+                            fmt::nChw16c},
+                    fmt::nChw16c,
+                    {{2, 3, 5, 5}, {2, 20, 5, 5}, {2, 1, 5, 5}, {2, 32, 5, 5},
+                            {2, 9, 5, 5}},
+                    {2, 65, 5, 5}},
             // not over channels
             concat_test_params_t {2, {fmt::nChw16c, fmt::nChw16c}, fmt::nchw,
                     {{4, 25, 5, 5}, {4, 25, 5, 5}}, {4, 25, 10, 5}},
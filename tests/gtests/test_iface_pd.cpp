@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2019-2020 Intel Corporation
+* Copyright 2019-2021 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -69,4 +69,19 @@ TEST_F(pd_test_t, ConvTestEmpty) {
     }
 }
 
+TEST_F(pd_test_t, ConvTestEstimates) {
+    auto pd = convolution_forward::primitive_desc {
+            {prop_kind::forward_inference, algorithm::convolution_direct,
+                    dat_md, wht_md, dat_md, {1, 1}, {0, 0}, {0, 0}},
+            e};
+
+    // A multiply-add per output point and input channel
+    const double flops = 2. * 16 * 16 * 16 * 16 * 16;
+    ASSERT_EQ(pd.query_f64(query::flops_estimate_f64), flops);
+
+    // The source and the weights are read and the destination is written
+    const double bytes = (double)(2 * dat_md.get_size() + wht_md.get_size());
+    ASSERT_EQ(pd.query_f64(query::bytes_estimate_f64), bytes);
+}
+
 } // namespace dnnl
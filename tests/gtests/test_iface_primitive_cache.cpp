@@ -73,6 +73,34 @@ TEST(primitive_cache_test, TestEviction) {
     ASSERT_EQ(get_primitive_cache_size(), 22);
 }
 
+TEST(primitive_cache_test, TestEvictionRecentlyUsed) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    engine eng(get_test_engine_kind(), 0);
+    auto create_relu_pd = [&](int i) {
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, {{i, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        return eltwise_forward::primitive_desc(relu_d, eng);
+    };
+
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(4);
+    fill_primitive_cache(4);
+
+    // Hit the oldest entry, the next one in the insertion order must be
+    // evicted instead.
+    auto relu_pd_0 = create_relu_pd(0);
+    auto relu_0 = eltwise_forward(relu_pd_0);
+    auto relu_pd_4 = create_relu_pd(4);
+    auto relu_4 = eltwise_forward(relu_pd_4);
+
+    ASSERT_EQ(get_primitive_cache_size(), 4);
+    ASSERT_TRUE(impl::is_pd_in_cache(relu_pd_0.get()));
+    ASSERT_FALSE(impl::is_pd_in_cache(create_relu_pd(1).get()));
+}
+
 TEST(primitive_cache_test, TestSizeLessCapacity) {
     set_primitive_cache_capacity(0);
     set_primitive_cache_capacity(15);
@@ -89,6 +117,58 @@ TEST(primitive_cache_test, TestSizeGreaterCapacity) {
     ASSERT_EQ(get_primitive_cache_size(), 10);
 }
 
+TEST(primitive_cache_test, TestStats) {
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(2);
+    auto start = get_primitive_cache_stats();
+    ASSERT_EQ(start.size, 0);
+    ASSERT_EQ(start.capacity, 2);
+
+    fill_primitive_cache(3);
+    auto stats = get_primitive_cache_stats();
+    ASSERT_EQ(stats.misses - start.misses, 3);
+    ASSERT_EQ(stats.evictions - start.evictions, 1);
+    ASSERT_EQ(stats.size, 2);
+    ASSERT_GE(stats.creation_time_ms, start.creation_time_ms);
+
+    // The first primitive has been evicted.
+    auto hits = stats.hits;
+    fill_primitive_cache(1);
+    stats = get_primitive_cache_stats();
+    ASSERT_EQ(stats.misses - start.misses, 4);
+    ASSERT_EQ(stats.evictions - start.evictions, 2);
+
+    set_primitive_cache_capacity(0);
+    stats = get_primitive_cache_stats();
+    ASSERT_EQ(stats.hits, hits);
+    ASSERT_EQ(stats.evictions - start.evictions, 4);
+    ASSERT_EQ(stats.size, 0);
+    ASSERT_EQ(stats.scratchpad_size, 0u);
+    ASSERT_EQ(stats.jit_code_size, 0u);
+}
+
+TEST(primitive_cache_test, TestBudget) {
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(1024);
+    set_primitive_cache_budget(1);
+    ASSERT_EQ(get_primitive_cache_budget(), 1u);
+
+    fill_primitive_cache(4);
+    auto stats = get_primitive_cache_stats();
+    ASSERT_LE(stats.scratchpad_size + stats.jit_code_size, 1u);
+
+    // Without the budget all the primitives are kept.
+    set_primitive_cache_budget(0);
+    fill_primitive_cache(4);
+    ASSERT_EQ(get_primitive_cache_size(), 4);
+
+    // Setting the budget evicts the primitives that don't fit.
+    set_primitive_cache_budget(1);
+    stats = get_primitive_cache_stats();
+    ASSERT_LE(stats.scratchpad_size + stats.jit_code_size, 1u);
+    set_primitive_cache_budget(0);
+}
+
 TEST(primitive_cache_test, TestCacheHit) {
     set_primitive_cache_capacity(0);
     set_primitive_cache_capacity(2);
@@ -14,8 +14,10 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <vector>
 
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
@@ -683,5 +685,62 @@ private:
 
 TEST_P(lnorm_test_t, TestsLnormF32) {}
 
+class lnorm_fused_test_t : public ::testing::Test {};
+
+// Residual add, normalization and quantization to s8 in a single primitive.
+CPU_TEST_F(lnorm_fused_test_t, TestsLnormResidualS8) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+    const memory::dim N = 6, C = 35;
+    const float eps = 1e-5f, oscale = 20.f;
+
+    engine eng = get_test_engine();
+    stream strm = make_stream(eng);
+
+    memory::desc src_md({N, C}, dt::f32, tag::ab);
+    memory::desc dst_md({N, C}, dt::s8, tag::ab);
+    layer_normalization_v2_forward::desc op_d(prop_kind::forward_inference,
+            src_md, dst_md, eps, normalization_flags::none);
+
+    post_ops po;
+    po.append_binary(algorithm::binary_add, src_md);
+    primitive_attr attr;
+    attr.set_output_scales(0, {oscale});
+    attr.set_post_ops(po);
+    layer_normalization_v2_forward::primitive_desc pd(op_d, attr, eng);
+
+    memory src(src_md, eng), residual(src_md, eng), dst(dst_md, eng);
+    fill_data<float>(N * C, src);
+    fill_data<float>(N * C, residual);
+
+    layer_normalization_v2_forward(pd).execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst},
+                    {DNNL_ARG_ATTR_MULTIPLE_POST_OP(0) | DNNL_ARG_SRC_1,
+                            residual}});
+    strm.wait();
+
+    auto src_data = map_memory<const float>(src);
+    auto residual_data = map_memory<const float>(residual);
+    auto dst_data = map_memory<const int8_t>(dst);
+    for (memory::dim n = 0; n < N; n++) {
+        std::vector<float> x(C);
+        float mean = 0.f, variance = 0.f;
+        for (memory::dim c = 0; c < C; c++) {
+            x[c] = src_data[n * C + c] + residual_data[n * C + c];
+            mean += x[c];
+        }
+        mean /= C;
+        for (memory::dim c = 0; c < C; c++)
+            variance += (x[c] - mean) * (x[c] - mean);
+        variance /= C;
+
+        for (memory::dim c = 0; c < C; c++) {
+            float ref = oscale * (x[c] - mean) / std::sqrt(variance + eps);
+            ref = std::min(127.f, std::max(-128.f, std::nearbyint(ref)));
+            ASSERT_NEAR(dst_data[n * C + c], ref, 1.f);
+        }
+    }
+}
+
 #include "layer_normalization.h"
 } // namespace dnnl
@@ -14,6 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <atomic>
+#include <chrono>
+
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
@@ -102,4 +105,49 @@ TEST(primitive_cache_mt_test, TestMTCacheHit) {
     ASSERT_EQ(get_primitive_cache_size(), n_primitives);
 }
 
+// Stresses creation under contention when the number of distinct primitives
+// exceeds a large capacity: every thread keeps a hot set of cache hits while
+// adding new primitives that force eviction. The mean creation latency is
+// reported as a test property (see --gtest_output=xml).
+TEST(primitive_cache_mt_test, TestMTCacheStress) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    engine eng(get_test_engine_kind(), 0);
+
+    const int capacity = 1024;
+    const int n_primitives = 2 * capacity;
+    const int n_hot = 16;
+
+    dnnl::set_primitive_cache_capacity(0);
+    dnnl::set_primitive_cache_capacity(capacity);
+
+    auto create_eltwise_primitive = [&](int np) {
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, {{np, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        auto relu_pd = eltwise_forward::primitive_desc(relu_d, eng);
+        auto relu = eltwise_forward(relu_pd);
+    };
+
+    std::atomic<int64_t> total_ns(0);
+    dnnl::impl::parallel(0, [&](int ithr, int nthr) {
+        int64_t ns = 0;
+        for (int i = ithr; i < n_primitives; i += nthr) {
+            auto start = std::chrono::steady_clock::now();
+            create_eltwise_primitive(i);
+            create_eltwise_primitive(i % n_hot);
+            auto end = std::chrono::steady_clock::now();
+            ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    end - start)
+                          .count();
+        }
+        total_ns += ns;
+    });
+
+    ASSERT_EQ(get_primitive_cache_size(), capacity);
+    RecordProperty("mean_creation_latency_ns",
+            std::to_string(total_ns / (2 * n_primitives)));
+}
+
 } // namespace dnnl
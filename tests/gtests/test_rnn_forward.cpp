@@ -14,7 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <functional>
 #include <numeric>
+#include <unordered_map>
 #include <utility>
 #include <type_traits>
 
@@ -23,6 +25,10 @@
 
 #include "oneapi/dnnl/dnnl.hpp"
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#include "omp.h"
+#endif
+
 namespace dnnl {
 
 struct test_rnn_sizes_t {
@@ -684,4 +690,104 @@ CPU_INSTANTIATE_TEST_SUITE_P(TestGRUlbr, lbr_gru_forward_test_f32,
                                 fmt::undef},
                         test_rnn_sizes_t {3, 1, 5, 1, 4, 4, 4, 4}}));
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+// Small forward problems run the cells of a direction along the
+// anti-diagonals of the grid when it is at least as wide as the number of
+// threads, which single-threaded runs never reach. The results computed with
+// enough threads are compared to the single-threaded ones.
+class rnn_wavefront_test_t : public ::testing::Test {
+protected:
+    static constexpr memory::dim L = 4, T = 6, N = 2, C = 16;
+    static constexpr int nthr_wavefront = (int)L;
+
+    memory::desc md(const memory::dims &dims, memory::format_tag tag) {
+        return memory::desc(dims, memory::data_type::f32, tag);
+    }
+    memory::desc weights_md(memory::dim G) {
+        return md({L, 1, C, G, C}, memory::format_tag::ldigo);
+    }
+    memory::desc bias_md(memory::dim G) {
+        return md({L, 1, G, C}, memory::format_tag::ldgo);
+    }
+    memory::desc layer_md() { return md({T, N, C}, memory::format_tag::tnc); }
+    memory::desc iter_md() {
+        return md({L, 1, N, C}, memory::format_tag::ldnc);
+    }
+
+    template <typename prim_t>
+    void Test(const std::function<typename prim_t::desc()> &make_desc) {
+        engine eng = get_test_engine();
+        stream strm = make_stream(eng);
+        const int nthr_saved = omp_get_max_threads();
+
+        auto run = [&](int nthr) {
+            // The schedule is chosen when the primitive is created
+            omp_set_num_threads(nthr);
+            typename prim_t::primitive_desc pd(make_desc(), eng);
+            std::unordered_map<int, memory> args;
+            for (int arg : {DNNL_ARG_SRC_LAYER, DNNL_ARG_SRC_ITER,
+                         DNNL_ARG_SRC_ITER_C, DNNL_ARG_WEIGHTS_LAYER,
+                         DNNL_ARG_WEIGHTS_ITER, DNNL_ARG_BIAS,
+                         DNNL_ARG_DST_LAYER, DNNL_ARG_DST_ITER,
+                         DNNL_ARG_DST_ITER_C}) {
+                auto arg_md = pd.query_md(query::exec_arg_md, arg);
+                if (arg_md.is_zero()) continue;
+                memory m(arg_md, eng);
+                fill_data<float>(
+                        arg_md.get_size() / sizeof(float), m, 0.f, 0.5f);
+                args.insert({arg, m});
+            }
+            prim_t(pd).execute(strm, args);
+            strm.wait();
+            omp_set_num_threads(nthr_saved);
+            return args;
+        };
+
+        auto ref = run(1);
+        auto tgt = run(nthr_wavefront);
+        for (int arg :
+                {DNNL_ARG_DST_LAYER, DNNL_ARG_DST_ITER, DNNL_ARG_DST_ITER_C}) {
+            if (ref.count(arg) == 0) continue;
+            compare_data<float>(ref.at(arg), tgt.at(arg), 1e-5f);
+        }
+    }
+};
+
+CPU_TEST_F(rnn_wavefront_test_t, TestsVanillaRnn) {
+    Test<vanilla_rnn_forward>([&]() {
+        return vanilla_rnn_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_tanh, dir::unidirectional_left2right,
+                layer_md(), iter_md(), weights_md(1), weights_md(1),
+                bias_md(1), layer_md(), iter_md());
+    });
+}
+
+CPU_TEST_F(rnn_wavefront_test_t, TestsLSTM) {
+    Test<lstm_forward>([&]() {
+        return lstm_forward::desc(prop_kind::forward_inference,
+                dir::unidirectional_left2right, layer_md(), iter_md(),
+                iter_md(), weights_md(4), weights_md(4), bias_md(4),
+                layer_md(), iter_md(), iter_md());
+    });
+}
+
+CPU_TEST_F(rnn_wavefront_test_t, TestsGRU) {
+    Test<gru_forward>([&]() {
+        return gru_forward::desc(prop_kind::forward_inference,
+                dir::unidirectional_left2right, layer_md(), iter_md(),
+                weights_md(3), weights_md(3), bias_md(3), layer_md(),
+                iter_md());
+    });
+}
+
+CPU_TEST_F(rnn_wavefront_test_t, TestsGRUlbr) {
+    Test<lbr_gru_forward>([&]() {
+        return lbr_gru_forward::desc(prop_kind::forward_inference,
+                dir::unidirectional_left2right, layer_md(), iter_md(),
+                weights_md(3), weights_md(3), bias_md(4), layer_md(),
+                iter_md());
+    });
+}
+#endif
+
 } // namespace dnnl
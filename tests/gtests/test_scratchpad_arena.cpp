@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <thread>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using dt = memory::data_type;
+using tag = memory::format_tag;
+
+class scratchpad_arena_test_t : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // The scratchpad arena is used by the CPU engines only
+        eng_ = engine(engine::kind::cpu, 0);
+
+        memory::desc src_md({2, 16, 13, 13}, dt::f32, tag::nchw);
+        memory::desc wei_md({16, 16, 3, 3}, dt::f32, tag::oihw);
+        memory::desc dst_md({2, 16, 13, 13}, dt::f32, tag::nchw);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, dst_md, {1, 1},
+                {1, 1}, {1, 1});
+        pd_ = convolution_forward::primitive_desc(desc, eng_);
+
+        src_ = memory(pd_.src_desc(), eng_);
+        wei_ = memory(pd_.weights_desc(), eng_);
+        fill_data<float>(src_md.get_size() / sizeof(float), src_);
+        fill_data<float>(wei_md.get_size() / sizeof(float), wei_);
+    }
+
+    memory execute(const convolution_forward &conv) {
+        memory dst(pd_.dst_desc(), eng_);
+        stream s = make_stream(eng_);
+        conv.execute(s,
+                {{DNNL_ARG_SRC, src_}, {DNNL_ARG_WEIGHTS, wei_},
+                        {DNNL_ARG_DST, dst}});
+        s.wait();
+        return dst;
+    }
+
+    engine eng_;
+    convolution_forward::primitive_desc pd_;
+    memory src_, wei_;
+};
+
+TEST_F(scratchpad_arena_test_t, Capacity) {
+    const size_t capacity = get_scratchpad_arena_capacity();
+    set_scratchpad_arena_capacity(1 << 20);
+    ASSERT_EQ(get_scratchpad_arena_capacity(), (size_t)1 << 20);
+    set_scratchpad_arena_capacity(capacity);
+    ASSERT_EQ(dnnl_get_scratchpad_arena_capacity(nullptr),
+            dnnl_invalid_arguments);
+}
+
+TEST_F(scratchpad_arena_test_t, ConcurrentExecution) {
+    const size_t capacity = get_scratchpad_arena_capacity();
+    set_scratchpad_arena_capacity(0);
+    memory ref = execute(convolution_forward(pd_));
+
+    // Primitives created with the arena enabled are executed from several
+    // threads at the same time; a small capacity forces some of the buffers
+    // to be freed
+    set_scratchpad_arena_capacity(pd_.scratchpad_desc().get_size());
+    const int nthreads = 4;
+    std::vector<convolution_forward> convs;
+    for (int i = 0; i < nthreads; i++)
+        convs.emplace_back(pd_);
+    std::vector<memory> dst(nthreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthreads; i++)
+        threads.emplace_back([&, i]() { dst[i] = execute(convs[i]); });
+    for (auto &t : threads)
+        t.join();
+    set_scratchpad_arena_capacity(capacity);
+
+    const size_t n = pd_.dst_desc().get_size() / sizeof(float);
+    const float *ref_ptr = static_cast<float *>(ref.get_data_handle());
+    for (int i = 0; i < nthreads; i++) {
+        const float *ptr = static_cast<float *>(dst[i].get_data_handle());
+        for (size_t j = 0; j < n; j++)
+            ASSERT_EQ(ptr[j], ref_ptr[j]);
+    }
+}
+
+} // namespace dnnl